@@ -105,6 +105,10 @@ CondDBESSource::CondDBESSource( const edm::ParameterSet& iConfig ) :
   m_policy( NOREFRESH ),
   m_doDump( iConfig.getUntrackedParameter<bool>( "DumpStat", false ) )
 {
+  // the payloads are loaded through database sessions which may be shared
+  // with the other CondDBESSources so they must not be read concurrently
+  usingGlobalMutex();
+
   if( iConfig.getUntrackedParameter<bool>( "RefreshAlways", false ) ) {
     m_policy = REFRESH_ALWAYS;
   }
@@ -89,6 +89,7 @@ PATH=/afs/cern.ch/work/r/rovere/protocolbuf/bin
 #include <mutex>
 #include <list>
 #include "DQMServices/Core/src/ROOTFilePB.pb.h"
+#include "DQMServices/Core/src/ROOTFilePBStream.h"
 #include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/io/gzip_stream.h>
 #include <google/protobuf/io/zero_copy_stream_impl.h>
@@ -236,6 +237,18 @@ void writeMessage(const dqmstorepb::ROOTFilePB &dqmstore_output_msg,
 }
 
 
+void fillHisto(dqmstorepb::ROOTFilePB::Histo &h,
+               const MicroME &mme) {
+  DEBUG(2, "Streaming ROOT object " << mme.fullname() << "\n");
+  h.set_full_pathname(mme.fullname());
+  TBufferFile buffer(TBufferFile::kWrite);
+  buffer.WriteObject(mme.obj);
+  h.set_size(buffer.Length());
+  h.set_flags(mme.flags);
+  h.set_streamed_histo((const void*)buffer.Buffer(),
+                       buffer.Length());
+}
+
 void fillMessage(dqmstorepb::ROOTFilePB &dqmstore_output_msg,
                  const MEStore & micromes) {
   MEStore::iterator mi = micromes.begin();
@@ -243,19 +256,36 @@ void fillMessage(dqmstorepb::ROOTFilePB &dqmstore_output_msg,
 
   DEBUG(1, "Streaming ROOT objects" << std::endl);
   for (; mi != me; ++mi) {
-    dqmstorepb::ROOTFilePB::Histo* h = dqmstore_output_msg.add_histo();
-    DEBUG(2, "Streaming ROOT object " << mi->fullname() << "\n");
-    h->set_full_pathname(mi->fullname());
-    TBufferFile buffer(TBufferFile::kWrite);
-    buffer.WriteObject(mi->obj);
-    h->set_size(buffer.Length());
-    h->set_flags(mi->flags);
-    h->set_streamed_histo((const void*)buffer.Buffer(),
-                          buffer.Length());
+    fillHisto(*dqmstore_output_msg.add_histo(), *mi);
     delete mi->obj;
   }
 }
 
+// Same output as fillMessage() and writeMessageFD(), without building
+// the whole message: each ME is streamed and deleted in turn.
+void writeMEStoreFD(const MEStore &micromes, int out_fd) {
+  FileOutputStream out_stream(out_fd);
+  GzipOutputStream::Options options;
+  options.format = GzipOutputStream::GZIP;
+  options.compression_level = 2;
+  GzipOutputStream gzip_stream(&out_stream,
+                               options);
+
+  DEBUG(1, "Streaming ROOT objects" << std::endl);
+  dqmstorepb::ROOTFilePB::Histo h;
+  for (MEStore::iterator mi = micromes.begin(), me = micromes.end(); mi != me; ++mi) {
+    h.Clear();
+    fillHisto(h, *mi);
+    dqmstorepb::writeHisto(&gzip_stream, h);
+    delete mi->obj;
+    mi->obj = nullptr;
+  }
+
+  // make sure we flush before close
+  gzip_stream.Close();
+  out_stream.Close();
+}
+
 
 void processDirectory(TFile *file,
                       const std::string& curdir,
@@ -396,25 +426,21 @@ int dumpFiles(const std::vector<std::string> &filenames) {
   return 0;
 }
 
+// The histograms are read and merged one at a time, so that only the
+// merged MEs are kept in memory, not the whole input message.  An
+// ME missing from the input, as in the files written with only the
+// modified MEs, is left as it is.
 int addFile(MEStore& micromes, int fd) {
-  dqmstorepb::ROOTFilePB dqmstore_msg;
-
   FileInputStream fin(fd);
   GzipInputStream input(&fin);
-  CodedInputStream input_coded(&input);
-  input_coded.SetTotalBytesLimit(1024*1024*1024, -1);
-  if (!dqmstore_msg.ParseFromCodedStream(&input_coded)) {
-    std::cout << "Fatal decoding stream: "
-              << fd << std::endl;
-    return ERR_NOFILE;
-  }
+  dqmstorepb::ROOTFilePB::Histo h;
+  bool corrupt = false;
 
   MEStore::iterator hint = micromes.begin();
-  for (int i = 0; i < dqmstore_msg.histo_size(); i++) {
+  while (dqmstorepb::readHisto(&input, h, corrupt)) {
     std::string path;
     std::string objname;
     TObject *obj = nullptr;
-    const dqmstorepb::ROOTFilePB::Histo &h = dqmstore_msg.histo(i);
     get_info(h, path, objname, &obj);
 
     MicroME mme(nullptr, path, objname, h.flags());
@@ -435,6 +461,11 @@ int addFile(MEStore& micromes, int fd) {
     ++hint;
   }
 
+  if (corrupt) {
+    std::cout << "Fatal decoding stream: "
+              << fd << std::endl;
+    return ERR_NOFILE;
+  }
   return 0;
 }
 
@@ -528,9 +559,7 @@ void addFilesWithFork(int parent_fd, const int fork_id, const int fork_total, co
   }
 
   // output everything to fd
-  dqmstorepb::ROOTFilePB dqmstore_output_msg;
-  fillMessage(dqmstore_output_msg, microme);
-  writeMessageFD(dqmstore_output_msg, parent_fd);
+  writeMEStoreFD(microme, parent_fd);
 };
 
 int addFiles(const std::string &output_filename,
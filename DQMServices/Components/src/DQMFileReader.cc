@@ -12,6 +12,7 @@ DQMFileReader::DQMFileReader(const edm::ParameterSet& ps)
   filenames_.clear();
   filenames_=pset_.getUntrackedParameter<std::vector<std::string > >("FileNames");
   referenceFileName_=pset_.getUntrackedParameter<std::string>("referenceFileName","");
+  mergeInParallel_=pset_.getUntrackedParameter<bool>("mergeInParallel",false);
 }
 
 DQMFileReader::~DQMFileReader()
@@ -52,6 +53,13 @@ DQMFileReader::beginJob()
   
   // read in files, stripping off Run Summary and Run <number> folders
   
+  if (mergeInParallel_ && dbe_)
+  {
+    std::cout << "DQMFileReader::beginJob: merging " << filenames_.size() << " files" << std::endl;
+    dbe_->loadFiles(filenames_);
+    return;
+  }
+
   for (unsigned int i=0; i<filenames_.size(); i++)
   {
     std::cout << "DQMFileReader::beginJob: loading" << filenames_[i] << std::endl;
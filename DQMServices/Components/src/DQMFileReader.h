@@ -36,6 +36,7 @@ private:
 
   std::vector<std::string > filenames_;
   std::string referenceFileName_;
+  bool mergeInParallel_;
 
 };
 
@@ -52,8 +52,17 @@ public:
   virtual void dqmBeginRun(edm::Run const&, edm::EventSetup const&) {}
   virtual void bookHistograms(DQMStore::IBooker &i, edm::Run const&, edm::EventSetup const&) = 0;
 
+protected:
+  /// Declares, from the constructor, that the module changes its
+  /// histograms only through MonitorElement::Fill while processing
+  /// events, never through getTH1() and the like nor by reading them
+  /// back.  With the DQMStore option shareMEsAcrossStreams its streams
+  /// then fill the same histograms.
+  void fillsOnlyThroughFill(void) { fillsOnlyThroughFill_ = true; }
+
 private:
   uint32_t stream_id_;
+  bool fillsOnlyThroughFill_;
 };
 
 //<<<<<< INLINE PUBLIC FUNCTIONS                                        >>>>>>
@@ -241,11 +241,14 @@ class DQMStore
   // DQMStore instance), that is capable of booking MonitorElements
   // into the DQMStore via a public API. The central mutex is acquired
   // *before* invoking fand automatically released upon returns.
+  // shareMEs is set by the modules that fill their histograms only
+  // through MonitorElement::Fill, see DQMEDAnalyzer.
   template <typename iFunc>
   void bookTransaction(iFunc f,
 		       uint32_t run,
 		       uint32_t streamId,
-		       uint32_t moduleId) {
+		       uint32_t moduleId,
+		       bool shareMEs = false) {
     std::lock_guard<std::mutex> guard(book_mutex_);
     /* If enableMultiThread is not enabled we do not set run_,
        streamId_ and moduleId_ to 0, since we rely on their default
@@ -254,6 +257,15 @@ class DQMStore
       run_ = run;
       streamId_ = streamId;
       moduleId_ = moduleId;
+      /* With shareMEsAcrossStreams all the streams of such a module
+         book the histograms of stream 0: the first one to book creates
+         them, the others get them back as they are, possibly already
+         filled. Scalars stay per stream, only the ones of stream 0
+         are merged. */
+      if (shareMEs && shareMEsAcrossStreams_ && moduleId != 0) {
+        bookShared_ = true;
+        bookedByOtherStream_ = ! sharedBookings_.insert(std::make_pair(run, moduleId)).second;
+      }
     }
     f(*ibooker_);
 
@@ -264,6 +276,8 @@ class DQMStore
       run_ = 0;
       streamId_ = 0;
       moduleId_ = 0;
+      bookShared_ = false;
+      bookedByOtherStream_ = false;
     }
   }
   // Signature needed in the harvesting where the booking is done
@@ -538,7 +552,8 @@ class DQMStore
                                        const std::string &path = "",
 				       const uint32_t run = 0,
 				       const uint32_t lumi = 0,
-				       const bool resetMEsAfterWriting = false);
+				       const bool resetMEsAfterWriting = false,
+				       const bool onlyModified = false);
   void                          save(const std::string &filename,
                                      const std::string &path = "",
                                      const std::string &pattern = "",
@@ -558,7 +573,11 @@ class DQMStore
   bool                          load(const std::string &filename,
                                      OpenRunDirs stripdirs = StripRunDirs,
                                      bool fileMustExist = true);
+  bool                          loadFiles(const std::vector<std::string> &filenames,
+                                          OpenRunDirs stripdirs = StripRunDirs,
+                                          bool fileMustExist = true);
   bool                          mtEnabled() { return enableMultiThread_; };
+  bool                          sharesMEs(uint32_t run, uint32_t moduleId);
 
   //-------------------------------------------------------------------------
   // ---------------------- Public print methods -----------------------------
@@ -695,6 +714,7 @@ class DQMStore
   typedef std::set<MonitorElement>                                      MEMap;
   typedef std::map<std::string, QCriterion *>                           QCMap;
   typedef std::map<std::string, QCriterion *(*)(const std::string &)>   QAMap;
+  typedef std::map<std::string, QCriterion *(*)(const QCriterion &)>    QCloneMap;
 
   unsigned                      verbose_;
   unsigned                      verboseQT_;
@@ -703,6 +723,11 @@ class DQMStore
   bool                          collateHistograms_;
   bool                          enableMultiThread_;
   bool                          LSbasedMode_;
+  bool                          shareMEsAcrossStreams_;
+  bool                          bookShared_;
+  bool                          bookedByOtherStream_;
+  std::set<std::pair<uint32_t, uint32_t> > sharedBookings_; //< (run, moduleId) booked with shared MEs
+  bool                          concurrentQTests_;
   bool                          forceResetOnBeginLumi_;
   std::string                   readSelectedDirectory_;
   uint32_t                      run_;
@@ -716,6 +741,7 @@ class DQMStore
 
   QCMap                         qtests_;
   QAMap                         qalgos_;
+  QCloneMap                     qclones_;
   QTestSpecs                    qtestspecs_;
 
   std::mutex book_mutex_;
@@ -19,6 +19,8 @@
 # include <string>
 # include <set>
 # include <map>
+# include <memory>
+# include <functional>
 # include <sstream>
 # include <iomanip>
 # include <cassert>
@@ -66,12 +68,16 @@ public:
   typedef std::vector<QReport>::const_iterator QReportIterator;
 
 private:
+  struct Shards;
+
   DQMNet::CoreObject    data_;       //< Core object information.
   Scalar                scalar_;     //< Current scalar value.
   TH1                   *object_;    //< Current ROOT object value.
   TH1                   *reference_; //< Current ROOT reference object.
   TH1                   *refvalue_;  //< Soft reference if any.
   std::vector<QReport>  qreports_;   //< QReports associated to this object.
+  bool                  dirty_;      //< Modified since last saved by DQMStore::savePB.
+  std::unique_ptr<Shards> shards_;   //< Fills of the streams sharing this ME, not merged yet.
 
   MonitorElement *initialise(Kind kind);
   MonitorElement *initialise(Kind kind, TH1 *rootobj);
@@ -81,6 +87,8 @@ private:
     data_.moduleId = 0;
   }
   void setLumi(uint32_t ls) {data_.lumi = ls;}
+  void share(void);
+  void mergeShards(void);
 
 public:
   MonitorElement(void);
@@ -133,13 +141,30 @@ public:
       return path;
     }
 
+  /// true if ME is filled by all the streams of its module rather than
+  /// copied per stream.  Fill() then goes to bins shared by the threads,
+  /// or for the histograms in 3D, profiles and histograms which can
+  /// extend their axes to a histogram of the calling thread.  These
+  /// fills are added to the ME at the end of the lumi and run: until then
+  /// getTH1() and the getters do not see these entries, and filling the
+  /// ROOT object directly is not safe.
+  bool isShared(void) const
+    { return shards_ != nullptr; }
+
   /// true if ME was updated in last monitoring cycle
   bool wasUpdated(void) const
     { return data_.flags & DQMNet::DQM_PROP_NEW; }
 
   /// Mark the object updated.
   void update(void)
-    { data_.flags |= DQMNet::DQM_PROP_NEW; }
+    { data_.flags |= DQMNet::DQM_PROP_NEW; dirty_ = true; }
+
+  /// true if ME was booked or modified since DQMStore::savePB last
+  /// wrote it; unlike wasUpdated() this is not cleared by the
+  /// monitoring cycles of the DQM network.  Fills through getTH1()
+  /// and the like do not set it, savePB also looks at the entries.
+  bool isDirty(void) const
+    { return dirty_; }
 
   /// specify whether ME should be reset at end of monitoring cycle (default:false);
   /// (typically called by Sources that control the original ME)
@@ -233,9 +258,11 @@ public:
   void runQTests(void);
 
 private:
+  void runQTests(const std::function<QCriterion *(QCriterion *)> &criterion);
   void doFill(int64_t x);
   void incompatible(const char *func) const;
   TH1 *accessRootObject(const char *func, int reqdim) const;
+  TH1 *fillObject(const char *func, int reqdim);
 
 public:
 #if DQM_ROOT_METHODS
@@ -306,6 +333,10 @@ private:
   void resetUpdate(void)
     { data_.flags &= ~DQMNet::DQM_PROP_NEW; }
 
+  /// mark ME as saved, or as modified since saved
+  void setDirty(bool dirty)
+    { dirty_ = dirty; }
+
   /// true if ME should be reset at end of monitoring cycle
   bool resetMe(void) const
     { return data_.flags & DQMNet::DQM_PROP_RESET; }
@@ -322,8 +353,8 @@ public:
   void softReset(void);
 private:
   void disableSoftReset(void);
-  void addProfiles(TProfile *h1, TProfile *h2, TProfile *sum, float c1, float c2);
-  void addProfiles(TProfile2D *h1, TProfile2D *h2, TProfile2D *sum, float c1, float c2);
+  static void addProfiles(TProfile *h1, TProfile *h2, TProfile *sum, float c1, float c2);
+  static void addProfiles(TProfile2D *h1, TProfile2D *h2, TProfile2D *sum, float c1, float c2);
   void copyFunctions(TH1 *from, TH1 *to);
   void copyFrom(TH1 *from);
 
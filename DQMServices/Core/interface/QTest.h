@@ -78,7 +78,8 @@ protected:
   void setAlgoName(std::string name)    { algoName_ = name; }
 
   float runTest(const MonitorElement *me, QReport &qr, DQMNet::QValue &qv)   {
-      assert(qr.qcriterion_ == this);
+      // this may be a clone of the criterion, see DQMStore::runQTests
+      assert(qr.qcriterion_->getName() == qtname_);
       assert(qv.qtname == qtname_);
 
       prob_ = runTest(me); // this runTest goes to SimpleTest derivates
@@ -7,7 +7,9 @@
 #include "FWCore/Utilities/interface/StreamID.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
-DQMEDAnalyzer::DQMEDAnalyzer() {}
+DQMEDAnalyzer::DQMEDAnalyzer()
+  : fillsOnlyThroughFill_(false)
+{}
 
 void DQMEDAnalyzer::beginStream(edm::StreamID id)
 {
@@ -24,7 +26,8 @@ void DQMEDAnalyzer::beginRun(edm::Run const &iRun,
                          },
                          iRun.run(),
                          streamId(),
-                         iRun.moduleCallingContext()->moduleDescription()->id());
+                         iRun.moduleCallingContext()->moduleDescription()->id(),
+                         fillsOnlyThroughFill_);
 }
 
 
@@ -41,6 +44,9 @@ void DQMEDAnalyzer::endLuminosityBlockSummary(edm::LuminosityBlock const &iLumi
                                               dqmDetails::NoCache*) const {
   DQMStore * store = edm::Service<DQMStore>().operator->();
   assert(store);
+  // shared MEs are merged once all the streams are done with the lumi
+  if (store->sharesMEs(iLumi.run(), iLumi.moduleCallingContext()->moduleDescription()->id()))
+    return;
   LogDebug("DQMEDAnalyzer") << "Merging Lumi local MEs ("
                             << iLumi.run() << ", "
                             << iLumi.id().luminosityBlock() << ", "
@@ -58,6 +64,9 @@ void DQMEDAnalyzer::endRunSummary(edm::Run const &iRun ,
                                   dqmDetails::NoCache*) const {
   DQMStore * store = edm::Service<DQMStore>().operator->();
   assert(store);
+  // shared MEs are merged once all the streams are done with the run
+  if (store->sharesMEs(iRun.run(), iRun.moduleCallingContext()->moduleDescription()->id()))
+    return;
   LogDebug("DQMEDAnalyzer") << "Merging Run local MEs ("
                             << iRun.run() << ", "
                             << stream_id_ << ", "
@@ -68,11 +77,23 @@ void DQMEDAnalyzer::endRunSummary(edm::Run const &iRun ,
                                          iRun.moduleCallingContext()->moduleDescription()->id());
 }
 
-void DQMEDAnalyzer::globalEndRunSummary(edm::Run const&,
+void DQMEDAnalyzer::globalEndRunSummary(edm::Run const &iRun,
                                         edm::EventSetup const&,
                                         RunContext const*,
                                         dqmDetails::NoCache*)
-{}
+{
+  DQMStore * store = edm::Service<DQMStore>().operator->();
+  assert(store);
+  if (!store->sharesMEs(iRun.run(), iRun.moduleCallingContext()->moduleDescription()->id()))
+    return;
+  LogDebug("DQMEDAnalyzer") << "Merging Run shared MEs ("
+                            << iRun.run() << ", "
+                            << iRun.moduleCallingContext()->moduleDescription()->id()
+                            << ") into the DQMStore@" << store << std::endl;
+  store->mergeAndResetMEsRunSummaryCache(iRun.run(),
+                                         0,
+                                         iRun.moduleCallingContext()->moduleDescription()->id());
+}
 
 std::shared_ptr<dqmDetails::NoCache>
 DQMEDAnalyzer::globalBeginLuminosityBlockSummary(edm::LuminosityBlock const&,
@@ -82,11 +103,25 @@ DQMEDAnalyzer::globalBeginLuminosityBlockSummary(edm::LuminosityBlock const&,
   return nullptr;
 }
 
-void DQMEDAnalyzer::globalEndLuminosityBlockSummary(edm::LuminosityBlock const&,
+void DQMEDAnalyzer::globalEndLuminosityBlockSummary(edm::LuminosityBlock const &iLumi,
                                                     edm::EventSetup const&,
                                                     LuminosityBlockContext const*,
                                                     dqmDetails::NoCache*)
-{}
+{
+  DQMStore * store = edm::Service<DQMStore>().operator->();
+  assert(store);
+  if (!store->sharesMEs(iLumi.run(), iLumi.moduleCallingContext()->moduleDescription()->id()))
+    return;
+  LogDebug("DQMEDAnalyzer") << "Merging Lumi shared MEs ("
+                            << iLumi.run() << ", "
+                            << iLumi.id().luminosityBlock() << ", "
+                            << iLumi.moduleCallingContext()->moduleDescription()->id()
+                            << ") into the DQMStore@" << store << std::endl;
+  store->mergeAndResetMEsLuminositySummaryCache(iLumi.run(),
+                                                iLumi.id().luminosityBlock(),
+                                                0,
+                                                iLumi.moduleCallingContext()->moduleDescription()->id());
+}
 
 
 
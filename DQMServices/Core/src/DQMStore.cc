@@ -3,6 +3,7 @@
 #include "DQMServices/Core/interface/QReport.h"
 #include "DQMServices/Core/interface/QTest.h"
 #include "DQMServices/Core/src/ROOTFilePB.pb.h"
+#include "DQMServices/Core/src/ROOTFilePBStream.h"
 #include "DQMServices/Core/src/DQMError.h"
 #include "classlib/utils/RegexpMatch.h"
 #include "classlib/utils/Regexp.h"
@@ -16,6 +17,11 @@
 #include "TClass.h"
 #include "TSystem.h"
 #include "TBufferFile.h"
+#include "tbb/blocked_range.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_reduce.h"
+#include <atomic>
 #include <iterator>
 #include <cerrno>
 #include <boost/algorithm/string.hpp>
@@ -50,6 +56,9 @@ DQMOldReceiver::runQualityTests.  */
 /** @var DQMStore::qalgos_
     Set of all the available quality test algorithms. */
 
+/** @var DQMStore::qclones_
+    Copy of a quality test, for each available algorithm. */
+
 //////////////////////////////////////////////////////////////////////
 /// name of global monitoring folder (containing all sources subdirectories)
 static const std::string s_monitorDirName = "DQMData";
@@ -117,15 +126,33 @@ mergePath(std::string &path, const std::string &dir, const std::string &name)
   path += name;
 }
 
+/// Check whether the histogram of @a me has entries.  The modules
+/// filling it through getTH1() and the like do not mark it dirty.
+static bool
+hasEntries(const MonitorElement &me)
+{
+  return me.kind() >= MonitorElement::DQM_KIND_TH1F
+    && me.getTH1()->GetEntries() != 0;
+}
+
 template <class T>
 QCriterion *
 makeQCriterion(const std::string &qtname)
 { return new T(qtname); }
 
+template <class T>
+QCriterion *
+cloneQCriterion(const QCriterion &qc)
+{ return new T(static_cast<const T &>(qc)); }
+
 template <class T>
 void
-initQCriterion(std::map<std::string, QCriterion *(*)(const std::string &)> &m)
-{ m[T::getAlgoName()] = &makeQCriterion<T>; }
+initQCriterion(std::map<std::string, QCriterion *(*)(const std::string &)> &m,
+               std::map<std::string, QCriterion *(*)(const QCriterion &)> &c)
+{
+  m[T::getAlgoName()] = &makeQCriterion<T>;
+  c[T::getAlgoName()] = &cloneQCriterion<T>;
+}
 
 
 /////////////////////////////////////////////////////////////
@@ -355,7 +382,11 @@ void DQMStore::IGetter::setCurrentFolder(const std::string &fullpath) {
     into the DQMStore.
     In case we book the global object for the first time, no Add action is
     needed since the ROOT histograms is cloned starting from the local
-    one. */
+    one.
+    The histograms shared by the streams of a module are booked as the
+    ones of stream 0 and merged once, at the global end of the lumi and
+    run, when no stream fills them any more. The histograms filled by
+    each thread are first added into them. */
 
 void DQMStore::mergeAndResetMEsRunSummaryCache(uint32_t run,
                                                uint32_t streamId,
@@ -366,6 +397,11 @@ void DQMStore::mergeAndResetMEsRunSummaryCache(uint32_t run,
               << ", stream: " << streamId
               << " module: " << moduleId << std::endl;
 
+  if (enableMultiThread_ && shareMEsAcrossStreams_) {
+    std::lock_guard<std::mutex> guard(book_mutex_);
+    sharedBookings_.erase(std::make_pair(run, moduleId));
+  }
+
   if (LSbasedMode_) {
     return;
   }
@@ -384,6 +420,8 @@ void DQMStore::mergeAndResetMEsRunSummaryCache(uint32_t run,
         || i->data_.moduleId != moduleId)
       break;
 
+    const_cast<MonitorElement*>(&*i)->mergeShards();
+
     // Handle Run-based histograms only.
     if (i->getLumiFlag() || LSbasedMode_) {
       ++i;
@@ -456,6 +494,8 @@ void DQMStore::mergeAndResetMEsLuminositySummaryCache(uint32_t run,
         || i->data_.moduleId != moduleId)
       break;
 
+    const_cast<MonitorElement*>(&*i)->mergeShards();
+
     // Handle LS-based histograms only.
     if (not (i->getLumiFlag() || LSbasedMode_)) {
       ++i;
@@ -485,6 +525,10 @@ void DQMStore::mergeAndResetMEsLuminositySummaryCache(uint32_t run,
 	      me->getTH1()->Add(i->getTH1());
           }
 	}
+      // update() is not called by the modules filling the ROOT object
+      // directly, such fills are only seen as entries
+      if (i->isDirty() || hasEntries(*i))
+        const_cast<MonitorElement*>(&*me)->setDirty(true);
     } else {
       if (verbose_ > 1)
         std::cout << "No global Object found. " << std::endl;
@@ -496,13 +540,25 @@ void DQMStore::mergeAndResetMEsLuminositySummaryCache(uint32_t run,
       actual_global_me.setLumi(lumi);
       gme = data_.insert(std::move(actual_global_me));
       assert(gme.second);
+      // never written yet
+      const_cast<MonitorElement*>(&*gme.first)->setDirty(true);
     }
-    // make the ME reusable for the next LS
+    // make the ME reusable for the next LS; it is modified again only
+    // if it gets filled
     const_cast<MonitorElement*>(&*i)->Reset();
+    const_cast<MonitorElement*>(&*i)->setDirty(false);
     ++i;
   }
 }
 
+/// true if the streams of the module fill the same histograms in the
+/// run; these are merged from the global end of the lumi and run
+/// rather than from each stream.
+bool DQMStore::sharesMEs(uint32_t run, uint32_t moduleId) {
+  std::lock_guard<std::mutex> guard(book_mutex_);
+  return sharedBookings_.count(std::make_pair(run, moduleId)) > 0;
+}
+
 //////////////////////////////////////////////////////////////////////
 DQMStore::DQMStore(const edm::ParameterSet &pset, edm::ActivityRegistry& ar)
   : verbose_ (1),
@@ -510,6 +566,10 @@ DQMStore::DQMStore(const edm::ParameterSet &pset, edm::ActivityRegistry& ar)
     reset_ (false),
     collateHistograms_ (false),
     enableMultiThread_(false),
+    shareMEsAcrossStreams_(false),
+    bookShared_(false),
+    bookedByOtherStream_(false),
+    concurrentQTests_(false),
     forceResetOnBeginLumi_(false),
     readSelectedDirectory_ (""),
     run_(0),
@@ -546,6 +606,10 @@ DQMStore::DQMStore(const edm::ParameterSet &pset)
     reset_ (false),
     collateHistograms_ (false),
     enableMultiThread_(false),
+    shareMEsAcrossStreams_(false),
+    bookShared_(false),
+    bookedByOtherStream_(false),
+    concurrentQTests_(false),
     readSelectedDirectory_ (""),
     run_(0),
     streamId_(0),
@@ -600,6 +664,14 @@ DQMStore::initializeFrom(const edm::ParameterSet& pset) {
   LSbasedMode_ = pset.getUntrackedParameter<bool>("LSbasedMode", false);
    if (LSbasedMode_)
      std::cout << "DQMStore: LSbasedMode option is enabled\n";
+
+  shareMEsAcrossStreams_ = pset.getUntrackedParameter<bool>("shareMEsAcrossStreams", false);
+  if (shareMEsAcrossStreams_)
+    std::cout << "DQMStore: MEs of DQMEDAnalyzers filling only through Fill are shared across streams\n";
+
+  concurrentQTests_ = pset.getUntrackedParameter<bool>("concurrentQTests", false);
+  if (concurrentQTests_)
+    std::cout << "DQMStore: quality tests of different directories run concurrently\n";
    
   std::string ref = pset.getUntrackedParameter<std::string>("referenceFileName", "");
   if (! ref.empty())
@@ -608,19 +680,19 @@ DQMStore::initializeFrom(const edm::ParameterSet& pset) {
     readFile(ref, true, "", s_referenceDirName, StripRunDirs, false);
   }
 
-  initQCriterion<Comp2RefChi2>(qalgos_);
-  initQCriterion<Comp2Ref2DChi2>(qalgos_);
-  initQCriterion<Comp2RefKolmogorov>(qalgos_);
-  initQCriterion<ContentsXRange>(qalgos_);
-  initQCriterion<ContentsYRange>(qalgos_);
-  initQCriterion<MeanWithinExpected>(qalgos_);
-  initQCriterion<Comp2RefEqualH>(qalgos_);
-  initQCriterion<DeadChannel>(qalgos_);
-  initQCriterion<NoisyChannel>(qalgos_);
-  initQCriterion<ContentsWithinExpected>(qalgos_);
-  initQCriterion<CompareToMedian>(qalgos_);
-  initQCriterion<CompareLastFilledBin>(qalgos_);
-  initQCriterion<CheckVariance>(qalgos_);
+  initQCriterion<Comp2RefChi2>(qalgos_, qclones_);
+  initQCriterion<Comp2Ref2DChi2>(qalgos_, qclones_);
+  initQCriterion<Comp2RefKolmogorov>(qalgos_, qclones_);
+  initQCriterion<ContentsXRange>(qalgos_, qclones_);
+  initQCriterion<ContentsYRange>(qalgos_, qclones_);
+  initQCriterion<MeanWithinExpected>(qalgos_, qclones_);
+  initQCriterion<Comp2RefEqualH>(qalgos_, qclones_);
+  initQCriterion<DeadChannel>(qalgos_, qclones_);
+  initQCriterion<NoisyChannel>(qalgos_, qclones_);
+  initQCriterion<ContentsWithinExpected>(qalgos_, qclones_);
+  initQCriterion<CompareToMedian>(qalgos_, qclones_);
+  initQCriterion<CompareLastFilledBin>(qalgos_, qclones_);
+  initQCriterion<CheckVariance>(qalgos_, qclones_);
 
   scaleFlag_ = pset.getUntrackedParameter<double>("ScalingFlag", 0.0);
   if (verbose_ > 0)
@@ -824,11 +896,20 @@ DQMStore::book(const std::string &dir, const std::string &name,
   // Put us in charge of h.
   h->SetDirectory(0);
 
+  // Histograms shared across streams are booked as the ones of stream 0.
+  uint32_t streamId = bookShared_ ? 0 : streamId_;
+
   // Check if the request monitor element already exists.
-  MonitorElement *me = findObject(dir, name, run_, 0, streamId_, moduleId_);
+  MonitorElement *me = findObject(dir, name, run_, 0, streamId, moduleId_);
   if (me)
   {
-    if (collateHistograms_)
+    if (bookedByOtherStream_)
+    {
+      // Another stream of the module booked it and may be filling it.
+      delete h;
+      return me;
+    }
+    else if (collateHistograms_)
     {
       collate(me, h, verbose_);
       delete h;
@@ -850,9 +931,11 @@ DQMStore::book(const std::string &dir, const std::string &name,
   {
     // Create and initialise core object.
     assert(dirs_.count(dir));
-    MonitorElement proto(&*dirs_.find(dir), name, run_, streamId_, moduleId_);
+    MonitorElement proto(&*dirs_.find(dir), name, run_, streamId, moduleId_);
     me = const_cast<MonitorElement &>(*data_.insert(std::move(proto)).first)
       .initialise((MonitorElement::Kind)kind, h);
+    if (bookShared_)
+      me->share();
 
     // Initialise quality test information.
     QTestSpecs::iterator qi = qtestspecs_.begin();
@@ -1589,21 +1672,28 @@ DQMStore::bookProfile2D(const std::string &name, TProfile2D *source)
 //////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////
+/// true if @a h can be added to @a into.
+static bool
+sameBinning(const TH1 *into, const TH1 *h)
+{
+  return into->GetNbinsX() == h->GetNbinsX()
+    && into->GetNbinsY() == h->GetNbinsY()
+    && into->GetNbinsZ() == h->GetNbinsZ()
+    && into->GetXaxis()->GetXmin() == h->GetXaxis()->GetXmin()
+    && into->GetYaxis()->GetXmin() == h->GetYaxis()->GetXmin()
+    && into->GetZaxis()->GetXmin() == h->GetZaxis()->GetXmin()
+    && into->GetXaxis()->GetXmax() == h->GetXaxis()->GetXmax()
+    && into->GetYaxis()->GetXmax() == h->GetYaxis()->GetXmax()
+    && into->GetZaxis()->GetXmax() == h->GetZaxis()->GetXmax()
+    && MonitorElement::CheckBinLabels(into->GetXaxis(), h->GetXaxis())
+    && MonitorElement::CheckBinLabels(into->GetYaxis(), h->GetYaxis())
+    && MonitorElement::CheckBinLabels(into->GetZaxis(), h->GetZaxis());
+}
+
 bool
 DQMStore::checkBinningMatches(MonitorElement *me, TH1 *h, unsigned verbose)
 {
-  if (me->getTH1()->GetNbinsX() != h->GetNbinsX()
-      || me->getTH1()->GetNbinsY() != h->GetNbinsY()
-      || me->getTH1()->GetNbinsZ() != h->GetNbinsZ()
-      || me->getTH1()->GetXaxis()->GetXmin() != h->GetXaxis()->GetXmin()
-      || me->getTH1()->GetYaxis()->GetXmin() != h->GetYaxis()->GetXmin()
-      || me->getTH1()->GetZaxis()->GetXmin() != h->GetZaxis()->GetXmin()
-      || me->getTH1()->GetXaxis()->GetXmax() != h->GetXaxis()->GetXmax()
-      || me->getTH1()->GetYaxis()->GetXmax() != h->GetYaxis()->GetXmax()
-      || me->getTH1()->GetZaxis()->GetXmax() != h->GetZaxis()->GetXmax()
-      || !MonitorElement::CheckBinLabels((TAxis*)me->getTH1()->GetXaxis(),(TAxis*)h->GetXaxis())
-      || !MonitorElement::CheckBinLabels((TAxis*)me->getTH1()->GetYaxis(),(TAxis*)h->GetYaxis())
-      || !MonitorElement::CheckBinLabels((TAxis*)me->getTH1()->GetZaxis(),(TAxis*)h->GetZaxis()) )
+  if (! sameBinning(me->getTH1(), h))
   {
     if(verbose > 0)
       std::cout << "*** DQMStore: WARNING:"
@@ -2539,23 +2629,47 @@ void DQMStore::savePB(const std::string &filename,
                       const std::string &path /* = "" */,
 		      const uint32_t run /* = 0 */,
 		      const uint32_t lumi /* = 0 */,
-		      const bool resetMEsAfterWriting /* = false */)
+		      const bool resetMEsAfterWriting /* = false */,
+		      const bool onlyModified /* = false */)
 {
   using google::protobuf::io::FileOutputStream;
   using google::protobuf::io::GzipOutputStream;
   using google::protobuf::io::StringOutputStream;
 
+  // The MEs filled through getTH1() and the like are not marked dirty,
+  // they are recognised by their entries, which needs them to be reset
+  // after each write.
+  if (onlyModified && ! resetMEsAfterWriting)
+    raiseDQMError("DQMStore", "Cannot save only the modified monitor elements"
+                  " to '%s' without resetting them after writing",
+                  filename.c_str());
+
   std::lock_guard<std::mutex> guard(book_mutex_);
 
   std::set<std::string>::iterator di, de;
   MEMap::iterator mi, me = data_.end();
-  dqmstorepb::ROOTFilePB dqmstore_message;
   int nme = 0;
+  int nskipped = 0;
 
   if (verbose_)
     std::cout << "\n DQMStore: Opening PBFile '"
               << filename << "'"<< std::endl;
 
+  // The MEs are streamed into the file one at a time, see
+  // ROOTFilePBStream.h, rather than collected in a single message.
+  int filedescriptor = ::open(filename.c_str(),
+                              O_WRONLY | O_CREAT | O_TRUNC,
+                              S_IRUSR | S_IWUSR |
+                              S_IRGRP | S_IWGRP |
+                              S_IROTH);
+  FileOutputStream file_stream(filedescriptor);
+  GzipOutputStream::Options options;
+  options.format = GzipOutputStream::GZIP;
+  options.compression_level = 1;
+  GzipOutputStream gzip_stream(&file_stream,
+                               options);
+  dqmstorepb::ROOTFilePB::Histo histo;
+
   // Loop over the directory structure.
   for (di = dirs_.begin(), de = dirs_.end(); di != de; ++di)
   {
@@ -2598,15 +2712,23 @@ void DQMStore::savePB(const std::string &filename,
       if (run != 0 && (mi->data_.streamId !=0 || mi->data_.moduleId !=0))
         continue;
 
+      // Skip the MEs that did not change since they were last
+      // written and reset: an earlier file has their content.
+      if (onlyModified && ! mi->isDirty() && ! hasEntries(*mi))
+      {
+        nskipped++;
+        continue;
+      }
+
       if (verbose_ > 1)
         std::cout << "DQMStore::savePB: saving monitor element '"
         << *mi->data_.dirname << "/" << mi->data_.objname << "'"
         << "flags " << mi->data_.flags << "\n";
 
       nme++;
-      dqmstorepb::ROOTFilePB::Histo* me = dqmstore_message.add_histo();
-      me->set_full_pathname((*mi->data_.dirname) + '/' + mi->data_.objname);
-      me->set_flags(mi->data_.flags);
+      histo.Clear();
+      histo.set_full_pathname((*mi->data_.dirname) + '/' + mi->data_.objname);
+      histo.set_flags(mi->data_.flags);
 
       TObject *toWrite = nullptr;
       bool deleteObject = false;
@@ -2620,9 +2742,10 @@ void DQMStore::savePB(const std::string &filename,
 
       TBufferFile buffer(TBufferFile::kWrite);
       buffer.WriteObject(toWrite);
-      me->set_size(buffer.Length());
-      me->set_streamed_histo((const void*)buffer.Buffer(),
-                             buffer.Length());
+      histo.set_size(buffer.Length());
+      histo.set_streamed_histo((const void*)buffer.Buffer(),
+                               buffer.Length());
+      dqmstorepb::writeHisto(&gzip_stream, histo);
 
       if (deleteObject) {
         delete toWrite;
@@ -2631,22 +2754,10 @@ void DQMStore::savePB(const std::string &filename,
       //reset the ME just written to make it available for the next LS (online)
       if (resetMEsAfterWriting)
 	const_cast<MonitorElement*>(&*mi)->Reset();
+      const_cast<MonitorElement*>(&*mi)->setDirty(false);
     }
   }
 
-  int filedescriptor = ::open(filename.c_str(),
-                              O_WRONLY | O_CREAT | O_TRUNC,
-                              S_IRUSR | S_IWUSR |
-                              S_IRGRP | S_IWGRP |
-                              S_IROTH);
-  FileOutputStream file_stream(filedescriptor);
-  GzipOutputStream::Options options;
-  options.format = GzipOutputStream::GZIP;
-  options.compression_level = 1;
-  GzipOutputStream gzip_stream(&file_stream,
-                               options);
-  dqmstore_message.SerializeToZeroCopyStream(&gzip_stream);
-
   // we need to flush it before we close the fd
   gzip_stream.Close();
   file_stream.Close();
@@ -2657,6 +2768,9 @@ void DQMStore::savePB(const std::string &filename,
     std::cout << "DQMStore::savePB: successfully wrote " << nme
               << " objects from path '" << path
 	      << "' into DQM file '" << filename << "'\n";
+  if (verbose_ && onlyModified)
+    std::cout << "DQMStore::savePB: skipped " << nskipped
+              << " objects not modified since last written\n";
 }
 
 
@@ -3175,23 +3289,17 @@ DQMStore::readFilePB(const std::string &filename,
     return false;
   }
 
-  dqmstorepb::ROOTFilePB dqmstore_message;
+  // The MEs are read one at a time, see ROOTFilePBStream.h.
   FileInputStream fin(filedescriptor);
   GzipInputStream input(&fin);
-  CodedInputStream input_coded(&input);
-  input_coded.SetTotalBytesLimit(1024*1024*1024, -1);
-  if (!dqmstore_message.ParseFromCodedStream(&input_coded)) {
-    raiseDQMError("DQMStore", "Fatal parsing file '%s'", filename.c_str());
-    return false;
-  }
-  ::close(filedescriptor);
+  dqmstorepb::ROOTFilePB::Histo h;
+  bool corrupt = false;
 
-  for (int i = 0; i < dqmstore_message.histo_size(); i++) {
+  while (dqmstorepb::readHisto(&input, h, corrupt)) {
     std::string path;
     std::string objname;
 
     TObject *obj = NULL;
-    const dqmstorepb::ROOTFilePB::Histo &h = dqmstore_message.histo(i);
     get_info(h, path, objname, &obj);
 
     setCurrentFolder(path);
@@ -3218,11 +3326,212 @@ DQMStore::readFilePB(const std::string &filename,
       delete obj;
     }
   }
+  ::close(filedescriptor);
+
+  if (corrupt) {
+    raiseDQMError("DQMStore", "Fatal parsing file '%s'", filename.c_str());
+    return false;
+  }
 
   cd();
   return true;
 }
 
+namespace {
+  /* An ME read from a range of protobuf files by loadFiles(): the
+     object it would have in the store after reading the files one
+     after the other with readFilePB(). */
+  struct MergedPB
+  {
+    std::unique_ptr<TObject> object;
+    uint32_t flags;     //< flags of its first occurrence
+    bool overwrite;     //< replaces the content of an existing ME
+  };
+  typedef std::map<std::string, MergedPB> MergedPBMap;
+
+  /* Body of the tree reduction of loadFiles(): the files of a range
+     are read into a map of MEs, and the map of the range to the right
+     is then merged into it.  Merging a range is merging its MEs one by
+     one, so that the order of the files is kept. */
+  template <class READ, class MERGE>
+  class PBFilesReducer
+  {
+  public:
+    PBFilesReducer(const std::vector<std::string> &filenames, READ &read, MERGE &merge)
+      : filenames_(filenames), read_(read), merge_(merge)
+      {}
+    PBFilesReducer(PBFilesReducer &other, tbb::split)
+      : filenames_(other.filenames_), read_(other.read_), merge_(other.merge_)
+      {}
+
+    void operator()(const tbb::blocked_range<size_t> &range)
+      {
+        for (size_t i = range.begin(); i != range.end(); ++i)
+          read_(filenames_[i], mes_);
+      }
+    void join(PBFilesReducer &other)
+      {
+        for (auto &me : other.mes_)
+          merge_(mes_, me.first, me.second);
+      }
+
+    MergedPBMap mes_;
+
+  private:
+    const std::vector<std::string> &filenames_;
+    READ &read_;
+    MERGE &merge_;
+  };
+}
+
+/// public load several files, merging the protobuf ones on several
+/// threads: each file is read on its own and the MEs are added two
+/// files at a time, in a tree.  The result is the one of load() for
+/// each file in turn, except for histograms whose binning changes
+/// between the files.  Files that are not protobuf files are loaded
+/// with load() in turn, between the protobuf files around them.  ROOT
+/// must be thread safe, which the framework ensures.
+bool
+DQMStore::loadFiles(const std::vector<std::string> &filenames,
+                    OpenRunDirs stripdirs /* =StripRunDirs */,
+                    bool fileMustExist /* =true */)
+{
+  using google::protobuf::io::FileInputStream;
+  using google::protobuf::io::GzipInputStream;
+
+  std::atomic<bool> ok(true);
+
+  // Adds an ME to the ones read before it, as readFilePB() and
+  // extract() do: the MEs of a lumi replace the earlier content, the
+  // histograms of a run are summed and the other run MEs keep the
+  // first content.
+  auto merge = [this](MergedPBMap &into, const std::string &path, MergedPB &from) {
+    MergedPBMap::iterator i = into.find(path);
+    if (i == into.end())
+    {
+      into.insert(std::make_pair(path, std::move(from)));
+      return;
+    }
+
+    MergedPB &to = i->second;
+    if (from.overwrite)
+    {
+      to.object = std::move(from.object);
+      to.overwrite = true;
+      return;
+    }
+
+    TH1 *h = dynamic_cast<TH1 *>(to.object.get());
+    TH1 *add = dynamic_cast<TH1 *>(from.object.get());
+    if (! h || ! add || h->IsA() != add->IsA())
+      return;
+    if (! sameBinning(h, add))
+    {
+      if (verbose_ > 0)
+        std::cout << "*** DQMStore: WARNING: loadFiles: different binning"
+                  << " - cannot add object '" << path << "'\n";
+      return;
+    }
+
+    if (TProfile *p = dynamic_cast<TProfile *>(h))
+      MonitorElement::addProfiles(static_cast<TProfile *>(add), p, p, 1, 1);
+    else if (TProfile2D *p = dynamic_cast<TProfile2D *>(h))
+      MonitorElement::addProfiles(static_cast<TProfile2D *>(add), p, p, 1, 1);
+    else
+      h->Add(add);
+  };
+
+  // Reads a file, as readFilePB() does, into the MEs of the files
+  // before it.
+  auto read = [this, &merge, &ok, fileMustExist](const std::string &filename, MergedPBMap &mes) {
+    int filedescriptor;
+    if ((filedescriptor = ::open(filename.c_str(), O_RDONLY)) == -1)
+    {
+      if (fileMustExist)
+        raiseDQMError("DQMStore", "Failed to open file '%s'", filename.c_str());
+      if (verbose_)
+        std::cout << "DQMStore::loadFiles: file '" << filename << "' does not exist, continuing\n";
+      ok = false;
+      return;
+    }
+
+    FileInputStream fin(filedescriptor);
+    GzipInputStream input(&fin);
+    dqmstorepb::ROOTFilePB::Histo h;
+    bool corrupt = false;
+    std::string path;
+    std::string objname;
+    while (dqmstorepb::readHisto(&input, h, corrupt))
+    {
+      TObject *obj = NULL;
+      get_info(h, path, objname, &obj);
+      MergedPB me;
+      me.object.reset(obj);
+      me.flags = h.flags();
+      me.overwrite = h.flags() & DQMNet::DQM_PROP_LUMI;
+      merge(mes, h.full_pathname(), me);
+    }
+    ::close(filedescriptor);
+
+    if (corrupt)
+      raiseDQMError("DQMStore", "Fatal parsing file '%s'", filename.c_str());
+  };
+
+  // Merges consecutive protobuf files, then puts the merged MEs in
+  // the store as readFilePB() would.
+  auto loadPB = [this, &read, &merge](const std::vector<std::string> &pbfiles) {
+    if (verbose_)
+      std::cout << "DQMStore::loadFiles: merging " << pbfiles.size()
+                << " protobuf files\n";
+
+    typedef PBFilesReducer<decltype(read), decltype(merge)> Reducer;
+    Reducer reducer(pbfiles, read, merge);
+    tbb::parallel_reduce(tbb::blocked_range<size_t>(0, pbfiles.size(), 1), reducer);
+
+    for (auto &merged : reducer.mes_)
+    {
+      const std::string &fullpath = merged.first;
+      size_t slash = fullpath.rfind('/');
+      std::string path(fullpath, 0, slash == std::string::npos ? 0 : slash);
+      std::string objname(fullpath, slash == std::string::npos ? 0 : slash+1);
+
+      setCurrentFolder(path);
+      MonitorElement *me = findObject(path, objname);
+      extract(merged.second.object.get(), path,
+              merged.second.overwrite, ! merged.second.overwrite);
+      if (me == nullptr)
+      {
+        me = findObject(path, objname);
+        me->data_.flags = merged.second.flags;
+      }
+    }
+  };
+
+  // The files are put in the store in the given order: a file that is
+  // not a protobuf file is loaded after the protobuf files before it.
+  std::vector<std::string> pbfiles;
+  for (const std::string &filename : filenames)
+  {
+    if (s_rxpbfile.match(filename, 0, 0))
+    {
+      pbfiles.push_back(filename);
+      continue;
+    }
+    if (! pbfiles.empty())
+    {
+      loadPB(pbfiles);
+      pbfiles.clear();
+    }
+    if (! load(filename, stripdirs, fileMustExist))
+      ok = false;
+  }
+  if (! pbfiles.empty())
+    loadPB(pbfiles);
+
+  cd();
+  return ok;
+}
+
 //////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////
@@ -3391,9 +3700,55 @@ DQMStore::runQTests(void)
   // Apply quality tests to each monitor element, skipping references.
   MEMap::iterator mi = data_.begin();
   MEMap::iterator me = data_.end();
+  if (! concurrentQTests_)
+  {
+    for ( ; mi != me; ++mi)
+      if (! isSubdirectory(s_referenceDirName, *mi->data_.dirname))
+        const_cast<MonitorElement &>(*mi).runQTests();
+
+    reset_ = false;
+    return;
+  }
+
+  // Otherwise the directories are tested concurrently.  The MEs of a
+  // directory are contiguous in data_.  A test keeps the state of its
+  // last run in its members and is usually attached to MEs of many
+  // directories, so each thread runs its own copies of the tests.
+  std::vector<std::vector<MonitorElement *> > dirs;
+  const std::string *dirname = 0;
   for ( ; mi != me; ++mi)
-    if (! isSubdirectory(s_referenceDirName, *mi->data_.dirname))
-      const_cast<MonitorElement &>(*mi).runQTests();
+  {
+    if (isSubdirectory(s_referenceDirName, *mi->data_.dirname))
+      continue;
+    if (mi->data_.dirname != dirname)
+    {
+      dirname = mi->data_.dirname;
+      dirs.push_back(std::vector<MonitorElement *>());
+    }
+    dirs.back().push_back(const_cast<MonitorElement *>(&*mi));
+  }
+
+  typedef std::map<QCriterion *, QCriterion *> QCClones;
+  tbb::enumerable_thread_specific<QCClones> clones;
+  tbb::parallel_for(size_t(0), dirs.size(), [this, &dirs, &clones](size_t i) {
+      QCClones &local = clones.local();
+      auto criterion = [this, &local](QCriterion *qc) {
+        QCriterion *&clone = local[qc];
+        if (! clone)
+        {
+          QCloneMap::const_iterator c = qclones_.find(qc->algoName());
+          assert(c != qclones_.end());
+          clone = c->second(*qc);
+        }
+        return clone;
+      };
+      for (MonitorElement *me : dirs[i])
+        me->runQTests(criterion);
+    });
+
+  for (QCClones &local : clones)
+    for (auto &clone : local)
+      delete clone.second;
 
   reset_ = false;
 }
@@ -4,10 +4,14 @@
 #include "DQMServices/Core/interface/QTest.h"
 #include "DQMServices/Core/src/DQMError.h"
 #include "TClass.h"
+#include "TDirectory.h"
 #include "TMath.h"
 #include "TList.h"
 #include "THashList.h"
+#include "tbb/enumerable_thread_specific.h"
+#include <atomic>
 #include <iostream>
+#include <mutex>
 #include <cassert>
 #include <cfloat>
 #include <inttypes.h>
@@ -35,6 +39,199 @@ checkRootObject(const std::string &name, TObject *tobj, const char *func, int re
   return h;
 }
 
+/// Gives access to the ROOT switch which tells if the fills out of
+/// the axis ranges count in the statistics of the histograms.
+struct StatOverflows : public TH1
+{
+  static bool get(void)
+    { return fgStatOverflows; }
+};
+
+/// Add w to a bin filled by several threads.
+static void
+addToBin(std::atomic<double> &bin, double w)
+{
+  double old = bin.load(std::memory_order_relaxed);
+  while (! bin.compare_exchange_weak(old, old + w, std::memory_order_relaxed))
+    ;
+}
+
+static std::atomic<double> *
+newBins(size_t n)
+{
+  std::atomic<double> *bins = new std::atomic<double>[n];
+  for (size_t i = 0; i < n; ++i)
+    bins[i].store(0., std::memory_order_relaxed);
+  return bins;
+}
+
+/// The fills of the streams sharing an ME, added into the ME at the end
+/// of the lumi and run.
+///
+/// The 1D and 2D histograms whose axes cannot extend are filled in
+/// place, in one array of atomic bins for all the threads, so that their
+/// memory does not grow with the number of streams.  The statistics of
+/// these fills (entries and sums of the weighted moments) are summed per
+/// thread and added when merging.  The other histograms are filled by
+/// each thread in an empty clone of the ME, created on the first fill of
+/// the thread.  Both are kept, emptied, from one lumi to the next.
+struct MonitorElement::Shards
+{
+  /// Entries and sums of w, w2, wx, wx2, wy, wy2 and wxy, laid out as
+  /// in TH1::GetStats.
+  struct Stats
+  {
+    double entries = 0.;
+    double sums[7] = {};
+  };
+
+  std::once_flag layout;
+  int dim = 0;                                 //< 1 or 2 if the bins are filled in place.
+  size_t ncells = 0;
+  std::unique_ptr<std::atomic<double>[]> sumw;
+  std::atomic<std::atomic<double> *> excessw2; //< Sum of w*w - w per bin, allocated by the first weight != 1.
+  tbb::enumerable_thread_specific<Stats> stats;
+  tbb::enumerable_thread_specific<TH1 *> local;
+
+  Shards(void)
+    : excessw2(nullptr)
+    {}
+
+  ~Shards(void)
+    {
+      for (TH1 *h : local)
+        delete h;
+      delete [] excessw2.load();
+    }
+
+  /// Decide, on the first fill once the booking is over, if the bins of
+  /// h are filled in place.
+  void lay(TH1 *h, Kind kind)
+    {
+      if (h->GetXaxis()->CanExtend() || h->GetYaxis()->CanExtend())
+        return;
+      if (kind == DQM_KIND_TH1F || kind == DQM_KIND_TH1S || kind == DQM_KIND_TH1D)
+        dim = 1;
+      else if (kind == DQM_KIND_TH2F || kind == DQM_KIND_TH2S || kind == DQM_KIND_TH2D)
+        dim = 2;
+      else
+        return;
+      ncells = h->GetNcells();
+      sumw.reset(newBins(ncells));
+    }
+
+  std::atomic<double> *excess(void)
+    {
+      std::atomic<double> *bins = excessw2.load();
+      if (! bins)
+      {
+        std::atomic<double> *fresh = newBins(ncells);
+        if (excessw2.compare_exchange_strong(bins, fresh))
+          bins = fresh;
+        else
+          delete [] fresh;
+      }
+      return bins;
+    }
+
+  /// Fill h in place as TH1::Fill(x, w) or TH2::Fill(x, y, w) would,
+  /// or return false if h is not a histogram of ndim dimensions filled
+  /// in place.
+  bool fill(TH1 *h, Kind kind, int ndim, double x, double y, double w)
+    {
+      std::call_once(layout, [&]() { lay(h, kind); });
+      if (ndim != dim)
+        return false;
+
+      int bin = h->GetXaxis()->FindFixBin(x);
+      bool inRange = bin > 0 && bin <= h->GetNbinsX();
+      if (dim == 2)
+      {
+        int biny = h->GetYaxis()->FindFixBin(y);
+        inRange = inRange && biny > 0 && biny <= h->GetNbinsY();
+        bin = h->GetBin(bin, biny);
+      }
+      addToBin(sumw[bin], w);
+      if (w != 1.)
+        addToBin(excess()[bin], w * w - w);
+
+      Stats &s = stats.local();
+      s.entries += 1;
+      if (! inRange && ! StatOverflows::get())
+        return true;
+      s.sums[0] += w;
+      s.sums[1] += w * w;
+      s.sums[2] += w * x;
+      s.sums[3] += w * x * x;
+      if (dim == 2)
+      {
+        s.sums[4] += w * y;
+        s.sums[5] += w * y * y;
+        s.sums[6] += w * x * y;
+      }
+      return true;
+    }
+
+  /// Add the fills in place into h and empty the bins.
+  void mergeInto(TH1 *h)
+    {
+      if (! dim)
+        return;
+
+      Stats total;
+      for (Stats &s : stats)
+      {
+        total.entries += s.entries;
+        for (int i = 0; i < 7; ++i)
+          total.sums[i] += s.sums[i];
+        s = Stats();
+      }
+      if (! total.entries)
+        return;
+
+      double hstats[TH1::kNstat] = {};
+      h->GetStats(hstats);
+      for (int i = 0; i < 7; ++i)
+        hstats[i] += total.sums[i];
+      double entries = h->GetEntries() + total.entries;
+
+      // as TH1::Fill, start summing the squares of the weights with the
+      // first weight != 1, from the contents so far
+      std::atomic<double> *excess = excessw2.load();
+      if (excess && ! h->GetSumw2N() && ! h->TestBit(TH1::kIsNotW))
+        h->Sumw2();
+      double *sumw2 = h->GetSumw2N() ? h->GetSumw2()->GetArray() : nullptr;
+      for (size_t bin = 0; bin < ncells; ++bin)
+      {
+        double w = sumw[bin].exchange(0., std::memory_order_relaxed);
+        double e = excess ? excess[bin].exchange(0., std::memory_order_relaxed) : 0.;
+        if (w)
+          h->AddBinContent(bin, w);
+        if (sumw2)
+          sumw2[bin] += w + e;
+      }
+      h->PutStats(hstats);
+      h->SetEntries(entries);
+    }
+
+  /// Drop the fills not merged yet.
+  void clear(void)
+    {
+      for (Stats &s : stats)
+        s = Stats();
+      std::atomic<double> *excess = excessw2.load();
+      for (size_t bin = 0; bin < ncells; ++bin)
+      {
+        sumw[bin].store(0., std::memory_order_relaxed);
+        if (excess)
+          excess[bin].store(0., std::memory_order_relaxed);
+      }
+      for (TH1 *h : local)
+        if (h)
+          h->Reset();
+    }
+};
+
 MonitorElement *
 MonitorElement::initialise(Kind kind)
 {
@@ -151,7 +348,8 @@ MonitorElement::initialise(Kind kind, const std::string &value)
 MonitorElement::MonitorElement(void)
   : object_(0),
     reference_(0),
-    refvalue_(0)
+    refvalue_(0),
+    dirty_(true)
 {
   data_.version  = 0;
   data_.dirname  = 0;
@@ -172,7 +370,8 @@ MonitorElement::MonitorElement(const std::string *path,
                                uint32_t moduleId /* = 0 */)
   : object_(0),
     reference_(0),
-    refvalue_(0)
+    refvalue_(0),
+    dirty_(true)
 {
   data_.version  = 0;
   data_.run      = run;
@@ -193,7 +392,8 @@ MonitorElement::MonitorElement(const MonitorElement &x, MonitorElementNoCloneTag
     object_(nullptr),
     reference_(x.reference_),
     refvalue_(nullptr),
-    qreports_(x.qreports_)
+    qreports_(x.qreports_),
+    dirty_(x.dirty_)
 {
 }
 
@@ -212,6 +412,7 @@ MonitorElement::MonitorElement(MonitorElement &&o)
 {
   object_ = o.object_;
   refvalue_ = o.refvalue_;
+  shards_ = std::move(o.shards_);
 
   o.object_ = nullptr;
   o.refvalue_ = nullptr;
@@ -266,19 +467,22 @@ MonitorElement::Fill(std::string &value)
 void
 MonitorElement::Fill(double x)
 {
-  update();
+  if (! shards_)
+    update();
+  else if (shards_->fill(object_, kind(), 1, x, 0., 1.))
+    return;
   if (kind() == DQM_KIND_INT)
     scalar_.num = static_cast<int64_t>(x);
   else if (kind() == DQM_KIND_REAL)
     scalar_.real = x;
   else if (kind() == DQM_KIND_TH1F)
-    accessRootObject(__PRETTY_FUNCTION__, 1)
+    fillObject(__PRETTY_FUNCTION__, 1)
       ->Fill(x, 1);
   else if (kind() == DQM_KIND_TH1S)
-    accessRootObject(__PRETTY_FUNCTION__, 1)
+    fillObject(__PRETTY_FUNCTION__, 1)
       ->Fill(x, 1);
   else if (kind() == DQM_KIND_TH1D)
-    accessRootObject(__PRETTY_FUNCTION__, 1)
+    fillObject(__PRETTY_FUNCTION__, 1)
       ->Fill(x, 1);
   else
     incompatible(__PRETTY_FUNCTION__);
@@ -288,19 +492,22 @@ MonitorElement::Fill(double x)
 void
 MonitorElement::doFill(int64_t x)
 {
-  update();
+  if (! shards_)
+    update();
+  else if (shards_->fill(object_, kind(), 1, static_cast<double>(x), 0., 1.))
+    return;
   if (kind() == DQM_KIND_INT)
     scalar_.num = static_cast<int64_t>(x);
   else if (kind() == DQM_KIND_REAL)
     scalar_.real = static_cast<double>(x);
   else if (kind() == DQM_KIND_TH1F)
-    accessRootObject(__PRETTY_FUNCTION__, 1)
+    fillObject(__PRETTY_FUNCTION__, 1)
       ->Fill(static_cast<double>(x), 1);
   else if (kind() == DQM_KIND_TH1S)
-    accessRootObject(__PRETTY_FUNCTION__, 1)
+    fillObject(__PRETTY_FUNCTION__, 1)
       ->Fill(static_cast<double>(x), 1);
   else if (kind() == DQM_KIND_TH1D)
-    accessRootObject(__PRETTY_FUNCTION__, 1)
+    fillObject(__PRETTY_FUNCTION__, 1)
       ->Fill(static_cast<double>(x), 1);
   else
     incompatible(__PRETTY_FUNCTION__);
@@ -310,27 +517,31 @@ MonitorElement::doFill(int64_t x)
 void
 MonitorElement::Fill(double x, double yw)
 {
-  update();
+  if (! shards_)
+    update();
+  else if (shards_->fill(object_, kind(), 1, x, 0., yw)
+           || shards_->fill(object_, kind(), 2, x, yw, 1.))
+    return;
   if (kind() == DQM_KIND_TH1F)
-    accessRootObject(__PRETTY_FUNCTION__, 1)
+    fillObject(__PRETTY_FUNCTION__, 1)
       ->Fill(x, yw);
   else if (kind() == DQM_KIND_TH1S)
-    accessRootObject(__PRETTY_FUNCTION__, 1)
+    fillObject(__PRETTY_FUNCTION__, 1)
       ->Fill(x, yw);
   else if (kind() == DQM_KIND_TH1D)
-    accessRootObject(__PRETTY_FUNCTION__, 1)
+    fillObject(__PRETTY_FUNCTION__, 1)
       ->Fill(x, yw);
   else if (kind() == DQM_KIND_TH2F)
-    static_cast<TH2F *>(accessRootObject(__PRETTY_FUNCTION__, 2))
+    static_cast<TH2F *>(fillObject(__PRETTY_FUNCTION__, 2))
       ->Fill(x, yw, 1);
   else if (kind() == DQM_KIND_TH2S)
-    static_cast<TH2S *>(accessRootObject(__PRETTY_FUNCTION__, 2))
+    static_cast<TH2S *>(fillObject(__PRETTY_FUNCTION__, 2))
       ->Fill(x, yw, 1);
   else if (kind() == DQM_KIND_TH2D)
-    static_cast<TH2D *>(accessRootObject(__PRETTY_FUNCTION__, 2))
+    static_cast<TH2D *>(fillObject(__PRETTY_FUNCTION__, 2))
       ->Fill(x, yw, 1);
   else if (kind() == DQM_KIND_TPROFILE)
-    static_cast<TProfile *>(accessRootObject(__PRETTY_FUNCTION__, 1))
+    static_cast<TProfile *>(fillObject(__PRETTY_FUNCTION__, 1))
       ->Fill(x, yw, 1);
   else
     incompatible(__PRETTY_FUNCTION__);
@@ -342,6 +553,10 @@ MonitorElement::Fill(double x, double yw)
 void
 MonitorElement::ShiftFillLast(double y, double ye, int xscale)
 {
+  if (shards_)
+    raiseDQMError("MonitorElement", "Method '%s' cannot be invoked on monitor"
+                  " element '%s' because it is shared across streams",
+                  __PRETTY_FUNCTION__, getFullname().c_str());
   update();
   if (kind() == DQM_KIND_TH1F
       || kind() == DQM_KIND_TH1S
@@ -414,24 +629,27 @@ MonitorElement::ShiftFillLast(double y, double ye, int xscale)
 void
 MonitorElement::Fill(double x, double y, double zw)
 {
-  update();
+  if (! shards_)
+    update();
+  else if (shards_->fill(object_, kind(), 2, x, y, zw))
+    return;
   if (kind() == DQM_KIND_TH2F)
-    static_cast<TH2F *>(accessRootObject(__PRETTY_FUNCTION__, 2))
+    static_cast<TH2F *>(fillObject(__PRETTY_FUNCTION__, 2))
       ->Fill(x, y, zw);
   else if (kind() == DQM_KIND_TH2S)
-    static_cast<TH2S *>(accessRootObject(__PRETTY_FUNCTION__, 2))
+    static_cast<TH2S *>(fillObject(__PRETTY_FUNCTION__, 2))
       ->Fill(x, y, zw);
   else if (kind() == DQM_KIND_TH2D)
-    static_cast<TH2D *>(accessRootObject(__PRETTY_FUNCTION__, 2))
+    static_cast<TH2D *>(fillObject(__PRETTY_FUNCTION__, 2))
       ->Fill(x, y, zw);
   else if (kind() == DQM_KIND_TH3F)
-    static_cast<TH3F *>(accessRootObject(__PRETTY_FUNCTION__, 2))
+    static_cast<TH3F *>(fillObject(__PRETTY_FUNCTION__, 2))
       ->Fill(x, y, zw, 1);
   else if (kind() == DQM_KIND_TPROFILE)
-    static_cast<TProfile *>(accessRootObject(__PRETTY_FUNCTION__, 2))
+    static_cast<TProfile *>(fillObject(__PRETTY_FUNCTION__, 2))
       ->Fill(x, y, zw);
   else if (kind() == DQM_KIND_TPROFILE2D)
-    static_cast<TProfile2D *>(accessRootObject(__PRETTY_FUNCTION__, 2))
+    static_cast<TProfile2D *>(fillObject(__PRETTY_FUNCTION__, 2))
       ->Fill(x, y, zw, 1);
   else
     incompatible(__PRETTY_FUNCTION__);
@@ -441,12 +659,13 @@ MonitorElement::Fill(double x, double y, double zw)
 void
 MonitorElement::Fill(double x, double y, double z, double w)
 {
-  update();
+  if (! shards_)
+    update();
   if (kind() == DQM_KIND_TH3F)
-    static_cast<TH3F *>(accessRootObject(__PRETTY_FUNCTION__, 2))
+    static_cast<TH3F *>(fillObject(__PRETTY_FUNCTION__, 2))
       ->Fill(x, y, z, w);
   else if (kind() == DQM_KIND_TPROFILE2D)
-    static_cast<TProfile2D *>(accessRootObject(__PRETTY_FUNCTION__, 2))
+    static_cast<TProfile2D *>(fillObject(__PRETTY_FUNCTION__, 2))
       ->Fill(x, y, z, w);
   else
     incompatible(__PRETTY_FUNCTION__);
@@ -464,8 +683,12 @@ MonitorElement::Reset(void)
   else if (kind() == DQM_KIND_STRING)
     scalar_.str.clear();
   else
+  {
+    if (shards_)
+      shards_->clear();
     return accessRootObject(__PRETTY_FUNCTION__, 1)
       ->Reset();
+  }
 }
 
 /// convert scalar data into a string.
@@ -649,6 +872,14 @@ MonitorElement::getQOthers(void) const
 /// run all quality tests
 void
 MonitorElement::runQTests(void)
+{
+  runQTests([](QCriterion *qc) { return qc; });
+}
+
+/// run all quality tests, each one with the criterion that @a criterion
+/// returns for it: DQMStore::runQTests gives each thread its own copies.
+void
+MonitorElement::runQTests(const std::function<QCriterion *(QCriterion *)> &criterion)
 {
   assert(qreports_.size() == data_.qreports.size());
 
@@ -668,7 +899,7 @@ MonitorElement::runQTests(void)
       std::string oldMessage = qv.message;
       int oldStatus = qv.code;
 
-      qc->runTest(this, qr, qv);
+      criterion(qc)->runTest(this, qr, qv);
 
       if (oldStatus != qv.code || oldMessage != qv.message)
         update();
@@ -697,6 +928,66 @@ MonitorElement::accessRootObject(const char *func, int reqdim) const
   return checkRootObject(data_.objname, object_, func, reqdim);
 }
 
+/// the ROOT object to fill: the ME itself, or for a shared ME the
+/// histogram of the calling thread, so that the streams do not wait
+/// for each other.
+TH1 *
+MonitorElement::fillObject(const char *func, int reqdim)
+{
+  TH1 *h = accessRootObject(func, reqdim);
+  if (! shards_)
+    return h;
+
+  TH1 *&shard = shards_->local.local();
+  if (! shard)
+  {
+    // keep the clone out of the current directory of the thread
+    TDirectory::TContext context(nullptr);
+    shard = static_cast<TH1 *>(h->Clone());
+    shard->SetDirectory(0);
+    shard->Reset();
+  }
+  return shard;
+}
+
+/// Let all the streams of the module fill this histogram, see Shards,
+/// until mergeShards().
+void
+MonitorElement::share(void)
+{
+  if (! shards_ && kind() >= DQM_KIND_TH1F)
+    shards_.reset(new Shards);
+}
+
+/// Add the fills of the streams into the ME and empty the shards for
+/// the next lumi.  Called by the DQMStore at the end of the lumi and
+/// run, when no stream fills the ME.
+void
+MonitorElement::mergeShards(void)
+{
+  if (! shards_)
+    return;
+
+  shards_->mergeInto(object_);
+  for (TH1 *shard : shards_->local)
+  {
+    if (! shard || ! shard->GetEntries())
+      continue;
+    if (object_->CanExtendAllAxes() && shard->CanExtendAllAxes())
+    {
+      TList list;
+      list.Add(shard);
+      if (-1 == object_->Merge(&list))
+        std::cout << "MonitorElement::mergeShards: Failed to merge DQM element "
+                  << getFullname() << std::endl;
+    }
+    else
+      object_->Add(shard);
+    shard->Reset();
+  }
+  update();
+}
+
 /*** getter methods (wrapper around ROOT methods) ****/
 //
 /// get mean value of histogram along x, y or z axis (axis=1, 2, 3 respectively)
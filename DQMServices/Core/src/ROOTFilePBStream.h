@@ -0,0 +1,80 @@
+#ifndef DQMSERVICES_CORE_ROOTFILEPB_STREAM_H
+# define DQMSERVICES_CORE_ROOTFILEPB_STREAM_H
+
+# include "DQMServices/Core/src/ROOTFilePB.pb.h"
+# include <google/protobuf/io/coded_stream.h>
+# include <google/protobuf/io/zero_copy_stream.h>
+# include <google/protobuf/wire_format_lite.h>
+
+/* A ROOTFilePB message is the sequence of its Histo fields, each one a
+   tag and a length-delimited Histo.  Writing and reading them one at a
+   time gives the same bytes as serialising and parsing the whole
+   message, without having all the streamed histograms in memory: the
+   files stay readable by any reader of ROOTFilePB messages. */
+
+namespace dqmstorepb
+{
+  /// Append @a h to the ROOTFilePB message streamed into @a output.
+  inline void
+  writeHisto(google::protobuf::io::ZeroCopyOutputStream *output,
+             const ROOTFilePB::Histo &h)
+  {
+    using google::protobuf::internal::WireFormatLite;
+    google::protobuf::io::CodedOutputStream coded(output);
+    coded.WriteTag(WireFormatLite::MakeTag(ROOTFilePB::kHistoFieldNumber,
+                                           WireFormatLite::WIRETYPE_LENGTH_DELIMITED));
+    coded.WriteVarint32(h.ByteSizeLong());
+    h.SerializeWithCachedSizes(&coded);
+  }
+
+  /// Read the next Histo of the ROOTFilePB message streamed from @a
+  /// input into @a h.  Returns false at the end of the message, with
+  /// @a corrupt set if the end was not a clean one.
+  inline bool
+  readHisto(google::protobuf::io::ZeroCopyInputStream *input,
+            ROOTFilePB::Histo &h,
+            bool &corrupt)
+  {
+    using google::protobuf::internal::WireFormatLite;
+    google::protobuf::io::CodedInputStream coded(input);
+    coded.SetTotalBytesLimit(1024*1024*1024, -1);
+    corrupt = false;
+    while (true)
+    {
+      uint32_t tag = coded.ReadTag();
+      if (tag == 0)
+      {
+        corrupt = ! coded.ConsumedEntireMessage();
+        return false;
+      }
+      // Fields unknown to this reader are skipped.
+      if (tag != WireFormatLite::MakeTag(ROOTFilePB::kHistoFieldNumber,
+                                         WireFormatLite::WIRETYPE_LENGTH_DELIMITED))
+      {
+        if (! WireFormatLite::SkipField(&coded, tag))
+        {
+          corrupt = true;
+          return false;
+        }
+        continue;
+      }
+
+      uint32_t size;
+      if (! coded.ReadVarint32(&size))
+      {
+        corrupt = true;
+        return false;
+      }
+      google::protobuf::io::CodedInputStream::Limit limit = coded.PushLimit(size);
+      if (! h.ParseFromCodedStream(&coded) || ! coded.ConsumedEntireMessage())
+      {
+        corrupt = true;
+        return false;
+      }
+      coded.PopLimit(limit);
+      return true;
+    }
+  }
+}
+
+#endif // DQMSERVICES_CORE_ROOTFILEPB_STREAM_H
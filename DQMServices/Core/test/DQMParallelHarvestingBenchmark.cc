@@ -0,0 +1,200 @@
+/** Compares the harvesting of many per-lumi protobuf files by a
+    DQMStore loading them one after the other and running the quality
+    tests on all its MEs in turn, with a DQMStore merging them with
+    loadFiles() and running the tests of the directories concurrently
+    (concurrentQTests).
+
+    The files are written from a synthetic store of the given number of
+    MEs, in directories of 100 MEs each: 1D and 2D histograms and a
+    profile, summed over the files, an integer kept from the first file
+    and a lumi integer replaced by each file.  As in real harvesting,
+    the same quality tests are attached to the MEs of all directories.
+    The MEs and the results of the quality tests must agree between
+    both stores.
+
+    Usage: DQMParallelHarvestingBenchmark [MEs] [files] [threads] [directory]
+*/
+
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+#include "DQMServices/Core/interface/QReport.h"
+#include "DQMServices/Core/interface/QTest.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "tbb/task_arena.h"
+#include "TH1.h"
+#include "TROOT.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+static const unsigned int MES_PER_DIR = 100;
+static const unsigned int GROUPS = 16;
+
+static std::string
+dirName(unsigned int dir)
+{
+  return "Benchmark/Group" + std::to_string(dir % GROUPS) + "/Dir" + std::to_string(dir);
+}
+
+static std::vector<std::string>
+writeFiles(unsigned int dirs, unsigned int nfiles, const std::string &directory)
+{
+  edm::ParameterSet pset;
+  DQMStore store(pset);
+  std::vector<MonitorElement *> mes;
+  for (unsigned int d = 0; d < dirs; ++d)
+  {
+    store.setCurrentFolder(dirName(d));
+    for (unsigned int i = 0; i < MES_PER_DIR - 12; ++i)
+    {
+      std::string name = "h1D_" + std::to_string(i);
+      mes.push_back(store.book1D(name, name, 50, 0., 100.));
+    }
+    for (unsigned int i = 0; i < 9; ++i)
+    {
+      std::string name = "h2D_" + std::to_string(i);
+      mes.push_back(store.book2D(name, name, 10, 0., 100., 10, 0., 100.));
+    }
+    mes.push_back(store.bookProfile("profile", "profile", 20, 0., 100., 0., 100.));
+    mes.push_back(store.bookInt("firstFile"));
+    mes.push_back(store.bookInt("lastFile"));
+    mes.back()->setLumiFlag();
+  }
+
+  std::vector<std::string> filenames;
+  std::mt19937 engine(0);
+  std::normal_distribution<double> value(50., 15.);
+  for (unsigned int f = 0; f < nfiles; ++f)
+  {
+    for (auto me : mes)
+    {
+      me->Reset();
+      switch (me->kind())
+      {
+      case MonitorElement::DQM_KIND_INT:
+        me->Fill(static_cast<int64_t>(f + 1));
+        break;
+      case MonitorElement::DQM_KIND_TH2F:
+      case MonitorElement::DQM_KIND_TPROFILE:
+        for (unsigned int i = 0; i < 20; ++i)
+          me->Fill(value(engine), value(engine));
+        break;
+      default:
+        for (unsigned int i = 0; i < 20; ++i)
+          me->Fill(value(engine));
+      }
+    }
+    filenames.push_back(directory + "/DQMParallelHarvesting_ls" + std::to_string(f) + ".pb");
+    store.savePB(filenames.back());
+  }
+  return filenames;
+}
+
+static void
+attachQTests(DQMStore &store)
+{
+  auto xrange = static_cast<ContentsXRange *>(store.createQTest(ContentsXRange::getAlgoName(), "xrange"));
+  xrange->setAllowedXRange(20., 80.);
+  store.useQTestByMatch("Benchmark/*h1D_*", "xrange");
+
+  auto yrange = static_cast<ContentsYRange *>(store.createQTest(ContentsYRange::getAlgoName(), "yrange"));
+  yrange->setAllowedYRange(0., 25.);
+  store.useQTestByMatch("Benchmark/*h1D_*", "yrange");
+}
+
+static double
+seconds(std::chrono::steady_clock::time_point since)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+}
+
+static bool
+sameContents(DQMStore &sequential, DQMStore &parallel)
+{
+  std::vector<MonitorElement *> mes = sequential.getAllContents("Benchmark");
+  for (auto me : mes)
+  {
+    MonitorElement *other = parallel.get(me->getFullname());
+    if (! other || other->kind() != me->kind())
+      return false;
+    if (me->kind() == MonitorElement::DQM_KIND_INT)
+    {
+      if (me->getIntValue() != other->getIntValue())
+        return false;
+    }
+    // The histograms of the files are summed in a different order.
+    else if (std::abs(me->getEntries() - other->getEntries()) > 1e-9 * me->getEntries()
+             || std::abs(me->getMean() - other->getMean()) > 1e-9 * std::abs(me->getMean()))
+      return false;
+
+    std::vector<QReport *> qreports = me->getQReports();
+    std::vector<QReport *> others = other->getQReports();
+    if (qreports.size() != others.size())
+      return false;
+    for (size_t i = 0; i < qreports.size(); ++i)
+      if (qreports[i]->getStatus() != others[i]->getStatus()
+          || qreports[i]->getMessage() != others[i]->getMessage())
+        return false;
+  }
+  return ! mes.empty();
+}
+
+int main(int argc, char **argv)
+{
+  unsigned int nmes = argc > 1 ? std::atoi(argv[1]) : 100000;
+  unsigned int nfiles = argc > 2 ? std::atoi(argv[2]) : 8;
+  unsigned int threads = argc > 3 ? std::atoi(argv[3]) : 8;
+  std::string directory = argc > 4 ? argv[4] : (getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp");
+  unsigned int dirs = (nmes + MES_PER_DIR - 1) / MES_PER_DIR;
+
+  ROOT::EnableThreadSafety();
+  // the objects read on the TBB threads must not go to gDirectory
+  TH1::AddDirectory(kFALSE);
+  std::vector<std::string> filenames = writeFiles(dirs, nfiles, directory);
+  std::cout << "Harvesting " << nfiles << " files of " << dirs * MES_PER_DIR
+            << " MEs with " << threads << " threads" << std::endl;
+
+  edm::ParameterSet pset;
+  DQMStore sequential(pset);
+  pset.addUntrackedParameter<bool>("concurrentQTests", true);
+  DQMStore parallel(pset);
+  tbb::task_arena arena(threads);
+
+  auto start = std::chrono::steady_clock::now();
+  for (const auto &filename : filenames)
+    sequential.load(filename);
+  double loadTime = seconds(start);
+  attachQTests(sequential);
+  start = std::chrono::steady_clock::now();
+  sequential.runQTests();
+  double qtestTime = seconds(start);
+  std::cout << std::fixed << std::setprecision(2)
+            << "sequential: load " << loadTime << " s, quality tests " << qtestTime << " s" << std::endl;
+
+  start = std::chrono::steady_clock::now();
+  arena.execute([&]() { parallel.loadFiles(filenames); });
+  loadTime = seconds(start);
+  attachQTests(parallel);
+  start = std::chrono::steady_clock::now();
+  arena.execute([&]() { parallel.runQTests(); });
+  qtestTime = seconds(start);
+  std::cout << "parallel:   load " << loadTime << " s, quality tests " << qtestTime << " s" << std::endl;
+
+  for (const auto &filename : filenames)
+    unlink(filename.c_str());
+
+  if (! sameContents(sequential, parallel))
+  {
+    std::cerr << "The harvested MEs differ between the two stores" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,153 @@
+/** Compares the filling of the MEs of a DQMEDAnalyzer from several
+    streams with a copy of the MEs per stream, merged at the end of the
+    run, and with MEs shared by the streams (shareMEsAcrossStreams),
+    where the threads fill the bins of the shared MEs in place, added
+    into the shared MEs at the end of the run.
+
+    Each stream books the MEs of the module, then fills every ME once per
+    event from its own thread, as the analyze() of the module would do;
+    the local MEs are then merged into the global MEs.  The contents of
+    the global MEs must agree between both modes.  The memory reported is
+    the heap used by the booked MEs and their fills before the merge.
+
+    Usage: DQMSharedMEsBenchmark [events per stream] [max streams]
+*/
+
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "TH1.h"
+#include "TROOT.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <malloc.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+static const unsigned int N_1D = 200;
+static const unsigned int N_2D = 20;
+static const uint32_t RUN = 1;
+static const uint32_t MODULE = 1;
+
+struct Result
+{
+  double fillTime;
+  double mergeTime;
+  double memory;
+  size_t localMEs;
+  double sum;
+};
+
+static double
+heapInUse(void)
+{
+  return mallinfo().uordblks;
+}
+
+static Result
+fillAndMerge(unsigned int streams, unsigned int events, bool shared)
+{
+  edm::ParameterSet pset;
+  pset.addUntrackedParameter<bool>("enableMultiThread", true);
+  pset.addUntrackedParameter<bool>("shareMEsAcrossStreams", shared);
+  DQMStore store(pset);
+  double heapBefore = heapInUse();
+
+  std::vector<std::vector<MonitorElement *> > mes(streams);
+  for (unsigned int s = 0; s < streams; ++s)
+    store.bookTransaction([&](DQMStore::IBooker &b) {
+        b.setCurrentFolder("Benchmark");
+        for (unsigned int i = 0; i < N_1D; ++i)
+        {
+          std::string name = "h1D_" + std::to_string(i);
+          mes[s].push_back(b.book1D(name, name, 100, 0., 100.));
+        }
+        for (unsigned int i = 0; i < N_2D; ++i)
+        {
+          std::string name = "h2D_" + std::to_string(i);
+          mes[s].push_back(b.book2D(name, name, 100, 0., 100., 100, 0., 100.));
+        }
+      }, RUN, s, MODULE, shared);
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (unsigned int s = 0; s < streams; ++s)
+    threads.emplace_back([&, s]() {
+        std::mt19937 engine(s);
+        std::normal_distribution<double> value(50., 15.);
+        for (unsigned int e = 0; e < events; ++e)
+          for (auto me : mes[s])
+          {
+            if (me->kind() == MonitorElement::DQM_KIND_TH2F)
+              me->Fill(value(engine), value(engine));
+            else
+              me->Fill(value(engine));
+          }
+      });
+  for (auto &thread : threads)
+    thread.join();
+  auto filled = std::chrono::steady_clock::now();
+  double memory = heapInUse() - heapBefore;
+
+  if (shared)
+    store.mergeAndResetMEsRunSummaryCache(RUN, 0, MODULE);
+  else
+    for (unsigned int s = 0; s < streams; ++s)
+      store.mergeAndResetMEsRunSummaryCache(RUN, s, MODULE);
+  auto merged = std::chrono::steady_clock::now();
+
+  Result result = {std::chrono::duration<double>(filled - start).count(),
+                   std::chrono::duration<double>(merged - filled).count(),
+                   memory, 0, 0.};
+  for (auto me : store.getAllContents("Benchmark", RUN))
+  {
+    if (me->moduleId() != 0)
+      ++result.localMEs;
+    else
+      result.sum += me->getTH1()->GetSumOfWeights() + me->getMean();
+  }
+  return result;
+}
+
+int main(int argc, char **argv)
+{
+  unsigned int events = argc > 1 ? std::atoi(argv[1]) : 2000;
+  unsigned int maxStreams = argc > 2 ? std::atoi(argv[2]) : 32;
+
+  ROOT::EnableThreadSafety();
+  TH1::AddDirectory(kFALSE);
+
+  bool ok = true;
+  for (unsigned int streams = 1; streams <= maxStreams; streams *= 2)
+  {
+    Result results[2];
+    for (bool shared : {false, true})
+    {
+      Result &result = results[shared];
+      result = fillAndMerge(streams, events, shared);
+      std::cout << std::setw(2) << streams << " streams, "
+                << (shared ? "shared:    " : "per stream:")
+                << std::fixed << std::setprecision(0)
+                << " fill " << streams * events * (N_1D + N_2D) / result.fillTime / 1e3 << " kFill/s,"
+                << std::setprecision(1)
+                << " merge " << result.mergeTime * 1e3 << " ms,"
+                << " memory " << result.memory / 1e6 << " MB, "
+                << result.localMEs << " local MEs" << std::endl;
+    }
+    // The fills from different streams are summed in a different order.
+    if (std::abs(results[0].sum - results[1].sum) > 1e-6 * std::abs(results[0].sum))
+      ok = false;
+  }
+
+  if (! ok)
+  {
+    std::cerr << "The merged MEs differ between the two modes" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
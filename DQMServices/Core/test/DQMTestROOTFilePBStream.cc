@@ -0,0 +1,114 @@
+/** Checks that the ROOTFilePB messages written and read one Histo at
+    a time, see ROOTFilePBStream.h, are the ones serialised and parsed
+    as a whole, through the gzip streams of the DQM files, and that a
+    truncated message is reported. */
+
+#include "DQMServices/Core/src/ROOTFilePBStream.h"
+#include <google/protobuf/io/gzip_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+using google::protobuf::io::ArrayInputStream;
+using google::protobuf::io::GzipInputStream;
+using google::protobuf::io::GzipOutputStream;
+using google::protobuf::io::StringOutputStream;
+
+int main()
+{
+  dqmstorepb::ROOTFilePB message;
+  std::mt19937 engine(12345);
+  for (int i = 0; i < 10000; ++i)
+  {
+    dqmstorepb::ROOTFilePB::Histo *h = message.add_histo();
+    std::string streamed(engine() % 4000, 'a' + i % 7);
+    h->set_full_pathname("Folder/Subfolder/histo_" + std::to_string(i));
+    h->set_size(streamed.size());
+    h->set_streamed_histo(streamed);
+    h->set_flags(i);
+  }
+
+  bool ok = true;
+
+  // the bytes before compression are the ones of the whole message
+  std::string whole, streamed;
+  {
+    StringOutputStream output(&whole);
+    message.SerializeToZeroCopyStream(&output);
+  }
+  {
+    StringOutputStream output(&streamed);
+    for (int i = 0; i < message.histo_size(); ++i)
+      dqmstorepb::writeHisto(&output, message.histo(i));
+  }
+  if (whole != streamed)
+  {
+    std::cerr << "The streamed message differs from the serialised one" << std::endl;
+    ok = false;
+  }
+
+  std::string file;
+  {
+    StringOutputStream output(&file);
+    GzipOutputStream::Options options;
+    options.format = GzipOutputStream::GZIP;
+    options.compression_level = 1;
+    GzipOutputStream gzip(&output, options);
+    for (int i = 0; i < message.histo_size(); ++i)
+      dqmstorepb::writeHisto(&gzip, message.histo(i));
+    gzip.Close();
+  }
+
+  // parsed as a whole by the existing readers
+  {
+    ArrayInputStream input(file.data(), file.size());
+    GzipInputStream gzip(&input);
+    dqmstorepb::ROOTFilePB parsed;
+    if (! parsed.ParseFromZeroCopyStream(&gzip)
+        || parsed.SerializeAsString() != whole)
+    {
+      std::cerr << "The streamed file cannot be parsed as a whole" << std::endl;
+      ok = false;
+    }
+  }
+
+  // read back one Histo at a time
+  {
+    ArrayInputStream input(file.data(), file.size());
+    GzipInputStream gzip(&input);
+    dqmstorepb::ROOTFilePB::Histo h;
+    bool corrupt = false;
+    int n = 0;
+    while (dqmstorepb::readHisto(&gzip, h, corrupt))
+    {
+      if (n >= message.histo_size()
+          || h.SerializeAsString() != message.histo(n).SerializeAsString())
+        ok = false;
+      ++n;
+    }
+    if (corrupt || n != message.histo_size())
+    {
+      std::cerr << "Read " << n << " of " << message.histo_size() << " histos back" << std::endl;
+      ok = false;
+    }
+  }
+
+  // a truncated message is not taken for a complete one
+  {
+    ArrayInputStream input(whole.data(), whole.size() - 100);
+    dqmstorepb::ROOTFilePB::Histo h;
+    bool corrupt = false;
+    while (dqmstorepb::readHisto(&input, h, corrupt))
+      ;
+    if (! corrupt)
+    {
+      std::cerr << "A truncated message was not reported" << std::endl;
+      ok = false;
+    }
+  }
+
+  google::protobuf::ShutdownProtobufLibrary();
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -28,6 +28,7 @@ DQMFileSaverPB::DQMFileSaverPB(const edm::ParameterSet &ps)
 
   fakeFilterUnitMode_ = ps.getUntrackedParameter<bool>("fakeFilterUnitMode", false);
   streamLabel_ = ps.getUntrackedParameter<std::string>("streamLabel", "streamDQMHistograms");
+  onlyModifiedMEs_ = ps.getUntrackedParameter<bool>("onlyModifiedMEs", false);
 
   transferDestination_ = "";
   mergeType_ = "";
@@ -81,7 +82,8 @@ void DQMFileSaverPB::saveLumi(const FileParameters& fp) const {
     store->savePB(openHistoFilePathName, "",
       store->mtEnabled() ? fp.run_ : 0,
       fp.lumi_,
-      true);
+      true,
+      onlyModifiedMEs_);
 
     // Now move the the data and json files into the output directory.
     ::rename(openHistoFilePathName.c_str(), histoFilePathName.c_str());
@@ -190,6 +192,10 @@ void DQMFileSaverPB::fillDescriptions(
   desc.addUntracked<std::string>("streamLabel", "streamDQMHistograms")->setComment(
       "Label of the stream.");
 
+  desc.addUntracked<bool>("onlyModifiedMEs", false)->setComment(
+      "If set, each lumi file only has the MEs filled since the previous one, "
+      "every ME being written at least once.");
+
   DQMFileSaverBase::fillDescription(desc);
 
   // Changed to use addDefault instead of add here because previously
@@ -30,6 +30,7 @@ class DQMFileSaverPB : public DQMFileSaverBase {
 
   bool fakeFilterUnitMode_;
   std::string streamLabel_;
+  bool onlyModifiedMEs_;
   mutable std::string transferDestination_;
   mutable std::string mergeType_;
 
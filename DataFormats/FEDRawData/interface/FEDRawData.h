@@ -8,6 +8,11 @@
  *  lenght of the data is a multiple of the S-Link64 word lenght (8 byte).
  *  The FED data should include the standard FED header and trailer.
  *
+ *  The data may instead be a view of an external buffer, for instance the
+ *  buffer the input source read the event into, kept alive as long as the
+ *  FEDRawData or one of its copies refers to it.  The view is transient:
+ *  the non-const accessors first copy the data into the owned buffer.
+ *
  *  \author G. Bruno - CERN, EP Division
  *  \author S. Argiro - CERN and INFN - 
  *                      Refactoring and Modifications to fit into CMSSW
@@ -16,6 +21,7 @@
 
 #include <vector>
 #include <cstddef>
+#include <memory>
 
 class FEDRawData {
 
@@ -44,17 +50,32 @@ class FEDRawData {
   unsigned char * data();
 
   /// Lenght of the data buffer in bytes
-  size_t size() const {return data_.size();}
+  size_t size() const {return external_ ? externalSize_ : data_.size();}
     
   /// Resize to the specified size in bytes. It is required that 
   /// the size is a multiple of the size of a FED word (8 bytes)
   void resize(size_t newsize);
 
+  /// Refer to the size bytes at data, in a buffer kept alive by owner,
+  /// instead of holding a copy of them. It is required that the size
+  /// is a multiple of the size of a FED word (8 bytes)
+  void setExternal(const unsigned char * data, size_t size, std::shared_ptr<const void> owner);
+
+  /// True if the data is a view of an external buffer
+  bool isExternal() const {return external_ != nullptr;}
+
  private:
 
+  /// Copy the data of the external buffer into the owned one
+  void copyExternal();
 
   Data data_;
 
+  // transient view of an external buffer
+  const unsigned char * external_;
+  size_t externalSize_;
+  std::shared_ptr<const void> owner_;
+
 };
 
 #endif
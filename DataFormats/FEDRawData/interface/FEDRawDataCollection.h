@@ -30,6 +30,12 @@ class FEDRawDataCollection : public edm::DoNotRecordParents {
 
   FEDRawDataCollection(const FEDRawDataCollection &);
 
+  /// True if the data of one of the FEDs is a view of an external buffer
+  bool hasExternal() const;
+
+  /// Copy the data of the FEDs viewing an external buffer into their own
+  void copyExternal();
+
   void swap(FEDRawDataCollection & other) {
     data_.swap(other.data_);
   }
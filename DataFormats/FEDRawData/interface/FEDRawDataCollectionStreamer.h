@@ -0,0 +1,36 @@
+#ifndef FEDRawData_FEDRawDataCollectionStreamer_h
+#define FEDRawData_FEDRawDataCollectionStreamer_h
+
+/** \class FEDRawDataCollectionStreamer
+ *  ROOT streamer writing a FEDRawDataCollection whose FEDRawData view an
+ *  external buffer as if they held a copy of it, the view itself being
+ *  transient.
+ *
+ *  It is set on the collection rather than on FEDRawData, so the
+ *  std::vector<FEDRawData> is still written by ROOT as usual, member-wise
+ *  included, and the layout of the data is unchanged.
+ *
+ *  Must be installed, with setFEDRawDataCollectionStreamer(), by the
+ *  producers of such collections before any of them is written.
+ */
+
+#include "TClassStreamer.h"
+#include "TClassRef.h"
+
+class TBuffer;
+
+class FEDRawDataCollectionStreamer : public TClassStreamer {
+ public:
+  explicit FEDRawDataCollectionStreamer() : cl_("FEDRawDataCollection") {}
+
+  void operator() (TBuffer &R__b, void *objp) override;
+
+  TClassStreamer* Generate() const override;
+
+ private:
+  TClassRef cl_;
+};
+
+void setFEDRawDataCollectionStreamer();
+
+#endif
@@ -24,6 +24,19 @@ FEDRawDataCollection::~FEDRawDataCollection(){
 
 }
 
+bool FEDRawDataCollection::hasExternal() const {
+  for (auto const& fed : data_) {
+    if (fed.isExternal()) return true;
+  }
+  return false;
+}
+
+void FEDRawDataCollection::copyExternal() {
+  for (auto& fed : data_) {
+    if (fed.isExternal()) fed.data();
+  }
+}
+
 
 const FEDRawData&   FEDRawDataCollection::FEDData(int fedid) const {
   return data_[fedid];
@@ -0,0 +1,34 @@
+#include "DataFormats/FEDRawData/interface/FEDRawDataCollectionStreamer.h"
+#include "DataFormats/FEDRawData/interface/FEDRawDataCollection.h"
+#include "TBuffer.h"
+#include "TClass.h"
+
+void
+FEDRawDataCollectionStreamer::operator()(TBuffer &R__b, void *objp) {
+  if (R__b.IsReading()) {
+    cl_->ReadBuffer(R__b, objp);
+  } else {
+    FEDRawDataCollection const* obj = static_cast<FEDRawDataCollection const*>(objp);
+    if (obj->hasExternal()) {
+      //write a copy holding the data, the product itself may be read by other modules
+      FEDRawDataCollection copy(*obj);
+      copy.copyExternal();
+      cl_->WriteBuffer(R__b, &copy);
+    } else {
+      cl_->WriteBuffer(R__b, objp);
+    }
+  }
+}
+
+TClassStreamer*
+FEDRawDataCollectionStreamer::Generate() const {
+  return new FEDRawDataCollectionStreamer(*this);
+}
+
+void setFEDRawDataCollectionStreamer() {
+  TClass *cl = TClass::GetClass("FEDRawDataCollection");
+  TClassStreamer *st = cl->GetStreamer();
+  if (st == nullptr) {
+    cl->AdoptStreamer(new FEDRawDataCollectionStreamer());
+  }
+}
@@ -0,0 +1,118 @@
+/** \file
+ *
+ *  Modules testing that FEDRawData viewing an external buffer are written
+ *  with their data: the producer makes such a collection, the analyzer
+ *  compares the data read back with the expected bytes.
+ *
+*/
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/global/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "DataFormats/FEDRawData/interface/FEDRawDataCollection.h"
+#include "DataFormats/FEDRawData/interface/FEDRawDataCollectionStreamer.h"
+#include "DataFormats/FEDRawData/interface/FEDNumbering.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+  namespace {
+    // FEDs made by the producer, the first ones viewing an external buffer,
+    // the last one holding its data
+    const int kFEDs[] = {1, 2, 600, 1023};
+    const unsigned int kNExternal = 3;
+
+    size_t fedSize(int fed, unsigned long long event) {
+      return 8*(1 + (fed + event)%64);
+    }
+
+    unsigned char fedByte(int fed, unsigned long long event, size_t i) {
+      return static_cast<unsigned char>(fed*7 + event*13 + i);
+    }
+  }
+
+  class FEDRawDataZeroCopyProducer: public edm::global::EDProducer<> {
+  public:
+    explicit FEDRawDataZeroCopyProducer(edm::ParameterSet const&) {
+      setFEDRawDataCollectionStreamer();
+      produces<FEDRawDataCollection>();
+    }
+
+    void produce(edm::StreamID, edm::Event& e, edm::EventSetup const&) const override {
+      auto const event = e.id().event();
+      size_t total = 0;
+      for (unsigned int i = 0; i != kNExternal; ++i) total += fedSize(kFEDs[i], event);
+
+      //one buffer for all the external FEDs, as the chunks of the input source
+      auto buffer = std::make_shared<std::vector<unsigned char>>(total);
+      auto product = std::make_unique<FEDRawDataCollection>();
+      size_t offset = 0;
+      for (int fed : kFEDs) {
+        size_t const size = fedSize(fed, event);
+        unsigned char* data;
+        if (fed != kFEDs[sizeof(kFEDs)/sizeof(kFEDs[0])-1]) {
+          data = &(*buffer)[offset];
+          product->FEDData(fed).setExternal(data, size, buffer);
+          offset += size;
+        } else {
+          product->FEDData(fed).resize(size);
+          data = product->FEDData(fed).data();
+        }
+        for (size_t i = 0; i != size; ++i) data[i] = fedByte(fed, event, i);
+      }
+      e.put(std::move(product));
+    }
+  };
+
+  class FEDRawDataZeroCopyAnalyzer: public edm::global::EDAnalyzer<> {
+  public:
+    explicit FEDRawDataZeroCopyAnalyzer(edm::ParameterSet const& pset) :
+      token_(consumes<FEDRawDataCollection>(pset.getUntrackedParameter<edm::InputTag>("src"))),
+      expectExternal_(pset.getUntrackedParameter<bool>("expectExternal"))
+    {}
+
+    void analyze(edm::StreamID, edm::Event const& e, edm::EventSetup const&) const override {
+      edm::Handle<FEDRawDataCollection> handle;
+      e.getByToken(token_, handle);
+      auto const event = e.id().event();
+      for (unsigned int i = 0; i != sizeof(kFEDs)/sizeof(kFEDs[0]); ++i) {
+        int const fed = kFEDs[i];
+        FEDRawData const& data = handle->FEDData(fed);
+        bool const external = expectExternal_ and i < kNExternal;
+        if (data.isExternal() != external) {
+          throw cms::Exception("TestFailure") << "event " << event << " FED " << fed
+                                              << (external ? " does not view" : " views") << " an external buffer";
+        }
+        if (data.size() != fedSize(fed, event)) {
+          throw cms::Exception("TestFailure") << "event " << event << " FED " << fed << " has "
+                                              << data.size() << " bytes instead of " << fedSize(fed, event);
+        }
+        for (size_t j = 0; j != data.size(); ++j) {
+          if (data.data()[j] != fedByte(fed, event, j)) {
+            throw cms::Exception("TestFailure") << "event " << event << " FED " << fed << " differs at byte " << j;
+          }
+        }
+      }
+      for (int fed = 0; fed <= FEDNumbering::lastFEDId(); ++fed) {
+        bool made = false;
+        for (int f : kFEDs) made = made or f == fed;
+        if (not made and handle->FEDData(fed).size() != 0) {
+          throw cms::Exception("TestFailure") << "event " << event << " FED " << fed << " is not empty";
+        }
+      }
+    }
+
+  private:
+    edm::EDGetTokenT<FEDRawDataCollection> const token_;
+    bool const expectExternal_;
+  };
+}
+
+using namespace test;
+DEFINE_FWK_MODULE(FEDRawDataZeroCopyProducer);
+DEFINE_FWK_MODULE(FEDRawDataZeroCopyAnalyzer);
@@ -8,8 +8,11 @@
 
 #include <cppunit/extensions/HelperMacros.h>
 #include <DataFormats/FEDRawData/interface/FEDRawData.h>
+#include <FWCore/Utilities/interface/Exception.h>
 
 #include <iostream>
+#include <memory>
+#include <vector>
 
 class testFEDRawData: public CppUnit::TestFixture {
 
@@ -17,6 +20,7 @@ class testFEDRawData: public CppUnit::TestFixture {
 
   CPPUNIT_TEST(testCtor);
   CPPUNIT_TEST(testdata);
+  CPPUNIT_TEST(testExternal);
  
   CPPUNIT_TEST_SUITE_END();
 
@@ -27,6 +31,7 @@ public:
   void tearDown(){}  
   void testCtor();
   void testdata(); 
+  void testExternal();
  
 }; 
 
@@ -56,5 +61,41 @@ void testFEDRawData::testdata(){
   CPPUNIT_ASSERT(buf[47] == 'c');
 }
 
+void testFEDRawData::testExternal(){
+  auto buffer = std::make_shared<std::vector<unsigned char>>(64, 'x');
+  std::weak_ptr<std::vector<unsigned char>> alive(buffer);
+
+  FEDRawData f;
+  f.setExternal(&(*buffer)[8], 16, buffer);
+  buffer.reset();
+  CPPUNIT_ASSERT(f.isExternal());
+  CPPUNIT_ASSERT(f.size()==size_t(16));
+  CPPUNIT_ASSERT(!alive.expired());
+
+  // copies share the buffer
+  const FEDRawData copy(f);
+  const FEDRawData& view = f;
+  CPPUNIT_ASSERT(copy.isExternal());
+  CPPUNIT_ASSERT(copy.data()==view.data());
+  CPPUNIT_ASSERT(view.data()==&(*alive.lock())[8]);
+
+  // writing copies the data out of the buffer
+  f.data()[0]='a';
+  CPPUNIT_ASSERT(!f.isExternal());
+  CPPUNIT_ASSERT(f.size()==size_t(16));
+  CPPUNIT_ASSERT(f.data()[0]=='a' && f.data()[15]=='x');
+  CPPUNIT_ASSERT(copy.data()[0]=='x');
+  CPPUNIT_ASSERT(!alive.expired());
+
+  {
+    FEDRawData last(copy);
+    last.resize(24);
+    CPPUNIT_ASSERT(!last.isExternal());
+    CPPUNIT_ASSERT(last.data()[15]=='x');
+  }
+  CPPUNIT_ASSERT(!alive.expired());
+
+  CPPUNIT_ASSERT_THROW(f.setExternal(&(*alive.lock())[0], 12, alive.lock()), cms::Exception);
+}
 
 #include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
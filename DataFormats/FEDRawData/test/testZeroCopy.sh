@@ -0,0 +1,8 @@
+#!/bin/bash
+
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+cmsRun ${LOCAL_TEST_DIR}/testZeroCopyWrite_cfg.py || die "Failure writing the zero-copy FEDRawDataCollection" $?
+cmsRun ${LOCAL_TEST_DIR}/testZeroCopyRead_cfg.py testZeroCopy.root || die "Failure reading back testZeroCopy.root" $?
+cmsRun ${LOCAL_TEST_DIR}/testZeroCopyRead_cfg.py testZeroCopy.dat || die "Failure reading back testZeroCopy.dat" $?
@@ -0,0 +1,23 @@
+import FWCore.ParameterSet.Config as cms
+import sys
+
+process = cms.Process("READ")
+
+# the file written by testZeroCopyWrite_cfg.py, by the PoolOutputModule
+# or the EventStreamFileWriter
+fileName = sys.argv[2]
+if fileName.endswith('.dat'):
+    process.source = cms.Source("NewEventStreamFileReader",
+        fileNames = cms.untracked.vstring('file:'+fileName)
+    )
+else:
+    process.source = cms.Source("PoolSource",
+        fileNames = cms.untracked.vstring('file:'+fileName)
+    )
+
+process.check = cms.EDAnalyzer("FEDRawDataZeroCopyAnalyzer",
+    src = cms.untracked.InputTag("raw"),
+    expectExternal = cms.untracked.bool(False)
+)
+
+process.p = cms.Path(process.check)
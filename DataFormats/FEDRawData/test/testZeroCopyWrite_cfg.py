@@ -0,0 +1,26 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("WRITE")
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(10))
+
+process.raw = cms.EDProducer("FEDRawDataZeroCopyProducer")
+
+process.poolOut = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('testZeroCopy.root')
+)
+
+process.streamOut = cms.OutputModule("EventStreamFileWriter",
+    fileName = cms.untracked.string('testZeroCopy.dat')
+)
+
+# writing must leave the product viewing its buffer
+process.check = cms.EDAnalyzer("FEDRawDataZeroCopyAnalyzer",
+    src = cms.untracked.InputTag("raw"),
+    expectExternal = cms.untracked.bool(True)
+)
+
+process.p = cms.Path(process.raw)
+process.e = cms.EndPath(process.poolOut+process.streamOut+process.check)
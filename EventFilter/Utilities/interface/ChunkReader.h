@@ -0,0 +1,39 @@
+#ifndef EventFilter_Utilities_ChunkReader_h
+#define EventFilter_Utilities_ChunkReader_h
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <sys/types.h>
+
+/*
+ * Asynchronous reads of the blocks of the input chunks of FedRawDataInputSource.
+ *
+ * Reads are submitted without waiting and completed from a thread of the reader,
+ * so that the reads of several chunks, possibly of several files, are in flight at
+ * the same time.  The "uring" backend submits them to an io_uring queue of the
+ * kernel, the "pread" backend to a pool of threads doing pread(2).
+ */
+
+namespace evf {
+
+  class ChunkReader {
+  public:
+    //bytes read, fewer than asked only at the end of the file, or -errno;
+    //the backends continue the reads which the kernel completes short
+    typedef std::function<void(ssize_t)> Callback;
+
+    virtual ~ChunkReader() {}
+
+    //the buffer and the file descriptor must stay valid until done was called
+    virtual void read(int fd, void* into, size_t size, off_t offset, Callback done) = 0;
+    virtual const char* backend() const = 0;
+
+    //"uring" or "auto" gives the io_uring backend if the kernel provides it, else "pread";
+    //depth is the number of reads in flight
+    static std::unique_ptr<ChunkReader> make(std::string const& backend, unsigned int depth);
+  };
+
+}
+
+#endif
@@ -175,6 +175,7 @@ namespace evf{
       void startedLookingForFile();
       void stoppedLookingForFile(unsigned int lumi);
       void reportLockWait(unsigned int ls, double waitTime, unsigned int lockCount);
+      void reportChunkRead(unsigned int ls, double readTimeUs);
       unsigned int getEventsProcessedForLumi(unsigned int lumi, bool * abortFlag=nullptr);
       bool getAbortFlagForLumi(unsigned int lumi);
       bool shouldWriteFiles(unsigned int lumi, unsigned int* proc=nullptr)
@@ -284,6 +285,7 @@ namespace evf{
       std::map<unsigned int, unsigned long> accuSize_;
       std::vector<double> leadTimes_;
       std::map<unsigned int, std::pair<double,unsigned int>> lockStatsDuringLumi_;
+      std::map<unsigned int, std::pair<double,unsigned int>> chunkReadStatsDuringLumi_;
 
       //for output module
       std::map<unsigned int, std::pair<unsigned int,bool>> processedEventsPerLumi_;
@@ -47,6 +47,8 @@ namespace evf{
       jsoncollector::IntJ fastFilesProcessedJ_;
       jsoncollector::DoubleJ fastLockWaitJ_;
       jsoncollector::IntJ fastLockCountJ_;
+      jsoncollector::DoubleJ fastChunkReadTimeJ_;
+      jsoncollector::IntJ fastChunkReadCountJ_;
       jsoncollector::IntJ fastEventsProcessedJ_;
 
       unsigned int varIndexThrougput_;
@@ -78,12 +80,16 @@ namespace evf{
 	fastFilesProcessedJ_ = 0;
         fastLockWaitJ_ = 0;
         fastLockCountJ_ = 0;
+        fastChunkReadTimeJ_ = 0;
+        fastChunkReadCountJ_ = 0;
         fastMacrostateJ_.setName("Macrostate");
         fastThroughputJ_.setName("Throughput");
         fastAvgLeadTimeJ_.setName("AverageLeadTime");
 	fastFilesProcessedJ_.setName("FilesProcessed");
 	fastLockWaitJ_.setName("LockWaitUs");
 	fastLockCountJ_.setName("LockCount");
+	fastChunkReadTimeJ_.setName("ChunkReadUs");
+	fastChunkReadCountJ_.setName("ChunkReadCount");
 
         fastPathProcessedJ_ = 0;
         fastPathProcessedJ_.setName("Processed");
@@ -98,6 +104,8 @@ namespace evf{
         fm->registerGlobalMonitorable(&fastFilesProcessedJ_,false);
         fm->registerGlobalMonitorable(&fastLockWaitJ_,false);
         fm->registerGlobalMonitorable(&fastLockCountJ_,false);
+        fm->registerGlobalMonitorable(&fastChunkReadTimeJ_,false);
+        fm->registerGlobalMonitorable(&fastChunkReadCountJ_,false);
 
 	for (unsigned int i=0;i<nStreams;i++) {
 	 jsoncollector::AtomicMonUInt * p  = new jsoncollector::AtomicMonUInt;
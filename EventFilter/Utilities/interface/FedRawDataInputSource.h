@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <cstdio>
+#include <cstdlib>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
@@ -31,6 +32,7 @@ struct  InputChunk;
 
 namespace evf {
 class FastMonitoringService;
+class ChunkReader;
 }
 
 namespace jsoncollector {
@@ -66,9 +68,17 @@ private:
 
   void readSupervisor();
   void readWorker(unsigned int tid);
+  void readChunkAsync(InputFile *file, InputChunk *chunk);
+  void completeChunk(InputFile *file, InputChunk *chunk, double readTimeUs);
+  int openInputFile(std::string const& name);
   void threadError();
   bool exceptionState() {return setExceptionState_;}
 
+  //chunks are recycled once neither the source nor an event refers to them
+  std::shared_ptr<const void> chunkOwner(InputChunk *chunk);
+  void releaseChunk(InputChunk *chunk);
+  static void releaseChunk(tbb::concurrent_queue<InputChunk*>& freeChunks, InputChunk *chunk);
+
   //functions for single buffered reader
   void readNextChunkIntoBuffer(InputFile *file);
 
@@ -97,6 +107,10 @@ private:
   const bool verifyAdler32_;
   const bool verifyChecksum_;
   const bool useL1EventID_;
+  bool zeroCopy_;
+  const std::string asyncRead_;
+  const unsigned int asyncReadDepth_;
+  const bool directIO_;
   std::vector<std::string> fileNames_;
   //std::vector<std::string> fileNamesSorted_;
 
@@ -111,6 +125,7 @@ private:
   const edm::DaqProvenanceHelper daqProvenanceHelper_;
 
   std::unique_ptr<FRDEventMsgView> event_;
+  std::shared_ptr<const void> eventOwner_; //keeps the event data alive in zero-copy mode
 
   edm::EventID eventID_;
   edm::ProcessHistoryID processHistoryID_;
@@ -144,7 +159,7 @@ private:
   tbb::concurrent_queue<unsigned int> workerPool_;
   std::vector<ReaderInfo> workerJob_;
 
-  tbb::concurrent_queue<InputChunk*> freeChunks_;
+  std::shared_ptr<tbb::concurrent_queue<InputChunk*>> freeChunks_; //shared with the owners of the zero-copy event data
   tbb::concurrent_queue<InputFile*> fileQueue_;
 
   std::mutex mReader_;
@@ -176,6 +191,10 @@ private:
 
   std::atomic<bool> threadInit_;
 
+  //asynchronous reader used instead of the reader threads
+  std::unique_ptr<evf::ChunkReader> chunkReader_;
+  std::atomic<bool> directIOUnsupported_{false};
+
   std::map<unsigned int,unsigned int> sourceEventsReport_;
   std::mutex monlock_;
 };
@@ -190,9 +209,13 @@ struct InputChunk {
   unsigned int offset_;
   unsigned int fileIndex_;
   std::atomic<bool> readComplete_;
+  std::atomic<unsigned int> users_; //the source and the events referring to the chunk
 
   InputChunk(unsigned int index, uint32_t size): size_(size),index_(index) {
-    buf_ = new unsigned char[size_];
+    //page aligned for reads with O_DIRECT
+    void *buf = nullptr;
+    if (posix_memalign(&buf,4096,size_)) throw std::bad_alloc();
+    buf_ = static_cast<unsigned char*>(buf);
     reset(0,0,0);
   }
   void reset(unsigned int newOffset, unsigned int toRead, unsigned int fileIndex) {
@@ -200,9 +223,10 @@ struct InputChunk {
     usedSize_=toRead;
     fileIndex_=fileIndex;
     readComplete_=false;
+    users_=1;
   }
 
-  ~InputChunk() {delete[] buf_;}
+  ~InputChunk() {free(buf_);}
 };
 
 
@@ -246,6 +270,10 @@ struct InputFile {
   bool advance(unsigned char* & dataPosition, const size_t size);
   void moveToPreviousChunk(const size_t size, const size_t offset);
   void rewindChunk(const size_t size);
+  //zero-copy mode, the chunks are not modified
+  size_t leftInChunk() const {return chunks_[currentChunk_]->size_ - chunkPosition_;}
+  void nextChunk();
+  bool copyOut(unsigned char* into, size_t size);
 };
 
 
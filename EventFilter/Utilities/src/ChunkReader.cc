@@ -0,0 +1,301 @@
+#include "EventFilter/Utilities/interface/ChunkReader.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define EVF_CHUNKREADER_URING
+#endif
+#endif
+
+namespace {
+
+  //iov_ and offset_ describe what is left to read, got_ what was read already
+  struct Request {
+    int fd_;
+    struct iovec iov_;
+    off_t offset_;
+    evf::ChunkReader::Callback done_;
+    ssize_t got_;
+
+    //true once the request is complete
+    bool advance(ssize_t got) {
+      iov_.iov_base = static_cast<char*>(iov_.iov_base)+got;
+      iov_.iov_len -= got;
+      offset_ += got;
+      got_ += got;
+      return iov_.iov_len==0;
+    }
+  };
+
+  //pool of threads doing blocking reads
+  class PreadChunkReader : public evf::ChunkReader {
+  public:
+    PreadChunkReader(unsigned int threads) : stop_(false) {
+      for (unsigned int i=0;i<threads;i++)
+        threads_.emplace_back(&PreadChunkReader::work,this);
+    }
+
+    ~PreadChunkReader() override {
+      {
+        std::lock_guard<std::mutex> lk(mutex_);
+        stop_=true;
+      }
+      cv_.notify_all();
+      for (auto& thread : threads_) thread.join();
+    }
+
+    void read(int fd, void* into, size_t size, off_t offset, Callback done) override {
+      std::lock_guard<std::mutex> lk(mutex_);
+      queue_.push_back(Request{fd,{into,size},offset,std::move(done),0});
+      cv_.notify_one();
+    }
+
+    const char* backend() const override {return "pread";}
+
+  private:
+    void work() {
+      while (true) {
+        Request request;
+        {
+          std::unique_lock<std::mutex> lk(mutex_);
+          //queued reads are completed before stopping
+          cv_.wait(lk,[this]() {return stop_ || !queue_.empty();});
+          if (queue_.empty()) return;
+          request = std::move(queue_.front());
+          queue_.pop_front();
+        }
+        //a short read is continued until the end of the file
+        ssize_t got;
+        do {
+          got = ::pread(request.fd_,request.iov_.iov_base,request.iov_.iov_len,request.offset_);
+        } while ((got<0 && errno==EINTR) || (got>0 && !request.advance(got)));
+        request.done_(got<0 ? -errno : request.got_);
+      }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Request> queue_;
+    std::vector<std::thread> threads_;
+    bool stop_;
+  };
+
+#ifdef EVF_CHUNKREADER_URING
+  //submission and completion rings shared with the kernel, the completions are reaped by a thread
+  class UringChunkReader : public evf::ChunkReader {
+  public:
+    UringChunkReader(unsigned int depth) {
+      struct io_uring_params params;
+      memset(&params,0,sizeof(params));
+      ringFd_ = syscall(__NR_io_uring_setup,depth,&params);
+      if (ringFd_<0) return;
+
+      sqRingSize_ = params.sq_off.array + params.sq_entries*sizeof(unsigned int);
+      cqRingSize_ = params.cq_off.cqes + params.cq_entries*sizeof(struct io_uring_cqe);
+      const bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+      if (singleMap) sqRingSize_ = cqRingSize_ = std::max(sqRingSize_,cqRingSize_);
+      sqRing_ = mmap(nullptr,sqRingSize_,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,ringFd_,IORING_OFF_SQ_RING);
+      cqRing_ = singleMap ? sqRing_ :
+        mmap(nullptr,cqRingSize_,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,ringFd_,IORING_OFF_CQ_RING);
+      sqesSize_ = params.sq_entries*sizeof(struct io_uring_sqe);
+      void* sqes = mmap(nullptr,sqesSize_,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,ringFd_,IORING_OFF_SQES);
+      if (sqRing_==MAP_FAILED || cqRing_==MAP_FAILED || sqes==MAP_FAILED) {
+        if (sqRing_!=MAP_FAILED) munmap(sqRing_,sqRingSize_);
+        if (cqRing_!=MAP_FAILED && !singleMap) munmap(cqRing_,cqRingSize_);
+        if (sqes!=MAP_FAILED) munmap(sqes,sqesSize_);
+        close(ringFd_);
+        ringFd_=-1;
+        return;
+      }
+
+      char* sq = static_cast<char*>(sqRing_);
+      sqHead_ = reinterpret_cast<unsigned int*>(sq + params.sq_off.head);
+      sqTail_ = reinterpret_cast<unsigned int*>(sq + params.sq_off.tail);
+      sqMask_ = *reinterpret_cast<unsigned int*>(sq + params.sq_off.ring_mask);
+      sqArray_ = reinterpret_cast<unsigned int*>(sq + params.sq_off.array);
+      sqes_ = static_cast<struct io_uring_sqe*>(sqes);
+      char* cq = static_cast<char*>(cqRing_);
+      cqHead_ = reinterpret_cast<unsigned int*>(cq + params.cq_off.head);
+      cqTail_ = reinterpret_cast<unsigned int*>(cq + params.cq_off.tail);
+      cqMask_ = *reinterpret_cast<unsigned int*>(cq + params.cq_off.ring_mask);
+      cqes_ = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+      entries_ = params.sq_entries;
+      singleMap_ = singleMap;
+
+      stopFd_ = eventfd(0,0);
+      if (stopFd_<0) {
+        unmap();
+        return;
+      }
+      reaper_ = std::thread(&UringChunkReader::reap,this);
+    }
+
+    ~UringChunkReader() override {
+      if (ringFd_<0) return;
+      {
+        std::unique_lock<std::mutex> lk(mutex_);
+        cv_.wait(lk,[this]() {return inFlight_==0;});
+      }
+      //wakes the reaper without going through the ring, this cannot fail once the eventfd exists
+      const uint64_t one = 1;
+      while (write(stopFd_,&one,sizeof(one))<0 && errno==EINTR) {}
+      reaper_.join();
+      close(stopFd_);
+      unmap();
+    }
+
+    bool valid() const {return ringFd_>=0;}
+
+    void read(int fd, void* into, size_t size, off_t offset, Callback done) override {
+      std::unique_ptr<Request> request(new Request{fd,{into,size},offset,std::move(done),0});
+      std::unique_lock<std::mutex> lk(mutex_);
+      cv_.wait(lk,[this]() {return inFlight_<entries_;});
+      const int error = submit(request.get());
+      if (error)
+        throw cms::Exception("ChunkReader") << "io_uring submission failed: " << strerror(error);
+      inFlight_++;
+      request.release();
+    }
+
+    const char* backend() const override {return "uring";}
+
+  private:
+    void unmap() {
+      munmap(sqes_,sqesSize_);
+      if (!singleMap_) munmap(cqRing_,cqRingSize_);
+      munmap(sqRing_,sqRingSize_);
+      close(ringFd_);
+      ringFd_=-1;
+    }
+
+    //called with the mutex held, which serializes the producers of the submission ring;
+    //returns 0 or the errno of the submission, the request is not queued if it failed
+    int submit(Request* request) {
+      const unsigned int tail = *sqTail_;
+      const unsigned int index = tail & sqMask_;
+      struct io_uring_sqe* sqe = &sqes_[index];
+      memset(sqe,0,sizeof(*sqe));
+      sqe->opcode = IORING_OP_READV;
+      sqe->fd = request->fd_;
+      sqe->addr = reinterpret_cast<unsigned long>(&request->iov_);
+      sqe->len = 1;
+      sqe->off = request->offset_;
+      sqe->user_data = reinterpret_cast<unsigned long>(request);
+      sqArray_[index] = index;
+      __atomic_store_n(sqTail_,tail+1,__ATOMIC_RELEASE);
+
+      while (syscall(__NR_io_uring_enter,ringFd_,1,0,0,nullptr,0)<0) {
+        if (errno==EINTR || errno==EAGAIN || errno==EBUSY) continue;
+        const int error = errno;
+        //the kernel did not take the entry, withdraw it so that it is not submitted later
+        if (__atomic_load_n(sqHead_,__ATOMIC_ACQUIRE)==tail) {
+          __atomic_store_n(sqTail_,tail,__ATOMIC_RELEASE);
+          return error;
+        }
+        break;
+      }
+      return 0;
+    }
+
+    void reap() {
+      struct pollfd fds[2] = {{ringFd_,POLLIN,0},{stopFd_,POLLIN,0}};
+      while (true) {
+        //an interrupted wait only reaps what already completed
+        poll(fds,2,-1);
+        unsigned int head = *cqHead_;
+        const unsigned int tail = __atomic_load_n(cqTail_,__ATOMIC_ACQUIRE);
+        std::vector<Request*> completed;
+        std::vector<Request*> continued;
+        for (;head!=tail;head++) {
+          const struct io_uring_cqe* cqe = &cqes_[head & cqMask_];
+          Request* request = reinterpret_cast<Request*>(cqe->user_data);
+          //a short read is continued until the end of the file
+          if ((cqe->res>0 && !request->advance(cqe->res)) || cqe->res==-EINTR || cqe->res==-EAGAIN)
+            continued.push_back(request);
+          else {
+            if (cqe->res<0) request->got_ = cqe->res;
+            completed.push_back(request);
+          }
+        }
+        __atomic_store_n(cqHead_,head,__ATOMIC_RELEASE);
+        if (!continued.empty()) {
+          std::lock_guard<std::mutex> lk(mutex_);
+          for (Request* request : continued) {
+            const int error = submit(request);
+            if (error) {
+              request->got_ = -error;
+              completed.push_back(request);
+            }
+          }
+        }
+        for (Request* request : completed) {
+          request->done_(request->got_);
+          delete request;
+        }
+        if (!completed.empty()) {
+          std::lock_guard<std::mutex> lk(mutex_);
+          inFlight_-=completed.size();
+          cv_.notify_all();
+        }
+        if (fds[1].revents) return;
+      }
+    }
+
+    int ringFd_;
+    void* sqRing_ = nullptr;
+    void* cqRing_ = nullptr;
+    size_t sqRingSize_ = 0;
+    size_t cqRingSize_ = 0;
+    size_t sqesSize_ = 0;
+    bool singleMap_ = false;
+    unsigned int* sqHead_ = nullptr;
+    unsigned int* sqTail_ = nullptr;
+    unsigned int sqMask_ = 0;
+    unsigned int* sqArray_ = nullptr;
+    struct io_uring_sqe* sqes_ = nullptr;
+    unsigned int* cqHead_ = nullptr;
+    unsigned int* cqTail_ = nullptr;
+    unsigned int cqMask_ = 0;
+    struct io_uring_cqe* cqes_ = nullptr;
+    unsigned int entries_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    unsigned int inFlight_ = 0;
+    int stopFd_ = -1;
+    std::thread reaper_;
+  };
+#endif
+
+}
+
+std::unique_ptr<evf::ChunkReader> evf::ChunkReader::make(std::string const& backend, unsigned int depth)
+{
+  if (backend!="auto" && backend!="uring" && backend!="pread")
+    throw cms::Exception("ChunkReader") << "Unknown read backend " << backend << ", expected auto, uring or pread";
+  if (!depth) depth=1;
+
+#ifdef EVF_CHUNKREADER_URING
+  if (backend!="pread") {
+    std::unique_ptr<UringChunkReader> reader(new UringChunkReader(depth));
+    if (reader->valid()) return reader;
+  }
+#endif
+  return std::unique_ptr<ChunkReader>(new PreadChunkReader(depth));
+}
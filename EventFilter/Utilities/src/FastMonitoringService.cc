@@ -411,6 +411,7 @@ namespace evf{
 		  filesProcessedDuringLumi_.erase(oldLumi);
 		  accuSize_.erase(oldLumi);
 		  lockStatsDuringLumi_.erase(oldLumi);
+		  chunkReadStatsDuringLumi_.erase(oldLumi);
 		  processedEventsPerLumi_.erase(oldLumi);
 	  }
 	  lastGlobalLumi_= newLumi;
@@ -707,6 +708,15 @@ namespace evf{
 
   }
 
+  //accumulated for the lumisection of the file, called by the source reader threads
+  void FastMonitoringService::reportChunkRead(unsigned int ls, double readTimeUs)
+  {
+          std::lock_guard<std::mutex> lock(fmt_.monlock_);
+	  auto& stats = chunkReadStatsDuringLumi_[ls];
+	  stats.first+=readTimeUs;
+	  stats.second++;
+  }
+
   //for the output module
   unsigned int FastMonitoringService::getEventsProcessedForLumi(unsigned int lumi, bool * abortFlag) {
     std::lock_guard<std::mutex> lock(fmt_.monlock_);
@@ -766,6 +776,16 @@ namespace evf{
        fmt_.m_data.fastLockWaitJ_=0.;
        fmt_.m_data.fastLockCountJ_=0.;
       }
+
+      auto itcr = chunkReadStatsDuringLumi_.find(ls);
+      if (itcr != chunkReadStatsDuringLumi_.end()) {
+	fmt_.m_data.fastChunkReadTimeJ_ = itcr->second.first;
+	fmt_.m_data.fastChunkReadCountJ_ = itcr->second.second;
+      }
+      else {
+       fmt_.m_data.fastChunkReadTimeJ_=0.;
+       fmt_.m_data.fastChunkReadCountJ_=0;
+      }
     }
     else {
       if (isGlobalLumiTransition_)
@@ -19,6 +19,7 @@
 
 #include "DataFormats/FEDRawData/interface/FEDNumbering.h"
 #include "DataFormats/FEDRawData/interface/FEDRawDataCollection.h"
+#include "DataFormats/FEDRawData/interface/FEDRawDataCollectionStreamer.h"
 
 #include "DataFormats/TCDS/interface/TCDSRaw.h"
 
@@ -34,6 +35,7 @@
 #include "EventFilter/FEDInterface/interface/fed_trailer.h"
 
 #include "EventFilter/Utilities/interface/FedRawDataInputSource.h"
+#include "EventFilter/Utilities/interface/ChunkReader.h"
 
 #include "EventFilter/Utilities/interface/FastMonitoringService.h"
 #include "EventFilter/Utilities/interface/DataPointDefinition.h"
@@ -65,6 +67,10 @@ FedRawDataInputSource::FedRawDataInputSource(edm::ParameterSet const& pset,
   verifyAdler32_(pset.getUntrackedParameter<bool> ("verifyAdler32", true)),
   verifyChecksum_(pset.getUntrackedParameter<bool> ("verifyChecksum", true)),
   useL1EventID_(pset.getUntrackedParameter<bool> ("useL1EventID", false)),
+  zeroCopy_(pset.getUntrackedParameter<bool> ("zeroCopy", false)),
+  asyncRead_(pset.getUntrackedParameter<std::string> ("asyncRead", "none")),
+  asyncReadDepth_(pset.getUntrackedParameter<unsigned int> ("asyncReadDepth", 8)),
+  directIO_(pset.getUntrackedParameter<bool> ("directIO", false)),
   fileNames_(pset.getUntrackedParameter<std::vector<std::string>> ("fileNames",std::vector<std::string>())),
   fileListMode_(pset.getUntrackedParameter<bool> ("fileListMode", false)),
   fileListLoopMode_(pset.getUntrackedParameter<bool> ("fileListLoopMode", false)),
@@ -130,6 +136,23 @@ FedRawDataInputSource::FedRawDataInputSource(edm::ParameterSet const& pset,
   singleBufferMode_ = !(numBuffers_>1);
   readingFilesCount_=0;
 
+  if (zeroCopy_ && singleBufferMode_) {
+    edm::LogWarning("FedRawDataInputSource") << "zeroCopy needs more than one buffer, FED data will be copied";
+    zeroCopy_=false;
+  }
+  //FEDRawData referring to the chunks are written as if they held the data
+  if (zeroCopy_) setFEDRawDataCollectionStreamer();
+
+  if (asyncRead_!="none") {
+    if (singleBufferMode_)
+      edm::LogWarning("FedRawDataInputSource") << "asyncRead needs more than one buffer, reading synchronously";
+    else {
+      chunkReader_ = evf::ChunkReader::make(asyncRead_,asyncReadDepth_);
+      edm::LogInfo("FedRawDataInputSource") << "Reading chunks asynchronously with the " << chunkReader_->backend()
+                                            << " backend, " << asyncReadDepth_ << " reads in flight";
+    }
+  }
+
   if (!crc32c_hw_test())
     edm::LogError("FedRawDataInputSource::FedRawDataInputSource") << "Intel crc32c checksum computation unavailable";
 
@@ -161,13 +184,15 @@ FedRawDataInputSource::FedRawDataInputSource(edm::ParameterSet const& pset,
    fms_->setInStateSup(evf::FastMonitoringThread::inInit);
   }
   //should delete chunks when run stops
+  freeChunks_ = std::make_shared<tbb::concurrent_queue<InputChunk*>>();
   for (unsigned int i=0;i<numBuffers_;i++) {
-    freeChunks_.push(new InputChunk(i,eventChunkSize_));
+    freeChunks_->push(new InputChunk(i,eventChunkSize_));
   }
 
   quit_threads_ = false;
 
-  for (unsigned int i=0;i<numConcurrentReads_;i++)
+  //the asynchronous reader replaces the reader threads
+  for (unsigned int i=0;i<numConcurrentReads_ && !chunkReader_;i++)
   {
     std::unique_lock<std::mutex> lk(startupLock_);
     //issue a memory fence here and in threads (constructor was segfaulting without this)
@@ -206,11 +231,11 @@ FedRawDataInputSource::~FedRawDataInputSource()
       delete workerThreads_[i];
     }
   }
-  for (unsigned int i=0;i<numConcurrentReads_;i++) delete cvReader_[i];
+  for (unsigned int i=0;i<cvReader_.size();i++) delete cvReader_[i];
   /*
   for (unsigned int i=0;i<numConcurrentReads_+1;i++) {
     InputChunk *ch;
-    while (!freeChunks_.try_pop(ch)) {}
+    while (!freeChunks_->try_pop(ch)) {}
     delete ch;
   }
   */
@@ -227,6 +252,10 @@ void FedRawDataInputSource::fillDescriptions(edm::ConfigurationDescriptions& des
   desc.addUntracked<bool> ("verifyAdler32", true)->setComment("Verify event Adler32 checksum with FRDv3 or v4");
   desc.addUntracked<bool> ("verifyChecksum", true)->setComment("Verify event CRC-32C checksum of FRDv5 or higher");
   desc.addUntracked<bool> ("useL1EventID", false)->setComment("Use L1 event ID from FED header if true or from TCDS FED if false");
+  desc.addUntracked<bool> ("zeroCopy", false)->setComment("FED data refer to the input buffers instead of copies; the buffers referred to by events in flight are not reused, numBuffers should allow for it");
+  desc.addUntracked<std::string> ("asyncRead", "none")->setComment("Read chunks asynchronously instead of with reader threads: none, auto, uring or pread (auto and uring use io_uring if the kernel provides it, else pread)");
+  desc.addUntracked<unsigned int> ("asyncReadDepth", 8)->setComment("Number of block reads in flight with asyncRead");
+  desc.addUntracked<bool> ("directIO", false)->setComment("Open input files with O_DIRECT, bypassing the page cache, where the file system supports it (not in single-buffer mode)");
   desc.addUntracked<bool> ("fileListMode", false)->setComment("Use fileNames parameter to directly specify raw files to open");
   desc.addUntracked<std::vector<std::string>> ("fileNames", std::vector<std::string>())->setComment("file list used when fileListMode is enabled");
   desc.setAllowAnything();
@@ -447,7 +476,7 @@ inline evf::EvFDaqDirector::FileStatus FedRawDataInputSource::getNextEvent()
   if (currentFile_->bufferPosition_==currentFile_->fileSize_) {
     readingFilesCount_--;
     //release last chunk (it is never released elsewhere)
-    freeChunks_.push(currentFile_->chunks_[currentFile_->currentChunk_]);
+    releaseChunk(currentFile_->chunks_[currentFile_->currentChunk_]);
     if (currentFile_->nEvents_>=0 && currentFile_->nEvents_!=int(currentFile_->nProcessed_))
     {
       throw cms::Exception("FedRawDataInputSource::getNextEvent")
@@ -544,6 +573,63 @@ inline evf::EvFDaqDirector::FileStatus FedRawDataInputSource::getNextEvent()
     //last chunk is released when this function is invoked next time
 
   }
+  //multibuffer mode, the events referring to the data in the chunks:
+  else if (zeroCopy_)
+  {
+    if (fms_) fms_->setInState(evf::FastMonitoringThread::inWaitChunk);
+    while (!currentFile_->waitForChunk(currentFile_->currentChunk_)) {
+      usleep(10000);
+      if (setExceptionState_) threadError();
+    }
+    if (fms_) fms_->setInState(evf::FastMonitoringThread::inChunkReceived);
+
+    chunkIsFree_ = false;
+    const uint32_t headerSize = FRDHeaderVersionSize[detectedFRDversion_];
+
+    //previous event ended the chunk
+    if (!currentFile_->leftInChunk()) {
+      currentFile_->nextChunk();
+      chunkIsFree_ = true;
+    }
+
+    InputChunk *chunk = currentFile_->chunks_[currentFile_->currentChunk_];
+    unsigned char *dataPosition = chunk->buf_ + currentFile_->chunkPosition_;
+    std::vector<unsigned char> header;
+    if (currentFile_->leftInChunk() >= headerSize)
+      event_.reset( new FRDEventMsgView(dataPosition) );
+    else {
+      header.resize(headerSize);
+      if (currentFile_->copyOut(&header[0], headerSize)) chunkIsFree_ = true;
+      event_.reset( new FRDEventMsgView(&header[0]) );
+    }
+    if (event_->size()>eventChunkSize_) {
+      throw cms::Exception("FedRawDataInputSource::getNextEvent")
+	      << " event id:"<< event_->event()<< " lumi:" << event_->lumi()
+	      << " run:" << event_->run() << " of size:" << event_->size()
+	      << " bytes does not fit into a chunk of size:" << eventChunkSize_ << " bytes";
+    }
+
+    const uint32_t eventLeft = event_->size() - (header.empty() ? 0 : headerSize);
+    if (currentFile_->fileSize_ - currentFile_->bufferPosition_ < eventLeft)
+    {
+      throw cms::Exception("FedRawDataInputSource::getNextEvent") <<
+	"Premature end of input file while reading event data";
+    }
+
+    if (header.empty() && currentFile_->leftInChunk() >= event_->size()) {
+      //everything is in a single chunk, the event refers to it
+      currentFile_->advance(dataPosition,event_->size());
+      eventOwner_ = chunkOwner(chunk);
+    }
+    else {
+      //event straddles two chunks, copy it out of them
+      auto buffer = std::make_shared<std::vector<unsigned char>>(event_->size());
+      if (!header.empty()) memcpy(&(*buffer)[0], &header[0], headerSize);
+      if (currentFile_->copyOut(&(*buffer)[event_->size()-eventLeft], eventLeft)) chunkIsFree_ = true;
+      event_.reset( new FRDEventMsgView(&(*buffer)[0]) );
+      eventOwner_ = buffer;
+    }
+  }
   //multibuffer mode:
   else
   {
@@ -673,6 +759,7 @@ void FedRawDataInputSource::read(edm::EventPrincipal& eventPrincipal)
   if (fms_) fms_->setInState(evf::FastMonitoringThread::inReadEvent);
   std::unique_ptr<FEDRawDataCollection> rawData(new FEDRawDataCollection);
   edm::Timestamp tstamp = fillFEDRawDataCollection(*rawData);
+  eventOwner_.reset();
 
   if (useL1EventID_){
     eventID_ = edm::EventID(eventRunNumber_, currentLumiSection_, L1EventID_);
@@ -736,7 +823,7 @@ void FedRawDataInputSource::read(edm::EventPrincipal& eventPrincipal)
     }
 
   }
-  if (chunkIsFree_) freeChunks_.push(currentFile_->chunks_[currentFile_->currentChunk_-1]);
+  if (chunkIsFree_) releaseChunk(currentFile_->chunks_[currentFile_->currentChunk_-1]);
   chunkIsFree_=false;
   if (fms_) fms_->setInState(evf::FastMonitoringThread::inNoRequest);
   return;
@@ -788,8 +875,12 @@ edm::Timestamp FedRawDataInputSource::fillFEDRawDataCollection(FEDRawDataCollect
       }
     }
     FEDRawData& fedData = rawData.FEDData(fedId);
-    fedData.resize(fedSize);
-    memcpy(fedData.data(), event + eventSize, fedSize);
+    if (eventOwner_)
+      fedData.setExternal((unsigned char*) (event + eventSize), fedSize, eventOwner_);
+    else {
+      fedData.resize(fedSize);
+      memcpy(fedData.data(), event + eventSize, fedSize);
+    }
   }
   assert(eventSize == 0);
 
@@ -926,14 +1017,14 @@ void FedRawDataInputSource::readSupervisor()
 
     //wait for at least one free thread and chunk
     int counter=0;
-    while ((workerPool_.empty() && !singleBufferMode_) || freeChunks_.empty() || readingFilesCount_>=maxBufferedFiles_)
+    while ((workerPool_.empty() && !singleBufferMode_ && !chunkReader_) || freeChunks_->empty() || readingFilesCount_>=maxBufferedFiles_)
     {
       //report state to monitoring
       if (fms_) {
         bool copy_active=false;
         for (auto j : tid_active_) if (j) copy_active=true;
         if (readingFilesCount_>=maxBufferedFiles_) fms_->setInStateSup(evf::FastMonitoringThread::inSupFileLimit);
-        else if (freeChunks_.empty()) {
+        else if (freeChunks_->empty()) {
           if (copy_active)
             fms_->setInStateSup(evf::FastMonitoringThread::inSupWaitFreeChunkCopying);
           else
@@ -954,7 +1045,7 @@ void FedRawDataInputSource::readSupervisor()
         LogDebug("FedRawDataInputSource") << "No free chunks or threads...";
       }
       else {
-        assert(!(workerPool_.empty() && !singleBufferMode_) || freeChunks_.empty());
+        assert(!(workerPool_.empty() && !singleBufferMode_ && !chunkReader_) || freeChunks_->empty());
       }
       if (quit_threads_.load(std::memory_order_relaxed) || edm::shutdown_flag.load(std::memory_order_relaxed)) {stop=true;break;}
     }
@@ -1094,7 +1185,7 @@ void FedRawDataInputSource::readSupervisor()
           }
 	  //get thread
 	  unsigned int newTid = 0xffffffff;
-	  while (!workerPool_.try_pop(newTid)) {
+	  while (!chunkReader_ && !workerPool_.try_pop(newTid)) {
 	    usleep(100000);
 	  }
 
@@ -1107,7 +1198,7 @@ void FedRawDataInputSource::readSupervisor()
               fms_->setInStateSup(evf::FastMonitoringThread::inSupNewFileWaitChunk);
           }
 	  InputChunk * newChunk = nullptr;
-	  while (!freeChunks_.try_pop(newChunk)) {
+	  while (!freeChunks_->try_pop(newChunk)) {
             usleep(100000);
             if (quit_threads_.load(std::memory_order_relaxed)) break;
 	  }
@@ -1120,10 +1211,16 @@ void FedRawDataInputSource::readSupervisor()
           }
           if (fms_) fms_->setInStateSup(evf::FastMonitoringThread::inSupNewFile);
 
-	  std::unique_lock<std::mutex> lk(mReader_);
-
 	  unsigned int toRead = eventChunkSize_;
 	  if (i==neededChunks-1 && fileSize%eventChunkSize_) toRead = fileSize%eventChunkSize_;
+
+	  if (chunkReader_) {
+	    newChunk->reset(i*eventChunkSize_,toRead,i);
+	    readChunkAsync(newInputFile,newChunk);
+	    continue;
+	  }
+
+	  std::unique_lock<std::mutex> lk(mReader_);
 	  newChunk->reset(i*eventChunkSize_,toRead,i);
 
 	  workerJob_[newTid].first=newInputFile;
@@ -1146,7 +1243,7 @@ void FedRawDataInputSource::readSupervisor()
 	//in single-buffer mode put single chunk in the file and let the main thread read the file
 	InputChunk * newChunk;
 	//should be available immediately
-	while(!freeChunks_.try_pop(newChunk)) usleep(100000);
+	while(!freeChunks_->try_pop(newChunk)) usleep(100000);
 
         std::unique_lock<std::mutex> lkw(mWakeup_);
 
@@ -1179,6 +1276,8 @@ void FedRawDataInputSource::readSupervisor()
     workerThreads_[i]->join();
     delete workerThreads_[i];
   }
+  //waits for the reads in flight
+  chunkReader_.reset();
 }
 
 void FedRawDataInputSource::readWorker(unsigned int tid)
@@ -1214,7 +1313,7 @@ void FedRawDataInputSource::readWorker(unsigned int tid)
     file = workerJob_[tid].first;
     chunk = workerJob_[tid].second;
 
-    int fileDescriptor = open(file->fileName_.c_str(), O_RDONLY);
+    int fileDescriptor = openInputFile(file->fileName_);
     off_t pos = lseek(fileDescriptor,chunk->offset_,SEEK_SET);
 
 
@@ -1248,12 +1347,71 @@ void FedRawDataInputSource::readWorker(unsigned int tid)
     LogDebug("FedRawDataInputSource") << " finished reading block -: " << (bufferLeft >> 20) << " MB" << " in " << msec.count() << " ms ("<< (bufferLeft >> 20)/double(msec.count())<<" GB/s)";
     close(fileDescriptor);
 
-    if (detectedFRDversion_==0 && chunk->offset_==0) detectedFRDversion_=*((uint32*)chunk->buf_);
-    assert(detectedFRDversion_<=5);
-    chunk->readComplete_=true;//this is atomic to secure the sequential buffer fill before becoming available for processing)
-    file->chunks_[chunk->fileIndex_]=chunk;//put the completed chunk in the file chunk vector at predetermined index
+    completeChunk(file,chunk,std::chrono::duration<double,std::micro>(diff).count());
+  }
+}
+
+void FedRawDataInputSource::readChunkAsync(InputFile *file, InputChunk *chunk)
+{
+  int fileDescriptor = openInputFile(file->fileName_);
+  if (fileDescriptor<0) {
+    edm::LogError("FedRawDataInputSource") <<
+    "readChunkAsync failed to open file -: " << file->fileName_ << " fd:" << fileDescriptor;
+    setExceptionState_=true;
+    return;
+  }
+
+  //whole blocks are asked as by the reader threads, the last block of the file comes short;
+  //the chunk reader continues any other short read, so fewer bytes means the file was truncated
+  const unsigned int blocks = (chunk->usedSize_+eventChunkBlock_-1)/eventChunkBlock_;
+  auto pending = std::make_shared<std::atomic<unsigned int>>(blocks);
+  auto bytesRead = std::make_shared<std::atomic<uint32_t>>(0);
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (unsigned int i=0;i<blocks;i++) {
+    chunkReader_->read(fileDescriptor, chunk->buf_+i*eventChunkBlock_, eventChunkBlock_, chunk->offset_+(off_t)i*eventChunkBlock_,
+      [=](ssize_t got) {
+        if (got>0) *bytesRead+=got;
+        else if (got<0)
+          edm::LogError("FedRawDataInputSource") << "readChunkAsync failed to read file -: " << file->fileName_
+                                                 << " at offset " << chunk->offset_+(off_t)i*eventChunkBlock_ << ": " << strerror(-got);
+        if (--*pending) return;
+
+        close(fileDescriptor);
+        if (*bytesRead!=chunk->usedSize_) {
+          edm::LogError("FedRawDataInputSource") << "readChunkAsync read " << *bytesRead << " bytes of file -: " << file->fileName_
+                                                 << " at offset " << chunk->offset_ << " instead of " << chunk->usedSize_;
+          setExceptionState_=true;
+          return;
+        }
+        auto diff = std::chrono::high_resolution_clock::now()-start;
+        LogDebug("FedRawDataInputSource") << " finished reading chunk -: " << (chunk->usedSize_ >> 20) << " MB in "
+                                          << std::chrono::duration_cast<std::chrono::milliseconds>(diff).count() << " ms";
+        completeChunk(file,chunk,std::chrono::duration<double,std::micro>(diff).count());
+      });
+  }
+}
+
+void FedRawDataInputSource::completeChunk(InputFile *file, InputChunk *chunk, double readTimeUs)
+{
+  if (fms_) fms_->reportChunkRead(file->lumi_,readTimeUs);
 
+  if (detectedFRDversion_==0 && chunk->offset_==0) detectedFRDversion_=*((uint32*)chunk->buf_);
+  assert(detectedFRDversion_<=5);
+  chunk->readComplete_=true;//this is atomic to secure the sequential buffer fill before becoming available for processing)
+  file->chunks_[chunk->fileIndex_]=chunk;//put the completed chunk in the file chunk vector at predetermined index
+}
+
+int FedRawDataInputSource::openInputFile(std::string const& name)
+{
+  if (directIO_) {
+    int fileDescriptor = open(name.c_str(), O_RDONLY | O_DIRECT);
+    if (fileDescriptor>=0 || errno!=EINVAL) return fileDescriptor;
+    //e.g. tmpfs, which holds the data in the page cache anyway
+    if (!directIOUnsupported_.exchange(true))
+      edm::LogWarning("FedRawDataInputSource") << "O_DIRECT is not supported for file -: " << name << ", reading through the page cache";
   }
+  return open(name.c_str(), O_RDONLY);
 }
 
 void FedRawDataInputSource::threadError()
@@ -1315,6 +1473,54 @@ inline void InputFile::rewindChunk(const size_t size) {
   bufferPosition_-=size;
 }
 
+inline void InputFile::nextChunk()
+{
+  while (!waitForChunk(currentChunk_+1)) {
+    usleep(100000);
+    if (parent_->exceptionState()) parent_->threadError();
+  }
+  currentChunk_++;
+  chunkPosition_=0;
+}
+
+//copy the data, moving to the next chunk if needed; returns true if it did
+inline bool InputFile::copyOut(unsigned char* into, size_t size)
+{
+  bool moved = false;
+  while (size) {
+    if (!leftInChunk()) {
+      nextChunk();
+      moved = true;
+    }
+    const size_t part = std::min(size, leftInChunk());
+    memcpy(into, chunks_[currentChunk_]->buf_ + chunkPosition_, part);
+    into+=part;
+    size-=part;
+    chunkPosition_+=part;
+    bufferPosition_+=part;
+  }
+  return moved;
+}
+
+std::shared_ptr<const void> FedRawDataInputSource::chunkOwner(InputChunk *chunk)
+{
+  chunk->users_++;
+  //the products may outlive the source, so only share its queue of free chunks
+  auto freeChunks = freeChunks_;
+  return std::shared_ptr<const void>(chunk->buf_, [freeChunks,chunk](const void*) {releaseChunk(*freeChunks,chunk);});
+}
+
+void FedRawDataInputSource::releaseChunk(InputChunk *chunk)
+{
+  releaseChunk(*freeChunks_,chunk);
+}
+
+void FedRawDataInputSource::releaseChunk(tbb::concurrent_queue<InputChunk*>& freeChunks, InputChunk *chunk)
+{
+  //the supervisor thread polls for free chunks
+  if (--chunk->users_ == 0) freeChunks.push(chunk);
+}
+
 //single-buffer mode file reading
 void FedRawDataInputSource::readNextChunkIntoBuffer(InputFile *file)
 {
@@ -0,0 +1,127 @@
+/** Reads a file in blocks through the backends of evf::ChunkReader, keeping
+    the given number of reads in flight, and checks the data read.  With
+    "direct" the file is opened with O_DIRECT, where the file system allows
+    it, and the page cache is dropped before each read.
+
+    Usage: testChunkReader [file size in MB] [reads in flight] [direct] [directory]
+*/
+
+#include "EventFilter/Utilities/interface/ChunkReader.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+  const size_t blockSize = 1024 * 1024;
+
+  uint64_t fileWord(size_t offset) { return offset * 2654435761u + 7; }
+
+  std::string writeFile(std::string const& dir, size_t size) {
+    std::string pattern = dir + "/chunkreader-XXXXXX";
+    std::vector<char> temp(pattern.c_str(), pattern.c_str() + pattern.size() + 1);
+    int fd = mkstemp(&temp[0]);
+    if (fd == -1)
+      throw cms::Exception("ChunkReaderTest") << "Cannot create a file in " << dir;
+    std::vector<uint64_t> block(blockSize / sizeof(uint64_t));
+    for (size_t offset = 0; offset < size; offset += blockSize) {
+      for (size_t i = 0; i < block.size(); ++i)
+        block[i] = fileWord(offset + i * sizeof(uint64_t));
+      size_t n = std::min(blockSize, size - offset);
+      if (write(fd, &block[0], n) != static_cast<ssize_t>(n))
+        throw cms::Exception("ChunkReaderTest") << "Cannot write " << &temp[0];
+    }
+    fsync(fd);
+    close(fd);
+    return std::string(&temp[0]);
+  }
+
+  // Reads the file in blocks, all of them submitted at once; the reader
+  // limits the reads in flight.  Returns the MB/s.
+  double readFile(evf::ChunkReader& reader, std::string const& path, size_t size, bool direct, bool& ok) {
+    int fd = -1;
+    if (direct)
+      fd = open(path.c_str(), O_RDONLY | O_DIRECT);
+    if (fd < 0)
+      fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw cms::Exception("ChunkReaderTest") << "Cannot open " << path;
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+
+    size_t blocks = (size + blockSize - 1) / blockSize;
+    void* buffer;
+    if (posix_memalign(&buffer, 4096, blocks * blockSize))
+      throw cms::Exception("ChunkReaderTest") << "Cannot allocate the buffer";
+    std::atomic<size_t> done(0), bytes(0);
+    std::atomic<bool> failed(false);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < blocks; ++i) {
+      reader.read(fd, static_cast<char*>(buffer) + i * blockSize, blockSize, i * blockSize, [&](ssize_t got) {
+        if (got < 0)
+          failed = true;
+        else
+          bytes += got;
+        ++done;
+      });
+    }
+    while (done < blocks)
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    close(fd);
+
+    if (failed || bytes != size)
+      ok = false;
+    const uint64_t* words = static_cast<const uint64_t*>(buffer);
+    for (size_t i = 0; i < size / sizeof(uint64_t); i += 509)
+      if (words[i] != fileWord(i * sizeof(uint64_t)))
+        ok = false;
+    free(buffer);
+    return size / seconds / (1024 * 1024);
+  }
+}
+
+int main(int argc, char** argv) try {
+  // not a multiple of the block size, the last read is short
+  size_t size = static_cast<size_t>(argc > 1 ? std::atoi(argv[1]) : 64) * 1024 * 1024 - 8 * 1024;
+  unsigned int depth = argc > 2 ? std::atoi(argv[2]) : 8;
+  bool direct = argc > 3 && std::string(argv[3]) == "direct";
+  std::string dir = argc > 4 ? argv[4] : (getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp");
+
+  std::string path = writeFile(dir, size);
+  bool ok = true;
+  for (char const* backend : {"pread", "auto"}) {
+    auto reader = evf::ChunkReader::make(backend, depth);
+    double rate = readFile(*reader, path, size, direct, ok);
+    std::cout << reader->backend() << ": " << depth << " reads in flight, " << std::fixed << std::setprecision(0)
+              << rate << " MB/s" << (direct ? " with O_DIRECT" : "") << std::endl;
+  }
+
+  bool thrown = false;
+  try {
+    evf::ChunkReader::make("aio", depth);
+  } catch (cms::Exception const&) {
+    thrown = true;
+  }
+  if (!thrown)
+    ok = false;
+
+  unlink(path.c_str());
+  if (!ok) {
+    std::cerr << "The data read differs from the data written" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+} catch (cms::Exception const& e) {
+  std::cerr << e.explainSelf() << std::endl;
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,223 @@
+/** Compares the filling of the FEDRawDataCollection of the events of a
+    FRD file by copying the FED data out of the input chunks, as
+    FedRawDataInputSource does by default, and by referring to the chunks
+    as with its zeroCopy option.
+
+    The file is read with read(2) in chunks of a pool, as the reader
+    threads of the source do; an event straddling two chunks is copied
+    once.  Every FED is then read through the const accessors, as the
+    unpackers do, and the checksums of both modes must agree.
+
+    Usage: FRDReadBenchmark [FRD v5 file | number of events to generate] [chunk size in MB]
+*/
+
+#include "DataFormats/FEDRawData/interface/FEDRawData.h"
+#include "DataFormats/FEDRawData/interface/FEDRawDataCollection.h"
+#include "DataFormats/FEDRawData/interface/FEDNumbering.h"
+#include "EventFilter/FEDInterface/interface/fed_header.h"
+#include "EventFilter/FEDInterface/interface/fed_trailer.h"
+#include "IOPool/Streamer/interface/FRDEventMessage.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+  typedef std::vector<unsigned char> Chunk;
+
+  std::string generate(unsigned int events) {
+    std::string dir = getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp";
+    std::string pattern = dir + "/frdbenchmark-XXXXXX";
+    std::vector<char> temp(pattern.c_str(), pattern.c_str() + pattern.size() + 1);
+    int fd = mkstemp(&temp[0]);
+    if (fd == -1)
+      throw cms::Exception("FRDReadBenchmark") << "Cannot create a file in " << dir;
+
+    std::mt19937 engine(12345);
+    std::lognormal_distribution<double> fedSize(7., 0.8);
+    std::vector<uint32_t> event;
+    for (unsigned int ev = 1; ev <= events; ++ev) {
+      event.assign(FRDHeaderVersionSize[5] / sizeof(uint32_t), 0);
+      for (unsigned int fedId = 0; fedId < 700; ++fedId) {
+        uint32_t words = std::max<uint32_t>(2, std::min(fedSize(engine), 64. * 1024) / 8);
+        size_t start = event.size();
+        event.resize(start + 2 * (words + 2));
+        event[start] = ev;
+        event[start + 1] = (FED_SLINK_START_MARKER << FED_HCTRLID_SHIFT) | (fedId << FED_SOID_SHIFT);
+        for (size_t i = start + 2; i < event.size() - 2; ++i)
+          event[i] = i * 2654435761u + ev;
+        event[event.size() - 2] = 0;
+        event[event.size() - 1] = (FED_SLINK_END_MARKER << FED_TCTRLID_SHIFT) | (words + 2);
+      }
+      event[0] = 5;
+      event[1] = 1;
+      event[2] = 1;
+      event[3] = ev;
+      event[4] = (event.size() * sizeof(uint32_t)) - FRDHeaderVersionSize[5];
+      if (write(fd, &event[0], event.size() * sizeof(uint32_t)) != static_cast<ssize_t>(event.size() * sizeof(uint32_t)))
+        throw cms::Exception("FRDReadBenchmark") << "Cannot write " << &temp[0];
+    }
+    close(fd);
+    return std::string(&temp[0]);
+  }
+
+  // Takes a chunk of the pool no event refers to any more.
+  std::shared_ptr<Chunk> freeChunk(std::vector<std::shared_ptr<Chunk>>& pool, size_t chunkSize) {
+    for (auto& chunk : pool)
+      if (chunk.use_count() == 1)
+        return chunk;
+    pool.push_back(std::make_shared<Chunk>(chunkSize));
+    return pool.back();
+  }
+
+  void fill(FEDRawDataCollection& rawData, unsigned char* payload, uint32_t eventSize, std::shared_ptr<const void> const& owner) {
+    while (eventSize > 0) {
+      eventSize -= sizeof(fedt_t);
+      const fedt_t* fedTrailer = (fedt_t*)(payload + eventSize);
+      const uint32_t fedSize = FED_EVSZ_EXTRACT(fedTrailer->eventsize) << 3;
+      eventSize -= (fedSize - sizeof(fedt_t));
+      const fedh_t* fedHeader = (fedh_t*)(payload + eventSize);
+      FEDRawData& fedData = rawData.FEDData(FED_SOID_EXTRACT(fedHeader->sourceid));
+      if (owner)
+        fedData.setExternal(payload + eventSize, fedSize, owner);
+      else {
+        fedData.resize(fedSize);
+        memcpy(fedData.data(), payload + eventSize, fedSize);
+      }
+    }
+  }
+
+  uint64_t unpack(FEDRawDataCollection const& rawData) {
+    uint64_t sum = 0;
+    for (int fedId = 0; fedId <= FEDNumbering::MAXFEDID; ++fedId) {
+      FEDRawData const& fedData = rawData.FEDData(fedId);
+      const uint64_t* words = (const uint64_t*)fedData.data();
+      for (size_t i = 0; i < fedData.size() / 8; ++i)
+        sum += words[i];
+    }
+    return sum;
+  }
+
+  struct Result {
+    double seconds;
+    size_t events;
+    size_t bytes;
+    size_t copied;
+    uint64_t checksum;
+  };
+
+  Result readFile(std::string const& path, size_t chunkSize, bool zeroCopy) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+      throw cms::Exception("FRDReadBenchmark") << "Cannot open " << path;
+
+    Result result = {0, 0, 0, 0, 0};
+    std::vector<std::shared_ptr<Chunk>> pool;
+    std::shared_ptr<Chunk> chunk = freeChunk(pool, chunkSize);
+    size_t filled = 0, position = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    // Reads the next chunk into a free one of the pool.
+    auto refill = [&]() {
+      auto next = freeChunk(pool, chunkSize);
+      ssize_t got = read(fd, next->data(), chunkSize);
+      if (got < 0)
+        throw cms::Exception("FRDReadBenchmark") << "Cannot read " << path;
+      return std::make_pair(next, static_cast<size_t>(got));
+    };
+
+    while (true) {
+      if (position == filled) {
+        auto next = refill();
+        chunk = next.first;
+        filled = next.second;
+        position = 0;
+        if (filled == 0)
+          break;
+      }
+
+      std::shared_ptr<const void> owner;
+      std::shared_ptr<Chunk> copy;
+      unsigned char* data = nullptr;
+      size_t headerSize = FRDHeaderVersionSize[5];
+      if (filled - position >= headerSize) {
+        FRDEventMsgView view(chunk->data() + position);
+        if (filled - position >= view.size()) {
+          data = chunk->data() + position;
+          position += view.size();
+          if (zeroCopy)
+            owner = chunk;
+        }
+      }
+      if (!data) {
+        // Straddling event: one private copy of it.
+        copy = std::make_shared<Chunk>(chunk->data() + position, chunk->data() + filled);
+        while (copy->size() < headerSize || copy->size() < FRDEventMsgView(copy->data()).size()) {
+          size_t need = copy->size() < headerSize ? headerSize : FRDEventMsgView(copy->data()).size();
+          auto next = refill();
+          chunk = next.first;
+          filled = next.second;
+          if (filled == 0)
+            throw cms::Exception("FRDReadBenchmark") << "Premature end of " << path;
+          position = std::min(need - copy->size(), filled);
+          copy->insert(copy->end(), chunk->data(), chunk->data() + position);
+        }
+        result.copied += copy->size();
+        data = copy->data();
+        if (zeroCopy)
+          owner = copy;
+      }
+
+      FRDEventMsgView view(data);
+      FEDRawDataCollection rawData;
+      fill(rawData, (unsigned char*)view.payload(), view.eventSize(), owner);
+      result.checksum += unpack(rawData);
+      result.bytes += view.size();
+      ++result.events;
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    close(fd);
+    return result;
+  }
+}
+
+int main(int argc, char** argv) try {
+  std::string arg = argc > 1 ? argv[1] : "2000";
+  size_t chunkSize = static_cast<size_t>(argc > 2 ? std::atoi(argv[2]) : 32) * 1024 * 1024;
+  bool generated = !arg.empty() && arg.find_first_not_of("0123456789") == std::string::npos;
+  std::string path = generated ? generate(std::atoi(arg.c_str())) : arg;
+
+  // Warm the page cache, so that both modes read from memory.
+  readFile(path, chunkSize, false);
+
+  Result results[2];
+  for (bool zeroCopy : {false, true}) {
+    Result& result = results[zeroCopy];
+    result = readFile(path, chunkSize, zeroCopy);
+    std::cout << (zeroCopy ? "zero copy: " : "copy:      ") << result.events << " events, " << std::fixed
+              << std::setprecision(0) << result.events / result.seconds << " events/s, "
+              << result.bytes / result.seconds / (1024 * 1024) << " MB/s, " << result.copied / (1024 * 1024)
+              << " MB of straddling events copied" << std::endl;
+  }
+
+  if (generated)
+    unlink(path.c_str());
+  if (results[0].checksum != results[1].checksum || results[0].events != results[1].events) {
+    std::cerr << "The FED data differs between the two modes" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+} catch (cms::Exception const& e) {
+  std::cerr << e.explainSelf() << std::endl;
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,74 @@
+#ifndef FWCore_Concurrency_WaitingTaskWithArenaHolder_h
+#define FWCore_Concurrency_WaitingTaskWithArenaHolder_h
+// -*- C++ -*-
+//
+// Package:     FWCore/Concurrency
+// Class  :     WaitingTaskWithArenaHolder
+//
+/**\class edm::WaitingTaskWithArenaHolder
+
+ Description: Holds a WaitingTask and the tbb::task_arena it was created in
+
+ Usage:
+    Behaves like a WaitingTaskHolder except that doneWaiting may be called
+ from a thread which is not part of the TBB thread pool (e.g. a thread
+ belonging to an external library). Once the last holder signals, the task
+ is spawned inside the original arena so it runs on one of the framework's
+ threads.
+*/
+//
+// Original Author:  FWCore
+//         Created:  Mon, 09 Oct 2017 15:12:23 GMT
+//
+
+// system include files
+#include <exception>
+#include <memory>
+
+// user include files
+
+// forward declarations
+namespace tbb {
+  class task_arena;
+}
+
+namespace edm {
+
+  class WaitingTask;
+
+  class WaitingTaskWithArenaHolder {
+  public:
+
+    WaitingTaskWithArenaHolder();
+
+    // Note that the arena will be the one containing the thread
+    // that runs this constructor. This is the arena where you
+    // eventually intend for the task to be spawned.
+    explicit WaitingTaskWithArenaHolder(WaitingTask* iTask);
+
+    ~WaitingTaskWithArenaHolder();
+
+    WaitingTaskWithArenaHolder(WaitingTaskWithArenaHolder const& iHolder);
+
+    WaitingTaskWithArenaHolder(WaitingTaskWithArenaHolder&& iOther);
+
+    WaitingTaskWithArenaHolder& operator=(WaitingTaskWithArenaHolder const& iRHS);
+
+    WaitingTaskWithArenaHolder& operator=(WaitingTaskWithArenaHolder&& iRHS);
+
+    // ---------- member functions ---------------------------
+
+    // This spawns the task. The arena is needed to get the task spawned
+    // into the correct arena of threads. Use of the arena allows doneWaiting
+    // to be called from a thread outside the arena of threads that will manage
+    // the task. doneWaiting can be called from a non-TBB thread.
+    void doneWaiting(std::exception_ptr iExcept);
+
+  private:
+    // ---------- member data --------------------------------
+    WaitingTask* m_task;
+    std::shared_ptr<tbb::task_arena> m_arena;
+  };
+}
+
+#endif
@@ -0,0 +1,90 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/Concurrency
+// Class  :     WaitingTaskWithArenaHolder
+//
+// Implementation:
+//     [Notes on implementation]
+//
+// Original Author:  FWCore
+//         Created:  Mon, 09 Oct 2017 15:12:23 GMT
+//
+
+// system include files
+#include <utility>
+
+// user include files
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
+#include "FWCore/Concurrency/interface/WaitingTask.h"
+#include "tbb/task_arena.h"
+
+namespace edm {
+
+  WaitingTaskWithArenaHolder::WaitingTaskWithArenaHolder() :
+    m_task(nullptr) {
+  }
+
+  WaitingTaskWithArenaHolder::WaitingTaskWithArenaHolder(WaitingTask* iTask) :
+    m_task(iTask),
+    m_arena(std::make_shared<tbb::task_arena>(tbb::task_arena::attach())) {
+    m_task->increment_ref_count();
+  }
+
+  WaitingTaskWithArenaHolder::~WaitingTaskWithArenaHolder() {
+    if(m_task) {
+      doneWaiting(std::exception_ptr{});
+    }
+  }
+
+  WaitingTaskWithArenaHolder::WaitingTaskWithArenaHolder(WaitingTaskWithArenaHolder const& iHolder) :
+    m_task(iHolder.m_task),
+    m_arena(iHolder.m_arena) {
+    if(m_task) {
+      m_task->increment_ref_count();
+    }
+  }
+
+  WaitingTaskWithArenaHolder::WaitingTaskWithArenaHolder(WaitingTaskWithArenaHolder&& iOther) :
+    m_task(iOther.m_task),
+    m_arena(std::move(iOther.m_arena)) {
+    iOther.m_task = nullptr;
+  }
+
+  WaitingTaskWithArenaHolder&
+  WaitingTaskWithArenaHolder::operator=(WaitingTaskWithArenaHolder const& iRHS) {
+    WaitingTaskWithArenaHolder tmp(iRHS);
+    std::swap(m_task, tmp.m_task);
+    std::swap(m_arena, tmp.m_arena);
+    return *this;
+  }
+
+  WaitingTaskWithArenaHolder&
+  WaitingTaskWithArenaHolder::operator=(WaitingTaskWithArenaHolder&& iRHS) {
+    WaitingTaskWithArenaHolder tmp(std::move(iRHS));
+    std::swap(m_task, tmp.m_task);
+    std::swap(m_arena, tmp.m_arena);
+    return *this;
+  }
+
+  // This spawns the task. The arena is needed to get the task spawned
+  // into the correct arena of threads. Use of the arena allows doneWaiting
+  // to be called from a thread outside the arena of threads that will manage
+  // the task. doneWaiting can be called from a non-TBB thread.
+  void
+  WaitingTaskWithArenaHolder::doneWaiting(std::exception_ptr iExcept) {
+    if(iExcept) {
+      m_task->dependentTaskFailed(iExcept);
+    }
+    //enqueue can run the task before we finish
+    // doneWaiting and some other thread might
+    // try to reuse this object. Resetting
+    // before enqueue avoids problems
+    auto task = m_task;
+    m_task = nullptr;
+    if(0 == task->decrement_ref_count()) {
+      // The enqueue call will cause a worker thread to be created in
+      // the arena if there is not one already.
+      m_arena->enqueue([task = task]() { tbb::task::spawn(*task); });
+    }
+  }
+}
@@ -0,0 +1,135 @@
+//
+//  waitingtaskwitharenaholder_t.cppunit.cpp
+//
+//  Checks that a WaitingTaskWithArenaHolder can be signalled from a
+//  thread which is not part of the TBB thread pool.
+//
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include "tbb/task.h"
+#include "FWCore/Concurrency/interface/WaitingTaskList.h"
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
+
+class WaitingTaskWithArenaHolder_test : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(WaitingTaskWithArenaHolder_test);
+  CPPUNIT_TEST(doneFromTBBThread);
+  CPPUNIT_TEST(doneFromExternalThread);
+  CPPUNIT_TEST(doneFromExternalThreadFailed);
+  CPPUNIT_TEST(copiesAndMoves);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void doneFromTBBThread();
+  void doneFromExternalThread();
+  void doneFromExternalThreadFailed();
+  void copiesAndMoves();
+  void setUp(){}
+  void tearDown(){}
+};
+
+namespace {
+  class TestCalledTask : public edm::WaitingTask {
+  public:
+    TestCalledTask(std::atomic<bool>& iCalled, std::exception_ptr& iPtr): m_called(iCalled), m_ptr(iPtr) {}
+
+    tbb::task* execute() override {
+      if(exceptionPtr()) {
+        m_ptr = *exceptionPtr();
+      }
+      m_called = true;
+      return nullptr;
+    }
+
+  private:
+    std::atomic<bool>& m_called;
+    std::exception_ptr& m_ptr;
+  };
+}
+
+void WaitingTaskWithArenaHolder_test::doneFromTBBThread()
+{
+  std::atomic<bool> called{false};
+  std::exception_ptr excPtr;
+
+  auto waitTask = edm::make_empty_waiting_task();
+  waitTask->set_ref_count(2);
+  //NOTE: allocate_child does NOT increment the ref_count of waitTask!
+  auto t = new (waitTask->allocate_child()) TestCalledTask{called,excPtr};
+  {
+    edm::WaitingTaskWithArenaHolder holder(t);
+    CPPUNIT_ASSERT(false==called);
+    holder.doneWaiting(std::exception_ptr{});
+  }
+  waitTask->wait_for_all();
+  CPPUNIT_ASSERT(true==called);
+  CPPUNIT_ASSERT( bool(excPtr) == false);
+}
+
+void WaitingTaskWithArenaHolder_test::doneFromExternalThread()
+{
+  std::atomic<bool> called{false};
+  std::exception_ptr excPtr;
+
+  auto waitTask = edm::make_empty_waiting_task();
+  waitTask->set_ref_count(2);
+  auto t = new (waitTask->allocate_child()) TestCalledTask{called,excPtr};
+  {
+    edm::WaitingTaskWithArenaHolder holder(t);
+    std::thread external([holder]() mutable {
+      holder.doneWaiting(std::exception_ptr{});
+    });
+    external.join();
+  }
+  waitTask->wait_for_all();
+  CPPUNIT_ASSERT(true==called);
+  CPPUNIT_ASSERT( bool(excPtr) == false);
+}
+
+void WaitingTaskWithArenaHolder_test::doneFromExternalThreadFailed()
+{
+  std::atomic<bool> called{false};
+  std::exception_ptr excPtr;
+
+  auto waitTask = edm::make_empty_waiting_task();
+  waitTask->set_ref_count(2);
+  auto t = new (waitTask->allocate_child()) TestCalledTask{called,excPtr};
+  {
+    edm::WaitingTaskWithArenaHolder holder(t);
+    std::thread external([holder]() mutable {
+      holder.doneWaiting(std::make_exception_ptr(std::runtime_error("failed")));
+    });
+    external.join();
+  }
+  waitTask->wait_for_all();
+  CPPUNIT_ASSERT(true==called);
+  CPPUNIT_ASSERT( bool(excPtr) == true);
+}
+
+void WaitingTaskWithArenaHolder_test::copiesAndMoves()
+{
+  std::atomic<bool> called{false};
+  std::exception_ptr excPtr;
+
+  auto waitTask = edm::make_empty_waiting_task();
+  waitTask->set_ref_count(2);
+  auto t = new (waitTask->allocate_child()) TestCalledTask{called,excPtr};
+  {
+    edm::WaitingTaskWithArenaHolder holder(t);
+    edm::WaitingTaskWithArenaHolder copy(holder);
+    edm::WaitingTaskWithArenaHolder moved(std::move(holder));
+    copy.doneWaiting(std::exception_ptr{});
+    CPPUNIT_ASSERT(false==called);
+    edm::WaitingTaskWithArenaHolder assigned;
+    assigned = std::move(moved);
+    CPPUNIT_ASSERT(false==called);
+  }
+  waitTask->wait_for_all();
+  CPPUNIT_ASSERT(true==called);
+  CPPUNIT_ASSERT( bool(excPtr) == false);
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION( WaitingTaskWithArenaHolder_test );
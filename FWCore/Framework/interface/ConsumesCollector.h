@@ -91,6 +91,11 @@ namespace edm {
     void consumesMany(const TypeToGet& id) {
       m_consumer->consumesMany<B>(id);
     }
+
+    template <typename ESProduct, typename ESRecord>
+    ESGetToken<ESProduct,ESRecord> esConsumes(std::string const& iLabel = std::string()) {
+      return m_consumer->esConsumes<ESProduct,ESRecord>(iLabel);
+    }
     
 
   private:
@@ -21,6 +21,7 @@
 
 // system include files
 #include <atomic>
+#include <mutex>
 
 // user include files
 
@@ -60,6 +61,23 @@ namespace edm {
          void setProviderDescription(ComponentDescription const* iDesc) {
             description_ = iDesc;
          }
+
+         /**Sets the mutex held while getImpl is called. All proxies of a DataProxyProvider
+          share the same mutex so the provider is never called concurrently, while
+          proxies from different providers can be filled on different threads.
+          The mutex stays held while getImpl gets data from the proxy of another provider.
+          Providers getting data from one another must declare it with esConsumes so they
+          are given one common mutex, an undeclared cycle is reported by an exception.
+          */
+         void setProviderMutex(std::recursive_mutex* iMutex) {
+            mutex_ = iMutex;
+         }
+
+         ///forgets the order in which iMutex was locked with other mutexes, called before iMutex is destroyed
+         static void forgetProviderMutex(std::recursive_mutex const* iMutex);
+
+         ///mutex used by proxies which are not associated to a provider specific mutex
+         static std::recursive_mutex& globalMutex();
       protected:
          /**This is the function which does the real work of getting the data if it is not
           already cached.  The returning 'void const*' must point to an instance of the class
@@ -88,10 +106,11 @@ namespace edm {
          DataProxy const& operator=(DataProxy const&) = delete; // stop default
 
          // ---------- member data --------------------------------
-         [[cms::thread_safe]] mutable void const* cache_; //protected by a global mutex
+         [[cms::thread_safe]] mutable void const* cache_; //protected by mutex_
          mutable std::atomic<bool> cacheIsValid_;
          mutable std::atomic<bool> nonTransientAccessRequested_;
          ComponentDescription const* description_;
+         std::recursive_mutex* mutex_;
       };
    }
 }
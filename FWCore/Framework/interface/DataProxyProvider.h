@@ -22,6 +22,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -29,6 +30,7 @@
 #include "FWCore/Framework/interface/EventSetupRecordKey.h"
 #include "FWCore/Framework/interface/DataKey.h"
 #include "FWCore/Framework/interface/ComponentDescription.h"
+#include "FWCore/Utilities/interface/ESGetToken.h"
 #include "FWCore/Utilities/interface/propagate_const.h"
 
 // forward declarations
@@ -47,6 +49,7 @@ class DataProxyProvider
       typedef std::vector< EventSetupRecordKey> Keys;
       typedef std::vector<std::pair<DataKey, edm::propagate_const<std::shared_ptr<DataProxy>>>> KeyedProxies;
       typedef std::map<EventSetupRecordKey, KeyedProxies> RecordProxies;
+      typedef std::vector<std::pair<EventSetupRecordKey, DataKey>> ESItems;
       
       DataProxyProvider();
       virtual ~DataProxyProvider() noexcept(false);
@@ -59,6 +62,12 @@ class DataProxyProvider
       const KeyedProxies& keyedProxies(const EventSetupRecordKey& iRecordKey) const ;
       
       const ComponentDescription& description() const { return description_;}
+
+      ///the data of other providers gotten by the proxies, as declared by calls to esConsumes
+      const ESItems& esItemsToGet() const { return esItemsToGet_; }
+
+      ///true if the proxies are serialized with all the providers using the global mutex
+      bool usesGlobalMutex() const;
       // ---------- static member functions --------------------
       /**Used to add parameters available to all inheriting classes
       */
@@ -82,6 +91,12 @@ class DataProxyProvider
       void resetProxies(const EventSetupRecordKey& iRecordType);
       void resetProxiesIfTransient(const EventSetupRecordKey& iRecordType);
 
+      /**This method is only to be called by the framework. The proxies of providers which
+       get data from one another are serialized with a mutex common to them instead of their
+       own one. A null pointer stands for the global mutex.
+       */
+      void shareMutex(std::shared_ptr<std::recursive_mutex> iMutex);
+
    protected:
       template< class T>
       void usingRecord() {
@@ -90,6 +105,22 @@ class DataProxyProvider
       
       void usingRecordWithKey(const EventSetupRecordKey&);
 
+      /**Call from the constructor if the provider uses a resource which is shared with
+       other providers and is not thread safe. All such providers are then serialized
+       with one another instead of only with themselves.
+       */
+      void usingGlobalMutex();
+
+      /**Call from the constructor for each data of another provider gotten by the proxies
+       of this provider while they produce their own data.
+       */
+      template<typename T, typename R>
+      ESGetToken<T,R> esConsumes(const std::string& iLabel = std::string()) {
+         esItemsToGet_.emplace_back(EventSetupRecordKey::makeKey<R>(),
+                                    DataKey(DataKey::makeTypeTag<T>(), iLabel.c_str()));
+         return ESGetToken<T,R>(iLabel);
+      }
+
       void invalidateProxies(const EventSetupRecordKey& iRecordKey) ;
 
       virtual void registerProxies(const EventSetupRecordKey& iRecordKey ,
@@ -107,6 +138,11 @@ class DataProxyProvider
       RecordProxies recordProxies_;
       ComponentDescription description_;
       std::string appendToDataLabel_;
+      ESItems esItemsToGet_;
+      //serializes the calls to the proxies of this provider
+      std::recursive_mutex ownMutex_;
+      std::shared_ptr<std::recursive_mutex> sharedMutex_;
+      std::recursive_mutex* mutex_;
 };
 
 template<class ProxyT>
@@ -23,13 +23,17 @@
 #include <string>
 #include <vector>
 #include <array>
+#include <utility>
 // user include files
+#include "FWCore/Framework/interface/DataKey.h"
+#include "FWCore/Framework/interface/EventSetupRecordKey.h"
 #include "FWCore/Framework/interface/ProductResolverIndexAndSkipBit.h"
 #include "FWCore/ServiceRegistry/interface/ConsumesInfo.h"
 #include "FWCore/Utilities/interface/TypeID.h"
 #include "FWCore/Utilities/interface/TypeToGet.h"
 #include "FWCore/Utilities/interface/InputTag.h"
 #include "FWCore/Utilities/interface/EDGetToken.h"
+#include "FWCore/Utilities/interface/ESGetToken.h"
 #include "FWCore/Utilities/interface/SoATuple.h"
 #include "DataFormats/Provenance/interface/BranchType.h"
 #include "FWCore/Utilities/interface/ProductResolverIndex.h"
@@ -69,6 +73,10 @@ namespace edm {
 
     std::vector<ProductResolverIndexAndSkipBit> const& itemsToGetFrom(BranchType iType) const { return itemsToGetFromBranch_[iType]; }
 
+    typedef std::vector<std::pair<eventsetup::EventSetupRecordKey, eventsetup::DataKey>> ESItems;
+    ///the EventSetup data declared by calls to esConsumes, prefetched before the module is run
+    ESItems const& esItemsToGet() const { return esItemsToGet_; }
+
     ///\return true if the product corresponding to the index was registered via consumes or mayConsume call
     bool registeredToConsume(ProductResolverIndex, bool, BranchType) const;
     
@@ -145,6 +153,13 @@ namespace edm {
       recordConsumes(B,id,edm::InputTag{},true);
     }
 
+    template <typename ESProduct, typename ESRecord>
+    ESGetToken<ESProduct,ESRecord> esConsumes(std::string const& iLabel = std::string()) {
+      esItemsToGet_.emplace_back(eventsetup::EventSetupRecordKey::makeKey<ESRecord>(),
+                                 eventsetup::DataKey(eventsetup::DataKey::makeTypeTag<ESProduct>(), iLabel.c_str()));
+      return ESGetToken<ESProduct,ESRecord>{iLabel};
+    }
+
   private:
     unsigned int recordConsumes(BranchType iBranch, TypeToGet const& iType, edm::InputTag const& iTag, bool iAlwaysGets);
 
@@ -189,6 +204,8 @@ namespace edm {
 
     std::array<std::vector<ProductResolverIndexAndSkipBit>, edm::NumBranchTypes> itemsToGetFromBranch_;
 
+    ESItems esItemsToGet_;
+
     bool frozen_;
     bool containsCurrentProcessAlias_;
   };
@@ -20,6 +20,8 @@ configured in the user's main() function, and is set running.
 #include "FWCore/Framework/src/SignallingProductRegistry.h"
 #include "FWCore/Framework/src/PreallocationConfiguration.h"
 
+#include "FWCore/Concurrency/interface/WaitingTaskList.h"
+
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 
 #include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
@@ -45,6 +47,7 @@ namespace edm {
   class EDLooperBase;
   class HistoryAppender;
   class ProcessDesc;
+  class StreamAutoTuner;
   class SubProcess;
   class WaitingTaskHolder;
   class WaitingTask;
@@ -258,6 +261,13 @@ namespace edm {
     
     void processEventWithLooper(EventPrincipal&);
 
+    //Starts writing the luminosity block in the OutputModules without
+    // waiting for them to finish
+    void writeLumiAsync(std::shared_ptr<LuminosityBlockPrincipal> iLumiPrincipal);
+    //Waits for the writes started by writeLumiAsync and rethrows
+    // any exception they produced
+    void waitForLumisBeingWritten();
+
     std::shared_ptr<ProductRegistry const> preg() const {return get_underlying_safe(preg_);}
     std::shared_ptr<ProductRegistry>& preg() {return get_underlying_safe(preg_);}
     std::shared_ptr<BranchIDListHelper const> branchIDListHelper() const {return get_underlying_safe(branchIDListHelper_);}
@@ -299,6 +309,8 @@ namespace edm {
     SharedResourcesAcquirer                       sourceResourcesAcquirer_;
     std::shared_ptr<std::recursive_mutex>         sourceMutex_;
     PrincipalCache                                principalCache_;
+    std::unique_ptr<EmptyWaitingTask, waitingtask::TaskDestroyer> lumiWritesWaitTask_;
+    std::vector<std::shared_ptr<LuminosityBlockPrincipal>> lumisBeingWritten_;
     bool                                          beginJobCalled_;
     bool                                          shouldWeStop_;
     bool                                          fileModeNoMerge_;
@@ -310,6 +322,7 @@ namespace edm {
     bool                                          forceESCacheClearOnNewRun_;
     
     PreallocationConfiguration                    preallocations_;
+    edm::propagate_const<std::unique_ptr<StreamAutoTuner>> streamAutoTuner_;
     
     bool                                          asyncStopRequestedWhileProcessingEvents_;
     InputSource::ItemType                         nextItemTypeFromProcessingEvents_;
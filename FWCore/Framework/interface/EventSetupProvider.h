@@ -123,6 +123,8 @@ class EventSetupProvider {
 
       void insert(EventSetupRecordKey const&, std::unique_ptr<EventSetupRecordProvider>);
 
+      void shareMutexesOfDependentProviders();
+
       // ---------- member data --------------------------------
       EventSetup eventSetup_;
       typedef std::map<EventSetupRecordKey, std::shared_ptr<EventSetupRecordProvider> > Providers;
@@ -53,12 +53,14 @@ using the 'setEventSetup' and 'clearEventSetup' functions.
 #include "FWCore/Framework/interface/DataKey.h"
 #include "FWCore/Framework/interface/NoProxyException.h"
 #include "FWCore/Framework/interface/ValidityInterval.h"
+#include "FWCore/Utilities/interface/ESGetToken.h"
 #include "FWCore/Utilities/interface/ESInputTag.h"
 
 // system include files
 #include <exception>
 #include <map>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <atomic>
@@ -145,6 +147,14 @@ namespace edm {
             }
          }
 
+         ///gets the data declared by the call to esConsumes which returned iToken
+         template<typename ProductT, typename RecordT, typename HolderT>
+         void get(ESGetToken<ProductT, RecordT> const& iToken, HolderT& iHolder) const {
+            static_assert(std::is_same<ProductT, typename HolderT::value_type>::value,
+                          "the type of the handle must be the type declared by esConsumes");
+            get(iToken.label(), iHolder);
+         }
+
          ///returns false if no data available for key
          bool doGet(DataKey const& aKey, bool aGetTransiently = false) const;
 
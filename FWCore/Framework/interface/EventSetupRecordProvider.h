@@ -69,6 +69,9 @@ class EventSetupRecordProvider {
       ///returns the first matching DataProxyProvider or a 'null' if not found
       std::shared_ptr<DataProxyProvider> proxyProvider(ParameterSetIDHolder const&);
 
+      ///returns the DataProxyProvider whose proxy was added to the Record for the key or a 'null' if not found
+      std::shared_ptr<DataProxyProvider> proxyProvider(DataKey const&);
+
 
       // ---------- static member functions --------------------
 
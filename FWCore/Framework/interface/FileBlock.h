@@ -52,7 +52,8 @@ namespace edm {
       // For given input and output files
       OutputMaxEventsTooSmall = (EventSelectionUsed << 1),
       SplitLevelMismatch = (OutputMaxEventsTooSmall << 1),
-      BranchMismatch = (SplitLevelMismatch << 1)
+      BranchMismatch = (SplitLevelMismatch << 1),
+      CompressionMismatch = (BranchMismatch << 1)
     };
 
     FileBlock() :
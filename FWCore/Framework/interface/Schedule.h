@@ -25,6 +25,19 @@
   wantSummary indicates whether or not the pass/fail/error stats
   for modules and paths should be printed at the end-of-job.
 
+  If the untracked bool concurrentModuleConstruction is true, the
+  global and stream modules are constructed and their beginJob called
+  in parallel. Their construction signals and product registrations
+  still happen one module at a time in the usual order. Services
+  watching the module beginJob signals must then be thread safe.
+
+  If the untracked bool deleteEarlyFromConsumes is true, each event
+  product made by a module of this process is deleted as soon as all
+  the modules which declared they consume it have run (or can no
+  longer run for this event), as if it were listed in canDeleteEarly.
+  Products kept by an OutputModule or aliased are never deleted early.
+  A module getting a product without declaring it gets an exception.
+
   A TriggerResults object will always be inserted into the event
   for any schedule.  The producer of the TriggerResults EDProduct
   is always the first module in the endpath.  The TriggerResultInserter
@@ -163,6 +176,10 @@ namespace edm {
     // Write the luminosity block
     void writeLumi(LuminosityBlockPrincipal const& lbp, ProcessContext const*);
 
+    // Write the luminosity block with all OutputModules running concurrently.
+    // iTask is signalled once every OutputModule has finished.
+    void writeLumiAsync(WaitingTaskHolder iTask, LuminosityBlockPrincipal const& lbp, ProcessContext const*);
+
     // Write the run
     void writeRun(RunPrincipal const& rp, ProcessContext const*);
 
@@ -293,6 +310,7 @@ namespace edm {
     std::vector<std::string> const* pathNames_;
     std::vector<std::string> const* endPathNames_;
     bool wantSummary_;
+    bool concurrentModuleConstruction_;
 
     volatile bool           endpathsAreActive_;
   };
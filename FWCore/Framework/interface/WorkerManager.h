@@ -65,7 +65,9 @@ namespace edm {
     
     void setupOnDemandSystem(Principal& principal, EventSetup const& es);
 
-    void beginJob(ProductRegistry const& iRegistry);
+    ///If iConcurrently is true, beginJob of the modules which are not serialized
+    /// is called concurrently once all the serialized ones are done
+    void beginJob(ProductRegistry const& iRegistry, bool iConcurrently = false);
     void endJob();
     void endJob(ExceptionCollector& collector);
 
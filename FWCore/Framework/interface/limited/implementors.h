@@ -121,20 +121,23 @@ namespace edm {
         LuminosityBlockCacheHolder<T,C>& operator=(LuminosityBlockCacheHolder<T,C> const&) = delete;
         ~LuminosityBlockCacheHolder() noexcept(false) {};
       protected:
-        C const* luminosityBlockCache(edm::LuminosityBlockIndex iID) const { return cache_.get(); }
+        C const* luminosityBlockCache(edm::LuminosityBlockIndex iID) const { return caches_[iID].get(); }
       private:
-        void doBeginLuminosityBlock_(LuminosityBlock const& rp, EventSetup const& c) final {
-          cache_ = globalBeginLuminosityBlock(rp,c);
+        void preallocLumis(unsigned int iNLumis) final {
+          caches_.reset( new std::shared_ptr<C>[iNLumis]);
         }
-        void doEndLuminosityBlock_(LuminosityBlock const& rp, EventSetup const& c) final {
-          globalEndLuminosityBlock(rp,c);
-          cache_.reset();
+        void doBeginLuminosityBlock_(LuminosityBlock const& lp, EventSetup const& c) final {
+          caches_[lp.index()] = globalBeginLuminosityBlock(lp,c);
+        }
+        void doEndLuminosityBlock_(LuminosityBlock const& lp, EventSetup const& c) final {
+          globalEndLuminosityBlock(lp,c);
+          caches_[lp.index()].reset();
         }
         
         virtual std::shared_ptr<C> globalBeginLuminosityBlock(edm::LuminosityBlock const&, edm::EventSetup const&) const = 0;
         virtual void globalEndLuminosityBlock(edm::LuminosityBlock const&, edm::EventSetup const&) const = 0;
-        //When threaded we will have a container for N items whre N is # of simultaneous runs
-        std::shared_ptr<C> cache_;
+        //One entry per simultaneous LuminosityBlock, indexed by LuminosityBlockIndex
+        std::unique_ptr<std::shared_ptr<C>[]> caches_;
       };
       
       template<typename T, typename C> class EndRunSummaryProducer;
@@ -183,17 +186,21 @@ namespace edm {
       private:
         friend class EndLuminosityBlockSummaryProducer<T,C>;
         
+        void preallocLumisSummary(unsigned int iNLumis) final {
+          caches_.reset( new std::shared_ptr<C>[iNLumis]);
+        }
+
         void doBeginLuminosityBlockSummary_(edm::LuminosityBlock const& lb, EventSetup const& c) final {
-          cache_ = globalBeginLuminosityBlockSummary(lb,c);
+          caches_[lb.index()] = globalBeginLuminosityBlockSummary(lb,c);
         }
 
         void doStreamEndLuminosityBlockSummary_(StreamID id, LuminosityBlock const& lb, EventSetup const& c) final
         {
           std::lock_guard<std::mutex> guard(mutex_);
-          streamEndLuminosityBlockSummary(id,lb,c,cache_.get());
+          streamEndLuminosityBlockSummary(id,lb,c,caches_[lb.index()].get());
         }
         void doEndLuminosityBlockSummary_(LuminosityBlock const& lb, EventSetup const& c) final {
-          globalEndLuminosityBlockSummary(lb,c,cache_.get());
+          globalEndLuminosityBlockSummary(lb,c,caches_[lb.index()].get());
         }
 
         virtual std::shared_ptr<C> globalBeginLuminosityBlockSummary(edm::LuminosityBlock const&, edm::EventSetup const&) const = 0;
@@ -201,8 +208,8 @@ namespace edm {
         
         virtual void globalEndLuminosityBlockSummary(edm::LuminosityBlock const&, edm::EventSetup const&, C*) const = 0;
         
-        //When threaded we will have a container for N items where N is # of simultaneous Lumis
-        std::shared_ptr<C> cache_;
+        //One entry per simultaneous LuminosityBlock, indexed by LuminosityBlockIndex
+        std::unique_ptr<std::shared_ptr<C>[]> caches_;
         std::mutex mutex_;
       };
 
@@ -289,7 +296,7 @@ namespace edm {
         
       private:
         void doEndLuminosityBlockProduce_(LuminosityBlock& lb, EventSetup const& c) final {
-          globalEndLuminosityBlockProduce(lb,c,LuminosityBlockSummaryCacheHolder<T,S>::cache_.get());
+          globalEndLuminosityBlockProduce(lb,c,LuminosityBlockSummaryCacheHolder<T,S>::caches_[lb.index()].get());
         }
         
         virtual void globalEndLuminosityBlockProduce(edm::LuminosityBlock&, edm::EventSetup const&, S const*) const = 0;
@@ -41,7 +41,8 @@ namespace edm {
       kOneSharedResources,
       kOneWatchRuns,
       kOneWatchLuminosityBlocks,
-      kWatchInputFiles
+      kWatchInputFiles,
+      kExternalWork
     };
     
     namespace AbilityBits {
@@ -57,7 +58,8 @@ namespace edm {
         kOneSharedResources=256,
         kOneWatchRuns=512,
         kOneWatchLuminosityBlocks=1024,
-        kWatchInputFiles=2048
+        kWatchInputFiles=2048,
+        kExternalWork=4096
       };
     }
     
@@ -76,6 +76,11 @@ namespace edm {
       struct HasAbility<edm::EndLuminosityBlockProducer, U...> :public HasAbility<U...> {
         static constexpr bool kEndLuminosityBlockProducer = true;
       };
+
+      template<typename... U>
+      struct HasAbility<edm::ExternalWork, U...> :public HasAbility<U...> {
+        static constexpr bool kExternalWork = true;
+      };
       
       template<>
       struct HasAbility<LastCheck> {
@@ -88,6 +93,7 @@ namespace edm {
         static constexpr bool kEndRunProducer = false;
         static constexpr bool kBeginLuminosityBlockProducer = false;
         static constexpr bool kEndLuminosityBlockProducer = false;
+        static constexpr bool kExternalWork = false;
       };
     }
     template<typename... T>
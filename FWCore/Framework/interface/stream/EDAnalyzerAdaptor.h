@@ -76,6 +76,11 @@ namespace edm {
       typedef CallGlobalLuminosityBlock<T> MyGlobalLuminosityBlock;
       typedef CallGlobalLuminosityBlockSummary<T> MyGlobalLuminosityBlockSummary;
       
+      void preallocLuminosityBlocks(unsigned int iNLumis) final {
+        m_lumis.resize(iNLumis);
+        m_lumiSummaries.resize(iNLumis);
+      }
+
       void setupStreamModules() final {
         this->createStreamModules([this] () -> EDAnalyzerBase* {
           auto tmp = impl::makeStreamModule<T>(*m_pset,m_global.get());
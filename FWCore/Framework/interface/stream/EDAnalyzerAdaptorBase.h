@@ -26,6 +26,7 @@
 // user include files
 #include "DataFormats/Provenance/interface/BranchType.h"
 #include "FWCore/Utilities/interface/ProductResolverIndex.h"
+#include "FWCore/Framework/interface/EDConsumerBase.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "DataFormats/Provenance/interface/ModuleDescription.h"
 #include "FWCore/ParameterSet/interface/ParameterSetfwd.h"
@@ -87,6 +88,7 @@ namespace edm {
       void itemsToGet(BranchType, std::vector<ProductResolverIndexAndSkipBit>&) const;
       void itemsMayGet(BranchType, std::vector<ProductResolverIndexAndSkipBit>&) const;
       std::vector<ProductResolverIndexAndSkipBit> const& itemsToGetFrom(BranchType) const;
+      EDConsumerBase::ESItems const& esItemsToGet() const;
 
       void updateLookup(BranchType iBranchType,
                         ProductResolverIndexHelper const&,
@@ -117,6 +119,7 @@ namespace edm {
       /*virtual*/ void preActionBeforeRunEventAsync(WaitingTask* iTask, ModuleCallingContext const& iModuleCallingContext, Principal const& iPrincipal) const {}
       
       virtual void setupStreamModules() = 0;
+      virtual void preallocLuminosityBlocks(unsigned int) = 0;
       void doBeginJob();
       virtual void doEndJob() = 0;
       
@@ -63,6 +63,12 @@ namespace edm {
       EDProducer(const EDProducer&) = delete; // stop default
       
       const EDProducer& operator=(const EDProducer&) = delete; // stop default
+
+      bool hasAcquire() const final { return HasAbility::kExternalWork; }
+
+      void doAcquire_(Event const& ev, EventSetup const& es, WaitingTaskWithArenaHolder& holder) final {
+        impl::doAcquireIfNeeded(this, ev, es, holder);
+      }
       
       // ---------- member data --------------------------------
       
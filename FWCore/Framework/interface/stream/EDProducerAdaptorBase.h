@@ -37,6 +37,7 @@ namespace edm {
   class ModuleCallingContext;
   class ActivityRegistry;
   class WaitingTask;
+  class WaitingTaskWithArenaHolder;
   
   namespace maker {
     template<typename T> class ModuleHolderT;
@@ -71,6 +72,12 @@ namespace edm {
       bool doEvent(EventPrincipal const& ep, EventSetup const& c,
                    ActivityRegistry*,
                    ModuleCallingContext const*) ;
+      void doAcquire(EventPrincipal const& ep, EventSetup const& c,
+                     ActivityRegistry*,
+                     ModuleCallingContext const*,
+                     WaitingTaskWithArenaHolder&);
+      //All stream modules are instances of the same type so the first one answers for all
+      bool hasAcquire() const;
       //For now this is a placeholder
       /*virtual*/ void preActionBeforeRunEventAsync(WaitingTask* iTask, ModuleCallingContext const& iModuleCallingContext, Principal const& iPrincipal) const {}
 
@@ -71,6 +71,11 @@ namespace edm {
       typedef CallBeginLuminosityBlockProduce<T> MyBeginLuminosityBlockProduce;
       typedef CallEndLuminosityBlockProduce<T> MyEndLuminosityBlockProduce;
       
+      void preallocLuminosityBlocks(unsigned int iNLumis) final {
+        m_lumis.resize(iNLumis);
+        m_lumiSummaries.resize(iNLumis);
+      }
+
       void setupStreamModules() final {
         this->createStreamModules([this] () -> M* {
           auto tmp = impl::makeStreamModule<T>(*m_pset,m_global.get());
@@ -27,6 +27,7 @@
 // user include files
 #include "DataFormats/Provenance/interface/BranchType.h"
 #include "FWCore/Utilities/interface/ProductResolverIndex.h"
+#include "FWCore/Framework/interface/EDConsumerBase.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "DataFormats/Provenance/interface/ModuleDescription.h"
 #include "FWCore/ParameterSet/interface/ParameterSetfwd.h"
@@ -79,6 +80,7 @@ namespace edm {
       void itemsToGet(BranchType, std::vector<ProductResolverIndexAndSkipBit>&) const;
       void itemsMayGet(BranchType, std::vector<ProductResolverIndexAndSkipBit>&) const;
       std::vector<ProductResolverIndexAndSkipBit> const& itemsToGetFrom(BranchType) const;
+      EDConsumerBase::ESItems const& esItemsToGet() const;
 
       void updateLookup(BranchType iBranchType,
                         ProductResolverIndexHelper const&,
@@ -136,6 +138,7 @@ namespace edm {
 
       void doPreallocate(PreallocationConfiguration const&);
       virtual void setupStreamModules() = 0;
+      virtual void preallocLuminosityBlocks(unsigned int) = 0;
       void doBeginJob();
       virtual void doEndJob() = 0;
       
@@ -20,8 +20,10 @@
 
 // system include files
 #include <memory>
+#include <utility>
 
 // user include files
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "FWCore/Utilities/interface/StreamID.h"
 #include "FWCore/Utilities/interface/RunIndex.h"
@@ -144,6 +146,24 @@ namespace edm {
         ///requires the following be defined in the inheriting class
         ///static void globalEndLuminosityBlockProduce(edm::LuminosityBlock&, edm::EventSetup const&, LuminosityBlockContext const*)
       };
+
+      class ExternalWork {
+      public:
+        ExternalWork() = default;
+        ExternalWork( ExternalWork const&) = delete;
+        ExternalWork& operator=(ExternalWork const&) = delete;
+        virtual ~ExternalWork() noexcept(false) {};
+
+        ///Called before produce. The module can start asynchronous work and must call
+        /// holder.doneWaiting once it is finished. produce is run after that call.
+        virtual void acquire(Event const&, edm::EventSetup const&, WaitingTaskWithArenaHolder) = 0;
+      };
+
+      //Used by the module templates to only call acquire if the module has the ExternalWork ability
+      inline void doAcquireIfNeeded(ExternalWork* base, Event const& ev, EventSetup const& es, WaitingTaskWithArenaHolder& holder) {
+        base->acquire(ev, es, std::move(holder));
+      }
+      inline void doAcquireIfNeeded(void*, Event const&, EventSetup const&, WaitingTaskWithArenaHolder&) {}
     }
   }
 }
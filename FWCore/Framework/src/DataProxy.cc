@@ -11,13 +11,18 @@
 //
 
 // system include files
+#include <algorithm>
 #include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 // user include files
 #include "FWCore/Framework/interface/DataProxy.h"
 #include "FWCore/Framework/interface/ComponentDescription.h"
 #include "FWCore/Framework/interface/MakeDataException.h"
 #include "FWCore/Framework/interface/EventSetupRecord.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 
 //
@@ -25,7 +30,6 @@
 //
 namespace edm {
    namespace eventsetup {
-     static std::recursive_mutex s_esGlobalMutex;
 //
 // static data member definitions
 //
@@ -43,7 +47,8 @@ DataProxy::DataProxy() :
    cache_(nullptr),
    cacheIsValid_(false),
    nonTransientAccessRequested_(false),
-   description_(dummyDescription())
+   description_(dummyDescription()),
+   mutex_(&globalMutex())
 {
 }
 
@@ -89,6 +94,7 @@ void
 DataProxy::invalidateTransientCache() {
    invalidateCache();
 }
+
 //
 // const member functions
 //
@@ -97,14 +103,87 @@ namespace  {
                            const DataKey& iKey)  {
       throw MakeDataException(iRecord.key(),iKey);
    }
+
+   //The provider mutex most recently locked by this thread
+   thread_local std::recursive_mutex const* s_heldMutex = nullptr;
+
+   //For each provider mutex, the provider mutexes which were locked while it was held.
+   // These are the dependencies between providers, as seen so far in the job.
+   std::mutex s_lockOrderMutex;
+   std::unordered_map<std::recursive_mutex const*, std::vector<std::recursive_mutex const*>> s_lockOrder;
+
+   bool leadsTo(std::recursive_mutex const* iFrom, std::recursive_mutex const* iTo) {
+      std::vector<std::recursive_mutex const*> toVisit(1, iFrom);
+      std::unordered_set<std::recursive_mutex const*> visited(toVisit.begin(), toVisit.end());
+      while(not toVisit.empty()) {
+         auto mutex = toVisit.back();
+         toVisit.pop_back();
+         if(mutex == iTo) {
+            return true;
+         }
+         auto itFound = s_lockOrder.find(mutex);
+         if(itFound != s_lockOrder.end()) {
+            for(auto next : itFound->second) {
+               if(visited.insert(next).second) {
+                  toVisit.push_back(next);
+               }
+            }
+         }
+      }
+      return false;
+   }
+
+   //Records that iWanted is locked while iHeld is held. If some thread can already lock
+   // iHeld while holding iWanted, the two providers could deadlock: this is an exception.
+   void checkLockOrder(std::recursive_mutex const* iHeld, std::recursive_mutex const* iWanted,
+                       EventSetupRecord const& iRecord, DataKey const& iKey,
+                       ComponentDescription const* iDesc) {
+      std::lock_guard<std::mutex> guard(s_lockOrderMutex);
+      auto& lockedAfter = s_lockOrder[iHeld];
+      if(std::find(lockedAfter.begin(), lockedAfter.end(), iWanted) != lockedAfter.end()) {
+         return;
+      }
+      if(leadsTo(iWanted, iHeld)) {
+         throw cms::Exception("ESCircularDependency")
+            <<"The data of type '"<<iKey.type().name()<<"' with label '"<<iKey.name().value()
+            <<"' in record '"<<iRecord.key().name()<<"' from the EventSetup module '"
+            <<iDesc->type_<<"' with label '"<<iDesc->label_
+            <<"' is requested while producing data of another module,\n"
+            "which in turn got data of this other module while producing its own.\n"
+            "The modules could deadlock. The module getting data of the other one while producing must declare\n"
+            "it by calling 'esConsumes' in its constructor so both modules are run under the same lock.";
+      }
+      lockedAfter.push_back(iWanted);
+   }
+
+   //Locks the mutex of a provider. The mutexes of the providers whose getImpl is waiting
+   // for this data stay locked, the dependencies between the providers are checked instead.
+   class ProviderLock {
+   public:
+      ProviderLock(std::recursive_mutex* iMutex,
+                   EventSetupRecord const& iRecord, DataKey const& iKey,
+                   ComponentDescription const* iDesc) : mutex_(iMutex), previous_(s_heldMutex) {
+         if(previous_ != nullptr and previous_ != iMutex) {
+            checkLockOrder(previous_, iMutex, iRecord, iKey, iDesc);
+         }
+         iMutex->lock();
+         s_heldMutex = iMutex;
+      }
+      ~ProviderLock() {
+         mutex_->unlock();
+         s_heldMutex = previous_;
+      }
+   private:
+      std::recursive_mutex* mutex_;
+      std::recursive_mutex const* previous_;
+   };
 }
-      
-      
+
 const void* 
 DataProxy::get(const EventSetupRecord& iRecord, const DataKey& iKey, bool iTransiently) const
 {
    if(!cacheIsValid()) {
-      std::lock_guard<std::recursive_mutex> guard(s_esGlobalMutex);
+      ProviderLock guard(mutex_, iRecord, iKey, description_);
       if(!cacheIsValid()) {
          cache_ = const_cast<DataProxy*>(this)->getImpl(iRecord, iKey);
          cacheIsValid_.store(true,std::memory_order_release);
@@ -131,5 +210,22 @@ void DataProxy::doGet(const EventSetupRecord& iRecord, const DataKey& iKey, bool
 //
 // static member functions
 //
+void
+DataProxy::forgetProviderMutex(std::recursive_mutex const* iMutex)
+{
+   std::lock_guard<std::mutex> guard(s_lockOrderMutex);
+   s_lockOrder.erase(iMutex);
+   for(auto& lockedAfter : s_lockOrder) {
+      lockedAfter.second.erase(std::remove(lockedAfter.second.begin(), lockedAfter.second.end(), iMutex),
+                               lockedAfter.second.end());
+   }
+}
+
+std::recursive_mutex&
+DataProxy::globalMutex()
+{
+   static std::recursive_mutex s_esGlobalMutex;
+   return s_esGlobalMutex;
+}
    }
 }
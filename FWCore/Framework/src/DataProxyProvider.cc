@@ -33,7 +33,7 @@ namespace edm {
 //
 // constructors and destructor
 //
-DataProxyProvider::DataProxyProvider() : recordProxies_(), description_()
+DataProxyProvider::DataProxyProvider() : recordProxies_(), description_(), mutex_(&ownMutex_)
 {
 }
 
@@ -44,6 +44,10 @@ DataProxyProvider::DataProxyProvider() : recordProxies_(), description_()
 
 DataProxyProvider::~DataProxyProvider() noexcept(false)
 {
+   DataProxy::forgetProviderMutex(&ownMutex_);
+   if(sharedMutex_) {
+      DataProxy::forgetProviderMutex(sharedMutex_.get());
+   }
 }
 
 //
@@ -68,6 +72,24 @@ DataProxyProvider::usingRecordWithKey(const EventSetupRecordKey& iKey)
    //keys_.push_back(iKey);
 }
 
+void
+DataProxyProvider::usingGlobalMutex()
+{
+   mutex_ = &DataProxy::globalMutex();
+}
+
+void
+DataProxyProvider::shareMutex(std::shared_ptr<std::recursive_mutex> iMutex)
+{
+   sharedMutex_ = std::move(iMutex);
+   mutex_ = sharedMutex_ ? sharedMutex_.get() : &DataProxy::globalMutex();
+   for(auto& recordProxies : recordProxies_) {
+      for(auto& keyedProxy : recordProxies.second) {
+         keyedProxy.second->setProviderMutex(mutex_);
+      }
+   }
+}
+
 void 
 DataProxyProvider::invalidateProxies(const EventSetupRecordKey& iRecordKey) 
 {
@@ -121,6 +143,12 @@ DataProxyProvider::isUsingRecord(const EventSetupRecordKey& iKey) const
    return recordProxies_.end() != recordProxies_.find(iKey);
 }
 
+bool
+DataProxyProvider::usesGlobalMutex() const
+{
+   return mutex_ == &DataProxy::globalMutex();
+}
+
 std::set<EventSetupRecordKey> 
 DataProxyProvider::usingRecords() const
 {
@@ -152,6 +180,7 @@ DataProxyProvider::keyedProxies(const EventSetupRecordKey& iRecordKey) const
           itProxy != itProxyEnd;
           ++itProxy) {
         itProxy->second->setProviderDescription(&description());
+        itProxy->second->setProviderMutex(mutex_);
         if( mustChangeLabels ) {
           //Using swap is fine since
           // 1) the data structure is not a map and so we have not sorted on the keys
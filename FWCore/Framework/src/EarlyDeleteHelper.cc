@@ -79,6 +79,7 @@ EarlyDeleteHelper::moduleRan(EventPrincipal const& iEvent) {
     auto value = --(count.count);
     if(value==0) {
       iEvent.deleteProduct(count.branch);
+      ++(count.deletions);
     }
   }
 }
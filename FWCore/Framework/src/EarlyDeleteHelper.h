@@ -31,14 +31,18 @@ namespace edm {
   struct BranchToCount {
     edm::BranchID const branch;
     std::atomic<unsigned int> count;
+    //number of events in which the product was deleted early
+    std::atomic<unsigned int> deletions;
     
     BranchToCount(edm::BranchID id, unsigned int count):
     branch(id),
-    count(count) {}
+    count(count),
+    deletions(0) {}
     
     BranchToCount(BranchToCount const& iOther):
     branch(iOther.branch),
-    count(iOther.count.load()) {}
+    count(iOther.count.load()),
+    deletions(iOther.deletions.load()) {}
   };
   
   class EarlyDeleteHelper
@@ -31,6 +31,7 @@
 #include "FWCore/Framework/src/EventSetupsController.h"
 #include "FWCore/Framework/src/InputSourceFactory.h"
 #include "FWCore/Framework/src/SharedResourcesRegistry.h"
+#include "FWCore/Framework/src/StreamAutoTuner.h"
 #include "FWCore/Framework/src/streamTransitionAsync.h"
 #include "FWCore/Framework/src/globalTransitionAsync.h"
 
@@ -50,6 +51,7 @@
 #include "FWCore/ServiceRegistry/interface/SystemBounds.h"
 
 #include "FWCore/Concurrency/interface/WaitingTaskHolder.h"
+#include "FWCore/Concurrency/interface/WaitingTaskList.h"
 
 #include "FWCore/Utilities/interface/Algorithms.h"
 #include "FWCore/Utilities/interface/DebugMacros.h"
@@ -68,6 +70,7 @@
 
 #include "boost/range/adaptor/reversed.hpp"
 
+#include <algorithm>
 #include <exception>
 #include <iomanip>
 #include <iostream>
@@ -424,35 +427,26 @@ namespace edm {
       edm::LogInfo("ThreadStreamSetup") <<"setting # threads "<<nThreads<<"\nsetting # streams "<<nStreams;
     }
 
-    /*
-      bool nRunsSet = false;
-    */
     unsigned int nConcurrentRuns =1;
-    /*
-      if(nRunsSet = optionsPset.existsAs<unsigned int>("numberOfConcurrentRuns",false)) {
+    if(optionsPset.existsAs<unsigned int>("numberOfConcurrentRuns",false)) {
       nConcurrentRuns = optionsPset.getUntrackedParameter<unsigned int>("numberOfConcurrentRuns");
-      }
-    */
+    }
+    if(nConcurrentRuns != 1) {
+      //The EventSetup only holds one IOV at a time so runs can not overlap
+      edm::LogWarning("ThreadStreamSetup") <<"concurrent runs are not supported, 'numberOfConcurrentRuns' is being set to 1";
+      nConcurrentRuns = 1;
+    }
     unsigned int nConcurrentLumis =1;
-    /*
-      if(optionsPset.existsAs<unsigned int>("numberOfConcurrentLuminosityBlocks",false)) {
-      nConcurrentLumis = optionsPset.getUntrackedParameter<unsigned int>("numberOfConcurrentLuminosityBlocks");
-      } else {
-      nConcurrentLumis = nConcurrentRuns;
-      }
-    */
-    //Check that relationships between threading parameters makes sense
-    /*
-      if(nThreads<nStreams) {
-      //bad
-      }
-      if(nConcurrentRuns>nStreams) {
-      //bad
-      }
-      if(nConcurrentRuns>nConcurrentLumis) {
-      //bad
-      }
-    */
+    if(optionsPset.existsAs<unsigned int>("numberOfConcurrentLuminosityBlocks",false) and
+       optionsPset.getUntrackedParameter<unsigned int>("numberOfConcurrentLuminosityBlocks") > 1) {
+      //All streams finish a luminosity block before the next one is started
+      edm::LogWarning("ThreadStreamSetup") <<"concurrent luminosity blocks are not supported, 'numberOfConcurrentLuminosityBlocks' is being set to 1";
+    }
+    if(optionsPset.getUntrackedParameter<bool>("writeLuminosityBlocksAsynchronously", false)) {
+      //the luminosity block being written and the next one being processed
+      nConcurrentLumis = 2;
+      edm::LogInfo("ThreadStreamSetup") <<"luminosity blocks are written asynchronously";
+    }
     IllegalParameters::setThrowAnException(optionsPset.getUntrackedParameter<bool>("throwIfIllegalParameter", true));
 
     printDependencies_ =  optionsPset.getUntrackedParameter("printDependencies", false);
@@ -490,9 +484,20 @@ namespace edm {
       nConcurrentLumis=1;
       nConcurrentRuns=1;
     }
+    if(hasSubProcesses) {
+      //SubProcesses read their luminosity blocks from the parent
+      // process one transition at a time
+      nConcurrentLumis=1;
+    }
 
     preallocations_ = PreallocationConfiguration{nThreads,nStreams,nConcurrentLumis,nConcurrentRuns};
 
+    if(nStreams > 1 and optionsPset.existsAs<ParameterSet>("adaptiveStreams",false)) {
+      //All Streams are preallocated, the tuner only limits how many of them process Events
+      streamAutoTuner_ = std::make_unique<StreamAutoTuner>(optionsPset.getUntrackedParameterSet("adaptiveStreams"),
+                                                          nStreams, nThreads);
+    }
+
     // initialize the input source
     input_ = makeInput(*parameterSet,
                        *common,
@@ -549,6 +554,11 @@ namespace edm {
     ServiceToken token = getToken();
     ServiceRegistry::Operate op(token);
 
+    // the OutputModules must not be destroyed while still writing
+    if(lumiWritesWaitTask_) {
+      lumiWritesWaitTask_->wait_for_all();
+    }
+
     // manually destroy all these thing that may need the services around
     // propagate_const<T> has no reset() function
     espController_ = nullptr;
@@ -582,6 +592,9 @@ namespace edm {
 
     //NOTE: this may throw
     checkForModuleDependencyCorrectness(pathsAndConsumesOfModules_, printDependencies_);
+    if(streamAutoTuner_) {
+      streamAutoTuner_->connect(*actReg_, pathsAndConsumesOfModules_.allModules());
+    }
     actReg_->preBeginJobSignal_(pathsAndConsumesOfModules_, processContext_);
 
     //NOTE:  This implementation assumes 'Job' means one call
@@ -626,6 +639,8 @@ namespace edm {
     //make the services available
     ServiceRegistry::Operate operate(serviceToken_);
 
+    c.call([this](){ this->waitForLumisBeingWritten(); });
+
     //NOTE: this really should go elsewhere in the future
     for(unsigned int i=0; i<preallocations_.numberOfStreams();++i) {
       c.call([this,i](){this->schedule_->endStream(i);});
@@ -721,6 +736,12 @@ namespace edm {
     
     sentry.completedSuccessfully();
     
+    if(itemType != InputSource::IsLumi) {
+      //only the start of the next luminosity block may
+      // overlap with writing the previous one
+      waitForLumisBeingWritten();
+    }
+
     StatusCode returnCode=epSuccess;
     
     if(checkForAsyncStopRequest(returnCode)) {
@@ -850,6 +871,7 @@ namespace edm {
   }
 
   void EventProcessor::closeOutputFiles() {
+    waitForLumisBeingWritten();
     if (fb_.get() != nullptr) {
       schedule_->closeOutputFiles();
       for_all(subProcesses_, [](auto& subProcess){ subProcess.closeOutputFiles(); });
@@ -1003,6 +1025,7 @@ namespace edm {
   }
 
   void EventProcessor::endRun(ProcessHistoryID const& phid, RunNumber_t run, bool cleaningUpAfterException) {
+    waitForLumisBeingWritten();
     RunPrincipal& runPrincipal = principalCache_.runPrincipal(phid, run);
     runPrincipal.setAtEndTransition(true);
     //We need to reset failed items since they might
@@ -1141,8 +1164,15 @@ namespace edm {
     if(looper_) {
       //looper_->doStreamBeginLuminosityBlock(schedule_->streamID(),lumiPrincipal, es);
     }
+    if(streamAutoTuner_) {
+      //Events of the new luminosity block are processed by the new number of streams
+      streamAutoTuner_->update();
+    }
   }
 
+  //The stream and global end transitions are run synchronously: all streams finish
+  // the luminosity block before the next one is read. When luminosity blocks are written
+  // asynchronously only the write, see writeLumiAsync, overlaps the next one.
   void EventProcessor::endLumi(ProcessHistoryID const& phid, RunNumber_t run, LuminosityBlockNumber_t lumi, bool cleaningUpAfterException) {
     LuminosityBlockPrincipal& lumiPrincipal = principalCache_.lumiPrincipal(phid, run, lumi);
     lumiPrincipal.setAtEndTransition(true);
@@ -1259,7 +1289,10 @@ namespace edm {
         << "Run is invalid\n"
         << "Contact a Framework Developer\n";
     }
-    auto lbp = std::make_shared<LuminosityBlockPrincipal>(input_->luminosityBlockAuxiliary(), preg(), *processConfiguration_, historyAppender_.get(), 0);
+    if(not principalCache_.hasAvailableLumiIndex()) {
+      waitForLumisBeingWritten();
+    }
+    auto lbp = std::make_shared<LuminosityBlockPrincipal>(input_->luminosityBlockAuxiliary(), preg(), *processConfiguration_, historyAppender_.get(), principalCache_.nextLumiIndex());
     {
       SendSourceTerminationSignalIfException sentry(actReg_.get());
       input_->readLuminosityBlock(*lbp, *historyAppender_);
@@ -1287,19 +1320,65 @@ namespace edm {
   }
 
   void EventProcessor::deleteRunFromCache(ProcessHistoryID const& phid, RunNumber_t run) {
+    waitForLumisBeingWritten();
     principalCache_.deleteRun(phid, run);
     for_all(subProcesses_, [run,phid](auto& subProcess){ subProcess.deleteRunFromCache(phid, run); });
     FDEBUG(1) << "\tdeleteRunFromCache " << run << "\n";
   }
 
   void EventProcessor::writeLumi(ProcessHistoryID const& phid, RunNumber_t run, LuminosityBlockNumber_t lumi) {
+    if(preallocations_.numberOfLuminosityBlocks() > 1) {
+      //SubProcesses are not allowed when writing luminosity blocks asynchronously
+      writeLumiAsync(principalCache_.lumiPrincipalPtr(phid, run, lumi));
+      FDEBUG(1) << "\twriteLumiAsync " << run << "/" << lumi << "\n";
+      return;
+    }
     schedule_->writeLumi(principalCache_.lumiPrincipal(phid, run, lumi), &processContext_);
     for_all(subProcesses_, [&phid, run, lumi](auto& subProcess){ subProcess.writeLumi(phid, run, lumi); });
     FDEBUG(1) << "\twriteLumi " << run << "/" << lumi << "\n";
   }
 
+  void EventProcessor::writeLumiAsync(std::shared_ptr<LuminosityBlockPrincipal> iLumiPrincipal) {
+    //The OutputModules require the luminosity blocks to be written in order
+    waitForLumisBeingWritten();
+
+    lumiWritesWaitTask_ = make_empty_waiting_task();
+    lumiWritesWaitTask_->increment_ref_count();
+
+    auto const& lumiPrincipal = *iLumiPrincipal;
+    lumisBeingWritten_.push_back(std::move(iLumiPrincipal));
+    schedule_->writeLumiAsync(WaitingTaskHolder(lumiWritesWaitTask_.get()), lumiPrincipal, &processContext_);
+  }
+
+  void EventProcessor::waitForLumisBeingWritten() {
+    if(not lumiWritesWaitTask_) {
+      return;
+    }
+    lumiWritesWaitTask_->wait_for_all();
+    std::exception_ptr exceptionPtr;
+    if(lumiWritesWaitTask_->exceptionPtr() != nullptr) {
+      exceptionPtr = *(lumiWritesWaitTask_->exceptionPtr());
+    }
+    lumiWritesWaitTask_.reset();
+
+    //the indexes can now be used by new luminosity blocks
+    for(auto const& lumiPrincipal : lumisBeingWritten_) {
+      principalCache_.releaseLumiIndex(lumiPrincipal->index());
+    }
+    lumisBeingWritten_.clear();
+    if(exceptionPtr) {
+      std::rethrow_exception(exceptionPtr);
+    }
+  }
+
   void EventProcessor::deleteLumiFromCache(ProcessHistoryID const& phid, RunNumber_t run, LuminosityBlockNumber_t lumi) {
+    auto lumiPrincipal = principalCache_.lumiPrincipalPtr(phid, run, lumi);
     principalCache_.deleteLumi(phid, run, lumi);
+    //If the luminosity block is still being written the index is
+    // released once the write finishes
+    if(std::find(lumisBeingWritten_.begin(), lumisBeingWritten_.end(), lumiPrincipal) == lumisBeingWritten_.end()) {
+      principalCache_.releaseLumiIndex(lumiPrincipal->index());
+    }
     for_all(subProcesses_, [&phid, run, lumi](auto& subProcess){ subProcess.deleteLumiFromCache(phid, run, lumi); });
     FDEBUG(1) << "\tdeleteLumiFromCache " << run << "/" << lumi << "\n";
   }
@@ -1396,6 +1475,10 @@ namespace edm {
   }
 
   InputSource::ItemType EventProcessor::readAndProcessEvents() {
+    //The OutputModules must finish writing the previous luminosity
+    // block before they can write any Event from the next one
+    waitForLumisBeingWritten();
+
     nextItemTypeFromProcessingEvents_ = InputSource::IsEvent; //needed for looper
     asyncStopRequestedWhileProcessingEvents_ = false;
 
@@ -1411,7 +1494,7 @@ namespace edm {
     auto eventLoopWaitTaskPtr = eventLoopWaitTask.get();
     eventLoopWaitTask->increment_ref_count();
 
-    const unsigned int kNumStreams = preallocations_.numberOfStreams();
+    const unsigned int kNumStreams = streamAutoTuner_ ? streamAutoTuner_->numberOfActiveStreams() : preallocations_.numberOfStreams();
     unsigned int iStreamIndex = 0;
     for(; iStreamIndex<kNumStreams-1; ++iStreamIndex) {
       eventLoopWaitTask->increment_ref_count();
@@ -15,6 +15,7 @@
 // system include files
 #include <algorithm>
 #include <cassert>
+#include <mutex>
 
 // user include files
 #include "FWCore/Framework/interface/EventSetupProvider.h"
@@ -337,7 +338,6 @@ EventSetupProvider::finishConfiguration()
          itFound->second->add(*itProvider);
       }
    }
-   dataProviders_.reset();
    
    //used for the case where no preferred Providers have been specified for the Record
    static const EventSetupRecordProvider::DataToPreferredProviderMap kEmptyMap;
@@ -394,9 +394,82 @@ EventSetupProvider::finishConfiguration()
          itProvider->second->setDependentProviders(depProviders);
       }
    }
+   shareMutexesOfDependentProviders();
+   dataProviders_.reset();
+
    mustFinishConfiguration_ = false;
 }
 
+void
+EventSetupProvider::shareMutexesOfDependentProviders()
+{
+   //The proxies of a provider keep its mutex while they get data from other providers.
+   // The providers which get data from one another, directly or through other providers,
+   // are given one common mutex so they can not deadlock.
+   std::vector<std::shared_ptr<DataProxyProvider> > const& dataProviders = *dataProviders_;
+   std::map<DataProxyProvider const*, unsigned int> providerIndex;
+   for(unsigned int index = 0; index != dataProviders.size(); ++index) {
+      providerIndex.emplace(dataProviders[index].get(), index);
+   }
+
+   std::vector<std::vector<unsigned int> > dependsOn(dataProviders.size());
+   bool hasDependencies = false;
+   for(unsigned int index = 0; index != dataProviders.size(); ++index) {
+      for(auto const& item : dataProviders[index]->esItemsToGet()) {
+         Providers::iterator itFound = providers_.find(item.first);
+         if(itFound == providers_.end()) {
+            continue;
+         }
+         std::shared_ptr<DataProxyProvider> dependent = itFound->second->proxyProvider(item.second);
+         auto itIndex = providerIndex.find(dependent.get());
+         if(itIndex != providerIndex.end() and itIndex->second != index) {
+            dependsOn[index].push_back(itIndex->second);
+            hasDependencies = true;
+         }
+      }
+   }
+   if(not hasDependencies) {
+      return;
+   }
+
+   //reaches[i][j] is true if provider i gets data from provider j, directly or not
+   std::vector<std::vector<bool> > reaches(dataProviders.size(), std::vector<bool>(dataProviders.size(), false));
+   for(unsigned int index = 0; index != dataProviders.size(); ++index) {
+      std::vector<unsigned int> toVisit(dependsOn[index]);
+      while(not toVisit.empty()) {
+         unsigned int next = toVisit.back();
+         toVisit.pop_back();
+         if(not reaches[index][next]) {
+            reaches[index][next] = true;
+            toVisit.insert(toVisit.end(), dependsOn[next].begin(), dependsOn[next].end());
+         }
+      }
+   }
+
+   std::vector<bool> done(dataProviders.size(), false);
+   for(unsigned int index = 0; index != dataProviders.size(); ++index) {
+      if(done[index] or not reaches[index][index]) {
+         continue;
+      }
+      std::vector<unsigned int> cycle;
+      bool usesGlobalMutex = false;
+      for(unsigned int other = 0; other != dataProviders.size(); ++other) {
+         if(reaches[index][other] and reaches[other][index]) {
+            cycle.push_back(other);
+            done[other] = true;
+            usesGlobalMutex = usesGlobalMutex or dataProviders[other]->usesGlobalMutex();
+         }
+      }
+      std::shared_ptr<std::recursive_mutex> mutex;
+      if(not usesGlobalMutex) {
+         mutex = std::make_shared<std::recursive_mutex>();
+      }
+      for(unsigned int other : cycle) {
+         dataProviders[other]->shareMutex(mutex);
+      }
+   }
+}
+
 typedef std::map<EventSetupRecordKey, std::shared_ptr<EventSetupRecordProvider> > Providers;
 typedef Providers::iterator Itr;
 static
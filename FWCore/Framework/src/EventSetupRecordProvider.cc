@@ -307,6 +307,17 @@ EventSetupRecordProvider::proxyProvider(ParameterSetIDHolder const& psetID) {
    return std::shared_ptr<DataProxyProvider>();
 }
 
+std::shared_ptr<DataProxyProvider>
+EventSetupRecordProvider::proxyProvider(DataKey const& iKey) {
+   ComponentDescription const* desc = record().providerDescription(iKey);
+   for (auto& dataProxyProvider : providers_) {
+      if (&(dataProxyProvider->description()) == desc) {
+         return get_underlying_safe(dataProxyProvider);
+      }
+   }
+   return std::shared_ptr<DataProxyProvider>();
+}
+
 void
 EventSetupRecordProvider::resetProxyProvider(ParameterSetIDHolder const& psetID, std::shared_ptr<DataProxyProvider> const& sharedDataProxyProvider) {
    for (auto& dataProxyProvider : providers_) {
@@ -30,10 +30,12 @@ namespace edm {
 
     std::shared_ptr<maker::ModuleHolder> makeReplacementModule(const edm::ParameterSet&) const;
 
+    ///Loads the plugin of the module type if needed. Not thread safe.
+    Maker* findMaker(const MakeModuleParams& p) const;
+
 
   private:
     Factory();
-    Maker* findMaker(const MakeModuleParams& p) const;
     static Factory const singleInstance_;
     mutable MakerMap makers_;
   };
@@ -80,8 +80,8 @@ namespace edm {
     workerManager_.endJob(collector);
   }
 
-  void GlobalSchedule::beginJob(ProductRegistry const& iRegistry) {
-    workerManager_.beginJob(iRegistry);
+  void GlobalSchedule::beginJob(ProductRegistry const& iRegistry, bool iConcurrently) {
+    workerManager_.beginJob(iRegistry, iConcurrently);
   }
   
   void GlobalSchedule::replaceModule(maker::ModuleHolder* iMod,
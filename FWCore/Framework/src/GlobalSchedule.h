@@ -99,7 +99,7 @@ namespace edm {
                                EventSetup const& eventSetup,
                                bool cleaningUpAfterException = false);
 
-    void beginJob(ProductRegistry const&);
+    void beginJob(ProductRegistry const&, bool iConcurrently = false);
     void endJob(ExceptionCollector & collector);
     
     /// Return a vector allowing const access to all the
@@ -40,6 +40,7 @@ namespace edm {
       m_maker(iMaker){}
       virtual ~ModuleHolder() {}
       std::unique_ptr<Worker> makeWorker(ExceptionToActionTable const* actions) const;
+      Maker const* maker() const { return m_maker; }
       
       virtual ModuleDescription const& moduleDescription() const = 0;
       virtual void setModuleDescription(ModuleDescription const& iDesc) = 0;
@@ -11,10 +11,14 @@
 //
 
 // system include files
+#include <exception>
+#include "tbb/parallel_for.h"
 
 // user include files
 #include "FWCore/Framework/src/ModuleRegistry.h"
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
 #include "FWCore/Framework/src/Factory.h"
+#include "FWCore/ServiceRegistry/interface/ServiceRegistry.h"
 
 
 namespace edm {
@@ -25,6 +29,14 @@ namespace edm {
                             signalslot::Signal<void(ModuleDescription const&)>& iPost) {
     auto modItr = labelToModule_.find(moduleLabel);
     if(modItr == labelToModule_.end()) {
+      auto prepared = preparedModules_.find(moduleLabel);
+      if(prepared != preparedModules_.end()) {
+        auto modPtr = prepared->second;
+        preparedModules_.erase(prepared);
+        modPtr->maker()->registerPreparedModule(p,*modPtr,iPre,iPost);
+        labelToModule_[moduleLabel] = modPtr;
+        return modPtr;
+      }
       auto modPtr=
       Factory::get()->makeModule(p,iPre,iPost);
       
@@ -35,6 +47,49 @@ namespace edm {
     return get_underlying_safe(modItr->second);
   }
   
+  void
+  ModuleRegistry::prepareModules(std::vector<MakeModuleParams> const& iParams) {
+    //plugin loading and the assignment of module IDs are done serially
+    // in the order of the configuration to keep them reproducible
+    std::vector<Maker const*> makers;
+    std::vector<unsigned int> ids;
+    std::vector<MakeModuleParams const*> toMake;
+    for(auto const& p: iParams) {
+      auto label = p.pset_->getParameter<std::string>("@module_label");
+      if(labelToModule_.find(label) != labelToModule_.end() or
+         preparedModules_.find(label) != preparedModules_.end()) {
+        continue;
+      }
+      Maker const* maker = Factory::get()->findMaker(p);
+      if(maker->mayConstructConcurrently()) {
+        makers.push_back(maker);
+        ids.push_back(ModuleDescription::getUniqueID());
+        toMake.push_back(&p);
+      }
+    }
+
+    std::vector<std::shared_ptr<maker::ModuleHolder>> modules(toMake.size());
+    std::vector<std::exception_ptr> exceptions(toMake.size());
+    auto token = ServiceRegistry::instance().presentToken();
+    tbb::parallel_for(std::size_t(0), toMake.size(), [&](std::size_t i) {
+      ServiceRegistry::Operate operate(token);
+      try {
+        modules[i] = makers[i]->prepareModule(*toMake[i], ids[i]);
+      } catch(...) {
+        exceptions[i] = std::current_exception();
+      }
+    });
+    //report the first failure in configuration order
+    for(auto const& e: exceptions) {
+      if(e) {
+        std::rethrow_exception(e);
+      }
+    }
+    for(auto& m: modules) {
+      preparedModules_.emplace(m->moduleDescription().moduleLabel(), std::move(m));
+    }
+  }
+
   maker::ModuleHolder*
   ModuleRegistry::replaceModule(std::string const& iModuleLabel,
                                 edm::ParameterSet const& iPSet,
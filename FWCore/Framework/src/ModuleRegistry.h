@@ -22,6 +22,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 // user include files
 #include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
@@ -45,6 +46,14 @@ namespace edm {
                                                    signalslot::Signal<void(ModuleDescription const&)>& iPre,
                                                    signalslot::Signal<void(ModuleDescription const&)>& iPost);
     
+    ///Constructs, concurrently, the modules whose constructors may run in parallel.
+    /// Their construction signals are emitted and their products registered
+    /// when getModule is called for them, so that happens in the usual order.
+    void prepareModules(std::vector<MakeModuleParams> const& iParams);
+
+    ///Drops the prepared modules never requested through getModule
+    void clearPreparedModules() { preparedModules_.clear(); }
+
     maker::ModuleHolder* replaceModule(std::string const& iModuleLabel,
                                        edm::ParameterSet const& iPSet,
                                        edm::PreallocationConfiguration const&);
@@ -58,6 +67,7 @@ namespace edm {
     }
   private:
     std::map<std::string, edm::propagate_const<std::shared_ptr<maker::ModuleHolder>>> labelToModule_;
+    std::map<std::string, std::shared_ptr<maker::ModuleHolder>> preparedModules_;
   };
 }
 
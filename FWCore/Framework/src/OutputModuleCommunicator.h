@@ -32,6 +32,7 @@ namespace edm {
 
   class ProcessContext;
   class ThinnedAssociationsHelper;
+  class WaitingTaskHolder;
 
   class OutputModuleCommunicator
   {
@@ -54,6 +55,10 @@ namespace edm {
     
     virtual void writeLumi(LuminosityBlockPrincipal const& lbp, ProcessContext const*) = 0;
     
+    ///Writes the luminosity block in a task. The write is serialized with the
+    /// other transitions of the OutputModule. iTask is signalled when done.
+    virtual void writeLumiAsync(WaitingTaskHolder iTask, LuminosityBlockPrincipal const& lbp, ProcessContext const*) = 0;
+    
     ///\return true if OutputModule has reached its limit on maximum number of events it wants to see
     virtual bool limitReached() const = 0;
     
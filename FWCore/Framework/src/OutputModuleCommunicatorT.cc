@@ -5,13 +5,22 @@
 #include "FWCore/Framework/interface/LuminosityBlockPrincipal.h"
 #include "FWCore/Framework/interface/RunPrincipal.h"
 #include "FWCore/Framework/interface/ModuleContextSentry.h"
+#include "FWCore/Framework/interface/OutputModule.h"
+#include "FWCore/Framework/interface/global/OutputModuleBase.h"
+#include "FWCore/Framework/interface/one/OutputModuleBase.h"
+#include "FWCore/Framework/interface/limited/OutputModuleBase.h"
+#include "FWCore/Concurrency/interface/FunctorTask.h"
+#include "FWCore/Concurrency/interface/WaitingTaskHolder.h"
 #include "FWCore/ServiceRegistry/interface/GlobalContext.h"
 #include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
 #include "FWCore/ServiceRegistry/interface/ParentContext.h"
+#include "FWCore/ServiceRegistry/interface/ServiceRegistry.h"
 #include "FWCore/Utilities/interface/LuminosityBlockIndex.h"
 
 #include "FWCore/Framework/src/OutputModuleCommunicatorT.h"
 
+#include "tbb/task.h"
+
 namespace edm {
 
   template<typename T>
@@ -62,6 +71,49 @@ namespace edm {
     module().doWriteLuminosityBlock(lbp, &mcc);
   }
 
+  template<typename T>
+  void
+  OutputModuleCommunicatorT<T>::writeLumiAsync(WaitingTaskHolder iTask, edm::LuminosityBlockPrincipal const& lbp, ProcessContext const* processContext) {
+    auto token = ServiceRegistry::instance().presentToken();
+    auto write = [this, iTask, &lbp, processContext, token]() mutable {
+      ServiceRegistry::Operate operate(token);
+      std::exception_ptr ptr;
+      try {
+        writeLumi(lbp, processContext);
+      } catch(...) {
+        ptr = std::current_exception();
+      }
+      iTask.doneWaiting(ptr);
+    };
+    pushWrite(module(), write);
+  }
+
+  //The writes must be serialized with the Event and other transitions
+  // of the module the same way the Worker does it
+  template<typename T>
+  template<typename F>
+  void OutputModuleCommunicatorT<T>::pushWrite(edm::OutputModule& iModule, F const& iWrite) {
+    iModule.sharedResourcesAcquirer().serialQueueChain().push(iWrite);
+  }
+
+  template<typename T>
+  template<typename F>
+  void OutputModuleCommunicatorT<T>::pushWrite(edm::one::OutputModuleBase& iModule, F const& iWrite) {
+    iModule.sharedResourcesAcquirer().serialQueueChain().push(iWrite);
+  }
+
+  template<typename T>
+  template<typename F>
+  void OutputModuleCommunicatorT<T>::pushWrite(edm::global::OutputModuleBase&, F const& iWrite) {
+    tbb::task::spawn(*make_functor_task(tbb::task::allocate_root(), iWrite));
+  }
+
+  template<typename T>
+  template<typename F>
+  void OutputModuleCommunicatorT<T>::pushWrite(edm::limited::OutputModuleBase& iModule, F const& iWrite) {
+    iModule.queue().push(iWrite);
+  }
+
   template<typename T>
   bool OutputModuleCommunicatorT<T>::wantAllEvents() const {return module().wantAllEvents();}
 
@@ -111,10 +163,6 @@ namespace edm {
   }
 }
 
-#include "FWCore/Framework/interface/OutputModule.h"
-#include "FWCore/Framework/interface/global/OutputModuleBase.h"
-#include "FWCore/Framework/interface/one/OutputModuleBase.h"
-#include "FWCore/Framework/interface/limited/OutputModuleBase.h"
 
 namespace edm {
   template class OutputModuleCommunicatorT<OutputModule>;
@@ -47,6 +47,8 @@ namespace edm {
     
     void writeLumi(edm::LuminosityBlockPrincipal const& lbp, ProcessContext const*) override;
     
+    void writeLumiAsync(WaitingTaskHolder iTask, edm::LuminosityBlockPrincipal const& lbp, ProcessContext const*) override;
+    
     ///\return true if OutputModule has reached its limit on maximum number of events it wants to see
     bool limitReached() const override;
     
@@ -67,6 +69,12 @@ namespace edm {
 
   private:
     inline T& module() const { return *module_;}
+
+    template<typename F> static void pushWrite(edm::OutputModule&, F const&);
+    template<typename F> static void pushWrite(edm::one::OutputModuleBase&, F const&);
+    template<typename F> static void pushWrite(edm::global::OutputModuleBase&, F const&);
+    template<typename F> static void pushWrite(edm::limited::OutputModuleBase&, F const&);
+
     T* module_;
   };
 }
@@ -7,6 +7,8 @@
 #include "FWCore/Utilities/interface/EDMException.h"
 #include "DataFormats/Provenance/interface/ProcessHistoryRegistry.h"
 
+#include <algorithm>
+
 namespace edm {
 
   PrincipalCache::PrincipalCache() :
@@ -20,6 +22,29 @@ namespace edm {
   void PrincipalCache::setNumberOfConcurrentPrincipals(PreallocationConfiguration const& iConfig)
   {
     eventPrincipals_.resize(iConfig.numberOfStreams());
+    //hand out the lowest index first
+    availableLumiIndexes_.clear();
+    availableLumiIndexes_.reserve(iConfig.numberOfLuminosityBlocks());
+    for(unsigned int index = iConfig.numberOfLuminosityBlocks(); index != 0; --index) {
+      availableLumiIndexes_.push_back(index-1);
+    }
+  }
+
+  unsigned int PrincipalCache::nextLumiIndex() {
+    if(availableLumiIndexes_.empty()) {
+      throw edm::Exception(edm::errors::LogicError)
+        << "PrincipalCache::nextLumiIndex\n"
+        << "Illegal attempt to start more concurrent luminosity blocks than were preallocated\n"
+        << "Contact a Framework Developer\n";
+    }
+    auto index = availableLumiIndexes_.back();
+    availableLumiIndexes_.pop_back();
+    return index;
+  }
+
+  void PrincipalCache::releaseLumiIndex(unsigned int iIndex) {
+    assert(std::find(availableLumiIndexes_.begin(), availableLumiIndexes_.end(), iIndex) == availableLumiIndexes_.end());
+    availableLumiIndexes_.push_back(iIndex);
   }
 
   RunPrincipal&
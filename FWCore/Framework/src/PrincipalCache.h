@@ -17,6 +17,15 @@ The RunPrincipal and LuminosityBlockPrincipal is
 created by the InputSource each time a different
 run or luminosity block is encountered.
 
+When more than one luminosity block is allowed to be
+in flight at the same time, this class also hands out
+the LuminosityBlockIndex used for each new
+LuminosityBlockPrincipal. An index stays reserved until
+it is explicitly released, which can happen after the
+LuminosityBlockPrincipal has been deleted from the cache
+(for example while the luminosity block is still being
+written by the OutputModules).
+
 Performs checks that process history IDs or runs and
 lumis, run numbers, and luminosity numbers are consistent.
 
@@ -66,6 +75,14 @@ namespace edm {
     void merge(std::shared_ptr<LuminosityBlockAuxiliary> aux, std::shared_ptr<ProductRegistry const> reg);
 
     void setNumberOfConcurrentPrincipals(PreallocationConfiguration const&);
+
+    ///\return true if a LuminosityBlockIndex is available for a new luminosity block
+    bool hasAvailableLumiIndex() const {return not availableLumiIndexes_.empty();}
+    ///Reserves and returns the index to be used for the next LuminosityBlockPrincipal
+    unsigned int nextLumiIndex();
+    ///Makes a previously reserved index available again
+    void releaseLumiIndex(unsigned int iIndex);
+
     void insert(std::shared_ptr<RunPrincipal> rp);
     void insert(std::shared_ptr<LuminosityBlockPrincipal> lbp);
     void insert(std::shared_ptr<EventPrincipal> ep);
@@ -90,6 +107,9 @@ namespace edm {
     std::shared_ptr<LuminosityBlockPrincipal> lumiPrincipal_;
     std::vector<std::shared_ptr<EventPrincipal>> eventPrincipals_;
 
+    // Indexes not used by any luminosity block which is still in flight
+    std::vector<unsigned int> availableLumiIndexes_;
+
     // This is just an accessor to the registry owned by the input source. 
     ProcessHistoryRegistry const* processHistoryRegistry_; // We don't own this
 
@@ -424,6 +424,45 @@ namespace edm {
         }
       }
     };
+
+    //Constructs ahead of the StreamSchedules the modules they would construct:
+    // those on Paths and EndPaths followed by the unused EDProducers and EDFilters
+    void prepareModules(ModuleRegistry& iRegistry,
+                        ParameterSet& proc_pset,
+                        service::TriggerNamesService const& tns,
+                        ProductRegistry& preg,
+                        PreallocationConfiguration const& prealloc,
+                        std::shared_ptr<ProcessConfiguration const> processConfiguration) {
+      std::vector<MakeModuleParams> params;
+      std::set<std::string> labels;
+      auto add = [&](std::string const& iLabel) {
+        if(labels.insert(iLabel).second) {
+          bool isTracked;
+          ParameterSet* modpset = proc_pset.getPSetForUpdate(iLabel, isTracked);
+          //unknown labels are reported when the StreamSchedule is filled
+          if(modpset != nullptr) {
+            params.emplace_back(modpset, preg, &prealloc, processConfiguration);
+          }
+        }
+      };
+      for(auto const* pathNames : {&tns.getTrigPaths(), &tns.getEndPaths()}) {
+        for(auto const& pathName : *pathNames) {
+          for(auto const& name : proc_pset.getParameter<vstring>(pathName)) {
+            add((name[0] == '!' or name[0] == '-') ? name.substr(1) : name);
+          }
+        }
+      }
+      for(auto const& label : proc_pset.getParameter<vstring>("@all_modules")) {
+        if(labels.find(label) == labels.end()) {
+          auto const& modpset = proc_pset.getParameterSet(label);
+          auto const modType = modpset.getParameter<std::string>("@module_edm_type");
+          if(modType == "EDProducer" or modType == "EDFilter") {
+            add(label);
+          }
+        }
+      }
+      iRegistry.prepareModules(params);
+    }
   }
   // -----------------------------
 
@@ -451,6 +490,7 @@ namespace edm {
     pathNames_(&tns.getTrigPaths()),
     endPathNames_(&tns.getEndPaths()),
     wantSummary_(tns.wantSummary()),
+    concurrentModuleConstruction_(proc_pset.getUntrackedParameterSet("options", ParameterSet()).getUntrackedParameter<bool>("concurrentModuleConstruction", false)),
     endpathsAreActive_(true)
   {
     makePathStatusInserters(pathStatusInserters_,
@@ -469,6 +509,10 @@ namespace edm {
                             processConfiguration,
                             std::string("EndPathStatusInserter"));
 
+    if(concurrentModuleConstruction_) {
+      prepareModules(*moduleRegistry_, proc_pset, tns, preg, prealloc, processConfiguration);
+    }
+
     assert(0<prealloc.numberOfStreams());
     streamSchedules_.reserve(prealloc.numberOfStreams());
     for(unsigned int i=0; i<prealloc.numberOfStreams();++i) {
@@ -484,6 +528,7 @@ namespace edm {
         StreamID{i},
         processContext));
     }
+    moduleRegistry_->clearPreparedModules();
 
     //TriggerResults are injected automatically by StreamSchedules and are
     // unknown to the ModuleRegistry
@@ -999,6 +1044,12 @@ namespace edm {
     for_all(all_output_communicators_, std::bind(&OutputModuleCommunicator::writeLumi, _1, std::cref(lbp), processContext));
   }
 
+  void Schedule::writeLumiAsync(WaitingTaskHolder iTask, LuminosityBlockPrincipal const& lbp, ProcessContext const* processContext) {
+    for(auto& c: all_output_communicators_) {
+      c->writeLumiAsync(iTask, lbp, processContext);
+    }
+  }
+
   bool Schedule::shouldWeCloseOutput() const {
     using std::placeholders::_1;
     // Return true iff at least one output module returns true.
@@ -1018,7 +1069,7 @@ namespace edm {
   }
 
   void Schedule::beginJob(ProductRegistry const& iRegistry) {
-    globalSchedule_->beginJob(iRegistry);
+    globalSchedule_->beginJob(iRegistry, concurrentModuleConstruction_);
   }
 
   void Schedule::beginStream(unsigned int iStreamID) {
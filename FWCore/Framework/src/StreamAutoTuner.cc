@@ -0,0 +1,163 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/Framework
+// Class  :     StreamAutoTuner
+//
+// Implementation:
+//     A module is stalled from the moment its prefetching finished until
+//     it starts running, which is the same definition used by the
+//     StallMonitor service. Only one Event per Stream is in flight so a
+//     (Stream, module) pair is never concurrently updated.
+//
+// Original Author:  FWCore
+//         Created:  Tue, 17 Oct 2017 09:12:44 GMT
+//
+
+// system include files
+#include <algorithm>
+#include <fstream>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+// user include files
+#include "StreamAutoTuner.h"
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
+#include "FWCore/ServiceRegistry/interface/StreamContext.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+
+namespace {
+  double processCPUSeconds() {
+    rusage usage;
+    if(0 != getrusage(RUSAGE_SELF, &usage)) {
+      return 0.;
+    }
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+      1E-6*(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+  }
+
+  double residentMB() {
+    std::ifstream statm("/proc/self/statm");
+    unsigned long size = 0, resident = 0;
+    if(not (statm >> size >> resident)) {
+      return 0.;
+    }
+    return static_cast<double>(resident)*sysconf(_SC_PAGESIZE)/(1024.*1024.);
+  }
+}
+
+namespace edm {
+
+  StreamAutoTuner::StreamAutoTuner(ParameterSet const& iConfig, unsigned int iNStreams, unsigned int iNThreads) :
+    minStreams_(std::max(1U, iConfig.getUntrackedParameter<unsigned int>("minimumNumberOfStreams", 1))),
+    maxStreams_(iNStreams),
+    nThreads_(iNThreads),
+    memoryBudgetMB_(iConfig.getUntrackedParameter<double>("memoryBudget", 0.)),
+    minimumSeconds_(iConfig.getUntrackedParameter<double>("minimumSecondsBetweenChanges", 10.)),
+    stallThreshold_(iConfig.getUntrackedParameter<double>("stallFractionThreshold", 0.1)),
+    utilizationThreshold_(iConfig.getUntrackedParameter<double>("cpuUtilizationThreshold", 0.9)),
+    active_(iConfig.getUntrackedParameter<unsigned int>("initialNumberOfStreams", 1)) {
+    if(minStreams_ > maxStreams_) {
+      throw Exception(errors::Configuration)
+        << "adaptiveStreams.minimumNumberOfStreams (" << minStreams_
+        << ") is larger than numberOfStreams (" << maxStreams_ << ")";
+    }
+    active_ = std::min(std::max(active_, minStreams_), maxStreams_);
+    LogInfo("ThreadStreamSetup") << "adaptive streams: starting with " << active_
+                                 << " of at most " << maxStreams_ << " streams";
+  }
+
+  void StreamAutoTuner::connect(ActivityRegistry& iRegistry, std::vector<ModuleDescription const*> const& iModules) {
+    for(auto const* md : iModules) {
+      nModules_ = std::max(nModules_, md->id()+1);
+    }
+    prefetchDone_.resize(maxStreams_*nModules_);
+    iRegistry.watchPostModuleEventPrefetching(this, &StreamAutoTuner::postModuleEventPrefetching);
+    iRegistry.watchPreModuleEvent(this, &StreamAutoTuner::preModuleEvent);
+    startWindow();
+  }
+
+  void StreamAutoTuner::postModuleEventPrefetching(StreamContext const& iStream, ModuleCallingContext const& iModule) {
+    auto const id = iModule.moduleDescription()->id();
+    if(id < nModules_) {
+      prefetchDone_[iStream.streamID().value()*nModules_+id] = std::chrono::steady_clock::now();
+    }
+  }
+
+  void StreamAutoTuner::preModuleEvent(StreamContext const& iStream, ModuleCallingContext const& iModule) {
+    auto const id = iModule.moduleDescription()->id();
+    if(id >= nModules_) {
+      return;
+    }
+    auto& start = prefetchDone_[iStream.streamID().value()*nModules_+id];
+    if(start.time_since_epoch().count() != 0) {
+      auto stall = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-start);
+      stallNanoseconds_.fetch_add(stall.count(), std::memory_order_relaxed);
+      start = std::chrono::steady_clock::time_point();
+    }
+  }
+
+  void StreamAutoTuner::startWindow() {
+    windowStart_ = std::chrono::steady_clock::now();
+    windowStartCPU_ = processCPUSeconds();
+    stallNanoseconds_.store(0, std::memory_order_relaxed);
+  }
+
+  void StreamAutoTuner::update() {
+    Measurement m;
+    m.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-windowStart_).count();
+    if(m.seconds < minimumSeconds_) {
+      return;
+    }
+    m.cpuSeconds = processCPUSeconds()-windowStartCPU_;
+    m.stallSeconds = 1E-9*stallNanoseconds_.load(std::memory_order_relaxed);
+    m.rssMB = residentMB();
+
+    auto const previous = active_;
+    decide(m);
+    if(previous != active_) {
+      LogInfo("ThreadStreamSetup") << "adaptive streams: changing from " << previous << " to " << active_
+                                   << " streams (CPU utilization " << m.cpuSeconds/(m.seconds*nThreads_)
+                                   << ", stall fraction " << m.stallSeconds/(m.seconds*previous)
+                                   << ", RSS " << m.rssMB << " MB)";
+    }
+    startWindow();
+  }
+
+  unsigned int StreamAutoTuner::decide(Measurement const& iM) {
+    if(rssBeforeGrowthMB_ > 0.) {
+      //learn how much memory the last added Stream needed
+      perStreamMB_ = std::max(iM.rssMB - rssBeforeGrowthMB_, 0.);
+      rssBeforeGrowthMB_ = 0.;
+    }
+    //conservative until we have grown at least once
+    double const perStreamMB = perStreamMB_ >= 0. ? perStreamMB_ : iM.rssMB/active_;
+    if(iM.seconds <= 0.) {
+      return active_;
+    }
+    double const utilization = iM.cpuSeconds/(iM.seconds*nThreads_);
+    double const stallFraction = iM.stallSeconds/(iM.seconds*active_);
+    bool const hasBudget = memoryBudgetMB_ > 0.;
+
+    if(hasBudget and iM.rssMB > memoryBudgetMB_) {
+      if(active_ > minStreams_) {
+        --active_;
+      }
+    } else if(utilization < utilizationThreshold_ and stallFraction < stallThreshold_) {
+      if(active_ < maxStreams_ and
+         (not hasBudget or iM.rssMB + perStreamMB <= memoryBudgetMB_)) {
+        rssBeforeGrowthMB_ = iM.rssMB;
+        ++active_;
+      }
+    } else if(stallFraction >= stallThreshold_ and utilization >= utilizationThreshold_) {
+      if(active_ > minStreams_) {
+        --active_;
+      }
+    }
+    return active_;
+  }
+}
@@ -0,0 +1,102 @@
+#ifndef FWCore_Framework_StreamAutoTuner_h
+#define FWCore_Framework_StreamAutoTuner_h
+// -*- C++ -*-
+//
+// Package:     FWCore/Framework
+// Class  :     StreamAutoTuner
+//
+/**\class edm::StreamAutoTuner StreamAutoTuner.h "StreamAutoTuner.h"
+
+ Description: Decides how many of the preallocated Streams process Events
+
+ Usage:
+    Enabled by adding the 'adaptiveStreams' PSet to process.options. The
+ value of 'numberOfStreams' then is the maximum number of Streams. The job
+ starts with 'initialNumberOfStreams' active Streams and at each
+ LuminosityBlock boundary the number is changed by at most one:
+    - shrink if the resident memory is above 'memoryBudget' (in MB)
+    - grow if the threads are not kept busy ('cpuUtilizationThreshold'),
+      modules seldom wait for a thread once their prefetching is done
+      ('stallFractionThreshold') and one more Stream is expected to fit
+      in the memory budget
+    - shrink if the threads are busy but modules often wait for a thread
+ Decisions are only taken after at least 'minimumSecondsBetweenChanges'
+ seconds of processing.
+
+*/
+//
+// Original Author:  FWCore
+//         Created:  Tue, 17 Oct 2017 09:12:44 GMT
+//
+
+// system include files
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+// user include files
+
+// forward declarations
+namespace edm {
+  class ActivityRegistry;
+  class ModuleCallingContext;
+  class ModuleDescription;
+  class ParameterSet;
+  class StreamContext;
+
+  class StreamAutoTuner {
+  public:
+    struct Measurement {
+      double seconds = 0.;      //wall clock time since the last decision
+      double cpuSeconds = 0.;   //CPU time of the process since the last decision
+      double stallSeconds = 0.; //summed over all Streams
+      double rssMB = 0.;
+    };
+
+    StreamAutoTuner(ParameterSet const& iConfig, unsigned int iNStreams, unsigned int iNThreads);
+    StreamAutoTuner(StreamAutoTuner const&) = delete;
+    StreamAutoTuner& operator=(StreamAutoTuner const&) = delete;
+
+    // ---------- const member functions ---------------------
+    unsigned int numberOfActiveStreams() const { return active_; }
+
+    // ---------- member functions ---------------------------
+    ///Start monitoring module stalls. Must be called once all modules have been constructed.
+    void connect(ActivityRegistry&, std::vector<ModuleDescription const*> const& iModules);
+
+    ///Called at LuminosityBlock boundaries. Not thread safe.
+    void update();
+
+    ///Applies one decision step and returns the new number of active Streams
+    unsigned int decide(Measurement const&);
+
+  private:
+    void postModuleEventPrefetching(StreamContext const&, ModuleCallingContext const&);
+    void preModuleEvent(StreamContext const&, ModuleCallingContext const&);
+    void startWindow();
+
+    // ---------- member data --------------------------------
+    unsigned int const minStreams_;
+    unsigned int const maxStreams_;
+    unsigned int const nThreads_;
+    double const memoryBudgetMB_;
+    double const minimumSeconds_;
+    double const stallThreshold_;
+    double const utilizationThreshold_;
+    unsigned int active_;
+
+    //memory learned from the last time a Stream was added, <0 if unknown
+    double perStreamMB_ = -1.;
+    double rssBeforeGrowthMB_ = 0.;
+
+    unsigned int nModules_ = 0;
+    //indexed by streamID*nModules_+moduleID
+    std::vector<std::chrono::steady_clock::time_point> prefetchDone_;
+    std::atomic<long long> stallNanoseconds_{0};
+
+    std::chrono::steady_clock::time_point windowStart_;
+    double windowStartCPU_ = 0.;
+  };
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include "FWCore/Framework/src/StreamSchedule.h"
 
+#include "DataFormats/Provenance/interface/BranchDescription.h"
 #include "DataFormats/Provenance/interface/BranchIDListHelper.h"
 #include "DataFormats/Provenance/interface/ProcessConfiguration.h"
 #include "DataFormats/Provenance/interface/ProductRegistry.h"
@@ -24,6 +25,7 @@
 #include "FWCore/Utilities/interface/Algorithms.h"
 #include "FWCore/Utilities/interface/ConvertException.h"
 #include "FWCore/Utilities/interface/ExceptionCollector.h"
+#include "FWCore/Utilities/interface/InputTag.h"
 #include "FWCore/Concurrency/interface/WaitingTaskHolder.h"
 
 #include <algorithm>
@@ -33,6 +35,7 @@
 #include <iomanip>
 #include <list>
 #include <map>
+#include <set>
 #include <exception>
 
 namespace edm {
@@ -124,6 +127,72 @@ namespace edm {
         }
       }
     }
+
+    // Adds a placeholder for each event product made by one of the modules of this
+    // schedule. Aliased products are not deleted early since the alias would still
+    // refer to the deleted product.
+    void
+    initializeBranchToReadingWorkerFromConsumes(ProductRegistry const& preg,
+                                                std::string const& processName,
+                                                std::set<std::string> const& workerLabels,
+                                                std::multimap<std::string,Worker*>& branchToReadingWorker,
+                                                std::vector<BranchDescription const*>& candidates)
+    {
+      std::set<BranchID> aliased;
+      for(auto const& item: preg.productList()) {
+        if(item.second.isAlias()) {
+          aliased.insert(item.second.originalBranchID());
+        }
+      }
+      for(auto const& item: preg.productList()) {
+        BranchDescription const& desc = item.second;
+        if(desc.branchType() != InEvent or not desc.produced() or desc.isAlias() or
+           desc.processName() != processName or
+           workerLabels.find(desc.moduleLabel()) == workerLabels.end() or
+           aliased.find(desc.branchID()) != aliased.end()) {
+          continue;
+        }
+        //the branch names all end with a period, which we do not want to compare with
+        std::string name = desc.branchName();
+        name.resize(name.size()-1);
+        if(branchToReadingWorker.find(name) == branchToReadingWorker.end()) {
+          branchToReadingWorker.insert(std::make_pair(name, static_cast<Worker*>(nullptr)));
+        }
+        candidates.push_back(&desc);
+      }
+    }
+
+    // Adds to branches the candidates which may be gotten using one of the
+    // consumes calls of the module. The matching is deliberately loose, a module
+    // wrongly counted as reading a product only delays its deletion.
+    void
+    branchesFromConsumes(Worker const& iWorker,
+                         std::string const& processName,
+                         std::vector<BranchDescription const*> const& candidates,
+                         std::set<std::string>& branches)
+    {
+      for(auto const& info: iWorker.consumesInfo()) {
+        if(info.branchType() != InEvent or info.skipCurrentProcess() or
+           not (info.process().empty() or info.process() == processName or
+                info.process() == InputTag::kCurrentProcess)) {
+          continue;
+        }
+        bool const consumesMany = info.label().empty();
+        for(auto desc: candidates) {
+          bool matches;
+          if(consumesMany) {
+            matches = info.kindOfType() != PRODUCT_TYPE or info.type() == desc->unwrappedTypeID();
+          } else {
+            matches = info.label() == desc->moduleLabel() and info.instance() == desc->productInstanceName();
+          }
+          if(matches) {
+            std::string name = desc->branchName();
+            name.resize(name.size()-1);
+            branches.insert(name);
+          }
+        }
+      }
+    }
   }
 
   // -----------------------------
@@ -238,13 +307,14 @@ namespace edm {
     }
 
 
-    initializeEarlyDelete(*modReg, opts,preg,allowEarlyDelete);
+    initializeEarlyDelete(*modReg, opts,preg,processConfiguration->processName(),allowEarlyDelete);
     
   } // StreamSchedule::StreamSchedule
 
   
   void StreamSchedule::initializeEarlyDelete(ModuleRegistry & modReg,
                                              edm::ParameterSet const& opts, edm::ProductRegistry const& preg,
+                                             std::string const& processName,
                                        bool allowEarlyDelete) {
     //for now, if have a subProcess, don't allow early delete
     // In the future we should use the SubProcess's 'keep list' to decide what can be kept
@@ -254,6 +324,21 @@ namespace edm {
     // registered for this job
     std::multimap<std::string,Worker*> branchToReadingWorker;
     initializeBranchToReadingWorker(opts,preg,branchToReadingWorker);
+    std::set<std::string> requestedBranches;
+    for(auto const& branchAndWorker: branchToReadingWorker) {
+      requestedBranches.insert(branchAndWorker.first);
+    }
+
+    //if 'deleteEarlyFromConsumes' was set also consider all products made in this
+    // job, each is deleted once all the modules consuming it have run
+    std::vector<BranchDescription const*> candidates;
+    if(opts.getUntrackedParameter<bool>("deleteEarlyFromConsumes",false)) {
+      std::set<std::string> workerLabels;
+      for(auto w: allWorkers()) {
+        workerLabels.insert(w->description().moduleLabel());
+      }
+      initializeBranchToReadingWorkerFromConsumes(preg,processName,workerLabels,branchToReadingWorker,candidates);
+    }
     
     //If no delete early items have been specified we don't have to do anything
     if(branchToReadingWorker.empty()) {
@@ -275,7 +360,10 @@ namespace edm {
           SelectedProductsForBranchType const& kept = comm->keptProducts();
           for(auto const& item: kept[InEvent]) {
             BranchDescription const& desc = *item.first;
-            auto found = branchToReadingWorker.equal_range(desc.branchName());
+            //the keys do not have the period which ends the branch names
+            std::string name = desc.branchName();
+            name.resize(name.size()-1);
+            auto found = branchToReadingWorker.equal_range(name);
             if(found.first !=found.second) {
               --nUniqueBranchesToDelete;
               branchToReadingWorker.erase(found.first,found.second);
@@ -293,7 +381,11 @@ namespace edm {
       //determine if this module could read a branch we want to delete early
       auto pset = pset::Registry::instance()->getMapped(w->description().parameterSetID());
       if(nullptr!=pset) {
-        auto branches = pset->getUntrackedParameter<std::vector<std::string>>("mightGet",kEmpty);
+        auto mightGet = pset->getUntrackedParameter<std::vector<std::string>>("mightGet",kEmpty);
+        std::set<std::string> branches(mightGet.begin(),mightGet.end());
+        if(not candidates.empty()) {
+          branchesFromConsumes(*w,processName,candidates,branches);
+        }
         if(not branches.empty()) {
           ++upperLimitOnReadingWorker;
         }
@@ -316,7 +408,10 @@ namespace edm {
       std::vector<std::string> unusedBranches;
       while(it !=branchToReadingWorker.end()) {
         if(it->second == nullptr) {
-          unusedBranches.push_back(it->first);
+          //products only considered because of 'deleteEarlyFromConsumes' are not worth a warning
+          if(requestedBranches.find(it->first) != requestedBranches.end()) {
+            unusedBranches.push_back(it->first);
+          }
           //erasing the object invalidates the iterator so must advance it first
           auto temp = it;
           ++it;
@@ -347,6 +442,7 @@ namespace edm {
           //have to put back the period we removed earlier in order to get the proper name
           BranchID bid(branchAndWorker.first+".");
           earlyDeleteBranchToCount_.emplace_back(bid,0U);
+          earlyDeleteBranchNames_.push_back(branchAndWorker.first);
           lastBranchName = branchAndWorker.first;
         }
         auto found = alreadySeenWorkers.find(branchAndWorker.second);
@@ -502,6 +598,13 @@ namespace edm {
   
   void StreamSchedule::endStream() {
     workerManager_.endStream(streamID_, streamContext_);
+    if(not earlyDeleteBranchToCount_.empty()) {
+      LogInfo l("DeleteEarly");
+      l<<"Stream "<<streamID_.value()<<" deleted early the following products in the given number of events.";
+      for(unsigned int i = 0; i != earlyDeleteBranchToCount_.size(); ++i) {
+        l<<"\n "<<earlyDeleteBranchNames_[i]<<" "<<earlyDeleteBranchToCount_[i].deletions.load();
+      }
+    }
   }
 
   void StreamSchedule::replaceModule(maker::ModuleHolder* iMod,
@@ -324,6 +324,7 @@ namespace edm {
     void initializeEarlyDelete(ModuleRegistry & modReg,
                                edm::ParameterSet const& opts,
                                edm::ProductRegistry const& preg, 
+                               std::string const& processName,
                                bool allowEarlyDelete);
 
     TrigResConstPtr results() const {return get_underlying_safe(results_);}
@@ -352,6 +353,8 @@ namespace edm {
     // keep track of how many modules are left that read this data but have
     // not yet been run in this event
     std::vector<BranchToCount> earlyDeleteBranchToCount_;
+    //Names of the branches in earlyDeleteBranchToCount_, used for the end of stream report
+    std::vector<std::string> earlyDeleteBranchNames_;
     //NOTE the following is effectively internal data for each EarlyDeleteHelper
     // but putting it into one vector makes for better allocation as well as
     // faster iteration when used to reset the earlyDeleteBranchToCount_
@@ -6,6 +6,8 @@
 #include "FWCore/Framework/src/EarlyDeleteHelper.h"
 #include "FWCore/ServiceRegistry/interface/StreamContext.h"
 #include "FWCore/Concurrency/interface/WaitingTask.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/EventSetupRecord.h"
 
 namespace edm {
   namespace {
@@ -202,7 +204,7 @@ private:
   }
 
   
-  void Worker::prefetchAsync(WaitingTask* iTask, ParentContext const& parentContext, Principal const& iPrincipal) {
+  void Worker::prefetchAsync(WaitingTask* iTask, ParentContext const& parentContext, EventSetup const& iSetup, Principal const& iPrincipal) {
     // Prefetch products the module declares it consumes (not including the products it maybe consumes)
     std::vector<ProductResolverIndexAndSkipBit> const& items = itemsToGetFrom(iPrincipal.branchType());
 
@@ -221,6 +223,7 @@ private:
         iPrincipal.prefetchAsync(iTask,productResolverIndex, skipCurrentProcess, &moduleCallingContext_);
       }
     }
+    esPrefetchAsync(iTask, iSetup);
     
     if(iPrincipal.branchType()==InEvent) {
       preActionBeforeRunEventAsync(iTask,moduleCallingContext_,iPrincipal);
@@ -232,6 +235,93 @@ private:
     }
   }
   
+  void Worker::esPrefetchAsync(WaitingTask* iTask, EventSetup const& iSetup) {
+    // Get the EventSetup data the module declares it consumes which are not already cached,
+    // each in its own task so the data from different providers are made concurrently
+    for(auto const& item : esItemsToGet()) {
+      eventsetup::EventSetupRecord const* record = iSetup.find(item.first);
+      if(nullptr == record or record->wasGotten(item.second)) {
+        continue;
+      }
+      eventsetup::DataKey const* key = &item.second;
+      iTask->increment_ref_count();
+      tbb::task::spawn(*make_functor_task(tbb::task::allocate_root(), [iTask, record, key]() {
+        try {
+          record->doGet(*key);
+        } catch(...) {
+          //the exception is thrown again when the module gets the data, with the module context
+        }
+        if(0 == iTask->decrement_ref_count()) {
+          tbb::task::spawn(*iTask);
+        }
+      }));
+    }
+  }
+
+  void Worker::runAcquire(EventPrincipal const& ep,
+                          EventSetup const& es,
+                          ParentContext const& parentContext,
+                          WaitingTaskWithArenaHolder holder) {
+    ModuleContextSentry moduleContextSentry(&moduleCallingContext_, parentContext);
+    try {
+      convertException::wrap([&]() {
+        this->implDoAcquire(ep, es, &moduleCallingContext_, holder);
+      });
+    } catch(cms::Exception& ex) {
+      exceptionContext(ex, &moduleCallingContext_);
+      throw;
+    }
+  }
+
+  void Worker::runAcquireAfterAsyncPrefetch(std::exception_ptr const* iEPtr,
+                                            EventPrincipal const& ep,
+                                            EventSetup const& es,
+                                            ParentContext const& parentContext,
+                                            WaitingTaskWithArenaHolder holder) {
+    std::exception_ptr exceptionPtr;
+    if(iEPtr) {
+      assert(*iEPtr);
+      //the RunModuleTask decides if the prefetching failure must be rethrown
+      exceptionPtr = *iEPtr;
+      moduleCallingContext_.setContext(ModuleCallingContext::State::kInvalid,ParentContext(),nullptr);
+    } else {
+      //runAcquire gets its own copy of the holder so the RunModuleTask
+      // can not start before we report any exception thrown by acquire
+      try {
+        runAcquire(ep, es, parentContext, holder);
+      } catch(...) {
+        exceptionPtr = std::current_exception();
+      }
+    }
+    holder.doneWaiting(exceptionPtr);
+  }
+
+  std::exception_ptr Worker::runAcquireAndWait(EventPrincipal const& ep,
+                                               EventSetup const& es,
+                                               ParentContext const& parentContext) {
+    auto waitTask = edm::make_empty_waiting_task();
+    //wait_for_all returns once the ref count drops back to 1
+    waitTask->increment_ref_count();
+    {
+      WaitingTaskWithArenaHolder holder(waitTask.get());
+      if(auto queue = serializeRunModule()) {
+        auto serviceToken = ServiceRegistry::instance().presentToken();
+        queue.pushAndWait([&]() {
+          //Need to make the services available
+          ServiceRegistry::Operate guard(serviceToken);
+          runAcquireAfterAsyncPrefetch(nullptr, ep, es, parentContext, std::move(holder));
+        });
+      } else {
+        runAcquireAfterAsyncPrefetch(nullptr, ep, es, parentContext, std::move(holder));
+      }
+    }
+    waitTask->wait_for_all();
+    if(waitTask->exceptionPtr() != nullptr) {
+      return *waitTask->exceptionPtr();
+    }
+    return std::exception_ptr{};
+  }
+
   void Worker::setEarlyDeleteHelper(EarlyDeleteHelper* iHelper) {
     earlyDeleteHelper_=iHelper;
   }
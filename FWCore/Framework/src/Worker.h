@@ -24,11 +24,13 @@ the worker is reset().
 #include "DataFormats/Provenance/interface/ModuleDescription.h"
 #include "FWCore/MessageLogger/interface/ExceptionMessages.h"
 #include "FWCore/Framework/src/WorkerParams.h"
+#include "FWCore/Framework/interface/EDConsumerBase.h"
 #include "FWCore/Framework/interface/ExceptionActions.h"
 #include "FWCore/Framework/interface/ModuleContextSentry.h"
 #include "FWCore/Framework/interface/OccurrenceTraits.h"
 #include "FWCore/Framework/interface/ProductResolverIndexAndSkipBit.h"
 #include "FWCore/Concurrency/interface/WaitingTaskList.h"
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
 #include "FWCore/ServiceRegistry/interface/ConsumesInfo.h"
@@ -188,6 +190,13 @@ namespace edm {
 
     virtual Types moduleType() const =0;
 
+    //true if the module has the ExternalWork ability and therefore
+    // needs acquire to be called before running on an Event
+    virtual bool hasAcquire() const = 0;
+
+    //true if calls to the module are serialized, e.g. because it uses shared resources
+    bool isSerialized() { return static_cast<bool>(serializeRunModule()); }
+
     void clearCounters() {
       timesRun_.store(0,std::memory_order_release);
       timesVisited_.store(0,std::memory_order_release);
@@ -214,6 +223,9 @@ namespace edm {
     virtual std::string workerType() const = 0;
     virtual bool implDo(EventPrincipal const&, EventSetup const& c,
                         ModuleCallingContext const* mcc) = 0;
+    virtual void implDoAcquire(EventPrincipal const&, EventSetup const& c,
+                               ModuleCallingContext const* mcc,
+                               WaitingTaskWithArenaHolder& holder) = 0;
     virtual bool implDoPrePrefetchSelection(StreamID id,
                                             EventPrincipal const& ep,
                                             ModuleCallingContext const* mcc) = 0;
@@ -255,6 +267,7 @@ namespace edm {
 
     virtual std::vector<ProductResolverIndexAndSkipBit> const& itemsToGetFrom(BranchType) const = 0;
 
+    virtual EDConsumerBase::ESItems const& esItemsToGet() const = 0;
 
     virtual std::vector<ProductResolverIndex> const& itemsShouldPutInEvent() const = 0;
 
@@ -330,7 +343,10 @@ namespace edm {
         
     void prefetchAsync(WaitingTask*,
                        ParentContext const& parentContext,
+                       EventSetup const&,
                        Principal const& );
+
+    void esPrefetchAsync(WaitingTask*, EventSetup const&);
         
     void emitPostModuleEventPrefetchingSignal() {
       actReg_->postModuleEventPrefetchingSignal_.emit(*moduleCallingContext_.getStreamContext(),moduleCallingContext_);
@@ -343,6 +359,27 @@ namespace edm {
                                                    StreamID streamID,
                                                    ParentContext const& parentContext,
                                                    typename T::Context const* context);
+
+    void runAcquire(EventPrincipal const& ep,
+                    EventSetup const& es,
+                    ParentContext const& parentContext,
+                    WaitingTaskWithArenaHolder holder);
+
+    void runAcquireAfterAsyncPrefetch(std::exception_ptr const* iEPtr,
+                                      EventPrincipal const& ep,
+                                      EventSetup const& es,
+                                      ParentContext const& parentContext,
+                                      WaitingTaskWithArenaHolder holder);
+
+    //Used by doWork to call acquire and block until the module signals
+    // its external work is done
+    std::exception_ptr runAcquireAndWait(EventPrincipal const& ep,
+                                         EventSetup const& es,
+                                         ParentContext const& parentContext);
+    template<typename P>
+    std::exception_ptr runAcquireAndWait(P const&,
+                                         EventSetup const&,
+                                         ParentContext const&) { return std::exception_ptr{}; }
         
     template< typename T>
     class RunModuleTask : public WaitingTask {
@@ -369,7 +406,8 @@ namespace edm {
         // to hold the exception_ptr
         std::exception_ptr temp_excptr;
         auto excptr = exceptionPtr();
-        if(T::isEvent_) {
+        //if the module has acquire, the signal was emitted by the AcquireTask
+        if(T::isEvent_ and not m_worker->hasAcquire()) {
           try {
             //pre was called in prefetchAsync
             m_worker->emitPostModuleEventPrefetchingSignal();
@@ -425,6 +463,95 @@ namespace edm {
       typename T::Context const* m_context;
       ServiceToken m_serviceToken;
     };
+
+    //Only Events have an acquire step. For the other transitions the
+    // task is never created.
+    template <typename T, typename DUMMY = void>
+    class AcquireTask : public WaitingTask {
+    public:
+      AcquireTask(Worker* worker,
+                  typename T::MyPrincipal const& ep,
+                  EventSetup const& es,
+                  ParentContext const& parentContext,
+                  WaitingTask* runModuleTask) {}
+      tbb::task* execute() override { return nullptr; }
+    };
+
+    template <typename DUMMY>
+    class AcquireTask<OccurrenceTraits<EventPrincipal, BranchActionStreamBegin>, DUMMY> : public WaitingTask {
+    public:
+      AcquireTask(Worker* worker,
+                  EventPrincipal const& ep,
+                  EventSetup const& es,
+                  ParentContext const& parentContext,
+                  WaitingTask* runModuleTask):
+      m_worker(worker),
+      m_principal(ep),
+      m_es(es),
+      m_parentContext(parentContext),
+      m_runModuleTask(runModuleTask),
+      m_serviceToken(ServiceRegistry::instance().presentToken()) {}
+
+      tbb::task* execute() override {
+        //Need to make the services available early so other services can see them
+        ServiceRegistry::Operate guard(m_serviceToken);
+
+        //incase the emit causes an exception, we need a memory location
+        // to hold the exception_ptr
+        std::exception_ptr temp_excptr;
+        auto excptr = exceptionPtr();
+        try {
+          //pre was called in prefetchAsync
+          m_worker->emitPostModuleEventPrefetchingSignal();
+        }catch(...) {
+          temp_excptr = std::current_exception();
+          if(not excptr) {
+            excptr = &temp_excptr;
+          }
+        }
+
+        //The holder keeps the RunModuleTask from running until
+        // the module signals that its external work is done
+        WaitingTaskWithArenaHolder holder(m_runModuleTask);
+
+        if( not excptr) {
+          if(auto queue = m_worker->serializeRunModule()) {
+            Worker* worker = m_worker;
+            auto const & principal = m_principal;
+            auto& es = m_es;
+            auto parentContext = m_parentContext;
+            auto serviceToken = m_serviceToken;
+            queue.push( [worker, &principal, &es, parentContext, serviceToken, holder]()
+            {
+              //Need to make the services available
+              ServiceRegistry::Operate guard(serviceToken);
+
+              worker->runAcquireAfterAsyncPrefetch(nullptr,
+                                                   principal,
+                                                   es,
+                                                   parentContext,
+                                                   holder);
+            });
+            return nullptr;
+          }
+        }
+
+        m_worker->runAcquireAfterAsyncPrefetch(excptr,
+                                               m_principal,
+                                               m_es,
+                                               m_parentContext,
+                                               std::move(holder));
+        return nullptr;
+      }
+
+    private:
+      Worker* m_worker;
+      EventPrincipal const& m_principal;
+      EventSetup const& m_es;
+      ParentContext const m_parentContext;
+      WaitingTask* m_runModuleTask;
+      ServiceToken m_serviceToken;
+    };
     
     std::atomic<int> timesRun_;
     std::atomic<int> timesVisited_;
@@ -672,7 +799,15 @@ namespace edm {
       
       auto runTask = new (tbb::task::allocate_root()) RunModuleTask<T>(
         this, ep,es,streamID,parentContext,context);
-      prefetchAsync(runTask, parentContext, ep);
+      if(T::isEvent_ and hasAcquire()) {
+        //the RunModuleTask is spawned once the module signals
+        // the WaitingTaskWithArenaHolder passed to acquire
+        auto acquireTask = new (tbb::task::allocate_root()) AcquireTask<T>(
+          this, ep,es,parentContext,runTask);
+        prefetchAsync(acquireTask, parentContext, es, ep);
+      } else {
+        prefetchAsync(runTask, parentContext, es, ep);
+      }
     }
   }
      
@@ -813,7 +948,7 @@ namespace edm {
         //set count to 2 since wait_for_all requires value to not go to 0
         waitTask->set_ref_count(2);
         
-        prefetchAsync(waitTask.get(),parentContext, ep);
+        prefetchAsync(waitTask.get(),parentContext, es, ep);
         waitTask->decrement_ref_count();
         waitTask->wait_for_all();
       }
@@ -833,6 +968,21 @@ namespace edm {
     
     //successful prefetch so no reset necessary
     prefetchSentry.release();
+    if(T::isEvent_ and hasAcquire()) {
+      auto acquireException = runAcquireAndWait(ep, es, parentContext);
+      if(acquireException) {
+        TransitionIDValue<typename T::MyPrincipal> idValue(ep);
+        if(shouldRethrowException(acquireException, parentContext, T::isEvent_, idValue)) {
+          setException<T::isEvent_>(acquireException);
+          waitingTasks_.doneWaiting(cached_exception_);
+          std::rethrow_exception(cached_exception_);
+        } else {
+          setPassed<T::isEvent_>();
+          waitingTasks_.doneWaiting(nullptr);
+          return true;
+        }
+      }
+    }
     if(auto queue = serializeRunModule()) {
       auto serviceToken = ServiceRegistry::instance().presentToken();
       queue.pushAndWait([&]() {
@@ -17,12 +17,17 @@ namespace edm {
   
   ModuleDescription
   Maker::createModuleDescription(MakeModuleParams const &p) const {
+    return createModuleDescription(p, ModuleDescription::getUniqueID());
+  }
+
+  ModuleDescription
+  Maker::createModuleDescription(MakeModuleParams const &p, unsigned int iModuleID) const {
     ParameterSet const& conf = *p.pset_;
     ModuleDescription md(conf.id(),
                          conf.getParameter<std::string>("@module_type"),
                          conf.getParameter<std::string>("@module_label"),
                          p.processConfiguration_.get(),
-                         ModuleDescription::getUniqueID());
+                         iModuleID);
     return md;
   }
   
@@ -61,10 +66,8 @@ namespace edm {
     }
   }
   
-  std::shared_ptr<maker::ModuleHolder>
-  Maker::makeModule(MakeModuleParams const& p,
-                    signalslot::Signal<void(ModuleDescription const&)>& pre,
-                    signalslot::Signal<void(ModuleDescription const&)>& post) const {
+  void
+  Maker::validateAndRegister(MakeModuleParams const& p) const {
     ConfigurationDescriptions descriptions(baseType());
     fillDescriptions(descriptions);
     try {
@@ -84,7 +87,14 @@ namespace edm {
     // but that would require rebuilding much more code so will be done at
     // a later date.
     edm::pset::Registry::instance()->insertMapped(*(p.pset_),true);
-    
+  }
+
+  std::shared_ptr<maker::ModuleHolder>
+  Maker::makeModule(MakeModuleParams const& p,
+                    signalslot::Signal<void(ModuleDescription const&)>& pre,
+                    signalslot::Signal<void(ModuleDescription const&)>& post) const {
+    validateAndRegister(p);
+
     ModuleDescription md = createModuleDescription(p);
     std::shared_ptr<maker::ModuleHolder> module;
     bool postCalled = false;
@@ -113,6 +123,54 @@ namespace edm {
     }
     return module;
   }
+
+  std::shared_ptr<maker::ModuleHolder>
+  Maker::prepareModule(MakeModuleParams const& p, unsigned int iModuleID) const {
+    validateAndRegister(p);
+
+    ModuleDescription md = createModuleDescription(p, iModuleID);
+    std::shared_ptr<maker::ModuleHolder> module;
+    try {
+      convertException::wrap([&]() {
+        module = makeModule(*(p.pset_));
+        module->setModuleDescription(md);
+        module->preallocate(*(p.preallocate_));
+      });
+    }
+    catch(cms::Exception & iException){
+      throwConfigurationException(md, iException);
+    }
+    return module;
+  }
+
+  void
+  Maker::registerPreparedModule(MakeModuleParams const& p,
+                                maker::ModuleHolder& iModule,
+                                signalslot::Signal<void(ModuleDescription const&)>& pre,
+                                signalslot::Signal<void(ModuleDescription const&)>& post) const {
+    ModuleDescription const& md = iModule.moduleDescription();
+    bool postCalled = false;
+    try {
+      convertException::wrap([&]() {
+        pre(md);
+        iModule.registerProductsAndCallbacks(p.reg_);
+        // if exception then post will be called in the catch block
+        postCalled = true;
+        post(md);
+      });
+    }
+    catch(cms::Exception & iException){
+      if(!postCalled) {
+        try {
+          post(md);
+        }
+        catch (...) {
+          // If post throws an exception ignore it because we are already handling another exception
+        }
+      }
+      throwConfigurationException(md, iException);
+    }
+  }
   
   std::unique_ptr<Worker> 
   Maker::makeWorker(ExceptionToActionTable const* actions,
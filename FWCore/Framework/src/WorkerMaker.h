@@ -19,6 +19,32 @@ namespace edm {
   class ParameterSet;
   class Maker;
   class ExceptionToActionTable;
+
+  namespace global {
+    class EDProducerBase;
+    class EDFilterBase;
+    class EDAnalyzerBase;
+  }
+  namespace stream {
+    class EDProducerAdaptorBase;
+    class EDFilterAdaptorBase;
+    class EDAnalyzerAdaptorBase;
+  }
+
+  namespace maker {
+    //Only modules which can not declare shared resources are constructed
+    // concurrently. Output modules are excluded since they open files.
+    template<typename T>
+    struct ConstructConcurrently {
+      static bool constexpr value = false;
+    };
+    template<> struct ConstructConcurrently<global::EDProducerBase> { static bool constexpr value = true; };
+    template<> struct ConstructConcurrently<global::EDFilterBase> { static bool constexpr value = true; };
+    template<> struct ConstructConcurrently<global::EDAnalyzerBase> { static bool constexpr value = true; };
+    template<> struct ConstructConcurrently<stream::EDProducerAdaptorBase> { static bool constexpr value = true; };
+    template<> struct ConstructConcurrently<stream::EDFilterAdaptorBase> { static bool constexpr value = true; };
+    template<> struct ConstructConcurrently<stream::EDAnalyzerAdaptorBase> { static bool constexpr value = true; };
+  }
   
   class Maker {
   public:
@@ -29,10 +55,23 @@ namespace edm {
     std::unique_ptr<Worker> makeWorker(ExceptionToActionTable const*,
                                        maker::ModuleHolder const*) const;
 
+    ///true if the module constructor may run concurrently with the constructors of other modules
+    bool mayConstructConcurrently() const { return constructConcurrently(); }
+
+    ///Validates the configuration and constructs the module with the given unique ID but
+    /// neither emits the construction signals nor registers the products. Thread safe.
+    std::shared_ptr<maker::ModuleHolder> prepareModule(MakeModuleParams const&, unsigned int iModuleID) const;
+    ///Completes the construction of a module made by prepareModule
+    void registerPreparedModule(MakeModuleParams const&,
+                                maker::ModuleHolder& iModule,
+                                signalslot::Signal<void(ModuleDescription const&)>& iPre,
+                                signalslot::Signal<void(ModuleDescription const&)>& iPost) const;
+
     std::shared_ptr<maker::ModuleHolder> makeReplacementModule(edm::ParameterSet const& p) const { return makeModule(p);}
 protected:
       
     ModuleDescription createModuleDescription(MakeModuleParams const& p) const;
+    ModuleDescription createModuleDescription(MakeModuleParams const& p, unsigned int iModuleID) const;
 
     void throwConfigurationException(ModuleDescription const& md,
                                      cms::Exception & iException) const;
@@ -43,12 +82,15 @@ protected:
     void validateEDMType(std::string const& edmType, MakeModuleParams const& p) const;
 
   private:
+    void validateAndRegister(MakeModuleParams const& p) const;
+
     virtual void fillDescriptions(ConfigurationDescriptions& iDesc) const = 0;
     virtual std::shared_ptr<maker::ModuleHolder> makeModule(edm::ParameterSet const& p) const  = 0;
     virtual std::unique_ptr<Worker> makeWorker(ExceptionToActionTable const* actions,
                                              ModuleDescription const& md,
                                                maker::ModuleHolder const* mod) const = 0;
     virtual const std::string& baseType() const =0;
+    virtual bool constructConcurrently() const = 0;
   };
   
   
@@ -63,6 +105,7 @@ protected:
     std::unique_ptr<Worker> makeWorker(ExceptionToActionTable const* actions, ModuleDescription const& md, maker::ModuleHolder const* mod) const override;
     std::shared_ptr<maker::ModuleHolder> makeModule(edm::ParameterSet const& p) const override;
     const std::string& baseType() const override;
+    bool constructConcurrently() const override;
   };
 
   template <class T>
@@ -101,6 +144,11 @@ protected:
   const std::string& WorkerMaker<T>::baseType() const {
     return T::baseType();
   }
+
+  template<class T>
+  bool WorkerMaker<T>::constructConcurrently() const {
+    return maker::ConstructConcurrently<typename T::ModuleType>::value;
+  }
   
 }
 
@@ -4,10 +4,15 @@
 #include "DataFormats/Provenance/interface/ProductRegistry.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ServiceRegistry.h"
 #include "FWCore/Utilities/interface/Algorithms.h"
 #include "FWCore/Utilities/interface/ExceptionCollector.h"
 #include "DataFormats/Provenance/interface/ProductResolverIndexHelper.h"
 
+#include "tbb/parallel_for.h"
+
+#include <exception>
+
 static const std::string kFilterType("EDFilter");
 static const std::string kProducerType("EDProducer");
 
@@ -97,7 +102,7 @@ namespace edm {
   }
 
 
-  void WorkerManager::beginJob(ProductRegistry const& iRegistry) {
+  void WorkerManager::beginJob(ProductRegistry const& iRegistry, bool iConcurrently) {
     auto const runLookup = iRegistry.productLookup(InRun);
     auto const lumiLookup = iRegistry.productLookup(InLumi);
     auto const eventLookup = iRegistry.productLookup(InEvent);
@@ -115,7 +120,34 @@ namespace edm {
         worker->resolvePutIndicies(InEvent,eventModuleToIndicies);
       }
       
-      for_all(allWorkers_, std::bind(&Worker::beginJob, std::placeholders::_1));
+      if(not iConcurrently) {
+        for_all(allWorkers_, std::bind(&Worker::beginJob, std::placeholders::_1));
+        return;
+      }
+      std::vector<Worker*> concurrent;
+      for(auto& worker : allWorkers_) {
+        if(worker->isSerialized() or worker->moduleType() == Worker::kOutputModule) {
+          worker->beginJob();
+        } else {
+          concurrent.push_back(worker);
+        }
+      }
+      std::vector<std::exception_ptr> exceptions(concurrent.size());
+      auto token = ServiceRegistry::instance().presentToken();
+      tbb::parallel_for(std::size_t(0), concurrent.size(), [&](std::size_t i) {
+        ServiceRegistry::Operate operate(token);
+        try {
+          concurrent[i]->beginJob();
+        } catch(...) {
+          exceptions[i] = std::current_exception();
+        }
+      });
+      //report the first failure in the order of the workers
+      for(auto const& e : exceptions) {
+        if(e) {
+          std::rethrow_exception(e);
+        }
+      }
     }
   }
 
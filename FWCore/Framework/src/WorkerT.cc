@@ -135,6 +135,32 @@ namespace edm{
     return module_->doEvent(ep, c, activityRegistry(), mcc);
   }
 
+  template<typename T>
+  inline
+  void
+  WorkerT<T>::implDoAcquire(EventPrincipal const&, EventSetup const&,
+                            ModuleCallingContext const*,
+                            WaitingTaskWithArenaHolder&) {
+  }
+
+  template<>
+  inline
+  void
+  WorkerT<global::EDProducerBase>::implDoAcquire(EventPrincipal const& ep, EventSetup const& c,
+                                                 ModuleCallingContext const* mcc,
+                                                 WaitingTaskWithArenaHolder& holder) {
+    module_->doAcquire(ep, c, activityRegistry(), mcc, holder);
+  }
+
+  template<>
+  inline
+  void
+  WorkerT<stream::EDProducerAdaptorBase>::implDoAcquire(EventPrincipal const& ep, EventSetup const& c,
+                                                        ModuleCallingContext const* mcc,
+                                                        WaitingTaskWithArenaHolder& holder) {
+    module_->doAcquire(ep, c, activityRegistry(), mcc, holder);
+  }
+
   template<typename T>
   inline
   bool
@@ -377,6 +403,17 @@ namespace edm{
     module_->doRegisterThinnedAssociations(registry, helper);
   }
 
+  template<typename T>
+  bool WorkerT<T>::hasAcquire() const {
+    return false;
+  }
+  template<> bool WorkerT<global::EDProducerBase>::hasAcquire() const {
+    return module_->hasAcquire();
+  }
+  template<> bool WorkerT<stream::EDProducerAdaptorBase>::hasAcquire() const {
+    return module_->hasAcquire();
+  }
+
   template<typename T>
   inline
   Worker::TaskQueueAdaptor WorkerT<T>::serializeRunModule() {
@@ -44,6 +44,8 @@ namespace edm {
     
     Types moduleType() const override;
 
+    bool hasAcquire() const override;
+
     void updateLookup(BranchType iBranchType,
                               ProductResolverIndexHelper const&) override;
     void resolvePutIndicies(BranchType iBranchType,
@@ -77,6 +79,9 @@ namespace edm {
   private:
     bool implDo(EventPrincipal const& ep, EventSetup const& c,
                         ModuleCallingContext const* mcc) override;
+    void implDoAcquire(EventPrincipal const& ep, EventSetup const& c,
+                       ModuleCallingContext const* mcc,
+                       WaitingTaskWithArenaHolder& holder) override;
     bool implDoPrePrefetchSelection(StreamID id,
                                             EventPrincipal const& ep,
                                             ModuleCallingContext const* mcc) override;
@@ -130,6 +135,8 @@ namespace edm {
     }
 
     std::vector<ProductResolverIndexAndSkipBit> const& itemsToGetFrom(BranchType iType) const final { return module_->itemsToGetFrom(iType); }
+
+    EDConsumerBase::ESItems const& esItemsToGet() const final { return module_->esItemsToGet(); }
     
     std::vector<ProductResolverIndex> const& itemsShouldPutInEvent() const override;
 
@@ -20,6 +20,7 @@
 #include "FWCore/Framework/src/edmodule_mightGet_config.h"
 #include "FWCore/Framework/src/PreallocationConfiguration.h"
 #include "FWCore/Framework/src/EventSignalsSentry.h"
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
 
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
@@ -61,12 +62,24 @@ namespace edm {
       return true;
     }
 
+    void
+    EDProducerBase::doAcquire(EventPrincipal const& ep, EventSetup const& c,
+                              ActivityRegistry* act,
+                              ModuleCallingContext const* mcc,
+                              WaitingTaskWithArenaHolder& holder) {
+      Event e(ep, moduleDescription_, mcc);
+      e.setConsumer(this);
+      this->doAcquire_(e.streamID(), e, c, holder);
+    }
+
     void
     EDProducerBase::doPreallocate(PreallocationConfiguration const& iPrealloc) {
       auto const nStreams = iPrealloc.numberOfStreams();
       previousParentages_.reset(new std::vector<BranchID>[nStreams]);
       previousParentageIds_.reset( new ParentageID[nStreams]);
       preallocStreams(nStreams);
+      preallocLumis(iPrealloc.numberOfLuminosityBlocks());
+      preallocLumisSummary(iPrealloc.numberOfLuminosityBlocks());
     }
     
     void
@@ -193,6 +206,9 @@ namespace edm {
     }
     
     void EDProducerBase::preallocStreams(unsigned int) {}
+    void EDProducerBase::preallocLumis(unsigned int) {}
+    void EDProducerBase::preallocLumisSummary(unsigned int) {}
+    void EDProducerBase::doAcquire_(StreamID, Event const&, edm::EventSetup const&, WaitingTaskWithArenaHolder&) {}
     void EDProducerBase::doBeginStream_(StreamID id){}
     void EDProducerBase::doEndStream_(StreamID id) {}
     void EDProducerBase::doStreamBeginRun_(StreamID id, Run const& rp, EventSetup const& c) {}
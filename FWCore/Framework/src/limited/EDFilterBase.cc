@@ -68,6 +68,8 @@ namespace edm {
       previousParentages_.reset(new std::vector<BranchID>[nStreams]);
       previousParentageIds_.reset(new ParentageID[nStreams]);
       preallocStreams(nStreams);
+      preallocLumis(iPrealloc.numberOfLuminosityBlocks());
+      preallocLumisSummary(iPrealloc.numberOfLuminosityBlocks());
     }
 
     void
@@ -194,6 +196,8 @@ namespace edm {
     }
     
     void EDFilterBase::preallocStreams(unsigned int) {}
+    void EDFilterBase::preallocLumis(unsigned int) {}
+    void EDFilterBase::preallocLumisSummary(unsigned int) {}
     void EDFilterBase::doBeginStream_(StreamID id){}
     void EDFilterBase::doEndStream_(StreamID id) {}
     void EDFilterBase::doStreamBeginRun_(StreamID id, Run const& rp, EventSetup const& c) {}
@@ -73,6 +73,7 @@ void
 EDAnalyzerAdaptorBase::doPreallocate(PreallocationConfiguration const& iPrealloc) {
   m_streamModules.resize(iPrealloc.numberOfStreams(),
                          static_cast<stream::EDAnalyzerBase*>(nullptr));
+  preallocLuminosityBlocks(iPrealloc.numberOfLuminosityBlocks());
   setupStreamModules();
 }
 
@@ -100,6 +101,12 @@ EDAnalyzerAdaptorBase::itemsToGetFrom(BranchType iType) const {
   return m_streamModules[0]->itemsToGetFrom(iType);
 }
 
+edm::EDConsumerBase::ESItems const&
+EDAnalyzerAdaptorBase::esItemsToGet() const {
+  assert(not m_streamModules.empty());
+  return m_streamModules[0]->esItemsToGet();
+}
+
 void
 EDAnalyzerAdaptorBase::updateLookup(BranchType iType,
                                     ProductResolverIndexHelper const& iHelper,
@@ -59,6 +59,23 @@ namespace edm {
       commit(e, &mod->previousParentageId_);
       return true;
     }
+
+    void
+    EDProducerAdaptorBase::doAcquire(EventPrincipal const& ep, EventSetup const& c,
+                                     ActivityRegistry* act,
+                                     ModuleCallingContext const* mcc,
+                                     WaitingTaskWithArenaHolder& holder) {
+      assert(ep.streamID()<m_streamModules.size());
+      auto mod = m_streamModules[ep.streamID()];
+      Event e(ep, moduleDescription(), mcc);
+      e.setConsumer(mod);
+      mod->doAcquire_(e, c, holder);
+    }
+
+    bool
+    EDProducerAdaptorBase::hasAcquire() const {
+      return m_streamModules[0]->hasAcquire();
+    }
     
     template class edm::stream::ProducingModuleAdaptorBase<edm::stream::EDProducerBase>;
   }
@@ -56,6 +56,7 @@ namespace edm {
     ProducingModuleAdaptorBase<T>::doPreallocate(PreallocationConfiguration const& iPrealloc) {
       m_streamModules.resize(iPrealloc.numberOfStreams(),
                              static_cast<T*>(nullptr));
+      preallocLuminosityBlocks(iPrealloc.numberOfLuminosityBlocks());
       setupStreamModules();
     }
 
@@ -104,6 +105,13 @@ namespace edm {
       return m_streamModules[0]->itemsToGetFrom(iType);
     }
 
+    template< typename T>
+    edm::EDConsumerBase::ESItems const&
+    ProducingModuleAdaptorBase<T>::esItemsToGet() const {
+      assert(not m_streamModules.empty());
+      return m_streamModules[0]->esItemsToGet();
+    }
+
     template< typename T>
     void
     ProducingModuleAdaptorBase<T>::modulesWhoseProductsAreConsumed(std::vector<ModuleDescription const*>& modules,
@@ -5,7 +5,10 @@
  *  Created by Chris Jones on 4/8/05.
  *  Changed by Viji Sundararajan on 28-Jun-05
  */
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <thread>
 #include "FWCore/Framework/interface/ESProducer.h"
 #include "FWCore/Framework/test/DummyData.h"
 #include "FWCore/Framework/test/DummyRecord.h"
@@ -35,6 +38,9 @@ CPPUNIT_TEST(dependsOnTest);
 CPPUNIT_TEST(labelTest);
 CPPUNIT_TEST_EXCEPTION(failMultipleRegistration,cms::Exception);
 CPPUNIT_TEST(forceCacheClearTest);
+CPPUNIT_TEST(independentProvidersTest);
+CPPUNIT_TEST(mutuallyDependentProvidersTest);
+CPPUNIT_TEST_EXCEPTION(undeclaredDependencyCycleTest,cms::Exception);
    
 CPPUNIT_TEST_SUITE_END();
 public:
@@ -50,6 +56,9 @@ public:
   void labelTest();
   void failMultipleRegistration();
   void forceCacheClearTest();
+  void independentProvidersTest();
+  void mutuallyDependentProvidersTest();
+  void undeclaredDependencyCycleTest();
 
 private:
 class Test1Producer : public ESProducer {
@@ -388,3 +397,157 @@ void testEsproducer::forceCacheClearTest()
    }
 }
 
+
+class InnerProducer : public ESProducer {
+public:
+   InnerProducer(): ptr_(new DummyData){
+      ptr_->value_ = 0;
+      setWhatProduced(this, "inner");
+   }
+   std::shared_ptr<DummyData> produce(const DummyRecord& /*iRecord*/) {
+      ++ptr_->value_;
+      return ptr_;
+   }
+private:
+   std::shared_ptr<DummyData> ptr_;
+};
+
+//Gets the data of another provider from a different thread while
+// its own produce method is running. If all providers were serialized
+// by one lock this would deadlock.
+class OuterProducer : public ESProducer {
+public:
+   OuterProducer(): ptr_(new DummyData){
+      ptr_->value_ = 0;
+      setWhatProduced(this, "outer");
+   }
+   std::shared_ptr<DummyData> produce(const DummyRecord& iRecord) {
+      std::thread other([this, &iRecord]() {
+         edm::ESHandle<DummyData> pInner;
+         iRecord.get("inner", pInner);
+         ptr_->value_ = 10*pInner->value_;
+      });
+      other.join();
+      return ptr_;
+   }
+private:
+   std::shared_ptr<DummyData> ptr_;
+};
+
+void testEsproducer::independentProvidersTest()
+{
+   EventSetupProvider provider;
+
+   provider.add(std::shared_ptr<DataProxyProvider>(std::make_shared<InnerProducer>()));
+   provider.add(std::shared_ptr<DataProxyProvider>(std::make_shared<OuterProducer>()));
+
+   std::shared_ptr<DummyFinder> pFinder = std::make_shared<DummyFinder>();
+   provider.add(std::shared_ptr<EventSetupRecordIntervalFinder>(pFinder));
+
+   for(int iTime=1; iTime != 3; ++iTime) {
+      const edm::Timestamp time(iTime);
+      pFinder->setInterval(edm::ValidityInterval(edm::IOVSyncValue(time), edm::IOVSyncValue(time)));
+      const edm::EventSetup& eventSetup = provider.eventSetupForInstance(edm::IOVSyncValue(time));
+      edm::ESHandle<DummyData> pDummy;
+      eventSetup.get<DummyRecord>().get("outer", pDummy);
+      CPPUNIT_ASSERT(0 != pDummy.product());
+      CPPUNIT_ASSERT(10*iTime == pDummy->value_);
+   }
+}
+
+//Produces "<name>1" from the "<other>2" of the other producer, and "<name>2".
+// The number of producers inside their "1" method at the same time is recorded.
+class CrossProducer : public ESProducer {
+public:
+   CrossProducer(std::string const& iName, std::string const& iOther, bool iDeclare,
+                 std::atomic<int>& iInside, std::atomic<int>& iMaxInside):
+   other_(iOther+"2"), inside_(iInside), maxInside_(iMaxInside), first_(new DummyData), second_(new DummyData) {
+      second_->value_ = 1;
+      setWhatProduced(this, &CrossProducer::produceFirst, edm::es::Label(iName+"1"));
+      setWhatProduced(this, &CrossProducer::produceSecond, edm::es::Label(iName+"2"));
+      if(iDeclare) {
+         otherToken_ = esConsumes<DummyData, DummyRecord>(other_);
+      }
+   }
+   std::shared_ptr<DummyData> produceFirst(const DummyRecord& iRecord) {
+      int inside = ++inside_;
+      int maxInside = maxInside_;
+      while(inside > maxInside and not maxInside_.compare_exchange_weak(maxInside, inside)) {}
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      edm::ESHandle<DummyData> pOther;
+      iRecord.get(other_, pOther);
+      first_->value_ = 1 + pOther->value_;
+      --inside_;
+      return first_;
+   }
+   std::shared_ptr<DummyData> produceSecond(const DummyRecord& /*iRecord*/) {
+      return second_;
+   }
+private:
+   std::string other_;
+   edm::ESGetToken<DummyData, DummyRecord> otherToken_;
+   std::atomic<int>& inside_;
+   std::atomic<int>& maxInside_;
+   std::shared_ptr<DummyData> first_;
+   std::shared_ptr<DummyData> second_;
+};
+
+//Each producer gets data from the other one, as both declare. They are given one
+// common lock so they never run at the same time and can not deadlock.
+void testEsproducer::mutuallyDependentProvidersTest()
+{
+   EventSetupProvider provider;
+   std::atomic<int> inside(0);
+   std::atomic<int> maxInside(0);
+
+   provider.add(std::shared_ptr<DataProxyProvider>(std::make_shared<CrossProducer>("a", "b", true, inside, maxInside)));
+   provider.add(std::shared_ptr<DataProxyProvider>(std::make_shared<CrossProducer>("b", "a", true, inside, maxInside)));
+
+   std::shared_ptr<DummyFinder> pFinder = std::make_shared<DummyFinder>();
+   provider.add(std::shared_ptr<EventSetupRecordIntervalFinder>(pFinder));
+
+   const edm::Timestamp time(1);
+   pFinder->setInterval(edm::ValidityInterval(edm::IOVSyncValue(time), edm::IOVSyncValue(time)));
+   const edm::EventSetup& eventSetup = provider.eventSetupForInstance(edm::IOVSyncValue(time));
+
+   int a = 0;
+   int b = 0;
+   std::thread other([&eventSetup, &b]() {
+      edm::ESHandle<DummyData> pB;
+      eventSetup.get<DummyRecord>().get("b1", pB);
+      b = pB->value_;
+   });
+   edm::ESHandle<DummyData> pA;
+   eventSetup.get<DummyRecord>().get("a1", pA);
+   a = pA->value_;
+   other.join();
+
+   CPPUNIT_ASSERT(1 == maxInside);
+   CPPUNIT_ASSERT(2 == a);
+   CPPUNIT_ASSERT(2 == b);
+}
+
+//Same as above without declaring the dependencies: once each provider was seen
+// getting data from the other one, the possible deadlock is an exception.
+void testEsproducer::undeclaredDependencyCycleTest()
+{
+   EventSetupProvider provider;
+   std::atomic<int> inside(0);
+   std::atomic<int> maxInside(0);
+
+   provider.add(std::shared_ptr<DataProxyProvider>(std::make_shared<CrossProducer>("a", "b", false, inside, maxInside)));
+   provider.add(std::shared_ptr<DataProxyProvider>(std::make_shared<CrossProducer>("b", "a", false, inside, maxInside)));
+
+   std::shared_ptr<DummyFinder> pFinder = std::make_shared<DummyFinder>();
+   provider.add(std::shared_ptr<EventSetupRecordIntervalFinder>(pFinder));
+
+   const edm::Timestamp time(1);
+   pFinder->setInterval(edm::ValidityInterval(edm::IOVSyncValue(time), edm::IOVSyncValue(time)));
+   const edm::EventSetup& eventSetup = provider.eventSetupForInstance(edm::IOVSyncValue(time));
+
+   edm::ESHandle<DummyData> pA;
+   eventSetup.get<DummyRecord>().get("a1", pA);
+   CPPUNIT_ASSERT(2 == pA->value_);
+   edm::ESHandle<DummyData> pB;
+   eventSetup.get<DummyRecord>().get("b1", pB);
+}
@@ -11,6 +11,10 @@ F4=${LOCAL_TEST_DIR}/test_limited_modules_cfg.py
 (cmsRun $F2 ) || die "Failure using $F2" $?
 (cmsRun $F3 ) || die "Failure using $F3" $?
 (cmsRun $F4 ) || die "Failure using $F4" $?
+(cmsRun ${LOCAL_TEST_DIR}/test_async_lumi_writes_cfg.py ) || die "Failure using test_async_lumi_writes_cfg.py" $?
+(cmsRun ${LOCAL_TEST_DIR}/test_external_work_cfg.py ) || die "Failure using test_external_work_cfg.py" $?
+(cmsRun ${LOCAL_TEST_DIR}/test_adaptive_streams_cfg.py ) || die "Failure using test_adaptive_streams_cfg.py" $?
+(cmsRun ${LOCAL_TEST_DIR}/test_concurrent_module_construction_cfg.py ) || die "Failure using test_concurrent_module_construction_cfg.py" $?
 
 #the last few lines of the output are the printout from the
 # ConcurrentModuleTimer service detailing how much time was
@@ -0,0 +1,112 @@
+/*
+ *  streamautotuner_t.cppunit.cc
+ *  CMSSW
+ *
+ *  Checks the decisions taken by the StreamAutoTuner
+ *
+ */
+
+#include "cppunit/extensions/HelperMacros.h"
+
+#include "FWCore/Framework/src/StreamAutoTuner.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+using namespace edm;
+
+class testStreamAutoTuner: public CppUnit::TestFixture
+{
+   CPPUNIT_TEST_SUITE(testStreamAutoTuner);
+
+   CPPUNIT_TEST(initialTest);
+   CPPUNIT_TEST(growTest);
+   CPPUNIT_TEST(memoryBudgetTest);
+   CPPUNIT_TEST(stallTest);
+   CPPUNIT_TEST_EXCEPTION(badConfigTest, cms::Exception);
+
+   CPPUNIT_TEST_SUITE_END();
+public:
+   void setUp(){}
+   void tearDown(){}
+
+   void initialTest();
+   void growTest();
+   void memoryBudgetTest();
+   void stallTest();
+   void badConfigTest();
+};
+
+///registration of the test so that the runner can find it
+CPPUNIT_TEST_SUITE_REGISTRATION(testStreamAutoTuner);
+
+namespace {
+  ParameterSet makeConfig(unsigned int iInitial, double iBudget, unsigned int iMin = 1) {
+    ParameterSet pset;
+    pset.addUntrackedParameter<unsigned int>("initialNumberOfStreams", iInitial);
+    pset.addUntrackedParameter<unsigned int>("minimumNumberOfStreams", iMin);
+    pset.addUntrackedParameter<double>("memoryBudget", iBudget);
+    return pset;
+  }
+
+  StreamAutoTuner::Measurement measure(double iUtilization, double iStallFraction, double iRSS,
+                                       unsigned int iNThreads, unsigned int iNActive) {
+    StreamAutoTuner::Measurement m;
+    m.seconds = 10.;
+    m.cpuSeconds = iUtilization*m.seconds*iNThreads;
+    m.stallSeconds = iStallFraction*m.seconds*iNActive;
+    m.rssMB = iRSS;
+    return m;
+  }
+}
+
+void testStreamAutoTuner::initialTest()
+{
+  StreamAutoTuner tooMany(makeConfig(10, 0.), 4, 4);
+  CPPUNIT_ASSERT(tooMany.numberOfActiveStreams() == 4);
+
+  StreamAutoTuner belowMin(makeConfig(1, 0., 2), 4, 4);
+  CPPUNIT_ASSERT(belowMin.numberOfActiveStreams() == 2);
+}
+
+void testStreamAutoTuner::growTest()
+{
+  StreamAutoTuner tuner(makeConfig(1, 0.), 4, 4);
+  //idle threads and no stalls: grow up to the number of preallocated streams
+  for(unsigned int i = 2; i <= 4; ++i) {
+    CPPUNIT_ASSERT(tuner.decide(measure(0.3, 0., 1000., 4, i-1)) == i);
+  }
+  CPPUNIT_ASSERT(tuner.decide(measure(0.3, 0., 1000., 4, 4)) == 4);
+
+  //busy threads without stalls: stay
+  CPPUNIT_ASSERT(tuner.decide(measure(0.98, 0., 1000., 4, 4)) == 4);
+}
+
+void testStreamAutoTuner::memoryBudgetTest()
+{
+  StreamAutoTuner tuner(makeConfig(1, 2500.), 8, 8);
+  //first estimate is the full RSS per stream, 1000+1000 fits in the budget
+  CPPUNIT_ASSERT(tuner.decide(measure(0.2, 0., 1000., 8, 1)) == 2);
+  //the second stream cost 200 MB
+  CPPUNIT_ASSERT(tuner.decide(measure(0.3, 0., 1200., 8, 2)) == 3);
+  CPPUNIT_ASSERT(tuner.decide(measure(0.4, 0., 1400., 8, 3)) == 4);
+  CPPUNIT_ASSERT(tuner.decide(measure(0.5, 0., 2400., 8, 4)) == 4);
+  //over budget: shrink
+  CPPUNIT_ASSERT(tuner.decide(measure(0.5, 0., 2600., 8, 4)) == 3);
+}
+
+void testStreamAutoTuner::stallTest()
+{
+  StreamAutoTuner tuner(makeConfig(4, 0., 2), 4, 4);
+  //busy threads and modules waiting for threads: shrink
+  CPPUNIT_ASSERT(tuner.decide(measure(0.99, 0.5, 1000., 4, 4)) == 3);
+  CPPUNIT_ASSERT(tuner.decide(measure(0.99, 0.5, 1000., 4, 3)) == 2);
+  //never below the minimum
+  CPPUNIT_ASSERT(tuner.decide(measure(0.99, 0.5, 1000., 4, 2)) == 2);
+  //stalls with idle threads (e.g. waiting on a shared resource): stay
+  CPPUNIT_ASSERT(tuner.decide(measure(0.5, 0.5, 1000., 4, 2)) == 2);
+}
+
+void testStreamAutoTuner::badConfigTest()
+{
+  StreamAutoTuner tuner(makeConfig(1, 0., 5), 4, 4);
+}
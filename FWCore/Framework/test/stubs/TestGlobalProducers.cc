@@ -11,7 +11,10 @@ for testing purposes only.
 #include <vector>
 #include <map>
 #include <functional>
+#include <chrono>
+#include <thread>
 #include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
 #include "FWCore/Framework/src/WorkerT.h"
 #include "FWCore/Framework/interface/HistoryAppender.h"
 #include "FWCore/ServiceRegistry/interface/ParentContext.h"
@@ -23,6 +26,7 @@ for testing purposes only.
 #include "FWCore/Framework/interface/MakerMacros.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Utilities/interface/EDMException.h"
+#include "TestOffloadPool.h"
 
 
 
@@ -570,6 +574,64 @@ struct Dummy {
     }
   };
 
+  class ExternalWorkIntProducer : public edm::global::EDProducer<edm::StreamCache<UnsafeCache>,edm::ExternalWork> {
+  public:
+    explicit ExternalWorkIntProducer(edm::ParameterSet const& p) :
+	trans_(p.getParameter<int>("transitions")),
+        workTime_(p.getParameter<unsigned int>("workTimeMicroSeconds")),
+        pool_(p.getParameter<unsigned int>("offloadThreads"))
+    {
+    produces<unsigned int>();
+    }
+
+    const unsigned int trans_; 
+    const unsigned int workTime_;
+    mutable std::atomic<unsigned int> m_count{0};
+    edmtest::TestOffloadPool pool_;
+
+    std::unique_ptr<UnsafeCache> beginStream(edm::StreamID iID) const override {
+      return std::make_unique<UnsafeCache>();
+    }
+
+    void acquire(edm::StreamID iID, edm::Event const& iEvent, edm::EventSetup const&, edm::WaitingTaskWithArenaHolder holder) const override {
+      auto sCache = streamCache(iID);
+      if ( sCache->work != 0 ) {
+        throw cms::Exception("out of sequence")
+          << "acquire called twice before produce in Stream " << iID.value();
+      }
+      //the stream cache is only touched by this stream and
+      // produce is not called until doneWaiting is called
+      auto workTime = workTime_;
+      unsigned int value = iEvent.id().event();
+      pool_.push([sCache, workTime, value, holder]() mutable {
+        //stand in for waiting on an external resource
+        std::this_thread::sleep_for(std::chrono::microseconds(workTime));
+        sCache->work = 1;
+        sCache->value = value;
+        holder.doneWaiting(std::exception_ptr{});
+      });
+    }
+
+    void produce(edm::StreamID iID, edm::Event& iEvent, edm::EventSetup const&) const override {
+      ++m_count;
+      auto sCache = streamCache(iID);
+      if ( sCache->work != 1 || sCache->value != iEvent.id().event() ) {
+        throw cms::Exception("out of sequence")
+          << "produce called before the external work finished in Stream " << iID.value();
+      }
+      sCache->work = 0;
+      iEvent.put(std::make_unique<unsigned int>(sCache->value));
+    }
+
+    ~ExternalWorkIntProducer() {
+      if(m_count != trans_) {
+        throw cms::Exception("transitions")
+          << "ExternalWorkIntProducer transitions "
+          << m_count<< " but it was supposed to be " << trans_;
+      }
+    }
+  };
+
 }
 }
 
@@ -582,4 +644,5 @@ DEFINE_FWK_MODULE(edmtest::global::TestBeginRunProducer);
 DEFINE_FWK_MODULE(edmtest::global::TestEndRunProducer);
 DEFINE_FWK_MODULE(edmtest::global::TestBeginLumiBlockProducer);
 DEFINE_FWK_MODULE(edmtest::global::TestEndLumiBlockProducer);
+DEFINE_FWK_MODULE(edmtest::global::ExternalWorkIntProducer);
 
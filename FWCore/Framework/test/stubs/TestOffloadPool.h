@@ -0,0 +1,77 @@
+#ifndef FWCore_Framework_test_stubs_TestOffloadPool_h
+#define FWCore_Framework_test_stubs_TestOffloadPool_h
+
+/*----------------------------------------------------------------------
+
+Stand-in for an external resource (e.g. a co-processor or a remote
+service) used by the ExternalWork test modules. Jobs are run by a set of
+std::threads which are not part of the TBB thread pool.
+
+----------------------------------------------------------------------*/
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace edmtest {
+
+  class TestOffloadPool {
+  public:
+    explicit TestOffloadPool(unsigned int iNThreads) {
+      threads_.reserve(iNThreads);
+      for(unsigned int i=0; i<iNThreads; ++i) {
+        threads_.emplace_back([this]() { this->run(); });
+      }
+    }
+
+    ~TestOffloadPool() {
+      {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stop_ = true;
+      }
+      cond_.notify_all();
+      for(auto& t: threads_) {
+        t.join();
+      }
+    }
+
+    TestOffloadPool(TestOffloadPool const&) = delete;
+    TestOffloadPool& operator=(TestOffloadPool const&) = delete;
+
+    //thread safe
+    void push(std::function<void()> iJob) const {
+      {
+        std::lock_guard<std::mutex> guard(mutex_);
+        jobs_.push_back(std::move(iJob));
+      }
+      cond_.notify_one();
+    }
+
+  private:
+    void run() {
+      while(true) {
+        std::function<void()> job;
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          cond_.wait(lock, [this]() { return stop_ or not jobs_.empty(); });
+          if(jobs_.empty()) {
+            return;
+          }
+          job = std::move(jobs_.front());
+          jobs_.pop_front();
+        }
+        job();
+      }
+    }
+
+    mutable std::mutex mutex_;
+    mutable std::condition_variable cond_;
+    mutable std::deque<std::function<void()>> jobs_;
+    std::vector<std::thread> threads_;
+    bool stop_ = false;
+  };
+}
+
+#endif
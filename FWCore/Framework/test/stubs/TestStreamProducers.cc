@@ -11,7 +11,10 @@ for testing purposes only.
 #include <vector>
 #include <map>
 #include <functional>
+#include <chrono>
+#include <thread>
 #include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/Concurrency/interface/WaitingTaskWithArenaHolder.h"
 #include "FWCore/Framework/src/WorkerT.h"
 #include "FWCore/Framework/interface/HistoryAppender.h"
 #include "FWCore/ServiceRegistry/interface/ParentContext.h"
@@ -21,6 +24,7 @@ for testing purposes only.
 #include "FWCore/Framework/interface/MakerMacros.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Utilities/interface/EDMException.h"
+#include "TestOffloadPool.h"
 
 
 
@@ -671,6 +675,65 @@ struct UnsafeCache {
     }
   };
 
+  class ExternalWorkIntProducer : public edm::stream::EDProducer<edm::GlobalCache<edmtest::TestOffloadPool>,edm::ExternalWork> {
+  public:
+    static std::atomic<unsigned int> m_count;
+    unsigned int trans_;
+    unsigned int workTime_;
+    //set by the offload thread, read in produce
+    unsigned int value_ = 0;
+    bool workDone_ = false;
+
+    static std::unique_ptr<edmtest::TestOffloadPool> initializeGlobalCache(edm::ParameterSet const& p) {
+      return std::make_unique<edmtest::TestOffloadPool>(p.getParameter<unsigned int>("offloadThreads"));
+    }
+
+    ExternalWorkIntProducer(edm::ParameterSet const& p, const edmtest::TestOffloadPool*)  {
+      trans_ = p.getParameter<int>("transitions");
+      workTime_ = p.getParameter<unsigned int>("workTimeMicroSeconds");
+      produces<unsigned int>();
+    }
+
+    void acquire(edm::Event const& iEvent, edm::EventSetup const&, edm::WaitingTaskWithArenaHolder holder) override {
+      if ( workDone_ ) {
+        throw cms::Exception("out of sequence")
+          << "acquire called twice before produce";
+      }
+      auto workTime = workTime_;
+      unsigned int value = iEvent.id().event();
+      //produce is not called until doneWaiting is called so it is safe to
+      // modify this stream's module from the offload thread
+      auto module = this;
+      globalCache()->push([module, workTime, value, holder]() mutable {
+        //stand in for waiting on an external resource
+        std::this_thread::sleep_for(std::chrono::microseconds(workTime));
+        module->value_ = value;
+        module->workDone_ = true;
+        holder.doneWaiting(std::exception_ptr{});
+      });
+    }
+
+    void produce(edm::Event& iEvent, edm::EventSetup const&) override {
+      ++m_count;
+      if ( !workDone_ || value_ != iEvent.id().event() ) {
+        throw cms::Exception("out of sequence")
+          << "produce called before the external work finished";
+      }
+      workDone_ = false;
+      iEvent.put(std::make_unique<unsigned int>(value_));
+    }
+
+    static void globalEndJob(edmtest::TestOffloadPool*) {
+    }
+
+    ~ExternalWorkIntProducer() {
+      if(m_count != trans_) {
+        throw cms::Exception("transitions")
+          << m_count<< " but it was supposed to be " << trans_;
+      }
+    }
+  };
+
 
    
 
@@ -685,6 +748,7 @@ std::atomic<unsigned int> edmtest::stream::TestBeginRunProducer::m_count{0};
 std::atomic<unsigned int> edmtest::stream::TestEndRunProducer::m_count{0};
 std::atomic<unsigned int> edmtest::stream::TestBeginLumiBlockProducer::m_count{0};
 std::atomic<unsigned int> edmtest::stream::TestEndLumiBlockProducer::m_count{0};
+std::atomic<unsigned int> edmtest::stream::ExternalWorkIntProducer::m_count{0};
 std::atomic<unsigned int> edmtest::stream::GlobalIntProducer::cvalue_{0};
 std::atomic<unsigned int> edmtest::stream::RunIntProducer::cvalue_{0};
 std::atomic<unsigned int> edmtest::stream::LumiIntProducer::cvalue_{0};
@@ -737,4 +801,5 @@ DEFINE_FWK_MODULE(edmtest::stream::TestBeginRunProducer);
 DEFINE_FWK_MODULE(edmtest::stream::TestEndRunProducer);
 DEFINE_FWK_MODULE(edmtest::stream::TestBeginLumiBlockProducer);
 DEFINE_FWK_MODULE(edmtest::stream::TestEndLumiBlockProducer);
+DEFINE_FWK_MODULE(edmtest::stream::ExternalWorkIntProducer);
 
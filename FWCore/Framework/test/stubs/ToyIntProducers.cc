@@ -156,8 +156,14 @@ namespace edmtest {
     explicit BusyWaitIntProducer(edm::ParameterSet const& p) :
     value_(p.getParameter<int>("ivalue")),
     iterations_(p.getParameter<unsigned int>("iterations")),
-    pi_(std::acos(-1)){
+    pi_(std::acos(-1)),
+    constructionSum_(0.) {
       produces<IntProduct>();
+      //optionally mimics a module doing expensive work in its constructor
+      auto const constructionIterations = p.getUntrackedParameter<unsigned int>("constructionIterations", 0);
+      for(unsigned int i = 0; i < constructionIterations; ++i) {
+        constructionSum_ += std::cos(i*pi_/constructionIterations);
+      }
     }
 
     virtual void produce(edm::StreamID, edm::Event& e, edm::EventSetup const& c) const override;
@@ -166,6 +172,7 @@ namespace edmtest {
     const int value_;
     const unsigned int iterations_;
     const double pi_;
+    double constructionSum_;
     
   };
   
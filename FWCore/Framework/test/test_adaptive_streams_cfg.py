@@ -0,0 +1,44 @@
+import FWCore.ParameterSet.Config as cms
+
+nEvtLumi = 4
+nEvtRun = 2*nEvtLumi
+nStreams = 4
+nEvt = 5*nEvtRun
+
+process = cms.Process("TESTADAPTIVESTREAMS")
+
+import FWCore.Framework.test.cmsExceptionsFatalOption_cff
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(nStreams),
+    numberOfStreams = cms.untracked.uint32(nStreams),
+    # change the number of active streams at every luminosity block
+    adaptiveStreams = cms.untracked.PSet(
+        initialNumberOfStreams = cms.untracked.uint32(1),
+        minimumSecondsBetweenChanges = cms.untracked.double(0.),
+        memoryBudget = cms.untracked.double(0.)
+    )
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(nEvt)
+)
+
+process.source = cms.Source("EmptySource",
+    timeBetweenEvents = cms.untracked.uint64(1000),
+    firstTime = cms.untracked.uint64(1000000),
+    numberEventsInRun = cms.untracked.uint32(nEvtRun),
+    numberEventsInLuminosityBlock = cms.untracked.uint32(nEvtLumi)
+)
+
+process.LumiIntProd = cms.EDProducer("edmtest::global::LumiIntProducer",
+    transitions = cms.int32(2*(nEvt/nEvtLumi))
+    ,cachevalue = cms.int32(nEvtLumi)
+)
+
+process.LumiIntAn = cms.EDAnalyzer("edmtest::global::LumiIntAnalyzer",
+    transitions = cms.int32(nEvt+2*(nEvt/nEvtLumi))
+    ,cachevalue = cms.int32(nEvtLumi)
+)
+
+process.p = cms.Path(process.LumiIntProd+process.LumiIntAn)
@@ -0,0 +1,58 @@
+import FWCore.ParameterSet.Config as cms
+
+nEvtLumi = 4
+nEvtRun = 2*nEvtLumi
+nStreams = 4
+nEvt = nStreams*nEvtRun*nEvtLumi
+
+process = cms.Process("TESTASYNCLUMIWRITES")
+
+import FWCore.Framework.test.cmsExceptionsFatalOption_cff
+
+process.options = cms.untracked.PSet(
+    numberOfStreams = cms.untracked.uint32(nStreams),
+    writeLuminosityBlocksAsynchronously = cms.untracked.bool(True)
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(nEvt)
+)
+
+process.source = cms.Source("EmptySource",
+    timeBetweenEvents = cms.untracked.uint64(1000),
+    firstTime = cms.untracked.uint64(1000000),
+    numberEventsInRun = cms.untracked.uint32(nEvtRun),
+    numberEventsInLuminosityBlock = cms.untracked.uint32(nEvtLumi)
+)
+
+process.LumiIntProd = cms.EDProducer("edmtest::global::LumiIntProducer",
+    transitions = cms.int32(2*(nEvt/nEvtLumi))
+    ,cachevalue = cms.int32(nEvtLumi)
+)
+
+process.LumiSumIntProd = cms.EDProducer("edmtest::global::LumiSummaryIntProducer",
+    transitions = cms.int32(nStreams*(nEvt/nEvtLumi)+2*(nEvt/nEvtLumi))
+    ,cachevalue = cms.int32(nEvtLumi)
+)
+
+process.LumiIntAn = cms.EDAnalyzer("edmtest::global::LumiIntAnalyzer",
+    transitions = cms.int32(nEvt+2*(nEvt/nEvtLumi))
+    ,cachevalue = cms.int32(nEvtLumi)
+)
+
+process.LumiSumIntAn = cms.EDAnalyzer("edmtest::global::LumiSummaryIntAnalyzer",
+    transitions = cms.int32(nEvt+nStreams*((nEvt/nEvtLumi)+1)+2*(nEvt/nEvtLumi))
+    ,cachevalue = cms.int32(nEvtLumi)
+)
+
+process.TestEndLumiBlockProd = cms.EDProducer("edmtest::global::TestEndLumiBlockProducer",
+    transitions = cms.int32((nEvt/nEvtLumi))
+)
+
+process.out = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('testAsyncLumiWrites.root')
+)
+
+process.p = cms.Path(process.LumiIntProd+process.LumiSumIntProd+process.LumiIntAn+process.LumiSumIntAn+process.TestEndLumiBlockProd)
+
+process.e = cms.EndPath(process.out)
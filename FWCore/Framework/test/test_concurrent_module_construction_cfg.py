@@ -0,0 +1,58 @@
+# Constructs a mix of global, stream and legacy modules with
+# concurrentModuleConstruction. The global and stream modules are
+# constructed in parallel, the legacy ones serially, and the sums checked
+# by the analyzer only work if all products were properly registered.
+#
+# To measure the startup time, raise nModules and constructionIterations
+# and compare 'time cmsRun' with concurrentModuleConstruction switched off.
+
+import FWCore.ParameterSet.Config as cms
+
+nModules = 50
+constructionIterations = 100000
+nThreads = 4
+
+process = cms.Process("TESTCONCURRENTCONSTRUCTION")
+
+import FWCore.Framework.test.cmsExceptionsFatalOption_cff
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(nThreads),
+    numberOfStreams = cms.untracked.uint32(nThreads),
+    concurrentModuleConstruction = cms.untracked.bool(True)
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(10)
+)
+
+process.source = cms.Source("EmptySource")
+
+onPath = []
+summed = []
+for i in range(nModules):
+    busy = cms.EDProducer("BusyWaitIntProducer",
+                          ivalue = cms.int32(i),
+                          iterations = cms.uint32(10),
+                          constructionIterations = cms.untracked.uint32(constructionIterations))
+    setattr(process, "busy%d" % i, busy)
+    onPath.append(busy)
+
+    stream = cms.EDProducer("IntProducer", ivalue = cms.int32(i))
+    setattr(process, "stream%d" % i, stream)
+    onPath.append(stream)
+    summed.append("stream%d" % i)
+
+    # not on any Path so constructed as unscheduled
+    setattr(process, "legacy%d" % i, cms.EDProducer("IntLegacyProducer", ivalue = cms.int32(i)))
+    summed.append("legacy%d" % i)
+
+process.sum = cms.EDProducer("AddIntsProducer", labels = cms.vstring(*summed))
+
+process.test = cms.EDAnalyzer("IntTestAnalyzer",
+    valueMustMatch = cms.untracked.int32(nModules*(nModules-1)),
+    moduleLabel = cms.untracked.string("sum")
+)
+
+process.p = cms.Path(reduce(lambda a, b: a+b, onPath))
+process.e = cms.EndPath(process.test)
@@ -0,0 +1,43 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(3))
+
+# no 'canDeleteEarly' or 'mightGet', the consumes calls are used instead
+process.options = cms.untracked.PSet(
+        deleteEarlyFromConsumes = cms.untracked.bool(True))
+
+
+process.maker = cms.EDProducer("DeleteEarlyProducer")
+
+process.reader = cms.EDAnalyzer("DeleteEarlyReader",
+                                tag = cms.untracked.InputTag("maker"))
+
+# kept by the output module, so never deleted early
+process.keptMaker = cms.EDProducer("DeleteEarlyProducer")
+
+process.keptReader = cms.EDAnalyzer("DeleteEarlyReader",
+                                    tag = cms.untracked.InputTag("keptMaker"))
+
+# each event deletes the product of 'maker' early and both products of
+# the previous event
+process.tester = cms.EDAnalyzer("DeleteEarlyCheckDeleteAnalyzer",
+                                expectedValues = cms.untracked.vuint32(1,3,5))
+
+process.out = cms.OutputModule("SewerModule",
+                               shouldPass = cms.int32(3),
+                               name = cms.string('for_keptMaker'),
+                               outputCommands = cms.untracked.vstring('drop *',
+                                                                      'keep *_keptMaker_*_*'))
+
+process.p = cms.Path(process.maker+process.keptMaker+process.reader+process.keptReader+process.tester)
+
+# the output module consumes the product of 'keptMaker', which must not
+# be deleted once it has run
+process.testerAfterOutput = cms.EDAnalyzer("DeleteEarlyCheckDeleteAnalyzer",
+                                           expectedValues = cms.untracked.vuint32(1,3,5))
+
+process.e = cms.EndPath(process.out+process.testerAfterOutput)
@@ -0,0 +1,36 @@
+import FWCore.ParameterSet.Config as cms
+
+nStreams = 8
+nEvt = 4*nStreams
+
+process = cms.Process("TESTEXTERNALWORK")
+
+import FWCore.Framework.test.cmsExceptionsFatalOption_cff
+
+# Only 2 threads are used for 8 streams. While a module waits for its
+# external work the thread is free to run the other streams, so all
+# streams can wait on the offload pool at the same time.
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(2),
+    numberOfStreams = cms.untracked.uint32(nStreams)
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(nEvt)
+)
+
+process.source = cms.Source("EmptySource")
+
+process.GlobalExternalWorkProd = cms.EDProducer("edmtest::global::ExternalWorkIntProducer",
+    transitions = cms.int32(nEvt),
+    workTimeMicroSeconds = cms.uint32(10000),
+    offloadThreads = cms.uint32(nStreams)
+)
+
+process.StreamExternalWorkProd = cms.EDProducer("edmtest::stream::ExternalWorkIntProducer",
+    transitions = cms.int32(nEvt),
+    workTimeMicroSeconds = cms.uint32(10000),
+    offloadThreads = cms.uint32(nStreams)
+)
+
+process.p = cms.Path(process.GlobalExternalWorkProd+process.StreamExternalWorkProd)
@@ -29,6 +29,7 @@
 // system include files
 
 #include <string>
+#include <vector>
 
 // Change log
 //
@@ -69,6 +70,9 @@
 //
 // 13  wmtan 11/11/11   Make non-copyable to satisfy Coverity. Would otherwise
 //                      need special copy ctor and copy assignment operator.
+//
+// 14  Categories listed in suppressedCategories are dropped before any
+//                      ErrorObj is made or any formatting is done.
 
 
 // user include files
@@ -112,6 +116,9 @@ public:
   CMS_THREAD_SAFE static bool debugAlwaysSuppressed;			// change log 9
   CMS_THREAD_SAFE static bool infoAlwaysSuppressed;			// change log 9
   CMS_THREAD_SAFE static bool warningAlwaysSuppressed;			// change log 9
+  // only changed while configuring the MessageLogger, kept sorted
+  CMS_THREAD_SAFE static std::vector<std::string> suppressedCategories;	// change log 14
+  static bool categorySuppressed(std::string const& category);		// change log 14
 private:
   edm::propagate_const<messagedrop::StringProducerWithPhase*> spWithPhase;
   edm::propagate_const<messagedrop::StringProducerPath*> spPath;
@@ -11,6 +11,7 @@
 //
 
 // system include files
+#include <algorithm>
 #include <cstring>
 #include <limits>
 
@@ -44,6 +45,9 @@
 //
 // 7  fwyzard 7/6/11    Add support for discarding LogError-level messages
 //                      on a per-module basis (needed at HLT)
+//
+// 8  suppressedCategories allows dropping messages of a category before
+//                      the message is formatted
 
 using namespace edm;
 
@@ -54,6 +58,15 @@ using namespace edm;
 bool MessageDrop::debugAlwaysSuppressed=false;		// change log 2
 bool MessageDrop::infoAlwaysSuppressed=false;	 	// change log 2
 bool MessageDrop::warningAlwaysSuppressed=false; 	// change log 2
+std::vector<std::string> MessageDrop::suppressedCategories;	// change log 8
+
+bool MessageDrop::categorySuppressed(std::string const& category) {
+  if(suppressedCategories.empty()) {
+    return false;
+  }
+  return std::binary_search(suppressedCategories.begin(), suppressedCategories.end(), category);
+}
+
 std::string MessageDrop::jobMode{};
 
 MessageDrop *
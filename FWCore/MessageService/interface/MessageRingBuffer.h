@@ -0,0 +1,113 @@
+#ifndef FWCore_MessageService_MessageRingBuffer_h
+#define FWCore_MessageService_MessageRingBuffer_h
+// -*- C++ -*-
+//
+// Package:     MessageService
+// Class  :     MessageRingBuffer
+//
+/**\class MessageRingBuffer MessageRingBuffer.h FWCore/MessageService/interface/MessageRingBuffer.h
+
+ Description: Bounded lock-free queue of messages with one producer and one consumer
+
+ Usage:
+    Each thread sending messages owns one MessageRingBuffer and is the only
+ one calling push. The thread draining the messages is the only one calling
+ pop. Neither call blocks or allocates.
+    The producer brackets its pushes with beginPush and endPush so that
+ waitForPush can block until a push which may have started is over.
+
+*/
+//
+// Original Author:  FWCore
+//         Created:  Wed, 18 Oct 2017 14:02:11 GMT
+//
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace edm {
+  class ErrorObj;
+
+  namespace service {
+
+    class MessageRingBuffer {
+    public:
+      ///iSize is rounded up to the next power of 2
+      explicit MessageRingBuffer(std::size_t iSize) {
+        std::size_t size = 1;
+        while(size < iSize) {
+          size <<= 1;
+        }
+        slots_.resize(size, nullptr);
+        mask_ = size-1;
+      }
+      MessageRingBuffer(MessageRingBuffer const&) = delete;
+      MessageRingBuffer& operator=(MessageRingBuffer const&) = delete;
+
+      ///only called by the producer, returns false if the buffer is full
+      bool push(ErrorObj* iMsg) {
+        auto const tail = tail_.load(std::memory_order_relaxed);
+        if(tail - head_.load(std::memory_order_acquire) > mask_) {
+          return false;
+        }
+        slots_[tail & mask_] = iMsg;
+        tail_.store(tail+1, std::memory_order_release);
+        return true;
+      }
+
+      ///only called by the consumer, returns nullptr if the buffer is empty
+      ErrorObj* pop() {
+        auto const head = head_.load(std::memory_order_relaxed);
+        if(head == tail_.load(std::memory_order_acquire)) {
+          return nullptr;
+        }
+        ErrorObj* msg = slots_[head & mask_];
+        head_.store(head+1, std::memory_order_release);
+        return msg;
+      }
+
+      std::size_t capacity() const { return mask_+1; }
+
+      ///only called by the producer before it decides to push
+      void beginPush() {
+        pushing_.store(true);
+      }
+
+      ///only called by the producer once it is done pushing
+      void endPush() {
+        pushing_.store(false);
+        if(waiting_.load()) {
+          std::lock_guard<std::mutex> guard(mutex_);
+          pushDone_.notify_all();
+        }
+      }
+
+      ///blocks until the producer is not between beginPush and endPush
+      void waitForPush() {
+        waiting_.store(true);
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          pushDone_.wait(lock, [this]() { return not pushing_.load(); });
+        }
+        waiting_.store(false);
+      }
+
+    private:
+      std::vector<ErrorObj*> slots_;
+      std::size_t mask_;
+      //keep the indices on different cache lines to avoid false sharing
+      alignas(64) std::atomic<std::size_t> head_{0};
+      alignas(64) std::atomic<std::size_t> tail_{0};
+      //only written by the producer, except when someone waits for it
+      std::atomic<bool> pushing_{false};
+      std::atomic<bool> waiting_{false};
+      std::mutex mutex_;
+      std::condition_variable pushDone_;
+    };
+  }
+}
+
+#endif
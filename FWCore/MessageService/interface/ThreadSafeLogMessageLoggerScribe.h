@@ -19,6 +19,8 @@
 
 #include <iostream>
 #include <atomic>
+#include <mutex>
+#include <thread>
 #include "tbb/concurrent_queue.h"
 
 namespace edm {
@@ -30,10 +32,18 @@ namespace service {
 //
 // OpCodeLOG_A_MESSAGE messages can be handled from multiple threads
 //
+// If 'async_buffer_size' is set, each thread sending messages puts them
+// into its own bounded MessageRingBuffer and a dedicated thread routes
+// them to the destinations. The sending threads then never wait on a lock.
+// 'async_drop_policy' decides what happens when a buffer is full:
+// "discard" (the default) drops the message and counts it, "wait" makes
+// the sending thread wait until there is room.
+//
 // -----------------------------------------------------------------------
 
 class ELadministrator;
 class ELstatistics;
+class MessageRingBuffer;
 
 class ThreadSafeLogMessageLoggerScribe : public AbstractMLscribe
 {
@@ -59,6 +69,14 @@ private:
 
   // --- log one consumed message
   void log(ErrorObj * errorobj_p);
+  void route(ErrorObj * errorobj_p);
+
+  // --- asynchronous mode
+  void startDrainThread(size_t bufferSize, bool waitWhenFull);
+  void stopDrainThread();
+  void drainLoop();
+  bool drainRingBuffers();
+  MessageRingBuffer* ringBufferForThisThread();
 
   // --- cause statistics destinations to output
   void triggerStatisticsSummaries();
@@ -111,6 +129,17 @@ private:
   tbb::concurrent_queue<ErrorObj*> m_waitingMessages;
   size_t m_waitingThreshold;
   std::atomic<unsigned long> m_tooManyWaitingMessagesCount;
+
+  // asynchronous mode
+  unsigned int const m_id;
+  std::atomic<bool> m_async;
+  std::atomic<bool> m_stopDrain;
+  bool m_waitWhenFull;
+  size_t m_ringBufferSize;
+  std::mutex m_ringBuffersMutex;  // only taken when a thread sends its first message
+  std::vector<std::unique_ptr<MessageRingBuffer>> m_ringBuffers;
+  std::mutex m_drainMutex;        // held while messages are routed asynchronously
+  std::thread m_drainThread;
   
 };  // ThreadSafeLogMessageLoggerScribe
 
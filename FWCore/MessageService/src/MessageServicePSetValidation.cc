@@ -68,6 +68,15 @@ messageLoggerPSet (ParameterSet const & pset)
   if (!thresh.empty()) validateThreshold(thresh, "MessageLogger");
   check<unsigned int>
   ( pset, "MessageLogger", "waiting_threshold");
+  check<unsigned int>
+  ( pset, "MessageLogger", "async_buffer_size");
+  std::string dropPolicy = check<std::string>
+  	( pset, "MessageLogger", "async_drop_policy" );
+  if (!dropPolicy.empty() && dropPolicy != "discard" && dropPolicy != "wait") {
+    flaws << "MessageLogger" << " PSet: \n"
+          << "async_drop_policy" << " is " << dropPolicy << "\n"
+          << "Allowed values are discard and wait\n";
+  }
   
   // Nested PSets
 
@@ -84,14 +93,20 @@ messageLoggerPSet (ParameterSet const & pset)
   // Nothing else -- look for int, unsigned int, bool, float, double, string
 
   noneExcept <int> (pset, "MessageLogger", "int");
-  noneExcept <unsigned int> (pset, "MessageLogger", "unsigned int","waiting_threshold");
+  vString okuint;
+  okuint.push_back ("waiting_threshold");
+  okuint.push_back ("async_buffer_size");
+  noneExcept <unsigned int> (pset, "MessageLogger", "unsigned int", okuint);
   noneExcept <bool> (pset, "MessageLogger","bool","messageSummaryToJobReport");
   	// Note - at this, the upper MessageLogger PSet level, the use of 
 	// optionalPSet makes no sense, so we are OK letting that be a flaw
   noneExcept <float> (pset, "MessageLogger","float");
   noneExcept <double> (pset, "MessageLogger","double");
-  noneExcept <std::string> (pset, "MessageLogger","string", 
-  		            "threshold", "generate_preconfiguration_message");
+  vString okstring;
+  okstring.push_back ("threshold");
+  okstring.push_back ("generate_preconfiguration_message");
+  okstring.push_back ("async_drop_policy");
+  noneExcept <std::string> (pset, "MessageLogger","string", okstring);
 
   // Append explanatory information if flaws were found
   
@@ -244,6 +259,7 @@ allowedVstring (std::string const & s)
   if (s == "suppressDebug") 	return true;
   if (s == "suppressWarning") 	return true;
   if (s == "suppressError") 	return true;
+  if (s == "suppressCategories") 	return true;
   return false;
 }  // allowedVstring
 
@@ -356,6 +372,7 @@ keywordCheck(std::string const & word)
   if (word == "suppressDebug") 	return false;
   if (word == "suppressWarning")return false;
   if (word == "suppressError")  return false;
+  if (word == "suppressCategories") return false;
   if (word == "threshold") 	return false;
   if (word == "ERROR") 		return false;
   if (word == "WARNING") 	return false;
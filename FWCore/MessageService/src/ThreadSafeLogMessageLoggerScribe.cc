@@ -14,6 +14,7 @@
 #include "FWCore/MessageService/interface/ELoutput.h"
 #include "FWCore/MessageService/interface/ELstatistics.h"
 #include "FWCore/MessageService/interface/ThreadQueue.h"
+#include "FWCore/MessageService/interface/MessageRingBuffer.h"
 
 #include "FWCore/MessageLogger/interface/ErrorObj.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
@@ -26,12 +27,35 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <fstream>
 #include <string>
 #include <csignal>
 
 using std::cerr;
 
+namespace {
+  std::atomic<unsigned int> s_nextScribeID{0};
+
+  //cache of the MessageRingBuffer used by this thread
+  struct ThreadRingBuffer {
+    unsigned int scribeID = ~0U;
+    edm::service::MessageRingBuffer* buffer = nullptr;
+  };
+  thread_local ThreadRingBuffer t_ringBuffer;
+
+  //true while this thread may route messages itself in asynchronous mode
+  thread_local bool t_routesMessages = false;
+
+  class RoutingSentry {
+  public:
+    RoutingSentry(): previous_(t_routesMessages) { t_routesMessages = true; }
+    ~RoutingSentry() { t_routesMessages = previous_; }
+  private:
+    bool previous_;
+  };
+}
+
 namespace edm {
   namespace service {
     
@@ -48,11 +72,18 @@ namespace edm {
     , m_messageBeingSent(false)
     , m_waitingThreshold(100)
     , m_tooManyWaitingMessagesCount(0)
+    , m_id(s_nextScribeID++)
+    , m_async(false)
+    , m_stopDrain(false)
+    , m_waitWhenFull(false)
+    , m_ringBufferSize(0)
     {
     }
     
     ThreadSafeLogMessageLoggerScribe::~ThreadSafeLogMessageLoggerScribe()
     {
+      stopDrainThread();
+
       //if there are any waiting message, finish them off
       ErrorObj* errorobj_p=nullptr;
       std::vector<std::string> categories;
@@ -76,6 +107,15 @@ namespace edm {
                                                  MessageLoggerQ::OpCode  opcode,
                                                  void * operand)
     {
+      //In asynchronous mode, everything but the logging of a message must
+      // wait until all earlier messages have been routed
+      std::unique_lock<std::mutex> drainLock;
+      std::unique_ptr<RoutingSentry> sentry;
+      if(opcode != MessageLoggerQ::LOG_A_MESSAGE and m_async.load()) {
+        drainLock = std::unique_lock<std::mutex>(m_drainMutex);
+        sentry = std::make_unique<RoutingSentry>();
+        drainRingBuffers();
+      }
       switch(opcode)  {  // interpret the work item
         default:  {
           assert(false);  // can't happen (we certainly hope!)
@@ -176,6 +216,36 @@ namespace edm {
     }  // ThreadSafeLogMessageLoggerScribe::runCommand(opcode, operand)
     
     void ThreadSafeLogMessageLoggerScribe::log ( ErrorObj *  errorobj_p ) {
+      if(not t_routesMessages and m_async.load()) {
+        auto buffer = ringBufferForThisThread();
+        //stopDrainThread switches off the asynchronous mode then waits for the pushes
+        // in flight in each ring buffer before its final drain, so a message pushed
+        // meanwhile cannot be left behind in a ring buffer
+        buffer->beginPush();
+        if(m_async.load()) {
+          bool pushed = buffer->push(errorobj_p);
+          if(not pushed and m_waitWhenFull) {
+            while(not (pushed = buffer->push(errorobj_p)) and m_async.load()) {
+              std::this_thread::yield();
+            }
+          }
+          if(pushed or not m_waitWhenFull) {
+            buffer->endPush();
+            if(not pushed) {
+              ++m_tooManyWaitingMessagesCount;
+              delete errorobj_p;
+            }
+            return;
+          }
+        }
+        buffer->endPush();
+        //the drain thread was stopped meanwhile, send the message synchronously
+      }
+      if(t_routesMessages) {
+        //we already have exclusive access to the destinations
+        route(errorobj_p);
+        return;
+      }
       bool expected = false;
       std::unique_ptr<ErrorObj> obj(errorobj_p);
       if(m_messageBeingSent.compare_exchange_strong(expected,true)) {
@@ -206,6 +276,131 @@ namespace edm {
         }
       }
     }
+
+    void ThreadSafeLogMessageLoggerScribe::route ( ErrorObj *  errorobj_p ) {
+      std::unique_ptr<ErrorObj> obj(errorobj_p);
+      std::vector<std::string> categories;
+      parseCategories(errorobj_p->xid().id, categories);
+      for (unsigned int icat = 0; icat < categories.size(); ++icat) {
+        errorobj_p->setID(categories[icat]);
+        admin_p->log( *errorobj_p );  // route the message text
+      }
+    }
+
+    MessageRingBuffer* ThreadSafeLogMessageLoggerScribe::ringBufferForThisThread() {
+      if(t_ringBuffer.scribeID != m_id) {
+        auto buffer = std::make_unique<MessageRingBuffer>(m_ringBufferSize);
+        t_ringBuffer.buffer = buffer.get();
+        t_ringBuffer.scribeID = m_id;
+        std::lock_guard<std::mutex> guard(m_ringBuffersMutex);
+        m_ringBuffers.push_back(std::move(buffer));
+      }
+      return t_ringBuffer.buffer;
+    }
+
+    bool ThreadSafeLogMessageLoggerScribe::drainRingBuffers() {
+      //caller must hold m_drainMutex
+      bool routedAny = false;
+      std::lock_guard<std::mutex> guard(m_ringBuffersMutex);
+      for(auto& buffer: m_ringBuffers) {
+        while(ErrorObj* errorobj_p = buffer->pop()) {
+          routedAny = true;
+          if(not active or purge_mode) {
+            delete errorobj_p;
+            continue;
+          }
+          try {
+            route(errorobj_p);
+          }
+          catch(cms::Exception& e)
+          {
+            ++count;
+            std::cerr << "ThreadSafeLogMessageLoggerScribe caught " << count
+            << " cms::Exceptions, text = \n"
+            << e.what() << "\n";
+            
+            if(count > 25)
+            {
+              cerr << "MessageLogger will no longer be processing "
+              << "messages due to errors (entering purge mode).\n";
+              purge_mode = true;
+            }
+          }
+          catch(...)
+          {
+            std::cerr << "ThreadSafeLogMessageLoggerScribe caught an unknown exception and "
+            << "will no longer be processing "
+            << "messages. (entering purge mode)\n";
+            purge_mode = true;
+          }
+        }
+      }
+      return routedAny;
+    }
+
+    void ThreadSafeLogMessageLoggerScribe::drainLoop() {
+      RoutingSentry sentry;
+      std::chrono::microseconds const kMinSleep(50);
+      std::chrono::microseconds const kMaxSleep(5000);
+      auto sleep = kMinSleep;
+      while(not m_stopDrain.load()) {
+        bool routedAny;
+        {
+          std::lock_guard<std::mutex> guard(m_drainMutex);
+          routedAny = drainRingBuffers();
+        }
+        if(routedAny) {
+          sleep = kMinSleep;
+        } else {
+          //back off while the job is quiet
+          std::this_thread::sleep_for(sleep);
+          sleep = std::min(2*sleep, kMaxSleep);
+        }
+      }
+    }
+
+    void ThreadSafeLogMessageLoggerScribe::startDrainThread(size_t bufferSize, bool waitWhenFull) {
+      if(m_async.load()) {
+        //buffers already handed out keep their size
+        return;
+      }
+      m_ringBufferSize = bufferSize;
+      m_waitWhenFull = waitWhenFull;
+      m_stopDrain = false;
+      m_drainThread = std::thread([this]() { drainLoop(); });
+      m_async = true;
+    }
+
+    void ThreadSafeLogMessageLoggerScribe::stopDrainThread() {
+      if(not m_drainThread.joinable()) {
+        return;
+      }
+      m_async = false;
+      m_stopDrain = true;
+      m_drainThread.join();
+
+      //messages may still be pushed by log() calls which saw the asynchronous
+      // mode before it was switched off, wait for them and route what is left
+      {
+        std::lock_guard<std::mutex> guard(m_ringBuffersMutex);
+        for(auto& buffer: m_ringBuffers) {
+          buffer->waitForPush();
+        }
+      }
+      //keep the synchronous senders away from the destinations meanwhile,
+      // their messages are queued in m_waitingMessages
+      bool expected = false;
+      while(not m_messageBeingSent.compare_exchange_weak(expected,true)) {
+        expected = false;
+        std::this_thread::yield();
+      }
+      {
+        RoutingSentry sentry;
+        std::lock_guard<std::mutex> guard(m_drainMutex);
+        drainRingBuffers();
+      }
+      m_messageBeingSent.store(false);
+    }
     
     void
     ThreadSafeLogMessageLoggerScribe::configure_errorlog()
@@ -235,6 +430,26 @@ namespace edm {
       m_waitingThreshold = getAparameter<unsigned int>(*job_pset_p,
                                                       "waiting_threshold",
                                                       100);
+
+      // categories dropped before the message is even formatted
+      vString suppressed
+      = getAparameter<vString>(*job_pset_p, "suppressCategories", empty_vString);
+      std::sort(suppressed.begin(), suppressed.end());
+      suppressed.erase(std::unique(suppressed.begin(), suppressed.end()), suppressed.end());
+      MessageDrop::suppressedCategories = suppressed;
+
+      unsigned int asyncBufferSize
+      = getAparameter<unsigned int>(*job_pset_p, "async_buffer_size", 0);
+      if(asyncBufferSize > 0) {
+        String dropPolicy
+        = getAparameter<String>(*job_pset_p, "async_drop_policy", "discard");
+        if(dropPolicy != "discard" and dropPolicy != "wait") {
+          throw edm::Exception ( edm::errors::Configuration )
+          << "MessageLogger parameter async_drop_policy must be either "
+          << "\"discard\" or \"wait\" but is \"" << dropPolicy << "\"\n";
+        }
+        startDrainThread(asyncBufferSize, dropPolicy == "wait");
+      }
       configure_ordinary_destinations();				// Change Log 16
       configure_statistics();					// Change Log 16
     }  // ThreadSafeLogMessageLoggerScribe::configure_errorlog()
@@ -0,0 +1,84 @@
+/*----------------------------------------------------------------------
+
+   Measures how many messages per second the ThreadSafeLogMessageLoggerScribe
+   can accept when many threads log concurrently, once with the default
+   configuration and once with a per thread buffer drained by a dedicated
+   thread (async_buffer_size). With the default configuration messages
+   sent while more than 'waiting_threshold' are waiting are dropped, with
+   async_drop_policy 'wait' none are.
+
+   Usage: messageLoggerBenchmark [maximum number of threads] [messages per thread]
+
+----------------------------------------------------------------------*/
+
+#include "FWCore/MessageService/interface/ThreadSafeLogMessageLoggerScribe.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/MessageLogger/interface/MessageLoggerQ.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+  edm::ParameterSet configuration(unsigned int iAsyncBufferSize) {
+    edm::ParameterSet info;
+    info.addUntrackedParameter<int>("limit", -1);
+    edm::ParameterSet dest;
+    dest.addUntrackedParameter<std::string>("threshold", "INFO");
+    dest.addUntrackedParameter<edm::ParameterSet>("INFO", info);
+    edm::ParameterSet pset;
+    pset.addUntrackedParameter<std::vector<std::string>>("destinations",
+                                                         std::vector<std::string>(1, "messageLoggerBenchmark"));
+    pset.addUntrackedParameter<edm::ParameterSet>("messageLoggerBenchmark", dest);
+    pset.addUntrackedParameter<unsigned int>("async_buffer_size", iAsyncBufferSize);
+    pset.addUntrackedParameter<std::string>("async_drop_policy", "wait");
+    return pset;
+  }
+
+  double run(unsigned int iAsyncBufferSize, unsigned int iNThreads, unsigned int iNMessages) {
+    auto scribe = std::make_shared<edm::service::ThreadSafeLogMessageLoggerScribe>();
+    edm::MessageLoggerQ::setMLscribe_ptr(scribe);
+    edm::MessageLoggerQ::MLqMOD(new std::string("grid"));
+    edm::MessageLoggerQ::MLqCFG(new edm::ParameterSet(configuration(iAsyncBufferSize)));
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for(unsigned int t = 0; t < iNThreads; ++t) {
+      threads.emplace_back([t, iNMessages]() {
+        for(unsigned int i = 0; i < iNMessages; ++i) {
+          edm::LogInfo("benchmark") << "thread " << t << " message " << i;
+        }
+      });
+    }
+    for(auto& t : threads) {
+      t.join();
+    }
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    //destroying the scribe routes all messages still buffered
+    edm::MessageLoggerQ::setMLscribe_ptr(std::shared_ptr<edm::service::AbstractMLscribe>());
+    scribe.reset();
+    return iNThreads * iNMessages / seconds;
+  }
+}
+
+int main(int argc, char* argv[]) {
+  unsigned int maxThreads = argc > 1 ? std::atoi(argv[1]) : 8;
+  unsigned int nMessages = argc > 2 ? std::atoi(argv[2]) : 1000;
+
+  std::cout << std::setw(8) << "threads" << std::setw(18) << "default (msg/s)" << std::setw(18) << "async (msg/s)"
+            << std::endl;
+  for(unsigned int nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+    double legacy = run(0, nThreads, nMessages);
+    double async = run(1024, nThreads, nMessages);
+    std::cout << std::setw(8) << nThreads << std::setw(18) << std::fixed << std::setprecision(0) << legacy
+              << std::setw(18) << async << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,30 @@
+#!/bin/bash
+
+pushd $LOCAL_TMP_DIR
+
+status=0
+  
+rm -f u37_only.log
+
+cmsRun -p $LOCAL_TEST_DIR/u37_cfg.py || exit $?
+
+# the 'wait' policy guarantees no message of cat_A is lost
+for severity in w i
+do
+  n=`grep -c "%MSG-$severity cat_A:" u37_only.log`
+  if [ "$n" -ne 3 ]
+  then
+    echo u37_only.log has $n instead of 3 %MSG-$severity messages of cat_A
+    status=1
+  fi
+done
+
+if grep -q "cat_B" u37_only.log
+then
+  echo u37_only.log contains messages of the suppressed category cat_B
+  status=1
+fi
+
+popd
+
+exit $status
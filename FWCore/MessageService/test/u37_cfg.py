@@ -0,0 +1,34 @@
+# Unit test configuration file for MessageLogger service:
+# Messages are routed by a dedicated thread (async_buffer_size) and
+# the categories in suppressCategories are dropped at the source.
+#
+
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+import FWCore.Framework.test.cmsExceptionsFatal_cff
+process.options = FWCore.Framework.test.cmsExceptionsFatal_cff.options
+
+process.load("FWCore.MessageService.test.Services_cff")
+
+process.MessageLogger = cms.Service("MessageLogger",
+    async_buffer_size = cms.untracked.uint32(64),
+    async_drop_policy = cms.untracked.string('wait'),
+    suppressCategories = cms.untracked.vstring('cat_B'),
+    u37_only = cms.untracked.PSet(
+        threshold = cms.untracked.string('INFO'),
+        noTimeStamps = cms.untracked.bool(True)
+    ),
+    destinations = cms.untracked.vstring('u37_only')
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(3)
+)
+
+process.source = cms.Source("EmptySource")
+
+process.sendSomeMessages = cms.EDAnalyzer("UnitTestClient_X")
+
+process.p = cms.Path(process.sendSomeMessages)
@@ -182,8 +182,19 @@ namespace edm {
     char         type;
     char         tracked;
 
-    // verify class invariant
-    void validate() const;
+    // scalar values are decoded once, by validate()
+    union Scalar {
+      bool b;
+      int i;
+      unsigned u;
+      long long l;
+      unsigned long long x;
+      double d;
+    };
+    Scalar scalar_;
+
+    // verify class invariant and cache the scalar value
+    void validate();
 
     // decode
     bool fromString(std::string::const_iterator b, std::string::const_iterator e);
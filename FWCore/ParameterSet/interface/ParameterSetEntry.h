@@ -43,6 +43,8 @@ namespace edm {
     ParameterSet& psetForUpdate();
     /// reconstitutes the PSet from the registry
     void fillPSet() const;
+    /// false if only the ID is known, in which case the PSet is unchanged since it was registered
+    bool hasPSet() const {return nullptr != thePSet_.load();}
 
     void updateID();
 
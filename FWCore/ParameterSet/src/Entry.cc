@@ -85,7 +85,7 @@ namespace edm {
 // ----------------------------------------------------------------------
 
   void
-  Entry::validate() const {
+  Entry::validate() {
     // tracked
     assert (tracked == '+' || tracked == '-');
 //     if(tracked != '+' && tracked != '-')
@@ -94,8 +94,7 @@ namespace edm {
     // type and rep
     switch(type)  {
       case 'B':  {  // Bool
-        bool  val;
-        if (!decode(val, rep)) throwEntryError("bool", rep);
+        if (!decode(scalar_.b, rep)) throwEntryError("bool", rep);
         break;
       }
       case 'b':  {  // vBool
@@ -104,8 +103,7 @@ namespace edm {
         break;
       }
       case 'I':  {  // Int32
-        int  val;
-        if(!decode(val, rep)) throwEntryError("int", rep);
+        if(!decode(scalar_.i, rep)) throwEntryError("int", rep);
         break;
       }
       case 'i':  {  // vInt32
@@ -114,8 +112,7 @@ namespace edm {
         break;
       }
       case 'U':  {  // Uint32
-        unsigned  val;
-        if(!decode(val, rep)) throwEntryError("unsigned int", rep);
+        if(!decode(scalar_.u, rep)) throwEntryError("unsigned int", rep);
         break;
       }
       case 'u':  {  // vUint32
@@ -124,8 +121,7 @@ namespace edm {
         break;
       }
       case 'L':  {  // Int64
-        int  val;
-        if(!decode(val, rep)) throwEntryError("int64", rep);
+        if(!decode(scalar_.l, rep)) throwEntryError("int64", rep);
         break;
       }
       case 'l':  {  // vInt64
@@ -134,8 +130,7 @@ namespace edm {
         break;
       }
       case 'X':  {  // Uint64
-        unsigned  val;
-        if(!decode(val, rep)) throwEntryError("unsigned int64", rep);
+        if(!decode(scalar_.x, rep)) throwEntryError("unsigned int64", rep);
         break;
       }
       case 'x':  {  // vUint64
@@ -199,8 +194,7 @@ namespace edm {
         break;
       }
       case 'D':  {  // Double
-        double  val;
-        if(!decode(val, rep)) throwEntryError("double", rep);
+        if(!decode(scalar_.d, rep)) throwEntryError("double", rep);
         break;
       }
       case 'd':  {  // vDouble
@@ -251,6 +245,9 @@ namespace edm {
 // constructors
 // ----------------------------------------------------------------------
 
+// A value given as a C++ type was just encoded, so decoding it again in
+// validate() is only done for the scalar types whose value is cached.
+
 // ----------------------------------------------------------------------
 // Bool
 
@@ -275,7 +272,6 @@ namespace edm {
   Entry::Entry(std::string const& name, std::vector<int> const& val, bool is_tracked) :
     name_(name), rep(), type('i'), tracked(is_tracked ? '+' : '-') {
     if(!encode(rep, val)) throwEncodeError("vector<int>");
-    validate();
   }
 
 // ----------------------------------------------------------------------
@@ -293,7 +289,6 @@ namespace edm {
  Entry::Entry(std::string const& name, std::vector<unsigned> const& val, bool is_tracked) :
    name_(name), rep(), type('u'), tracked(is_tracked ? '+' : '-') {
    if(!encode(rep, val)) throwEncodeError("vector<unsigned int>");
-    validate();
   }
 
 // ----------------------------------------------------------------------
@@ -311,7 +306,6 @@ namespace edm {
   Entry::Entry(std::string const& name, std::vector<long long> const& val, bool is_tracked) :
     name_(name), rep(), type('l'), tracked(is_tracked ? '+' : '-') {
     if(!encode(rep, val)) throwEncodeError("vector<int64>");
-    validate();
   }
 
 // ----------------------------------------------------------------------
@@ -329,7 +323,6 @@ namespace edm {
  Entry::Entry(std::string const& name, std::vector<unsigned long long> const& val, bool is_tracked) :
    name_(name), rep(), type('x'), tracked(is_tracked ? '+' : '-') {
    if(!encode(rep, val)) throwEncodeError("vector<unsigned int64>");
-    validate();
   }
 
 // ----------------------------------------------------------------------
@@ -347,7 +340,6 @@ namespace edm {
   Entry::Entry(std::string const& name, std::vector<double> const& val, bool is_tracked) :
     name_(name), rep(), type('d'), tracked(is_tracked ? '+' : '-') {
     if(!encode(rep, val)) throwEncodeError("vector<double>");
-    validate();
   }
 
 // ----------------------------------------------------------------------
@@ -356,7 +348,6 @@ namespace edm {
   Entry::Entry(std::string const& name, std::string const& val, bool is_tracked) :
     name_(name), rep(), type('S'), tracked(is_tracked ? '+' : '-') {
     if(!encode(rep, val)) throwEncodeError("string");
-    validate();
   }
 
 // ----------------------------------------------------------------------
@@ -365,7 +356,6 @@ namespace edm {
   Entry::Entry(std::string const& name, std::vector<std::string> const& val, bool is_tracked) :
        name_(name), rep(), type('s'), tracked(is_tracked ? '+' : '-') {
     if(!encode(rep, val)) throwEncodeError("vector<string>");
-    validate();
   }
 
 // ----------------------------------------------------------------------
@@ -374,7 +364,6 @@ namespace edm {
   Entry::Entry(std::string const& name, FileInPath const& val, bool is_tracked) :
     name_(name), rep(), type('F'), tracked(is_tracked ? '+' : '-') {
     if (!encode(rep, val)) throwEncodeError("FileInPath");
-    validate();
   }
 
 // ----------------------------------------------------------------------
@@ -383,7 +372,6 @@ namespace edm {
   Entry::Entry(std::string const& name, InputTag const& val, bool is_tracked) :
     name_(name), rep(), type('t'), tracked(is_tracked ? '+' : '-') {
     if (!encode(rep, val)) throwEncodeError("InputTag");
-    validate();
   }
 
 
@@ -393,7 +381,6 @@ namespace edm {
   Entry::Entry(std::string const& name, std::vector<InputTag> const& val, bool is_tracked) :
     name_(name), rep(), type('v'), tracked(is_tracked ? '+' : '-') {
     if (!encode(rep, val)) throwEncodeError("VInputTag");
-    validate();
   }
 
 
@@ -403,7 +390,6 @@ namespace edm {
    Entry::Entry(std::string const& name, ESInputTag const& val, bool is_tracked) :
    name_(name), rep(), type(kTESInputTag), tracked(is_tracked ? '+' : '-') {
       if (!encode(rep, val)) throwEncodeError("InputTag");
-      validate();
    }
 
 // ----------------------------------------------------------------------
@@ -412,7 +398,6 @@ namespace edm {
    Entry::Entry(std::string const& name, std::vector<ESInputTag> const& val, bool is_tracked) :
    name_(name), rep(), type(kTVESInputTag), tracked(is_tracked ? '+' : '-') {
       if (!encode(rep, val)) throwEncodeError("VESInputTag");
-      validate();
    }
 
 
@@ -422,7 +407,6 @@ namespace edm {
   Entry::Entry(std::string const& name, EventID const& val, bool is_tracked) :
     name_(name), rep(), type('E'), tracked(is_tracked ? '+' : '-') {
     if (!encode(rep, val)) throwEncodeError("EventID");
-    validate();
   }
 
 
@@ -432,7 +416,6 @@ namespace edm {
   Entry::Entry(std::string const& name, std::vector<EventID> const& val, bool is_tracked) :
     name_(name), rep(), type('e'), tracked(is_tracked ? '+' : '-') {
     if (!encode(rep, val)) throwEncodeError("VEventID");
-    validate();
   }
 
 
@@ -443,7 +426,6 @@ namespace edm {
   Entry::Entry(std::string const& name, LuminosityBlockID const& val, bool is_tracked) :
     name_(name), rep(), type('M'), tracked(is_tracked ? '+' : '-') {
     if (!encode(rep, val)) throwEncodeError("LuminosityBlockID");
-    validate();
   }
 
 
@@ -453,7 +435,6 @@ namespace edm {
   Entry::Entry(std::string const& name, std::vector<LuminosityBlockID> const& val, bool is_tracked) :
     name_(name), rep(), type('m'), tracked(is_tracked ? '+' : '-') {
     if (!encode(rep, val)) throwEncodeError("VLuminosityBlockID");
-    validate();
   }
 
 // ----------------------------------------------------------------------
@@ -462,7 +443,6 @@ namespace edm {
   Entry::Entry(std::string const& name, LuminosityBlockRange const& val, bool is_tracked) :
     name_(name), rep(), type('A'), tracked(is_tracked ? '+' : '-') {
     if (!encode(rep, val)) throwEncodeError("LuminosityBlockRange");
-    validate();
   }
 
 
@@ -472,7 +452,6 @@ namespace edm {
   Entry::Entry(std::string const& name, std::vector<LuminosityBlockRange> const& val, bool is_tracked) :
     name_(name), rep(), type('a'), tracked(is_tracked ? '+' : '-') {
     if (!encode(rep, val)) throwEncodeError("VLuminosityBlockRange");
-    validate();
   }
 
 // ----------------------------------------------------------------------
@@ -481,7 +460,6 @@ namespace edm {
   Entry::Entry(std::string const& name, EventRange const& val, bool is_tracked) :
     name_(name), rep(), type('R'), tracked(is_tracked ? '+' : '-') {
     if (!encode(rep, val)) throwEncodeError("EventRange");
-    validate();
   }
 
 // ----------------------------------------------------------------------
@@ -490,7 +468,6 @@ namespace edm {
   Entry::Entry(std::string const& name, std::vector<EventRange> const& val, bool is_tracked) :
     name_(name), rep(), type('r'), tracked(is_tracked ? '+' : '-') {
     if (!encode(rep, val)) throwEncodeError("VEventRange");
-    validate();
   }
 
 
@@ -500,7 +477,6 @@ namespace edm {
   Entry::Entry(std::string const& name, ParameterSet const& val, bool is_tracked) :
     name_(name), rep(), type('P'), tracked(is_tracked ? '+' : '-') {
     if(!encode(rep, val)) throwEncodeError("ParameterSet");
-    validate();
   }
 
 // ----------------------------------------------------------------------
@@ -509,7 +485,6 @@ namespace edm {
   Entry::Entry(std::string const& name, std::vector<ParameterSet> const& val, bool is_tracked) :
       name_(name), rep(), type('p'), tracked(is_tracked ? '+' : '-') {
     if(!encode(rep, val)) throwEncodeError("vector<ParameterSet>");
-    validate();
   }
 
 // ----------------------------------------------------------------------
@@ -637,9 +612,7 @@ namespace edm {
   bool
   Entry::getBool() const {
     if (type != 'B') throwValueError("bool");
-    bool  val;
-    if (!decode(val, rep)) throwEntryError("bool", rep);
-    return val;
+    return scalar_.b;
   }
 
 
@@ -649,9 +622,7 @@ namespace edm {
   int
   Entry::getInt32() const {
     if(type != 'I') throwValueError("int");
-    int  val;
-    if(!decode(val, rep)) throwEntryError("int", rep);
-    return val;
+    return scalar_.i;
   }
 
 // ----------------------------------------------------------------------
@@ -672,9 +643,7 @@ namespace edm {
   long long
   Entry::getInt64() const {
     if(type != 'L') throwValueError("int64");
-    long long  val;
-    if(!decode(val, rep)) throwEntryError("int64", rep);
-    return val;
+    return scalar_.l;
   }
 
 // ----------------------------------------------------------------------
@@ -696,9 +665,7 @@ namespace edm {
   unsigned
   Entry::getUInt32() const {
     if(type != 'U') throwValueError("unsigned int");
-    unsigned  val;
-    if(!decode(val, rep)) throwEntryError("unsigned int", rep);
-    return val;
+    return scalar_.u;
   }
 
 // ----------------------------------------------------------------------
@@ -719,9 +686,7 @@ namespace edm {
   unsigned long long
   Entry::getUInt64() const {
     if(type != 'X') throwValueError("uint64");
-    unsigned long long val;
-    if(!decode(val, rep)) throwEntryError("uint64", rep);
-    return val;
+    return scalar_.x;
   }
 
 // ----------------------------------------------------------------------
@@ -741,9 +706,7 @@ namespace edm {
   double
   Entry::getDouble() const {
     if(type != 'D') throwValueError("double");
-    double  val;
-    if(!decode(val, rep)) throwEntryError("double", rep);
-    return val;
+    return scalar_.d;
   }
 
 // ----------------------------------------------------------------------
@@ -183,6 +183,10 @@ namespace edm {
   void ParameterSet::calculateID() {
     // make sure contained tracked psets are updated
     for(auto& item : psetTable_) {
+      if(item.second.id().isValid() && !item.second.hasPSet()) {
+        // avoid reconstituting the PSet from the registry just to get its ID
+        continue;
+      }
       ParameterSet& pset = item.second.psetForUpdate();
       if(!pset.isRegistered()) {
         pset.registerIt();
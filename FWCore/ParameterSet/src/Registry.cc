@@ -33,6 +33,12 @@ namespace edm {
   
     bool
     Registry::insertMapped(value_type const& v, bool forceUpdate) {
+      if(not forceUpdate) {
+        // identical ParameterSets are common, do not copy them again
+        if(m_map.find(v.id()) != m_map.end()) {
+          return false;
+        }
+      }
       auto wasAdded = m_map.insert(std::make_pair(v.id(),v));
       if(forceUpdate and not wasAdded.second) {
         wasAdded.first->second = v;
@@ -115,6 +115,10 @@ namespace edm {
   }
 
   void VParameterSetEntry::registerPsetsAndUpdateIDs() {
+    if(theIDs_ && nullptr == theVPSet_.load()) {
+      // the PSets were never reconstituted so the IDs are up to date
+      return;
+    }
     fillVPSet();
     theIDs_ = value_ptr<std::vector<ParameterSetID> >(new std::vector<ParameterSetID>);
     theIDs_->resize(theVPSet_->size());
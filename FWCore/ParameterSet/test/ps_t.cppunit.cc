@@ -23,6 +23,7 @@ class testps: public CppUnit::TestFixture
   CPPUNIT_TEST(boolTest);
   CPPUNIT_TEST(intTest);
   CPPUNIT_TEST(uintTest);
+  CPPUNIT_TEST(int64Test);
   CPPUNIT_TEST(doubleTest);
   CPPUNIT_TEST(stringTest);
   CPPUNIT_TEST(eventIDTest);
@@ -39,6 +40,7 @@ class testps: public CppUnit::TestFixture
   CPPUNIT_TEST(testCopyFrom);
   CPPUNIT_TEST(testGetParameterAsString);
   CPPUNIT_TEST(calculateIDTest);
+  CPPUNIT_TEST(reregisterTest);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -49,6 +51,7 @@ public:
   void boolTest();
   void intTest();
   void uintTest();
+  void int64Test();
   void doubleTest();
   void stringTest();
   void eventIDTest();
@@ -65,6 +68,7 @@ public:
   void testCopyFrom();
   void testGetParameterAsString();
   void calculateIDTest();
+  void reregisterTest();
   // Still more to do...
 private:
 };
@@ -193,6 +197,16 @@ void testps::uintTest()
 
 }
 
+void testps::int64Test()
+{
+  testbody<long long>(-std::numeric_limits<long long>::max());
+  testbody<long long>(-2112);
+  testbody<long long>(0);
+  testbody<long long>(std::numeric_limits<long long>::max());
+  testbody<unsigned long long>(0);
+  testbody<unsigned long long>(std::numeric_limits<unsigned long long>::max());
+}
+
 void testps::doubleTest()
 {
   testbody<double>(-1.25);
@@ -631,4 +645,34 @@ void testps::testGetParameterAsString()
   CPPUNIT_ASSERT(vpsetStr == vpsetStr2);
 }
 
+void testps::reregisterTest()
+{
+  edm::ParameterSet nested;
+  nested.addParameter<int>("i", 1);
+  std::vector<edm::ParameterSet> vpset(2, nested);
+  edm::ParameterSet ps;
+  ps.addParameter<edm::ParameterSet>("nested", nested);
+  ps.addParameter<std::vector<edm::ParameterSet> >("vpset", vpset);
+  ps.addParameter<double>("d", 2.5);
+  ps.registerIt();
+
+  // the nested PSets of the registered copy are only known by their IDs
+  edm::ParameterSet const& fromRegistry = edm::getParameterSet(ps.id());
+  edm::ParameterSet copy;
+  copy.copyForModify(fromRegistry);
+  copy.addUntrackedParameter<bool>("untracked", true);
+  copy.registerIt();
+  CPPUNIT_ASSERT(copy.id() == ps.id());
+  CPPUNIT_ASSERT(copy.getParameterSet("nested").getParameter<int>("i") == 1);
+  CPPUNIT_ASSERT(copy.getParameterSetVector("vpset").size() == 2);
+
+  // changing a nested PSet must still change the ID
+  edm::ParameterSet modified;
+  modified.copyForModify(fromRegistry);
+  modified.getPSetForUpdate("nested")->addParameter<int>("i", 2);
+  modified.registerIt();
+  CPPUNIT_ASSERT(modified.id() != ps.id());
+  CPPUNIT_ASSERT(edm::getParameterSet(modified.id()).getParameterSet("nested").getParameter<int>("i") == 2);
+}
+
 #include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
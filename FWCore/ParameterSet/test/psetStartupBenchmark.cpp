@@ -0,0 +1,142 @@
+/*----------------------------------------------------------------------
+
+   Measures the ParameterSet operations done at the start of a job with a
+   large configuration. A synthetic menu with many modules is built, the
+   process ParameterSet is registered and each module then reads its
+   parameters the same way the framework and a module constructor do.
+   Many modules share identical nested ParameterSets, as in real menus.
+
+   Usage: psetStartupBenchmark [number of modules] [repetitions]
+
+----------------------------------------------------------------------*/
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/Registry.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+  class Timer {
+  public:
+    explicit Timer(char const* iName): name_(iName), start_(std::chrono::steady_clock::now()) {}
+    ~Timer() {
+      std::cout << "  " << name_ << ": "
+                << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count()
+                << " ms" << std::endl;
+    }
+  private:
+    char const* name_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  edm::ParameterSet makeModule(unsigned int i) {
+    edm::ParameterSet module;
+    module.addParameter<std::string>("@module_type", "SyntheticProducer" + std::to_string(i % 50));
+    module.addParameter<std::string>("@module_label", "module" + std::to_string(i));
+    module.addParameter<std::string>("@module_edm_type", "EDProducer");
+    for(unsigned int p = 0; p != 5; ++p) {
+      module.addParameter<int>("intParameter" + std::to_string(p), i + p);
+      module.addParameter<double>("doubleParameter" + std::to_string(p), 0.5 * (i + p));
+      module.addParameter<unsigned int>("uintParameter" + std::to_string(p), p);
+      module.addParameter<bool>("boolParameter" + std::to_string(p), (i + p) % 2 == 0);
+    }
+    module.addParameter<std::string>("stringParameter", "value" + std::to_string(i));
+    module.addParameter<edm::InputTag>("src", edm::InputTag("module" + std::to_string(i / 2), "", ""));
+    std::vector<std::string> names;
+    for(unsigned int p = 0; p != 20; ++p) {
+      names.push_back("HLT_Path" + std::to_string((i + p) % 500) + "_v1");
+    }
+    module.addParameter<std::vector<std::string>>("triggerNames", names);
+    module.addParameter<std::vector<double>>("cuts", std::vector<double>(30, 1.5));
+
+    //a handful of nested PSets are shared by most modules
+    edm::ParameterSet shared;
+    shared.addParameter<double>("ptMin", 10. + i % 10);
+    shared.addParameter<std::vector<int>>("bins", std::vector<int>(20, i % 10));
+    module.addParameter<edm::ParameterSet>("selection", shared);
+
+    std::vector<edm::ParameterSet> vpset;
+    for(unsigned int p = 0; p != 3; ++p) {
+      edm::ParameterSet element;
+      element.addParameter<std::string>("name", "element" + std::to_string(p));
+      element.addParameter<int>("index", p);
+      vpset.push_back(element);
+    }
+    module.addParameter<std::vector<edm::ParameterSet>>("elements", vpset);
+    return module;
+  }
+
+  void readModule(edm::ParameterSet const& module, unsigned long long& checksum) {
+    for(unsigned int p = 0; p != 5; ++p) {
+      checksum += module.getParameter<int>("intParameter" + std::to_string(p));
+      checksum += module.getParameter<double>("doubleParameter" + std::to_string(p));
+      checksum += module.getParameter<unsigned int>("uintParameter" + std::to_string(p));
+      checksum += module.getParameter<bool>("boolParameter" + std::to_string(p));
+    }
+    checksum += module.getParameter<std::string>("stringParameter").size();
+    checksum += module.getParameter<edm::InputTag>("src").label().size();
+    checksum += module.getParameter<std::vector<std::string>>("triggerNames").size();
+    checksum += module.getParameter<std::vector<double>>("cuts").size();
+    auto const& selection = module.getParameterSet("selection");
+    checksum += selection.getParameter<double>("ptMin");
+    checksum += selection.getParameter<std::vector<int>>("bins").size();
+    for(auto const& element : module.getParameterSetVector("elements")) {
+      checksum += element.getParameter<int>("index");
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  unsigned int const nModules = argc > 1 ? std::atoi(argv[1]) : 3000;
+  unsigned int const nRepetitions = argc > 2 ? std::atoi(argv[2]) : 1;
+
+  unsigned long long checksum = 0;
+  for(unsigned int r = 0; r != nRepetitions; ++r) {
+    edm::pset::Registry::instance()->clear();
+    std::cout << "menu with " << nModules << " modules" << std::endl;
+
+    edm::ParameterSet process;
+    {
+      Timer t("build");
+      std::vector<std::string> labels;
+      for(unsigned int i = 0; i != nModules; ++i) {
+        labels.push_back("module" + std::to_string(i));
+        process.addParameter<edm::ParameterSet>(labels.back(), makeModule(i));
+      }
+      process.addParameter<std::vector<std::string>>("@all_modules", labels);
+      process.addParameter<std::string>("@process_name", "BENCH");
+    }
+    {
+      Timer t("register");
+      process.registerIt();
+    }
+    std::vector<edm::ParameterSetID> ids;
+    ids.reserve(nModules);
+    for(unsigned int i = 0; i != nModules; ++i) {
+      ids.push_back(process.getParameterSet("module" + std::to_string(i)).id());
+    }
+    {
+      Timer t("retrieve from registry and read");
+      for(auto const& id : ids) {
+        readModule(edm::getParameterSet(id), checksum);
+      }
+    }
+    {
+      Timer t("copy, modify and re-register");
+      for(auto const& id : ids) {
+        edm::ParameterSet copy;
+        copy.copyForModify(edm::getParameterSet(id));
+        copy.addUntrackedParameter<bool>("@benchmark", true);
+        copy.registerIt();
+      }
+    }
+    std::cout << "  registry size: " << edm::pset::Registry::instance()->size() << std::endl;
+  }
+  std::cout << "checksum " << checksum << std::endl;
+  return 0;
+}
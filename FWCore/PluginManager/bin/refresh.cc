@@ -1,4 +1,5 @@
 #include "FWCore/PluginManager/interface/CacheParser.h"
+#include "FWCore/PluginManager/interface/PluginCacheIndex.h"
 #include "FWCore/PluginManager/interface/PluginCapabilities.h"
 #include "FWCore/PluginManager/interface/PluginFactoryBase.h"
 #include "FWCore/PluginManager/interface/PluginFactoryManager.h"
@@ -331,7 +332,13 @@ int main (int argc, char **argv) try {
       "Please check permissions on the file.";
     }
     CacheParser::write(old, fcf);
+    fcf.close();
     rename(temporaryFilename.c_str(), cacheFile.string().c_str());  
+
+    // The binary index lets jobs look up plugins without parsing the cache file
+    path indexFile(directory);
+    indexFile /= edmplugin::standard::cacheIndexFileName();
+    PluginCacheIndex::write(old, cacheFile, indexFile);
   } catch(std::exception& iException) {
     std::cerr << "Caught exception " << iException.what() << std::endl;
     returnValue = EXIT_FAILURE;
@@ -0,0 +1,94 @@
+#ifndef FWCore_PluginManager_PluginCacheIndex_h
+#define FWCore_PluginManager_PluginCacheIndex_h
+// -*- C++ -*-
+//
+// Package:     PluginManager
+// Class  :     PluginCacheIndex
+//
+/**\class PluginCacheIndex PluginCacheIndex.h FWCore/PluginManager/interface/PluginCacheIndex.h
+
+ Description: Memory mapped binary index of the plugins of one cache file
+
+ Usage:
+    The index is written by EdmPluginRefresh next to the text cache file of a
+ directory and records the modification time, size, inode and a hash of the
+ content of that cache file. If the cache file changed since, open returns a
+ null pointer and the text cache file must be parsed instead. The content is
+ only hashed again when the modification time cannot tell a rewrite.
+    Finding the library of a plugin is a hash table lookup done directly in
+ the mapped file, nothing is parsed or allocated when opening the index.
+
+*/
+//
+// Original Author:  FWCore
+//         Created:  Fri, 20 Oct 2017 10:12:37 GMT
+//
+
+// system include files
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <boost/filesystem/path.hpp>
+
+// user include files
+#include "FWCore/PluginManager/interface/CacheParser.h"
+
+// forward declarations
+
+namespace edmplugin {
+class PluginCacheIndex
+{
+
+   public:
+      struct Match {
+        ///file name, relative to the directory of the cache, of the first library with the plugin
+        char const* loadable_ = nullptr;
+        ///another library of the same directory also registering the plugin
+        char const* duplicate_ = nullptr;
+      };
+
+      ~PluginCacheIndex();
+
+      // ---------- const member functions ---------------------
+      Match find(const std::string& iCategory, const std::string& iPlugin) const;
+
+      bool hasCategory(const std::string& iCategory) const;
+
+      ///Adds the plugins exactly as CacheParser::read would have for the text cache file
+      void fill(const boost::filesystem::path& iDirectory, CacheParser::CategoryToInfos& oOut) const;
+
+      // ---------- static member functions --------------------
+      ///Returns a null pointer if iIndexFile does not exist, is corrupted or does not correspond to iCacheFile
+      static std::unique_ptr<PluginCacheIndex> open(const boost::filesystem::path& iIndexFile,
+                                                    const boost::filesystem::path& iCacheFile);
+
+      ///Writes the index for iCacheFile which must already contain the plugins in iPlugins
+      static void write(const CacheParser::LoadableToPlugins& iPlugins,
+                        const boost::filesystem::path& iCacheFile,
+                        const boost::filesystem::path& iIndexFile);
+
+   private:
+      struct Header;
+      struct Entry;
+
+      PluginCacheIndex(void* iAddress, std::size_t iSize);
+      PluginCacheIndex(const PluginCacheIndex&) = delete; // stop default
+
+      const PluginCacheIndex& operator=(const PluginCacheIndex&) = delete; // stop default
+
+      char const* string(std::uint32_t iOffset) const { return strings_+iOffset; }
+
+      // ---------- member data --------------------------------
+      void* address_;
+      std::size_t size_;
+      Header const* header_;
+      Entry const* entries_;
+      std::uint32_t const* bucketStarts_;
+      std::uint32_t const* slots_;
+      std::uint32_t const* categories_;
+      char const* strings_;
+};
+
+}
+#endif
@@ -32,6 +32,7 @@
 #include "FWCore/Utilities/interface/Signal.h"
 #include "FWCore/PluginManager/interface/SharedLibrary.h"
 #include "FWCore/PluginManager/interface/PluginInfo.h"
+#include "FWCore/PluginManager/interface/PluginCacheIndex.h"
 
 // forward declarations
 namespace edmplugin {
@@ -77,11 +78,10 @@ class PluginManager
                                                  const std::string& iPlugin);
       
       /**The container is ordered by category, then plugin name and then by precidence order of the plugin files.
-        Therefore the first match on category and plugin name will be the proper file to load
+        Therefore the first match on category and plugin name will be the proper file to load.
+        The container is only filled when first requested.
         */
-      const CategoryToInfos& categoryToInfos() const {
-        return categoryToInfos_;
-      }
+      const CategoryToInfos& categoryToInfos() const;
       
       //If can not find iPlugin in category iCategory return null pointer, any other failure will cause a throw
       const SharedLibrary* tryToLoad(const std::string& iCategory,
@@ -120,11 +120,25 @@ class PluginManager
       const boost::filesystem::path& loadableFor_(const std::string& iCategory,
                                                   const std::string& iPlugin,
                                                   bool& ioThrowIfFailElseSucceedStatus);
+      //The plugins of one cache file. If the cache file has an up to date
+      // PluginCacheIndex, the cache file itself is not read.
+      struct Cache {
+        boost::filesystem::path directory_;
+        std::unique_ptr<PluginCacheIndex> index_;
+        CategoryToInfos infos_;
+      };
+
       // ---------- member data --------------------------------
       SearchPath searchPath_;
       tbb::concurrent_unordered_map<boost::filesystem::path, std::shared_ptr<SharedLibrary>, PluginManagerPathHasher > loadables_;
       
-      CategoryToInfos categoryToInfos_;
+      //in order of precedence
+      std::vector<Cache> caches_;
+      //the loadables found through a PluginCacheIndex, keyed by category and plugin name
+      tbb::concurrent_unordered_map<std::string, boost::filesystem::path, tbb::tbb_hash<std::string>> indexedLoadables_;
+
+      mutable std::once_flag categoryToInfosFilled_;
+      mutable CategoryToInfos categoryToInfos_;
       std::recursive_mutex pluginLoadMutex_;
 };
 
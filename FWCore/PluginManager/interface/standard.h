@@ -34,6 +34,8 @@ namespace edmplugin {
     
     const boost::filesystem::path& cachefileName();
     const boost::filesystem::path& poisonedCachefileName();
+    ///binary index of the cache file, see PluginCacheIndex
+    const boost::filesystem::path& cacheIndexFileName();
     
     const std::string& pluginPrefix();
   }
@@ -0,0 +1,340 @@
+// -*- C++ -*-
+//
+// Package:     PluginManager
+// Class  :     PluginCacheIndex
+//
+// Implementation:
+//     The file is laid out as
+//       Header
+//       Entry[nEntries]              in the order of the lines of the text cache file
+//       uint32_t[nBuckets+1]         start of each hash bucket in the slots
+//       uint32_t[nEntries]           entry indices grouped by bucket, in entry order
+//       uint32_t[nCategories]        offsets of the category names, sorted
+//       char[stringsSize]            null terminated strings
+//     so all plugins with the same name and category found in the cache
+//     file are next to each other in their bucket.
+//
+// Original Author:  FWCore
+//         Created:  Fri, 20 Oct 2017 10:12:37 GMT
+//
+
+// system include files
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <boost/filesystem/path.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// user include files
+#include "FWCore/PluginManager/interface/PluginCacheIndex.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+namespace edmplugin {
+//
+// constants, enums and typedefs
+//
+struct PluginCacheIndex::Header {
+  char magic_[8];
+  std::uint32_t version_;
+  std::uint32_t nEntries_;
+  std::uint32_t nBuckets_;
+  std::uint32_t nCategories_;
+  std::uint32_t stringsSize_;
+  std::uint32_t cacheHash_;
+  std::int64_t cacheSeconds_;
+  std::int64_t cacheNanoseconds_;
+  std::uint64_t cacheSize_;
+  std::uint64_t cacheInode_;
+};
+
+struct PluginCacheIndex::Entry {
+  std::uint32_t hash_;
+  std::uint32_t category_;
+  std::uint32_t name_;
+  std::uint32_t loadable_;
+};
+
+namespace {
+  const char kMagic[8] = {'E','D','M','P','L','I','D','X'};
+  const std::uint32_t kVersion = 3;
+
+  std::uint32_t hashOf(const char* iCategory, const char* iPlugin) {
+    //FNV-1a, the value is stored in the file so must not depend on the platform
+    std::uint32_t hash = 2166136261U;
+    auto add = [&hash](const char* iString) {
+      for(; *iString != '\0'; ++iString) {
+        hash = (hash ^ static_cast<unsigned char>(*iString))*16777619U;
+      }
+    };
+    add(iCategory);
+    hash = hash*16777619U;
+    add(iPlugin);
+    return hash;
+  }
+
+  //FNV-1a of the content of the cache file
+  bool contentHashOf(const boost::filesystem::path& iFile, std::uint32_t& oHash) {
+    int fd = ::open(iFile.string().c_str(), O_RDONLY);
+    if(fd < 0) {
+      return false;
+    }
+    std::uint32_t hash = 2166136261U;
+    char buffer[65536];
+    ssize_t nRead;
+    while((nRead = ::read(fd, buffer, sizeof(buffer))) > 0) {
+      for(ssize_t i = 0; i != nRead; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(buffer[i]))*16777619U;
+      }
+    }
+    close(fd);
+    oHash = hash;
+    return nRead == 0;
+  }
+
+  //A rewrite of the cache file keeping its size and inode is seen from its modification
+  // time unless it happens in the same tick of the clock of the file system as the
+  // modification recorded in the index. As the index is written after the cache file,
+  // that can only happen if the recorded time is not older than the index itself, then
+  // the content must be compared. Without nanoseconds only the seconds can be compared.
+  bool isAmbiguous(timespec const& iCacheTime, timespec const& iIndexTime) {
+    if(iCacheTime.tv_nsec == 0 or iIndexTime.tv_nsec == 0) {
+      return iCacheTime.tv_sec >= iIndexTime.tv_sec;
+    }
+    return iCacheTime.tv_sec > iIndexTime.tv_sec or
+      (iCacheTime.tv_sec == iIndexTime.tv_sec and iCacheTime.tv_nsec >= iIndexTime.tv_nsec);
+  }
+
+  std::size_t fileSize(std::uint32_t nEntries, std::uint32_t nBuckets, std::uint32_t nCategories, std::uint32_t nStrings) {
+    return 64 + 16*static_cast<std::size_t>(nEntries) +
+      4*(static_cast<std::size_t>(nBuckets)+1+nEntries+nCategories) + nStrings;
+  }
+
+  struct CompPluginInfos {
+    bool operator()(const PluginInfo& iLHS, const PluginInfo& iRHS) const {
+      return iLHS.name_ < iRHS.name_;
+    }
+  };
+}
+
+//
+// constructors and destructor
+//
+PluginCacheIndex::PluginCacheIndex(void* iAddress, std::size_t iSize):
+  address_(iAddress),
+  size_(iSize),
+  header_(static_cast<Header const*>(iAddress)),
+  entries_(reinterpret_cast<Entry const*>(header_+1)),
+  bucketStarts_(reinterpret_cast<std::uint32_t const*>(entries_+header_->nEntries_)),
+  slots_(bucketStarts_+header_->nBuckets_+1),
+  categories_(slots_+header_->nEntries_),
+  strings_(reinterpret_cast<char const*>(categories_+header_->nCategories_))
+{
+  static_assert(sizeof(Header) == 64 and sizeof(Entry) == 16, "fileSize must match the layout of the file");
+}
+
+PluginCacheIndex::~PluginCacheIndex()
+{
+  munmap(address_, size_);
+}
+
+//
+// const member functions
+//
+PluginCacheIndex::Match
+PluginCacheIndex::find(const std::string& iCategory, const std::string& iPlugin) const
+{
+  Match match;
+  auto const hash = hashOf(iCategory.c_str(), iPlugin.c_str());
+  auto const bucket = hash & (header_->nBuckets_-1);
+  for(auto slot = bucketStarts_[bucket], slotEnd = bucketStarts_[bucket+1]; slot != slotEnd; ++slot) {
+    Entry const& entry = entries_[slots_[slot]];
+    if(entry.hash_ == hash and iPlugin == string(entry.name_) and iCategory == string(entry.category_)) {
+      if(match.loadable_ == nullptr) {
+        match.loadable_ = string(entry.loadable_);
+      } else {
+        match.duplicate_ = string(entry.loadable_);
+        break;
+      }
+    }
+  }
+  return match;
+}
+
+bool
+PluginCacheIndex::hasCategory(const std::string& iCategory) const
+{
+  auto end = categories_+header_->nCategories_;
+  auto it = std::lower_bound(categories_, end, iCategory,
+                             [this](std::uint32_t iOffset, const std::string& iName) {
+                               return iName.compare(string(iOffset)) > 0;
+                             });
+  return it != end and iCategory == string(*it);
+}
+
+void
+PluginCacheIndex::fill(const boost::filesystem::path& iDirectory, CacheParser::CategoryToInfos& oOut) const
+{
+  PluginInfo info;
+  for(auto entry = entries_, end = entries_+header_->nEntries_; entry != end; ++entry) {
+    info.name_ = string(entry->name_);
+    info.loadable_ = iDirectory / string(entry->loadable_);
+    oOut[string(entry->category_)].push_back(info);
+  }
+  for(auto& categoryInfos : oOut) {
+    std::stable_sort(categoryInfos.second.begin(), categoryInfos.second.end(), CompPluginInfos());
+  }
+}
+
+//
+// static member functions
+//
+std::unique_ptr<PluginCacheIndex>
+PluginCacheIndex::open(const boost::filesystem::path& iIndexFile, const boost::filesystem::path& iCacheFile)
+{
+  struct stat cacheStatus;
+  if(0 != stat(iCacheFile.string().c_str(), &cacheStatus)) {
+    return std::unique_ptr<PluginCacheIndex>();
+  }
+
+  int fd = ::open(iIndexFile.string().c_str(), O_RDONLY);
+  if(fd < 0) {
+    return std::unique_ptr<PluginCacheIndex>();
+  }
+  struct stat status;
+  if(0 != fstat(fd, &status) or static_cast<std::size_t>(status.st_size) < sizeof(Header)) {
+    close(fd);
+    return std::unique_ptr<PluginCacheIndex>();
+  }
+  std::size_t const size = status.st_size;
+  void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(address == MAP_FAILED) {
+    return std::unique_ptr<PluginCacheIndex>();
+  }
+
+  Header const* header = static_cast<Header const*>(address);
+  bool const valid = 0 == std::memcmp(header->magic_, kMagic, sizeof(kMagic)) and
+    header->version_ == kVersion and
+    header->nBuckets_ != 0 and (header->nBuckets_ & (header->nBuckets_-1)) == 0 and
+    size == fileSize(header->nEntries_, header->nBuckets_, header->nCategories_, header->stringsSize_) and
+    header->stringsSize_ != 0 and static_cast<char const*>(address)[size-1] == '\0' and
+    header->cacheSeconds_ == static_cast<std::int64_t>(cacheStatus.st_mtim.tv_sec) and
+    header->cacheNanoseconds_ == static_cast<std::int64_t>(cacheStatus.st_mtim.tv_nsec) and
+    header->cacheSize_ == static_cast<std::uint64_t>(cacheStatus.st_size) and
+    header->cacheInode_ == static_cast<std::uint64_t>(cacheStatus.st_ino);
+  std::uint32_t cacheHash;
+  if(not valid or
+     (isAmbiguous(cacheStatus.st_mtim, status.st_mtim) and
+      (not contentHashOf(iCacheFile, cacheHash) or header->cacheHash_ != cacheHash))) {
+    munmap(address, size);
+    return std::unique_ptr<PluginCacheIndex>();
+  }
+  return std::unique_ptr<PluginCacheIndex>(new PluginCacheIndex(address, size));
+}
+
+void
+PluginCacheIndex::write(const CacheParser::LoadableToPlugins& iPlugins,
+                        const boost::filesystem::path& iCacheFile,
+                        const boost::filesystem::path& iIndexFile)
+{
+  std::string strings;
+  std::map<std::string, std::uint32_t> offsets;
+  auto offsetOf = [&](const std::string& iString) {
+    auto inserted = offsets.insert(std::make_pair(iString, static_cast<std::uint32_t>(strings.size())));
+    if(inserted.second) {
+      strings.append(iString.c_str(), iString.size()+1);
+    }
+    return inserted.first->second;
+  };
+
+  //same order as the lines written by CacheParser::write
+  std::vector<Entry> entries;
+  std::map<std::string, std::uint32_t> categories;
+  for(auto const& loadablePlugins : iPlugins) {
+    auto const loadable = offsetOf(loadablePlugins.first.string());
+    auto nameAndTypes = loadablePlugins.second;
+    std::sort(nameAndTypes.begin(), nameAndTypes.end());
+    for(auto const& nameAndType : nameAndTypes) {
+      Entry entry;
+      entry.hash_ = hashOf(nameAndType.second.c_str(), nameAndType.first.c_str());
+      entry.category_ = offsetOf(nameAndType.second);
+      entry.name_ = offsetOf(nameAndType.first);
+      entry.loadable_ = loadable;
+      categories[nameAndType.second] = entry.category_;
+      entries.push_back(entry);
+    }
+  }
+  if(strings.empty()) {
+    strings.push_back('\0');
+  }
+
+  std::uint32_t nBuckets = 1;
+  while(nBuckets < entries.size()) {
+    nBuckets <<= 1;
+  }
+  std::vector<std::uint32_t> bucketStarts(nBuckets+1, 0);
+  for(auto const& entry : entries) {
+    ++bucketStarts[(entry.hash_ & (nBuckets-1))+1];
+  }
+  for(std::uint32_t i = 0; i != nBuckets; ++i) {
+    bucketStarts[i+1] += bucketStarts[i];
+  }
+  std::vector<std::uint32_t> slots(entries.size());
+  {
+    std::vector<std::uint32_t> next(bucketStarts.begin(), bucketStarts.end()-1);
+    for(std::uint32_t i = 0; i != entries.size(); ++i) {
+      slots[next[entries[i].hash_ & (nBuckets-1)]++] = i;
+    }
+  }
+  std::vector<std::uint32_t> categoryOffsets;
+  for(auto const& category : categories) {
+    categoryOffsets.push_back(category.second);
+  }
+
+  Header header;
+  std::memcpy(header.magic_, kMagic, sizeof(kMagic));
+  header.version_ = kVersion;
+  header.nEntries_ = entries.size();
+  header.nBuckets_ = nBuckets;
+  header.nCategories_ = categoryOffsets.size();
+  header.stringsSize_ = strings.size();
+  struct stat cacheStatus;
+  if(0 != stat(iCacheFile.string().c_str(), &cacheStatus) or
+     not contentHashOf(iCacheFile, header.cacheHash_)) {
+    throw cms::Exception("PluginCacheIndexWriteFailed")<<"unable to read the cache file '"<<iCacheFile.string()<<"'";
+  }
+  header.cacheSeconds_ = cacheStatus.st_mtim.tv_sec;
+  header.cacheNanoseconds_ = cacheStatus.st_mtim.tv_nsec;
+  header.cacheSize_ = cacheStatus.st_size;
+  header.cacheInode_ = cacheStatus.st_ino;
+
+  //write to a temporary file so a job never maps a partially written index
+  std::string const temporaryFilename = iIndexFile.string()+".tmp";
+  {
+    std::ofstream file(temporaryFilename.c_str(), std::ios::binary);
+    if(not file) {
+      throw cms::Exception("PluginCacheIndexWriteFailed")<<"unable to open file '"<<temporaryFilename<<"' for writing.\n"
+      "Please check permissions on the file.";
+    }
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    file.write(reinterpret_cast<char const*>(entries.data()), entries.size()*sizeof(Entry));
+    file.write(reinterpret_cast<char const*>(bucketStarts.data()), bucketStarts.size()*sizeof(std::uint32_t));
+    file.write(reinterpret_cast<char const*>(slots.data()), slots.size()*sizeof(std::uint32_t));
+    file.write(reinterpret_cast<char const*>(categoryOffsets.data()), categoryOffsets.size()*sizeof(std::uint32_t));
+    file.write(strings.data(), strings.size());
+    if(not file.flush()) {
+      throw cms::Exception("PluginCacheIndexWriteFailed")<<"failed writing the file '"<<temporaryFilename<<"'";
+    }
+  }
+  if(0 != std::rename(temporaryFilename.c_str(), iIndexFile.string().c_str())) {
+    throw cms::Exception("PluginCacheIndexWriteFailed")<<"unable to rename '"<<temporaryFilename<<"' to '"
+    <<iIndexFile.string()<<"'";
+  }
+}
+}
@@ -13,6 +13,7 @@
 // system include files
 #include <boost/filesystem/operations.hpp>
 
+#include <algorithm>
 #include <fstream>
 #include <functional>
 #include <set>
@@ -54,6 +55,22 @@ static bool readCacheFile(const boost::filesystem::path &cacheFile,
   }
   return false;
 }
+
+static void throwMultiplePlugins(const std::string& iPlugin,
+                                 const boost::filesystem::path& iFirst,
+                                 const boost::filesystem::path& iSecond)
+{
+  throw cms::Exception("MultiplePlugins")<<"The plugin '"<<iPlugin<<"' is found in multiple files \n"
+  " '"<<iFirst.leaf()<<"'\n '"
+  <<iSecond.leaf()<<"'\n"
+  "in directory '"<<iFirst.branch_path().string()<<"'.\n"
+  "The code must be changed so the plugin only appears in one plugin file. "
+  "You will need to remove the macro which registers the plugin so it only appears in"
+  " one of these files.\n"
+  "  If none of these files register such a plugin, "
+  "then the problem originates in a library to which all these files link.\n"
+  "The plugin registration must be removed from that library since plugins are not allowed in regular libraries.";
+}
 //
 // constructors and destructor
 //
@@ -73,14 +90,14 @@ PluginManager::PluginManager(const PluginManager::Config& iConfig) :
     // When building a single big executable the plugins are already registered in the 
     // PluginFactoryManager, we therefore only need to populate the categoryToInfos_ map
     // with the relevant information.
+    caches_.emplace_back();
     for (PluginFactoryManager::const_iterator i = pfm->begin(), e = pfm->end(); i != e; ++i)
     {
-    	categoryToInfos_[(*i)->category()] = (*i)->available();
+    	caches_.back().infos_[(*i)->category()] = (*i)->available();
     }
 
     //read in the files
-    //Since we are looping in the 'precidence' order then the lists in categoryToInfos_ will also be
-    // in that order
+    //Since we are looping in the 'precidence' order then caches_ will also be in that order
     bool foundAtLeastOneCacheFile = false;
     std::set<std::string> alreadySeen;
     for(SearchPath::const_iterator itPath=searchPath_.begin(), itEnd = searchPath_.end();
@@ -98,7 +115,10 @@ PluginManager::PluginManager(const PluginManager::Config& iConfig) :
         }
         boost::filesystem::path cacheFile = dir/kCacheFile;
         
-        if (readCacheFile(cacheFile, dir, categoryToInfos_))
+        caches_.emplace_back();
+        caches_.back().directory_ = dir;
+        caches_.back().index_ = PluginCacheIndex::open(dir/standard::cacheIndexFileName(), cacheFile);
+        if (caches_.back().index_ or readCacheFile(cacheFile, dir, caches_.back().infos_))
         {
           foundAtLeastOneCacheFile=true; 
         }
@@ -106,7 +126,9 @@ PluginManager::PluginManager(const PluginManager::Config& iConfig) :
         // We do not check for return code since we do not want to consider a
         // poison cache file as a valid cache file having been found.
         boost::filesystem::path poisonedCacheFile = dir/kPoisonedCacheFile;
-        readCacheFile(poisonedCacheFile, dir/"poisoned", categoryToInfos_);
+        caches_.emplace_back();
+        caches_.back().directory_ = dir/"poisoned";
+        readCacheFile(poisonedCacheFile, caches_.back().directory_, caches_.back().infos_);
       }
     }
     if(not foundAtLeastOneCacheFile) {
@@ -175,55 +197,86 @@ PluginManager::loadableFor_(const std::string& iCategory,
 {
   const bool throwIfFail = ioThrowIfFailElseSucceedStatus;
   ioThrowIfFailElseSucceedStatus = true;
-  CategoryToInfos::iterator itFound = categoryToInfos_.find(iCategory);
-  if(itFound == categoryToInfos_.end()) {
-    if(throwIfFail) {
+
+  //the first cache with the plugin has precedence
+  bool categoryFound = false;
+  for(auto const& cache : caches_) {
+    if(cache.index_) {
+      PluginCacheIndex::Match match = cache.index_->find(iCategory, iPlugin);
+      if(match.loadable_ == nullptr) {
+        categoryFound = categoryFound or cache.index_->hasCategory(iCategory);
+        continue;
+      }
+      if(match.duplicate_ != nullptr) {
+        throwMultiplePlugins(iPlugin, cache.directory_/match.loadable_, cache.directory_/match.duplicate_);
+      }
+      std::string key(iCategory);
+      key += '\0';
+      key += iPlugin;
+      auto itFound = indexedLoadables_.find(key);
+      if(itFound == indexedLoadables_.end()) {
+        itFound = indexedLoadables_.insert(std::make_pair(key, cache.directory_/match.loadable_)).first;
+      }
+      return itFound->second;
+    }
+
+    CategoryToInfos::const_iterator itFound = cache.infos_.find(iCategory);
+    if(itFound == cache.infos_.end()) {
+      continue;
+    }
+    categoryFound = true;
+    PluginInfo i;
+    i.name_ = iPlugin;
+    typedef std::vector<PluginInfo>::const_iterator PIItr;
+    std::pair<PIItr,PIItr> range = std::equal_range(itFound->second.begin(),
+                                                    itFound->second.end(),
+                                                    i,
+                                                    PICompare() );
+    if(range.first == range.second) {
+      continue;
+    }
+    if(range.second - range.first > 1 ) {
+      //see if the come from the same directory
+      if(range.first->loadable_.branch_path() == (range.first+1)->loadable_.branch_path()) {
+        throwMultiplePlugins(iPlugin, range.first->loadable_, (range.first+1)->loadable_);
+      }
+    }
+    return range.first->loadable_;
+  }
+
+  if(throwIfFail) {
+    if(not categoryFound) {
       throw cms::Exception("PluginNotFound")<<"Unable to find plugin '"<<iPlugin<<
       "' because the category '"<<iCategory<<"' has no known plugins";
-    } else {
-      ioThrowIfFailElseSucceedStatus = false;
-      static const boost::filesystem::path s_path;
-      return s_path;
     }
+    throw cms::Exception("PluginNotFound")<<"Unable to find plugin '"<<iPlugin
+    <<"' in category '"<<iCategory<<"'. Please check spelling of name.";
   }
-  
-  PluginInfo i;
-  i.name_ = iPlugin;
-  typedef std::vector<PluginInfo>::iterator PIItr;
-  std::pair<PIItr,PIItr> range = std::equal_range(itFound->second.begin(),
-                                                  itFound->second.end(),
-                                                  i,
-                                                  PICompare() );
-  
-  if(range.first == range.second) {
-    if(throwIfFail) {
-      throw cms::Exception("PluginNotFound")<<"Unable to find plugin '"<<iPlugin
-      <<"' in category '"<<iCategory<<"'. Please check spelling of name.";
-    } else {
-      ioThrowIfFailElseSucceedStatus = false;
-      static const boost::filesystem::path s_path;
-      return s_path;
+  ioThrowIfFailElseSucceedStatus = false;
+  static const boost::filesystem::path s_path;
+  return s_path;
+}
+
+const PluginManager::CategoryToInfos&
+PluginManager::categoryToInfos() const
+{
+  std::call_once(categoryToInfosFilled_, [this]() {
+    for(auto const& cache : caches_) {
+      if(cache.index_) {
+        cache.index_->fill(cache.directory_, categoryToInfos_);
+        continue;
+      }
+      for(auto const& categoryInfos : cache.infos_) {
+        auto& infos = categoryToInfos_[categoryInfos.first];
+        infos.insert(infos.end(), categoryInfos.second.begin(), categoryInfos.second.end());
+      }
     }
-  }
-  
-  if(range.second - range.first > 1 ) {
-    //see if the come from the same directory
-    if(range.first->loadable_.branch_path() == (range.first+1)->loadable_.branch_path()) {
-      //std::cout<<range.first->name_ <<" " <<(range.first+1)->name_<<std::endl;
-      throw cms::Exception("MultiplePlugins")<<"The plugin '"<<iPlugin<<"' is found in multiple files \n"
-      " '"<<range.first->loadable_.leaf()<<"'\n '"
-      <<(range.first+1)->loadable_.leaf()<<"'\n"
-      "in directory '"<<range.first->loadable_.branch_path().string()<<"'.\n"
-      "The code must be changed so the plugin only appears in one plugin file. "
-      "You will need to remove the macro which registers the plugin so it only appears in"
-      " one of these files.\n"
-      "  If none of these files register such a plugin, "
-      "then the problem originates in a library to which all these files link.\n"
-      "The plugin registration must be removed from that library since plugins are not allowed in regular libraries.";
+    //keep the order of precedence for identical names
+    for(auto& categoryInfos : categoryToInfos_) {
+      std::stable_sort(categoryInfos.second.begin(), categoryInfos.second.end(), PICompare());
     }
-  }
-  
-  return range.first->loadable_;
+  });
+  return categoryToInfos_;
 }
 
 namespace {
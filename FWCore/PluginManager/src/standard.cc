@@ -53,6 +53,11 @@ namespace edmplugin {
       static const boost::filesystem::path s_path(".poisonededmplugincache");
       return s_path;
     }
+
+    const boost::filesystem::path& cacheIndexFileName() {
+      static const boost::filesystem::path s_path(".edmplugincache.idx");
+      return s_path;
+    }
     
     
     const std::string& pluginPrefix() {
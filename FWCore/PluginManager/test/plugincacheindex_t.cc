@@ -0,0 +1,196 @@
+// -*- C++ -*-
+//
+// Package:     PluginManager
+// Class  :     plugincacheindex_t
+//
+// Implementation:
+//     <Notes on implementation>
+//
+// Original Author:  FWCore
+//         Created:  Fri, 20 Oct 2017 10:12:37 GMT
+//
+
+// system include files
+#include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
+#include <cppunit/extensions/HelperMacros.h>
+#include <boost/filesystem/operations.hpp>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+// user include files
+#include "FWCore/PluginManager/interface/PluginCacheIndex.h"
+
+class TestPluginCacheIndex : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestPluginCacheIndex);
+  CPPUNIT_TEST(testFind);
+  CPPUNIT_TEST(testFill);
+  CPPUNIT_TEST(testStale);
+  CPPUNIT_TEST(testAmbiguousTime);
+  CPPUNIT_TEST_SUITE_END();
+public:
+    void testFind();
+    void testFill();
+    void testStale();
+    void testAmbiguousTime();
+    void setUp();
+    void tearDown();
+private:
+    boost::filesystem::path directory_;
+    boost::filesystem::path cacheFile_;
+    boost::filesystem::path indexFile_;
+    edmplugin::CacheParser::LoadableToPlugins plugins_;
+};
+
+///registration of the test so that the runner can find it
+CPPUNIT_TEST_SUITE_REGISTRATION(TestPluginCacheIndex);
+
+void
+TestPluginCacheIndex::setUp()
+{
+  using namespace edmplugin;
+  directory_ = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  boost::filesystem::create_directories(directory_);
+  cacheFile_ = directory_ / ".edmplugincache";
+  indexFile_ = directory_ / ".edmplugincache.idx";
+
+  plugins_.clear();
+  plugins_["pluginA.so"].push_back(CacheParser::NameAndType("BetaClass<Itl >", "Cat Two"));
+  plugins_["pluginA.so"].push_back(CacheParser::NameAndType("AlphaClass", "Cat One"));
+  plugins_["pluginB.so"].push_back(CacheParser::NameAndType("GammaClass", "Cat One"));
+  //registered twice in the same directory
+  plugins_["pluginC.so"].push_back(CacheParser::NameAndType("AlphaClass", "Cat One"));
+  for(unsigned int i = 0; i != 100; ++i) {
+    plugins_["pluginD.so"].push_back(CacheParser::NameAndType("Many"+std::to_string(i), "Cat Three"));
+  }
+
+  std::ofstream cache(cacheFile_.string().c_str());
+  CacheParser::LoadableToPlugins copy(plugins_);
+  CacheParser::write(copy, cache);
+  cache.close();
+  PluginCacheIndex::write(plugins_, cacheFile_, indexFile_);
+}
+
+void
+TestPluginCacheIndex::tearDown()
+{
+  boost::filesystem::remove_all(directory_);
+}
+
+void
+TestPluginCacheIndex::testFind()
+{
+  using namespace edmplugin;
+  auto index = PluginCacheIndex::open(indexFile_, cacheFile_);
+  CPPUNIT_ASSERT(index.get() != nullptr);
+
+  auto match = index->find("Cat Two", "BetaClass<Itl >");
+  CPPUNIT_ASSERT(match.loadable_ != nullptr);
+  CPPUNIT_ASSERT(std::string("pluginA.so") == match.loadable_);
+  CPPUNIT_ASSERT(match.duplicate_ == nullptr);
+
+  match = index->find("Cat One", "AlphaClass");
+  CPPUNIT_ASSERT(std::string("pluginA.so") == match.loadable_);
+  CPPUNIT_ASSERT(match.duplicate_ != nullptr);
+  CPPUNIT_ASSERT(std::string("pluginC.so") == match.duplicate_);
+
+  for(unsigned int i = 0; i != 100; ++i) {
+    match = index->find("Cat Three", "Many"+std::to_string(i));
+    CPPUNIT_ASSERT(match.loadable_ != nullptr);
+    CPPUNIT_ASSERT(std::string("pluginD.so") == match.loadable_);
+  }
+
+  CPPUNIT_ASSERT(index->find("Cat One", "BetaClass<Itl >").loadable_ == nullptr);
+  CPPUNIT_ASSERT(index->find("Cat Four", "AlphaClass").loadable_ == nullptr);
+
+  CPPUNIT_ASSERT(index->hasCategory("Cat One"));
+  CPPUNIT_ASSERT(index->hasCategory("Cat Three"));
+  CPPUNIT_ASSERT(not index->hasCategory("Cat Four"));
+  CPPUNIT_ASSERT(not index->hasCategory("Cat"));
+}
+
+void
+TestPluginCacheIndex::testFill()
+{
+  using namespace edmplugin;
+  auto index = PluginCacheIndex::open(indexFile_, cacheFile_);
+  CPPUNIT_ASSERT(index.get() != nullptr);
+
+  CacheParser::CategoryToInfos fromIndex;
+  index->fill(directory_, fromIndex);
+
+  CacheParser::CategoryToInfos fromText;
+  std::ifstream cache(cacheFile_.string().c_str());
+  CacheParser::read(cache, directory_, fromText);
+
+  CPPUNIT_ASSERT(fromIndex.size() == fromText.size());
+  for(auto const& categoryInfos : fromText) {
+    auto const& infos = fromIndex[categoryInfos.first];
+    CPPUNIT_ASSERT(infos.size() == categoryInfos.second.size());
+    for(unsigned int i = 0; i != infos.size(); ++i) {
+      CPPUNIT_ASSERT(infos[i].name_ == categoryInfos.second[i].name_);
+      CPPUNIT_ASSERT(infos[i].loadable_ == categoryInfos.second[i].loadable_);
+    }
+  }
+}
+
+void
+TestPluginCacheIndex::testStale()
+{
+  using namespace edmplugin;
+  CPPUNIT_ASSERT(PluginCacheIndex::open(directory_ / "missing", cacheFile_).get() == nullptr);
+
+  //the cache file was updated after the index was written
+  {
+    std::ofstream cache(cacheFile_.string().c_str(), std::ios::app);
+    cache << "pluginE.so DeltaClass Cat%One\n";
+  }
+  CPPUNIT_ASSERT(PluginCacheIndex::open(indexFile_, cacheFile_).get() == nullptr);
+
+  //the cache file was rewritten within the same second, keeping its size
+  PluginCacheIndex::write(plugins_, cacheFile_, indexFile_);
+  CPPUNIT_ASSERT(PluginCacheIndex::open(indexFile_, cacheFile_).get() != nullptr);
+  {
+    auto const time = boost::filesystem::last_write_time(cacheFile_);
+    std::fstream cache(cacheFile_.string().c_str(), std::ios::in | std::ios::out);
+    cache.seekp(0);
+    cache << "plugin_";
+    cache.close();
+    boost::filesystem::last_write_time(cacheFile_, time);
+  }
+  CPPUNIT_ASSERT(PluginCacheIndex::open(indexFile_, cacheFile_).get() == nullptr);
+
+  //a truncated index is ignored
+  PluginCacheIndex::write(plugins_, cacheFile_, indexFile_);
+  CPPUNIT_ASSERT(PluginCacheIndex::open(indexFile_, cacheFile_).get() != nullptr);
+  boost::filesystem::resize_file(indexFile_, boost::filesystem::file_size(indexFile_)-1);
+  CPPUNIT_ASSERT(PluginCacheIndex::open(indexFile_, cacheFile_).get() == nullptr);
+}
+
+void
+TestPluginCacheIndex::testAmbiguousTime()
+{
+  using namespace edmplugin;
+  //the cache file is modified in the same tick as the index is written, only
+  // its content tells if it was rewritten
+  struct stat status;
+  CPPUNIT_ASSERT(0 == stat(indexFile_.string().c_str(), &status));
+  timespec times[2];
+  times[0] = status.st_mtim;
+  times[1] = status.st_mtim;
+  ++times[1].tv_sec;
+  CPPUNIT_ASSERT(0 == utimensat(AT_FDCWD, cacheFile_.string().c_str(), times, 0));
+  PluginCacheIndex::write(plugins_, cacheFile_, indexFile_);
+  CPPUNIT_ASSERT(PluginCacheIndex::open(indexFile_, cacheFile_).get() != nullptr);
+
+  {
+    std::fstream cache(cacheFile_.string().c_str(), std::ios::in | std::ios::out);
+    cache.seekp(0);
+    cache << "plugin_";
+  }
+  CPPUNIT_ASSERT(0 == utimensat(AT_FDCWD, cacheFile_.string().c_str(), times, 0));
+  CPPUNIT_ASSERT(PluginCacheIndex::open(indexFile_, cacheFile_).get() == nullptr);
+}
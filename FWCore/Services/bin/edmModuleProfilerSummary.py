@@ -0,0 +1,143 @@
+#!/usr/bin/env python
+#==============================
+#
+# Summarises the binary file written by the ModuleProfiler service.
+#
+# For each module and transition the number of calls and the total
+# wall time, CPU time, bytes allocated and bytes freed are printed.
+# If a second file is given, the per module CPU times of the two files
+# are compared which allows spotting regressions between two jobs.
+#
+# The file layout is documented in FWCore/Services/plugins/ModuleProfiler.cc
+#==============================
+
+from __future__ import print_function
+import argparse
+import struct
+import sys
+
+_magic = b'EDMPROF\x00'
+_header = struct.Struct('=8sII')
+_moduleRecord = struct.Struct('=BBHIII')
+_measurementRecord = struct.Struct('=BBHIQQQQQ')
+
+_transitions = ['construction', 'beginJob', 'beginStream',
+                'globalBeginRun', 'streamBeginRun',
+                'globalBeginLumi', 'streamBeginLumi',
+                'event',
+                'streamEndLumi', 'globalEndLumi',
+                'streamEndRun', 'globalEndRun',
+                'endStream', 'endJob']
+
+_allocationSources = ['none', 'allocator shim', 'jemalloc']
+
+class ModuleStats(object):
+    def __init__(self):
+        self.calls = 0
+        self.wall = 0
+        self.cpu = 0
+        self.maxWall = 0
+        self.allocated = 0
+        self.deallocated = 0
+    def add(self, wall, cpu, allocated, deallocated):
+        self.calls += 1
+        self.wall += wall
+        self.cpu += cpu
+        self.maxWall = max(self.maxWall, wall)
+        self.allocated += allocated
+        self.deallocated += deallocated
+
+class Profile(object):
+    def __init__(self, fileName):
+        self.modules = dict()
+        self.stats = dict()
+        with open(fileName, 'rb') as f:
+            data = f.read()
+        magic, version, allocationSource = _header.unpack_from(data, 0)
+        if magic != _magic:
+            raise RuntimeError(fileName + ' was not written by the ModuleProfiler service')
+        if version != 1:
+            raise RuntimeError('unsupported file version %d' % version)
+        self.allocationSource = _allocationSources[allocationSource] if allocationSource < len(_allocationSources) else 'unknown'
+        pos = _header.size
+        size = len(data)
+        while pos < size:
+            kind = data[pos:pos+1]
+            if kind == b'T':
+                (_, transition, stream, moduleID, start, wall, cpu, allocated, deallocated) = _measurementRecord.unpack_from(data, pos)
+                pos += _measurementRecord.size
+                key = (moduleID, transition)
+                stats = self.stats.get(key)
+                if stats is None:
+                    stats = self.stats[key] = ModuleStats()
+                stats.add(wall, cpu, allocated, deallocated)
+            elif kind == b'M':
+                (_, _, labelSize, moduleID, typeSize, _) = _moduleRecord.unpack_from(data, pos)
+                pos += _moduleRecord.size
+                label = data[pos:pos+labelSize].decode()
+                pos += labelSize
+                moduleType = data[pos:pos+typeSize].decode()
+                pos += typeSize
+                self.modules[moduleID] = (label, moduleType)
+            else:
+                raise RuntimeError('corrupted file at byte %d' % pos)
+
+    def label(self, moduleID):
+        return self.modules.get(moduleID, ('<unknown %d>' % moduleID, ''))[0]
+
+    def cpuPerModule(self, transition=None):
+        result = dict()
+        for (moduleID, t), stats in self.stats.items():
+            if transition is None or t == transition:
+                label = self.label(moduleID)
+                result[label] = result.get(label, 0) + stats.cpu
+        return result
+
+def printSummary(profile, transition, top):
+    print('Allocation information from: ' + profile.allocationSource)
+    rows = []
+    for (moduleID, t), stats in profile.stats.items():
+        if transition is not None and t != transition:
+            continue
+        rows.append((profile.label(moduleID), _transitions[t] if t < len(_transitions) else str(t), stats))
+    rows.sort(key=lambda r: r[2].cpu, reverse=True)
+    if top:
+        rows = rows[:top]
+    width = max([len(r[0]) for r in rows] + [len('Module')])
+    print('%-*s %-16s %10s %12s %12s %12s %14s %14s' % (width, 'Module', 'Transition', 'Calls', 'CPU (s)', 'Wall (s)', 'Max wall (s)', 'Allocated (MB)', 'Freed (MB)'))
+    for label, transitionName, stats in rows:
+        print('%-*s %-16s %10d %12.4f %12.4f %12.4f %14.3f %14.3f' % (width, label, transitionName, stats.calls,
+                                                                   stats.cpu*1e-9, stats.wall*1e-9, stats.maxWall*1e-9,
+                                                                   stats.allocated/1048576., stats.deallocated/1048576.))
+
+def printComparison(reference, profile, transition, threshold):
+    ref = reference.cpuPerModule(transition)
+    new = profile.cpuPerModule(transition)
+    rows = []
+    for label in set(ref) | set(new):
+        r = ref.get(label, 0)*1e-9
+        n = new.get(label, 0)*1e-9
+        change = (n-r)/r*100. if r > 0 else float('inf')
+        if abs(change) >= threshold:
+            rows.append((label, r, n, change))
+    rows.sort(key=lambda r: r[2]-r[1], reverse=True)
+    width = max([len(r[0]) for r in rows] + [len('Module')])
+    print('%-*s %14s %14s %10s' % (width, 'Module', 'Reference (s)', 'CPU (s)', 'Change %'))
+    for label, r, n, change in rows:
+        print('%-*s %14.4f %14.4f %10.1f' % (width, label, r, n, change))
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Summarise the file written by the ModuleProfiler service.')
+    parser.add_argument('fileName', help='file written by the ModuleProfiler service')
+    parser.add_argument('--reference', help='second ModuleProfiler file to compare the CPU time of each module against')
+    parser.add_argument('--transition', choices=_transitions, help='only consider the given transition')
+    parser.add_argument('--top', type=int, default=0, help='only print the N most expensive entries')
+    parser.add_argument('--threshold', type=float, default=5., help='only print modules whose CPU time changed by at least this percentage when comparing')
+    args = parser.parse_args()
+
+    transition = _transitions.index(args.transition) if args.transition else None
+    profile = Profile(args.fileName)
+    if args.reference:
+        printComparison(Profile(args.reference), profile, transition, args.threshold)
+    else:
+        printSummary(profile, transition, args.top)
@@ -0,0 +1,410 @@
+// -*- C++ -*-
+//
+// Package: FWCore/Services
+// Class  : ModuleProfiler
+//
+// Implementation:
+//
+//   For every module transition the wall-clock time, the CPU time of
+//   the thread running the module and the number of bytes allocated and
+//   freed by that thread are measured. The measurements are exclusive:
+//   the cost of a module run from within another module (e.g. by a
+//   delayed get) is only attributed to the inner module.
+//
+//   Each measurement is appended as a fixed-size binary record to a
+//   buffer owned by the thread. Full buffers are handed to a
+//   ThreadSafeOutputFileStream so the file is written while the job
+//   runs. The file layout is described below and is read by the
+//   edmModuleProfilerSummary.py script.
+//
+//   Allocation information is taken from (in order of preference)
+//     1) an allocator shim loaded in the process (e.g. via LD_PRELOAD)
+//        which exports 'edm_alloc_shim_thread_counters'
+//        (see PerfTools/AllocShim)
+//     2) jemalloc's per-thread statistics, if jemalloc was built with
+//        statistics enabled
+//   If neither is available, the allocation fields are 0.
+//
+//   File layout (native byte order):
+//     header : char[8] "EDMPROF", uint32 version, uint32 allocation source
+//     'M' record (module description), 16 bytes followed by the strings
+//       uint8 kind, uint8 unused, uint16 label size, uint32 module id,
+//       uint32 type size, uint32 unused, char label[], char type[]
+//     'T' record (measurement), 48 bytes
+//       uint8 kind, uint8 transition, uint16 stream (0xFFFF if none),
+//       uint32 module id, uint64 start (ns since the service was made),
+//       uint64 wall (ns), uint64 cpu (ns), uint64 bytes allocated,
+//       uint64 bytes freed
+//
+
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/Concurrency/interface/ThreadSafeOutputFileStream.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/GlobalContext.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+#include "FWCore/ServiceRegistry/interface/StreamContext.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+#include "PerfTools/AllocShim/interface/AllocShim.h"
+
+#include "tbb/enumerable_thread_specific.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <dlfcn.h>
+#include <time.h>
+
+// see <jemalloc/jemalloc.h>
+extern "C" {
+  typedef int (*mallctl_t)(const char* name, void* oldp, size_t* oldlenp, void* newp, size_t newlen);
+}
+// the shim is looked up at run time, so the plugin works with or without it
+typedef decltype(&edm_alloc_shim_thread_counters) alloc_shim_counters_t;
+
+namespace {
+
+  constexpr char const kMagic[8] = {'E','D','M','P','R','O','F','\0'};
+  constexpr uint32_t kVersion = 1;
+  constexpr uint16_t kNoStream = 0xFFFF;
+
+  enum class AllocationSource : uint32_t { kNone = 0, kShim = 1, kJemalloc = 2 };
+
+  enum class Transition : uint8_t {
+    kConstruction = 0,
+    kBeginJob,
+    kBeginStream,
+    kGlobalBeginRun,
+    kStreamBeginRun,
+    kGlobalBeginLumi,
+    kStreamBeginLumi,
+    kEvent,
+    kStreamEndLumi,
+    kGlobalEndLumi,
+    kStreamEndRun,
+    kGlobalEndRun,
+    kEndStream,
+    kEndJob
+  };
+
+  struct ModuleRecord {
+    uint8_t kind = 'M';
+    uint8_t unused0 = 0;
+    uint16_t labelSize;
+    uint32_t moduleID;
+    uint32_t typeSize;
+    uint32_t unused1 = 0;
+  };
+  static_assert(sizeof(ModuleRecord) == 16, "ModuleRecord layout changed");
+
+  struct MeasurementRecord {
+    uint8_t kind = 'T';
+    uint8_t transition;
+    uint16_t stream;
+    uint32_t moduleID;
+    uint64_t start;
+    uint64_t wall;
+    uint64_t cpu;
+    uint64_t allocated;
+    uint64_t deallocated;
+  };
+  static_assert(sizeof(MeasurementRecord) == 48, "MeasurementRecord layout changed");
+
+  uint64_t const s_zero = 0;
+  alloc_shim_counters_t s_shimCounters = nullptr;
+  mallctl_t s_mallctl = nullptr;
+
+  AllocationSource findAllocationSource() {
+    s_shimCounters = reinterpret_cast<alloc_shim_counters_t>(::dlsym(RTLD_DEFAULT, "edm_alloc_shim_thread_counters"));
+    if(s_shimCounters) {
+      return AllocationSource::kShim;
+    }
+    s_mallctl = reinterpret_cast<mallctl_t>(::dlsym(RTLD_DEFAULT, "mallctl"));
+    if(s_mallctl) {
+      // only usable if jemalloc was built with --enable-stats
+      bool enableStats = false;
+      size_t boolSize = sizeof(bool);
+      s_mallctl("config.stats", &enableStats, &boolSize, nullptr, 0);
+      if(enableStats) {
+        return AllocationSource::kJemalloc;
+      }
+    }
+    return AllocationSource::kNone;
+  }
+
+  inline uint64_t threadCPUTime() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec)*1000000000ULL + ts.tv_nsec;
+  }
+
+  struct Measurement {
+    uint64_t wall = 0;
+    uint64_t cpu = 0;
+    uint64_t allocated = 0;
+    uint64_t deallocated = 0;
+
+    Measurement& operator+=(Measurement const& iOther) {
+      wall += iOther.wall;
+      cpu += iOther.cpu;
+      allocated += iOther.allocated;
+      deallocated += iOther.deallocated;
+      return *this;
+    }
+    Measurement& operator-=(Measurement const& iOther) {
+      wall -= iOther.wall;
+      cpu -= iOther.cpu;
+      allocated -= iOther.allocated;
+      deallocated -= iOther.deallocated;
+      return *this;
+    }
+  };
+
+  // Only ever used by the thread which created it.
+  class ThreadData {
+  public:
+    explicit ThreadData(AllocationSource iSource) :
+      allocated_(&s_zero),
+      deallocated_(&s_zero) {
+      if(iSource == AllocationSource::kShim) {
+        auto counters = s_shimCounters();
+        allocated_ = &counters->allocated;
+        deallocated_ = &counters->deallocated;
+      } else if(iSource == AllocationSource::kJemalloc) {
+        size_t ptrSize = sizeof(uint64_t*);
+        s_mallctl("thread.allocatedp", &allocated_, &ptrSize, nullptr, 0);
+        s_mallctl("thread.deallocatedp", &deallocated_, &ptrSize, nullptr, 0);
+      }
+    }
+
+    Measurement now(std::chrono::steady_clock::time_point iBegin) const {
+      Measurement m;
+      m.wall = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-iBegin).count();
+      m.cpu = threadCPUTime();
+      m.allocated = *allocated_;
+      m.deallocated = *deallocated_;
+      return m;
+    }
+
+    struct Frame {
+      Measurement start;
+      Measurement nested;
+    };
+    std::vector<Frame> frames_;
+    std::string buffer_;
+
+  private:
+    uint64_t const* allocated_;
+    uint64_t const* deallocated_;
+  };
+
+  template<typename T>
+  void append(std::string& oBuffer, T const& iRecord) {
+    oBuffer.append(reinterpret_cast<char const*>(&iRecord), sizeof(T));
+  }
+
+  inline uint16_t stream_id(edm::StreamContext const& sc) {
+    return sc.streamID().value();
+  }
+}
+
+namespace edm {
+  namespace service {
+
+    class ModuleProfiler {
+    public:
+      ModuleProfiler(ParameterSet const&, ActivityRegistry&);
+      ~ModuleProfiler();
+      static void fillDescriptions(ConfigurationDescriptions& descriptions);
+
+    private:
+      void start();
+      void stop(Transition iTransition, uint16_t iStream, unsigned int iModuleID);
+      void postEndJob();
+
+      ThreadSafeOutputFileStream file_;
+      AllocationSource const allocationSource_;
+      std::size_t const bufferSize_;
+      std::chrono::steady_clock::time_point const beginTime_;
+      tbb::enumerable_thread_specific<ThreadData> threadData_;
+    };
+  }
+}
+
+using edm::service::ModuleProfiler;
+
+ModuleProfiler::ModuleProfiler(ParameterSet const& iPS, ActivityRegistry& iRegistry) :
+  file_{iPS.getUntrackedParameter<std::string>("fileName")},
+  allocationSource_{findAllocationSource()},
+  bufferSize_{iPS.getUntrackedParameter<unsigned int>("bufferSize")},
+  beginTime_{std::chrono::steady_clock::now()},
+  threadData_{[this]() { return ThreadData(allocationSource_); }} {
+
+  if(not file_) {
+    throw edm::Exception(edm::errors::Configuration)
+      << "ModuleProfiler could not open file '" << iPS.getUntrackedParameter<std::string>("fileName") << "' for writing.";
+  }
+  {
+    std::string header(kMagic, sizeof(kMagic));
+    append(header, kVersion);
+    append(header, static_cast<uint32_t>(allocationSource_));
+    file_.write(std::move(header));
+  }
+  if(allocationSource_ == AllocationSource::kNone) {
+    LogInfo("ModuleProfiler") << "No allocator shim or jemalloc statistics found, allocations will not be recorded.";
+  }
+
+  iRegistry.watchPreModuleConstruction([this](ModuleDescription const& md) {
+      ModuleRecord record;
+      record.labelSize = md.moduleLabel().size();
+      record.moduleID = md.id();
+      record.typeSize = md.moduleName().size();
+      std::string msg;
+      append(msg, record);
+      msg += md.moduleLabel();
+      msg += md.moduleName();
+      file_.write(std::move(msg));
+      start();
+    });
+  iRegistry.watchPostModuleConstruction([this](ModuleDescription const& md) {
+      stop(Transition::kConstruction, kNoStream, md.id());
+    });
+
+  iRegistry.watchPreModuleBeginJob([this](ModuleDescription const&) { start(); });
+  iRegistry.watchPostModuleBeginJob([this](ModuleDescription const& md) {
+      stop(Transition::kBeginJob, kNoStream, md.id());
+    });
+  iRegistry.watchPreModuleEndJob([this](ModuleDescription const&) { start(); });
+  iRegistry.watchPostModuleEndJob([this](ModuleDescription const& md) {
+      stop(Transition::kEndJob, kNoStream, md.id());
+    });
+
+  auto startStream = [this](StreamContext const&, ModuleCallingContext const&) { start(); };
+  auto startGlobal = [this](GlobalContext const&, ModuleCallingContext const&) { start(); };
+
+  iRegistry.watchPreModuleBeginStream(startStream);
+  iRegistry.watchPostModuleBeginStream([this](StreamContext const& sc, ModuleCallingContext const& mcc) {
+      stop(Transition::kBeginStream, stream_id(sc), mcc.moduleDescription()->id());
+    });
+  iRegistry.watchPreModuleEndStream(startStream);
+  iRegistry.watchPostModuleEndStream([this](StreamContext const& sc, ModuleCallingContext const& mcc) {
+      stop(Transition::kEndStream, stream_id(sc), mcc.moduleDescription()->id());
+    });
+
+  iRegistry.watchPreModuleGlobalBeginRun(startGlobal);
+  iRegistry.watchPostModuleGlobalBeginRun([this](GlobalContext const&, ModuleCallingContext const& mcc) {
+      stop(Transition::kGlobalBeginRun, kNoStream, mcc.moduleDescription()->id());
+    });
+  iRegistry.watchPreModuleGlobalEndRun(startGlobal);
+  iRegistry.watchPostModuleGlobalEndRun([this](GlobalContext const&, ModuleCallingContext const& mcc) {
+      stop(Transition::kGlobalEndRun, kNoStream, mcc.moduleDescription()->id());
+    });
+  iRegistry.watchPreModuleGlobalBeginLumi(startGlobal);
+  iRegistry.watchPostModuleGlobalBeginLumi([this](GlobalContext const&, ModuleCallingContext const& mcc) {
+      stop(Transition::kGlobalBeginLumi, kNoStream, mcc.moduleDescription()->id());
+    });
+  iRegistry.watchPreModuleGlobalEndLumi(startGlobal);
+  iRegistry.watchPostModuleGlobalEndLumi([this](GlobalContext const&, ModuleCallingContext const& mcc) {
+      stop(Transition::kGlobalEndLumi, kNoStream, mcc.moduleDescription()->id());
+    });
+
+  iRegistry.watchPreModuleStreamBeginRun(startStream);
+  iRegistry.watchPostModuleStreamBeginRun([this](StreamContext const& sc, ModuleCallingContext const& mcc) {
+      stop(Transition::kStreamBeginRun, stream_id(sc), mcc.moduleDescription()->id());
+    });
+  iRegistry.watchPreModuleStreamEndRun(startStream);
+  iRegistry.watchPostModuleStreamEndRun([this](StreamContext const& sc, ModuleCallingContext const& mcc) {
+      stop(Transition::kStreamEndRun, stream_id(sc), mcc.moduleDescription()->id());
+    });
+  iRegistry.watchPreModuleStreamBeginLumi(startStream);
+  iRegistry.watchPostModuleStreamBeginLumi([this](StreamContext const& sc, ModuleCallingContext const& mcc) {
+      stop(Transition::kStreamBeginLumi, stream_id(sc), mcc.moduleDescription()->id());
+    });
+  iRegistry.watchPreModuleStreamEndLumi(startStream);
+  iRegistry.watchPostModuleStreamEndLumi([this](StreamContext const& sc, ModuleCallingContext const& mcc) {
+      stop(Transition::kStreamEndLumi, stream_id(sc), mcc.moduleDescription()->id());
+    });
+
+  iRegistry.watchPreModuleEvent(startStream);
+  iRegistry.watchPostModuleEvent([this](StreamContext const& sc, ModuleCallingContext const& mcc) {
+      stop(Transition::kEvent, stream_id(sc), mcc.moduleDescription()->id());
+    });
+
+  iRegistry.watchPostEndJob(this, &ModuleProfiler::postEndJob);
+}
+
+ModuleProfiler::~ModuleProfiler() {
+  //in case the job stopped before postEndJob
+  postEndJob();
+}
+
+void ModuleProfiler::fillDescriptions(ConfigurationDescriptions& descriptions) {
+  ParameterSetDescription desc;
+  desc.addUntracked<std::string>("fileName", "moduleProfile.bin")->setComment("Name of the file to which the binary records are written.\n"
+                                                                               "Use edmModuleProfilerSummary.py to summarise the file.");
+  desc.addUntracked<unsigned int>("bufferSize", 1<<16)->setComment("Number of bytes each thread accumulates before writing to the file.");
+  descriptions.add("ModuleProfiler", desc);
+  descriptions.setComment("This service records, per module and per transition, the wall time, the thread CPU time and "
+                          "the bytes allocated and freed, and writes them to a binary file while the job runs.");
+}
+
+void ModuleProfiler::start() {
+  auto& data = threadData_.local();
+  data.frames_.push_back(ThreadData::Frame{data.now(beginTime_), Measurement{}});
+}
+
+void ModuleProfiler::stop(Transition iTransition, uint16_t iStream, unsigned int iModuleID) {
+  auto& data = threadData_.local();
+  if(data.frames_.empty()) {
+    //no matching start, e.g. the 'pre' signal was emitted before this service was watching
+    return;
+  }
+  auto const end = data.now(beginTime_);
+  auto const frame = data.frames_.back();
+  data.frames_.pop_back();
+
+  Measurement total = end;
+  total -= frame.start;
+  if(not data.frames_.empty()) {
+    data.frames_.back().nested += total;
+  }
+  Measurement exclusive = total;
+  exclusive -= frame.nested;
+
+  MeasurementRecord record;
+  record.transition = static_cast<uint8_t>(iTransition);
+  record.stream = iStream;
+  record.moduleID = iModuleID;
+  record.start = frame.start.wall;
+  record.wall = exclusive.wall;
+  record.cpu = exclusive.cpu;
+  record.allocated = exclusive.allocated;
+  record.deallocated = exclusive.deallocated;
+  append(data.buffer_, record);
+
+  if(data.buffer_.size() >= bufferSize_) {
+    std::string full;
+    full.reserve(bufferSize_+sizeof(MeasurementRecord));
+    full.swap(data.buffer_);
+    file_.write(std::move(full));
+  }
+}
+
+void ModuleProfiler::postEndJob() {
+  for(auto& data : threadData_) {
+    if(not data.buffer_.empty()) {
+      std::string full;
+      full.swap(data.buffer_);
+      file_.write(std::move(full));
+    }
+  }
+}
+
+DEFINE_FWK_SERVICE(ModuleProfiler);
@@ -0,0 +1,9 @@
+#!/bin/bash
+
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+F1=${LOCAL_TEST_DIR}/test_moduleprofiler_cfg.py
+
+(cmsRun $F1 ) || die "Failure using $F1" $?
+(python ${LOCAL_TEST_DIR}/../bin/edmModuleProfilerSummary.py moduleprofiler.bin --transition event | grep -q "^ints ") || die "Failure summarising moduleprofiler.bin" $?
@@ -0,0 +1,18 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(100))
+
+process.options = cms.untracked.PSet(numberOfThreads = cms.untracked.uint32(2),
+                                     numberOfStreams = cms.untracked.uint32(0))
+
+process.ints = cms.EDProducer("IntProducer", ivalue = cms.int32(2))
+
+process.p = cms.Path(process.ints)
+
+process.add_(cms.Service("ModuleProfiler",
+                         fileName = cms.untracked.string("moduleprofiler.bin"),
+                         bufferSize = cms.untracked.uint32(1024)))
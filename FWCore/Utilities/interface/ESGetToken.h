@@ -0,0 +1,59 @@
+#ifndef FWCore_Utilities_ESGetToken_h
+#define FWCore_Utilities_ESGetToken_h
+// -*- C++ -*-
+//
+// Package:     FWCore/Utilities
+// Class  :     ESGetToken
+//
+/**\class ESGetToken ESGetToken.h "FWCore/Utilities/interface/ESGetToken.h"
+
+ Description: A Token used to get data from an EventSetup Record
+
+ Usage:
+    A ESGetToken is created by calls to 'esConsumes' from an EDM module or from an EventSetup
+ data provider. Declaring the EventSetup data used lets the framework prefetch it before the module
+ is run and serialize the providers which get data from one another.
+ The ESGetToken can then be used to get the data from the Record it was declared for.
+
+*/
+//
+// Original Author:  FWCore
+//         Created:  Fri, 16 Oct 2026 09:12:40 GMT
+//
+
+// system include files
+#include <string>
+
+// user include files
+
+// forward declarations
+namespace edm {
+  class EDConsumerBase;
+  namespace eventsetup {
+    class DataProxyProvider;
+  }
+
+  template<typename ESProduct, typename ESRecord>
+  class ESGetToken
+  {
+    friend class EDConsumerBase;
+    friend class eventsetup::DataProxyProvider;
+
+  public:
+
+    ESGetToken() : m_label{}, m_isInitialized{false} {}
+
+    // ---------- const member functions ---------------------
+    std::string const& label() const { return m_label; }
+    bool isUninitialized() const { return not m_isInitialized; }
+
+  private:
+    explicit ESGetToken(std::string const& iLabel) : m_label{iLabel}, m_isInitialized{true} { }
+
+    // ---------- member data --------------------------------
+    std::string m_label;
+    bool m_isInitialized;
+  };
+}
+
+#endif
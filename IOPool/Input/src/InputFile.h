@@ -46,6 +46,8 @@ namespace edm {
     TObject* Get(char const* name) {return file_->Get(name);}
     TFileCacheRead* GetCacheRead() const {return file_->GetCacheRead();}
     void SetCacheRead(TFileCacheRead* tfcr) {file_->SetCacheRead(tfcr, nullptr, TFile::kDoNotDisconnect);}
+    // Asks the file to read the byte ranges asynchronously, see TStorageFactoryFile::ReadBuffers.
+    void readAhead(Long64_t* pos, Int_t* len, Int_t nbuf) {file_->ReadBuffers(nullptr, pos, len, nbuf);}
     void logFileAction(char const* msg, char const* fileName) const;
   private:
     edm::propagate_const<std::unique_ptr<TFile>> file_;
@@ -17,6 +17,8 @@
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "Utilities/StorageFactory/interface/StorageFactory.h"
 
+#include "TTreeCacheUnzip.h"
+
 namespace edm {
   RootPrimaryFileSequence::RootPrimaryFileSequence(
                 ParameterSet const& pset,
@@ -33,7 +35,8 @@ namespace edm {
     treeCacheSize_(noEventSort_ ? pset.getUntrackedParameter<unsigned int>("cacheSize") : 0U),
     duplicateChecker_(new DuplicateChecker(pset)),
     usingGoToEvent_(false),
-    enablePrefetching_(false) {
+    enablePrefetching_(false),
+    readAheadClusters_(pset.getUntrackedParameter<unsigned int>("readAheadClusters")) {
 
     // The SiteLocalConfig controls the TTreeCache size and the prefetching settings.
     Service<SiteLocalConfig> pSLC;
@@ -44,6 +47,17 @@ namespace edm {
       enablePrefetching_ = pSLC->enablePrefetching();
     }
 
+    // ROOT has a single parallel unzipping switch for the process, read whenever a TTree cache is made.
+    // It is set once here, while the job is configured, and never reset.
+    if(pset.getUntrackedParameter<bool>("parallelUnzip")) {
+      TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+    }
+
+    // The asynchronous reads of the files are only done in the background on request.
+    if(readAheadClusters_ > 0) {
+      StorageFactory::getToModify()->setReadAhead(true);
+    }
+
     std::string branchesMustMatch = pset.getUntrackedParameter<std::string>("branchesMustMatch", std::string("permissive"));
     if(branchesMustMatch == std::string("strict")) branchesMustMatch_ = BranchDescription::Strict;
 
@@ -143,7 +157,8 @@ namespace edm {
           input_.bypassVersionCheck(),
           input_.labelRawDataLikeMC(),
           usingGoToEvent_,
-          enablePrefetching_);
+          enablePrefetching_,
+          readAheadClusters_);
   }
 
   bool RootPrimaryFileSequence::nextFile() {
@@ -330,6 +345,15 @@ namespace edm {
                      "Note 3: Any sorting occurs independently in each input file (no sorting across input files).");
     desc.addUntracked<unsigned int>("cacheSize", roottree::defaultCacheSize)
         ->setComment("Size of ROOT TTree prefetch cache.  Affects performance.");
+    desc.addUntracked<bool>("parallelUnzip", false)
+        ->setComment("True:  Decompress the baskets in the TTree caches in parallel, outside of the lock serializing the reading of products.\n"
+                     "       The decompression runs as TBB tasks if ROOT implicit multi-threading is enabled (InitRootHandlers.EnableIMT).\n"
+                     "       The ROOT setting is global: it applies to every TTree cache made in the job afterwards.\n"
+                     "False: Decompress each basket when a product in it is read.");
+    desc.addUntracked<unsigned int>("readAheadClusters", 0U)
+        ->setComment("Number of clusters of the event TTree, after the one in the TTree cache, read in a background thread.\n"
+                     "Only used if the storage system does not prefetch itself; the memory used is limited by AdaptorConfig.readAheadMemoryMB.\n"
+                     "0 disables the read-ahead.");
     std::string defaultString("permissive");
     desc.addUntracked<std::string>("branchesMustMatch", defaultString)
         ->setComment("'strict':     Branches in each input file must match those in the first file.\n"
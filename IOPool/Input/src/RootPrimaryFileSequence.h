@@ -78,6 +78,7 @@ namespace edm {
     edm::propagate_const<std::shared_ptr<DuplicateChecker>> duplicateChecker_;
     bool usingGoToEvent_;
     bool enablePrefetching_;
+    unsigned int readAheadClusters_;
   }; // class RootPrimaryFileSequence
 }
 #endif
@@ -8,8 +8,10 @@
 #include "TTreeIndex.h"
 #include "TTreeCache.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <vector>
 
 namespace edm {
   namespace {
@@ -24,6 +26,19 @@ namespace edm {
       TBranch* branch = tree->GetBranch(BranchTypeToBranchEntryInfoBranchName(branchType).c_str());
       return branch;
     }
+    // Adds the position and size in the file of the baskets of branch starting in [first, end).
+    void addBaskets(TBranch* branch, Long64_t first, Long64_t end, std::vector<Long64_t>& positions, std::vector<Int_t>& lengths) {
+      Int_t const nBaskets = branch->GetWriteBasket();
+      Long64_t const* basketEntries = branch->GetBasketEntry();
+      Int_t const* basketBytes = branch->GetBasketBytes();
+      for(Int_t i = std::lower_bound(basketEntries, basketEntries + nBaskets, first) - basketEntries;
+          i < nBaskets and basketEntries[i] < end; ++i) {
+        if(basketBytes[i] > 0) {
+          positions.push_back(branch->GetBasketSeek(i));
+          lengths.push_back(basketBytes[i]);
+        }
+      }
+    }
   }
   RootTree::RootTree(std::shared_ptr<InputFile> filePtr,
                      BranchType const& branchType,
@@ -32,6 +47,7 @@ namespace edm {
                      unsigned int cacheSize,
                      unsigned int learningEntries,
                      bool enablePrefetching,
+                     unsigned int readAheadClusters,
                      InputType inputType) :
     filePtr_(filePtr),
     tree_(dynamic_cast<TTree*>(filePtr_.get() != nullptr ? filePtr_->Get(BranchTypeToProductTreeName(branchType).c_str()) : nullptr)),
@@ -56,6 +72,8 @@ namespace edm {
     cacheSize_(cacheSize),
     treeAutoFlush_(0),
     enablePrefetching_(enablePrefetching),
+    readAheadClusters_(readAheadClusters),
+    readAheadEntry_(0),
     enableTriggerCache_(branchType_ == InEvent),
     rootDelayedReader_(new RootDelayedReader(*this, filePtr, inputType)),
     branchEntryInfoBranch_(metaTree_ ? getProductProvenanceBranch(metaTree_, branchType_) : (tree_ ? getProductProvenanceBranch(tree_, branchType_) : nullptr)),
@@ -211,6 +229,7 @@ namespace edm {
     // we're not incurring additional over-reading - we're just doing it more efficiently.
     // NOTE: Constructor guarantees treeAutoFlush_ is positive, even if TTree->GetAutoFlush() is negative.
     if(theEntryNumber < entryNumber_ and theEntryNumber >=0) {
+      readAheadEntry_ = 0;
       //We started reading the file near the end, now we need to correct for the learning length
       if(switchOverEntry_ >tree_->GetEntries()) {
         switchOverEntry_ = switchOverEntry_-tree_->GetEntries();
@@ -239,6 +258,38 @@ namespace edm {
     if (treeCache_ && treeCache_->IsLearning() && switchOverEntry_ >= 0 && entryNumber_ >= switchOverEntry_) {
       stopTraining();
     }
+    if (readAheadClusters_ > 0 && treeCache_ && !treeCache_->IsLearning() && !treeCache_->IsAsyncReading() && entryNumber_ >= 0) {
+      readAhead();
+    }
+  }
+
+  // Requests the baskets of the branches in the treeCache_ for the readAheadClusters_ clusters
+  // following the one of the current entry, which the treeCache_ reads itself.  The file reads them
+  // in the background so that, when the treeCache_ moves to the next cluster, its data is in memory.
+  void
+  RootTree::readAhead() {
+    TTree::TClusterIterator clusterIter = tree_->GetClusterIterator(entryNumber_);
+    clusterIter.Next();
+    EntryNumber first = std::max(clusterIter.GetNextEntry(), readAheadEntry_);
+    EntryNumber end = clusterIter.GetNextEntry();
+    for(unsigned int i = 0; i < readAheadClusters_ && end < entries_; ++i) {
+      clusterIter.Next();
+      end = clusterIter.GetNextEntry();
+    }
+    end = std::min(end, entries_);
+    if(end <= first) {
+      return;
+    }
+    std::vector<Long64_t> positions;
+    std::vector<Int_t> lengths;
+    TObjArray const* branches = treeCache_->GetCachedBranches();
+    for(Int_t i = 0, n = branches->GetEntriesFast(); i < n; ++i) {
+      addBaskets(static_cast<TBranch*>(branches->UncheckedAt(i)), first, end, positions, lengths);
+    }
+    readAheadEntry_ = end;
+    if(!positions.empty()) {
+      filePtr_->readAhead(&positions[0], &lengths[0], positions.size());
+    }
   }
 
   // The actual implementation is done below; it's split in this strange
@@ -77,6 +77,7 @@ namespace edm {
              unsigned int cacheSize,
              unsigned int learningEntries,
              bool enablePrefetching,
+             unsigned int readAheadClusters,
              InputType inputType);
     ~RootTree();
 
@@ -171,6 +172,7 @@ namespace edm {
     void setTreeMaxVirtualSize(int treeMaxVirtualSize);
     void startTraining();
     void stopTraining();
+    void readAhead();
 
     std::shared_ptr<InputFile> filePtr_;
 // We use bare pointers for pointers to some ROOT entities.
@@ -204,6 +206,11 @@ namespace edm {
 // Enable asynchronous I/O in ROOT (done in a separate thread).  Only takes
 // effect on the primary treeCache_; all other caches have this explicitly disabled.
     bool enablePrefetching_;
+// Number of clusters after the current one requested from the file to be read
+// in the background while the current one is processed, and the first entry
+// not requested yet.
+    unsigned int readAheadClusters_;
+    EntryNumber readAheadEntry_;
     bool enableTriggerCache_;
     std::unique_ptr<RootDelayedReader> rootDelayedReader_;
 
@@ -0,0 +1,38 @@
+# Reads every product of every event with the baskets of the event TTree
+# decompressed in parallel.
+#
+# Usage: cmsRun PoolParallelUnzipTest_cfg.py [file] [number of threads] [parallelUnzip 0/1]
+#
+# It is also a benchmark: run it on a local MiniAOD file with an increasing
+# number of threads, with and without parallelUnzip, and compare the
+# events/sec given by 'time cmsRun' or the TimeReport.
+
+import sys
+import FWCore.ParameterSet.Config as cms
+
+fileName = sys.argv[2] if len(sys.argv) > 2 else "PoolInputTest.root"
+nThreads = int(sys.argv[3]) if len(sys.argv) > 3 else 4
+parallelUnzip = bool(int(sys.argv[4])) if len(sys.argv) > 4 else True
+
+process = cms.Process("PARALLELUNZIP")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(nThreads),
+    numberOfStreams = cms.untracked.uint32(0),
+    wantSummary = cms.untracked.bool(True)
+)
+
+process.add_(cms.Service("InitRootHandlers", EnableIMT = cms.untracked.bool(True)))
+
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring("file:" + fileName),
+    parallelUnzip = cms.untracked.bool(parallelUnzip)
+)
+
+process.getAll = cms.EDAnalyzer("EventContentAnalyzer",
+    getData = cms.untracked.bool(True),
+    listContent = cms.untracked.bool(False)
+)
+
+process.p = cms.Path(process.getAll)
@@ -0,0 +1,35 @@
+# Reads every product of every event with the clusters of the event TTree
+# following the current one read in a background thread.
+#
+# Usage: cmsRun PoolReadAheadTest_cfg.py [file] [readAheadClusters]
+#
+# It is also a benchmark: run it on a remote or slow file with and without
+# readAheadClusters and compare 'time cmsRun'.  The readAhead, readAheadWait
+# and readAheadHidden lines of the StorageStatistics summary show how much
+# was read ahead and how much of the read latency was hidden.
+
+import sys
+import FWCore.ParameterSet.Config as cms
+
+fileName = sys.argv[2] if len(sys.argv) > 2 else "PoolInputTest.root"
+readAheadClusters = int(sys.argv[3]) if len(sys.argv) > 3 else 2
+
+process = cms.Process("READAHEAD")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.add_(cms.Service("AdaptorConfig",
+    stats = cms.untracked.bool(True),
+    readAheadMemoryMB = cms.untracked.uint32(64)
+))
+
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring("file:" + fileName),
+    readAheadClusters = cms.untracked.uint32(readAheadClusters)
+)
+
+process.getAll = cms.EDAnalyzer("EventContentAnalyzer",
+    getData = cms.untracked.bool(True),
+    listContent = cms.untracked.bool(False)
+)
+
+process.p = cms.Path(process.getAll)
@@ -10,6 +10,9 @@ cp PoolInputTest.root PoolInputOther.root
 
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolInputTest_cfg.py || die 'Failure using PoolInputTest_cfg.py' $?
 
+cmsRun ${LOCAL_TEST_DIR}/PoolParallelUnzipTest_cfg.py PoolInputTest.root || die 'Failure using PoolParallelUnzipTest_cfg.py' $?
+cmsRun ${LOCAL_TEST_DIR}/PoolReadAheadTest_cfg.py PoolInputTest.root || die 'Failure using PoolReadAheadTest_cfg.py' $?
+
 cmsRun ${LOCAL_TEST_DIR}/PrePool2FileInputTest_cfg.py || die 'Failure using PrePool2FileInputTest_cfg.py' $?
 cmsRun ${LOCAL_TEST_DIR}/Pool2FileInputTest_cfg.py || die 'Failure using Pool2FileInputTest_cfg.py' $?
 
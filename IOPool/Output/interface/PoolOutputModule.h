@@ -52,6 +52,7 @@ namespace edm {
     int const& splitLevel() const {return splitLevel_;}
     std::string const& basketOrder() const {return basketOrder_;}
     int const& treeMaxVirtualSize() const {return treeMaxVirtualSize_;}
+    bool parallelCompression() const {return parallelCompression_;}
     bool const& overrideInputFileSplitLevels() const {return overrideInputFileSplitLevels_;}
     DropMetaData const& dropMetaData() const {return dropMetaData_;}
     std::string const& catalog() const {return catalog_;}
@@ -86,7 +87,7 @@ namespace edm {
 
       OutputItem();
 
-      explicit OutputItem(BranchDescription const* bd, EDGetToken const& token, int splitLevel, int basketSize);
+      explicit OutputItem(BranchDescription const* bd, EDGetToken const& token, int splitLevel, int basketSize, int compressionSettings);
 
       ~OutputItem() {}
 
@@ -102,6 +103,7 @@ namespace edm {
       mutable void const* product_;
       int splitLevel_;
       int basketSize_;
+      int compressionSettings_; // ROOT compression settings of the branch, -1 for the ones of the file
     };
 
     typedef std::vector<OutputItem> OutputItemList;
@@ -114,11 +116,22 @@ namespace edm {
       splitLevel_(iSplitLevel < 1? 1: iSplitLevel) //minimum is 1
       {}
       bool match(std::string const& iBranchName) const;
-      std::regex convert(std::string const& iGlobBranchExpression )const;
+      static std::regex convert(std::string const& iGlobBranchExpression);
       
       std::regex branch_;
       int splitLevel_;
     };
+
+    struct SpecialCompressionForBranch {
+      SpecialCompressionForBranch(std::string const& iBranchName, std::string const& iAlgorithm, int iLevel, int iFileLevel);
+      bool match(std::string const& iBranchName) const;
+
+      std::regex branch_;
+      int compressionSettings_;
+    };
+
+    ///ROOT compression algorithm for the names allowed in the configuration, throws for any other name
+    static int rootCompressionAlgorithm(std::string const& iName);
     
     OutputItemListArray const& selectedOutputItemList() const {return selectedOutputItemList_;}
 
@@ -170,6 +183,7 @@ namespace edm {
     AuxItemArray auxItems_;
     OutputItemListArray selectedOutputItemList_;
     std::vector<SpecialSplitLevelForBranch> specialSplitLevelForBranches_;
+    std::vector<SpecialCompressionForBranch> specialCompressionForBranches_;
     std::string const fileName_;
     std::string const logicalFileName_;
     std::string const catalog_;
@@ -181,6 +195,7 @@ namespace edm {
     int const splitLevel_;
     std::string basketOrder_;
     int const treeMaxVirtualSize_;
+    bool const parallelCompression_;
     int whyNotFastClonable_;
     DropMetaData dropMetaData_;
     std::string const moduleLabel_;
@@ -26,6 +26,7 @@
 #include "TBranchElement.h"
 #include "TObjArray.h"
 #include "RVersion.h"
+#include "Compression.h"
 
 #include <fstream>
 #include <iomanip>
@@ -51,6 +52,7 @@ namespace edm {
     splitLevel_(std::min<int>(pset.getUntrackedParameter<int>("splitLevel") + 1, 99)),
     basketOrder_(pset.getUntrackedParameter<std::string>("sortBaskets")),
     treeMaxVirtualSize_(pset.getUntrackedParameter<int>("treeMaxVirtualSize")),
+    parallelCompression_(pset.getUntrackedParameter<bool>("parallelCompression")),
     whyNotFastClonable_(pset.getUntrackedParameter<bool>("fastCloning") ? FileBlock::CanFastClone : FileBlock::DisabledInConfigFile),
     dropMetaData_(DropNone),
     moduleLabel_(pset.getParameter<std::string>("@module_label")),
@@ -94,6 +96,18 @@ namespace edm {
       specialSplitLevelForBranches_.emplace_back(s.getUntrackedParameter<std::string>("branch"),
                                                  s.getUntrackedParameter<int>("splitLevel"));
     }
+
+    auto const& specialCompression {pset.getUntrackedParameterSetVector("overrideBranchesCompression")};
+
+    // Check the algorithm names now rather than when the first file is opened.
+    rootCompressionAlgorithm(compressionAlgorithm_);
+    specialCompressionForBranches_.reserve(specialCompression.size());
+    for(auto const& s: specialCompression) {
+      specialCompressionForBranches_.emplace_back(s.getUntrackedParameter<std::string>("branch"),
+                                                  s.getUntrackedParameter<std::string>("compressionAlgorithm"),
+                                                  s.getUntrackedParameter<int>("compressionLevel"),
+                                                  compressionLevel_);
+    }
       
     // We don't use this next parameter, but we read it anyway because it is part
     // of the configuration of this module.  An external parser creates the
@@ -123,14 +137,16 @@ namespace edm {
         token_(),
         product_(nullptr),
         splitLevel_(BranchDescription::invalidSplitLevel),
-        basketSize_(BranchDescription::invalidBasketSize) {}
+        basketSize_(BranchDescription::invalidBasketSize),
+        compressionSettings_(-1) {}
 
-  PoolOutputModule::OutputItem::OutputItem(BranchDescription const* bd, EDGetToken const& token, int splitLevel, int basketSize) :
+  PoolOutputModule::OutputItem::OutputItem(BranchDescription const* bd, EDGetToken const& token, int splitLevel, int basketSize, int compressionSettings) :
         branchDescription_(bd),
         token_(token),
         product_(nullptr),
         splitLevel_(splitLevel),
-        basketSize_(basketSize) {}
+        basketSize_(basketSize),
+        compressionSettings_(compressionSettings) {}
 
 
   PoolOutputModule::OutputItem::Sorter::Sorter(TTree* tree) : treeMap_(new std::map<std::string, int>) {
@@ -169,12 +185,51 @@ namespace edm {
     return std::regex_match(iBranchName,branch_);
   }
 
-  std::regex PoolOutputModule::SpecialSplitLevelForBranch::convert( std::string const& iGlobBranchExpression) const {
+  std::regex PoolOutputModule::SpecialSplitLevelForBranch::convert( std::string const& iGlobBranchExpression) {
     std::string tmp(iGlobBranchExpression);
     boost::replace_all(tmp, "*", ".*");
     boost::replace_all(tmp, "?", ".");
     return std::regex(tmp);
   }
+
+  PoolOutputModule::SpecialCompressionForBranch::SpecialCompressionForBranch(std::string const& iBranchName,
+                                                                             std::string const& iAlgorithm,
+                                                                             int iLevel,
+                                                                             int iFileLevel) :
+    branch_(SpecialSplitLevelForBranch::convert(iBranchName)),
+    compressionSettings_(100 * rootCompressionAlgorithm(iAlgorithm) + (iLevel < 0 ? iFileLevel : iLevel)) {
+  }
+
+  inline bool PoolOutputModule::SpecialCompressionForBranch::match( std::string const& iBranchName) const {
+    return std::regex_match(iBranchName,branch_);
+  }
+
+  int PoolOutputModule::rootCompressionAlgorithm(std::string const& iName) {
+    if(iName == "ZLIB") {
+      return ROOT::kZLIB;
+    } else if(iName == "LZMA") {
+      return ROOT::kLZMA;
+    }
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,12,0)
+    else if(iName == "LZ4") {
+      return ROOT::kLZ4;
+    }
+#endif
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,20,0)
+    else if(iName == "ZSTD") {
+      return ROOT::kZSTD;
+    }
+#endif
+    throw Exception(errors::Configuration) << "PoolOutputModule configured with unknown compression algorithm '" << iName << "'\n"
+                                           << "Allowed compression algorithms are ZLIB and LZMA"
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,12,0)
+                                           << ", LZ4"
+#endif
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,20,0)
+                                           << ", ZSTD"
+#endif
+                                           << "\n";
+  }
   
   void PoolOutputModule::fillSelectedItemList(BranchType branchType, TTree* theInputTree) {
 
@@ -202,6 +257,13 @@ namespace edm {
       BranchDescription const& prod = *kept.first;
       TBranch* theBranch = ((!prod.produced() && theInputTree != nullptr && !overrideInputFileSplitLevels_) ? theInputTree->GetBranch(prod.branchName().c_str()) : nullptr);
 
+      int compressionSettings = -1;
+      for(auto const& b: specialCompressionForBranches_) {
+        if(b.match(prod.branchName())) {
+          compressionSettings = b.compressionSettings_;
+        }
+      }
+
       if(theBranch != nullptr) {
         splitLevel = theBranch->GetSplitLevel();
         basketSize = theBranch->GetBasketSize();
@@ -214,7 +276,7 @@ namespace edm {
         }
         basketSize = (prod.basketSize() == BranchDescription::invalidBasketSize ? basketSize_ : prod.basketSize());
       }
-      outputItemList.emplace_back(&prod, kept.second, splitLevel, basketSize);
+      outputItemList.emplace_back(&prod, kept.second, splitLevel, basketSize, compressionSettings);
     }
 
     // Sort outputItemList to allow fast copying.
@@ -439,7 +501,7 @@ namespace edm {
     desc.addUntracked<int>("compressionLevel", 9)
         ->setComment("ROOT compression level of output file.");
     desc.addUntracked<std::string>("compressionAlgorithm", "ZLIB")
-        ->setComment("Algorithm used to compress data in the ROOT output file, allowed values are ZLIB and LZMA");
+        ->setComment("Algorithm used to compress data in the ROOT output file, allowed values are ZLIB and LZMA, and LZ4 and ZSTD if supported by ROOT");
     desc.addUntracked<int>("basketSize", 16384)
         ->setComment("Default ROOT basket size in output file.");
     desc.addUntracked<int>("eventAutoFlushCompressedSize",20*1024*1024)
@@ -451,6 +513,11 @@ namespace edm {
                      "Used by ROOT when fast copying. Affects performance.");
     desc.addUntracked<int>("treeMaxVirtualSize", -1)
         ->setComment("Size of ROOT TTree TBasket cache.  Affects performance.");
+    desc.addUntracked<bool>("parallelCompression", false)
+        ->setComment("True:  Compress the full baskets of the branches of the event TTree in parallel, the writes to the file are still serialized.\n"
+                     "       The compression runs as TBB tasks if ROOT implicit multi-threading is enabled (InitRootHandlers.EnableIMT).\n"
+                     "       The order of the baskets in the file then depends on which compression finishes first.\n"
+                     "False: Compress each basket on the thread running the output module when it is full.");
     desc.addUntracked<bool>("fastCloning", true)
         ->setComment("True:  Allow fast copying, if possible.\n"
                      "False: Disable fast copying.");
@@ -477,6 +544,14 @@ namespace edm {
       specialSplit.addUntracked<int>("splitLevel")->setComment("The special split level for the branch");
       desc.addVPSetUntracked("overrideBranchesSplitLevel",specialSplit, std::vector<ParameterSet>());
     }
+    {
+      ParameterSetDescription specialCompression;
+      specialCompression.addUntracked<std::string>("branch")->setComment("Name of branch needing a special compression. The name can contain wildcards '*' and '?'. If several match, the last one is used");
+      specialCompression.addUntracked<std::string>("compressionAlgorithm")->setComment("Algorithm used to compress the branch, same values as for compressionAlgorithm");
+      specialCompression.addUntracked<int>("compressionLevel", -1)->setComment("Compression level of the branch, -1 for the compressionLevel of the file");
+      desc.addVPSetUntracked("overrideBranchesCompression",specialCompression, std::vector<ParameterSet>())
+      ->setComment("A branch copied by fast cloning keeps the compression of the input file, unless the compression asked for it differs, in which case fast cloning is disabled.");
+    }
     OutputModule::fillDescription(desc);
   }
 
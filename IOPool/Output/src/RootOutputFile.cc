@@ -102,23 +102,16 @@ namespace edm {
       pEventEntryInfoVector_(&eventEntryInfoVector_),
       pBranchListIndexes_(nullptr),
       pEventSelectionIDs_(nullptr),
-      eventTree_(filePtr(), InEvent, om_->splitLevel(), om_->treeMaxVirtualSize()),
-      lumiTree_(filePtr(), InLumi, om_->splitLevel(), om_->treeMaxVirtualSize()),
-      runTree_(filePtr(), InRun, om_->splitLevel(), om_->treeMaxVirtualSize()),
+      eventTree_(filePtr(), InEvent, om_->splitLevel(), om_->treeMaxVirtualSize(), om_->parallelCompression()),
+      lumiTree_(filePtr(), InLumi, om_->splitLevel(), om_->treeMaxVirtualSize(), false),
+      runTree_(filePtr(), InRun, om_->splitLevel(), om_->treeMaxVirtualSize(), false),
       treePointers_(),
       dataTypeReported_(false),
       processHistoryRegistry_(),
       parentageIDs_(),
       branchesWithStoredHistory_(),
       wrapperBaseTClass_(TClass::GetClass("edm::WrapperBase")) {
-    if (om_->compressionAlgorithm() == std::string("ZLIB")) {
-      filePtr_->SetCompressionAlgorithm(ROOT::kZLIB);
-    } else if (om_->compressionAlgorithm() == std::string("LZMA")) {
-      filePtr_->SetCompressionAlgorithm(ROOT::kLZMA);
-    } else {
-      throw Exception(errors::Configuration) << "PoolOutputModule configured with unknown compression algorithm '" << om_->compressionAlgorithm() << "'\n"
-					     << "Allowed compression algorithms are ZLIB and LZMA\n";
-    }
+    filePtr_->SetCompressionAlgorithm(PoolOutputModule::rootCompressionAlgorithm(om_->compressionAlgorithm()));
     if (-1 != om->eventAutoFlushSize()) {
       eventTree_.setAutoFlush(-1*om->eventAutoFlushSize());
     }
@@ -152,6 +145,7 @@ namespace edm {
                            item.product_,
                            item.splitLevel_,
                            item.basketSize_,
+                           item.compressionSettings_,
                            item.branchDescription_->produced());
         //make sure we always store product registry info for all branches we create
         branchesWithStoredHistory_.insert(item.branchID());
@@ -288,6 +282,10 @@ namespace edm {
         message << "The format of a data product has changed.\n";
         whyNotFastClonable &= ~(FileBlock::BranchMismatch);
       }
+      if((whyNotFastClonable & FileBlock::CompressionMismatch) != 0) {
+        message << "the compression of a branch or branches was modified.\n";
+        whyNotFastClonable &= ~(FileBlock::CompressionMismatch);
+      }
       assert(whyNotFastClonable == FileBlock::CanFastClone);
       if (isWarning) {
         LogWarning("FastCloningDisabled") << message.str();
@@ -331,6 +329,11 @@ namespace edm {
         }
       }
 
+      // Fast cloning copies the compressed baskets, so it would ignore overrideBranchesCompression.
+      if(!eventTree_.checkCompressionSettings(fb.tree())) {
+        whyNotFastClonable_ |= FileBlock::CompressionMismatch;
+      }
+
       // Since this check can be time consuming, we do it only if we would otherwise fast clone.
       if(whyNotFastClonable_ == FileBlock::CanFastClone) {
         if(!eventTree_.checkIfFastClonable(fb.tree())) {
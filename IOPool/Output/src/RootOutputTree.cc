@@ -88,7 +88,8 @@ namespace edm {
                    std::shared_ptr<TFile> filePtr,
                    BranchType const& branchType,
                    int splitLevel,
-                   int treeMaxVirtualSize) :
+                   int treeMaxVirtualSize,
+                   bool parallelCompression) :
       filePtr_(filePtr),
       tree_(makeTTree(filePtr.get(), BranchTypeToProductTreeName(branchType), splitLevel)),
       producedBranches_(),
@@ -100,6 +101,9 @@ namespace edm {
       fastCloneAuxBranches_(false) {
 
     if(treeMaxVirtualSize >= 0) tree_->SetMaxVirtualSize(treeMaxVirtualSize);
+    // ROOT turns this on for every new TTree once implicit multi-threading is enabled. It is
+    // only wanted if requested, as the baskets are then written in the order their compression ends.
+    tree_->SetImplicitMT(parallelCompression);
   }
 
   TTree*
@@ -123,6 +127,21 @@ namespace edm {
     return assignTTree(filePtr, tree);
   }
 
+  bool
+  RootOutputTree::checkCompressionSettings(TTree* inputTree) const {
+
+    assert(inputTree != nullptr);
+
+    // Are the read branches with a compression of their own compressed the same way in the input?
+    for(auto const& outputBranch : recompressedReadBranches_) {
+      TBranch* inputBranch = inputTree->GetBranch(outputBranch->GetName());
+      if(inputBranch != nullptr && inputBranch->GetCompressionSettings() != outputBranch->GetCompressionSettings()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   bool
   RootOutputTree::checkSplitLevelsAndBasketSizes(TTree* inputTree) const {
 
@@ -314,6 +333,8 @@ namespace edm {
   void
   RootOutputTree::fillTree() {
     if(currentlyFastCloning_) {
+      // Filling the branches one by one, ROOT compresses them serially even with
+      // parallelCompression; only the final flush of the baskets is done in parallel.
       if(!fastCloneAuxBranches_)fillTTree(auxBranches_);
       fillTTree(unclonedAuxBranches_);
       fillTTree(producedBranches_);
@@ -329,6 +350,7 @@ namespace edm {
                             void const*& pProd,
                             int splitLevel,
                             int basketSize,
+                            int compressionSettings,
                             bool produced) {
       assert(splitLevel != BranchDescription::invalidSplitLevel);
       assert(basketSize != BranchDescription::invalidBasketSize);
@@ -346,10 +368,16 @@ namespace edm {
         pProd = nullptr;
       }
 */
+      if(compressionSettings >= 0) {
+        branch->SetCompressionSettings(compressionSettings);
+      }
       if(produced) {
         producedBranches_.push_back(branch);
       } else {
         readBranches_.push_back(branch);
+        if(compressionSettings >= 0) {
+          recompressedReadBranches_.push_back(branch);
+        }
       }
   }
 
@@ -26,7 +26,8 @@ namespace edm {
     RootOutputTree(std::shared_ptr<TFile> filePtr,
                    BranchType const& branchType,
                    int splitLevel,
-                   int treeMaxVirtualSize);
+                   int treeMaxVirtualSize,
+                   bool parallelCompression);
 
     ~RootOutputTree() {}
 
@@ -68,10 +69,13 @@ namespace edm {
                    void const*& pProd,
                    int splitLevel,
                    int basketSize,
+                   int compressionSettings,
                    bool produced);
 
     bool checkSplitLevelsAndBasketSizes(TTree* inputTree) const;
 
+    bool checkCompressionSettings(TTree* inputTree) const;
+
     bool checkIfFastClonable(TTree* inputTree) const;
 
     bool checkEntriesInReadBranches(Long64_t expectedNumberOfEntries) const;
@@ -121,6 +125,7 @@ namespace edm {
     std::vector<TBranch*> auxBranches_;
     std::vector<TBranch*> unclonedAuxBranches_;
     std::vector<TBranch*> unclonedReadBranches_;
+    std::vector<TBranch*> recompressedReadBranches_; // read branches with their own compression settings
 
     std::set<std::string> clonedReadBranchNames_;
     bool currentlyFastCloning_;
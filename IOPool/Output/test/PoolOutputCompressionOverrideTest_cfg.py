@@ -0,0 +1,36 @@
+# Writes the OtherThing products with a compression different from the one
+# of the rest of the file.
+#
+# The compression of each branch and the time to decompress it can be
+# checked with
+#   edmEventSize -v -D PoolOutputCompressionOverrideTest.root
+
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TESTOUTPUT")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(20)
+)
+process.Thing = cms.EDProducer("ThingProducer")
+
+process.OtherThing = cms.EDProducer("OtherThingProducer")
+
+process.output = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('file:PoolOutputCompressionOverrideTest.root'),
+    compressionAlgorithm = cms.untracked.string("LZMA"),
+    compressionLevel = cms.untracked.int32(4),
+    overrideBranchesCompression = cms.untracked.VPSet(
+        cms.untracked.PSet(
+            branch = cms.untracked.string("*_OtherThing_*"),
+            compressionAlgorithm = cms.untracked.string("ZLIB"),
+            compressionLevel = cms.untracked.int32(1)
+        )
+    )
+)
+
+process.source = cms.Source("EmptySource")
+
+process.p = cms.Path(process.Thing*process.OtherThing)
+process.ep = cms.EndPath(process.output)
@@ -0,0 +1,48 @@
+# Writes events with the baskets of the event TTree compressed in parallel.
+#
+# Usage: cmsRun PoolOutputParallelCompressionTest_cfg.py [compressionAlgorithm] [compressionLevel] [number of threads] [parallelCompression 0/1] [events]
+#
+# It is also a benchmark of the compression settings: run it with ZLIB and
+# LZMA, an increasing number of threads, with and without
+# parallelCompression, and compare the events/sec given by 'time cmsRun'
+# or the TimeReport and the size of the output files.
+
+import sys
+import FWCore.ParameterSet.Config as cms
+
+algorithm = sys.argv[2] if len(sys.argv) > 2 else "LZMA"
+level = int(sys.argv[3]) if len(sys.argv) > 3 else 4
+nThreads = int(sys.argv[4]) if len(sys.argv) > 4 else 4
+parallelCompression = bool(int(sys.argv[5])) if len(sys.argv) > 5 else True
+nEvents = int(sys.argv[6]) if len(sys.argv) > 6 else 200
+
+process = cms.Process("PARALLELCOMPRESSION")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(nThreads),
+    numberOfStreams = cms.untracked.uint32(0),
+    wantSummary = cms.untracked.bool(True)
+)
+
+process.add_(cms.Service("InitRootHandlers", EnableIMT = cms.untracked.bool(True)))
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(nEvents)
+)
+
+process.source = cms.Source("EmptySource")
+
+process.Thing = cms.EDProducer("ThingProducer")
+
+process.OtherThing = cms.EDProducer("OtherThingProducer")
+
+process.output = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('file:PoolOutputParallelCompressionTest.root'),
+    compressionAlgorithm = cms.untracked.string(algorithm),
+    compressionLevel = cms.untracked.int32(level),
+    parallelCompression = cms.untracked.bool(parallelCompression)
+)
+
+process.p = cms.Path(process.Thing*process.OtherThing)
+process.ep = cms.EndPath(process.output)
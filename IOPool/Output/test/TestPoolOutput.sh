@@ -6,6 +6,10 @@ pushd ${LOCAL_TMP_DIR}
 
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolOutputTest_cfg.py || die 'Failure using PoolOutputTest_cfg.py' $?
 
+cmsRun ${LOCAL_TEST_DIR}/PoolOutputParallelCompressionTest_cfg.py LZMA 4 4 1 || die 'Failure using PoolOutputParallelCompressionTest_cfg.py' $?
+
+cmsRun ${LOCAL_TEST_DIR}/PoolOutputCompressionOverrideTest_cfg.py || die 'Failure using PoolOutputCompressionOverrideTest_cfg.py' $?
+
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolDropTest_cfg.py || die 'Failure using PoolDropTest_cfg.py' $?
 
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolMissingTest_cfg.py || die 'Failure using PoolMissingTest_cfg.py' $?
@@ -28,10 +28,9 @@
 #include "IOPool/Streamer/interface/InitMessage.h"
 #include "IOPool/Streamer/interface/MsgTools.h"
 #include "IOPool/Streamer/interface/StreamerInputFile.h"
+#include "IOPool/Streamer/interface/StreamerInputSource.h"
 #include "IOPool/Streamer/interface/StreamerOutputFile.h"
 
-#include "zlib.h"
-
 #include <iostream>
 #include <map>
 #include <memory>
@@ -287,22 +286,12 @@ bool uncompressBuffer(unsigned char *inputBuffer,
                               std::vector<unsigned char> &outputBuffer,
                               unsigned int expectedFullSize)
   {
-    unsigned long origSize = expectedFullSize;
-    unsigned long uncompressedSize = expectedFullSize*1.1;
-    outputBuffer.resize(uncompressedSize);
-    int ret = uncompress(&outputBuffer[0], &uncompressedSize,
-                         inputBuffer, inputSize);
-    if(ret == Z_OK) {
-        // check the length against original uncompressed length
-        if(origSize != uncompressedSize) {
-            std::cout << "Problem with uncompress, original size = "
-                 << origSize << " uncompress size = " << uncompressedSize << std::endl;
-            return false;
-        }
-    } else {
-        std::cout << "Problem with uncompress, return value = "
-             << ret << std::endl;
-        return false;
+    // the algorithm is recognised from the data, as in the StreamerInputSource
+    try {
+      edm::StreamerInputSource::uncompressBuffer(inputBuffer, inputSize, outputBuffer, expectedFullSize);
+    } catch(cms::Exception const& e) {
+      std::cout << "Problem with uncompress: " << e.explainSelf() << std::endl;
+      return false;
     }
     return true;
 }
@@ -11,6 +11,7 @@
 #include "TBufferFile.h"
 
 #include <cstdint>
+#include <string>
 #include <vector>
 
 #include "DataFormats/Provenance/interface/BranchIDList.h"
@@ -65,6 +66,19 @@ namespace edm
   class ModuleCallingContext;
   class ThinnedAssociationsHelper;
 
+  /**
+   * The ZLIB event data is written with zlib's compress2, as it always was.
+   * The other algorithms are written in ROOT's compressed block format,
+   * whose block headers record the algorithm, so the reader recognises
+   * them from the data itself.
+   */
+  enum StreamerCompressionAlgo {
+    ZLIB = 1,
+    LZMA = 2,
+    LZ4 = 3,
+    ZSTD = 4
+  };
+
   class StreamSerializer
   {
 
@@ -78,6 +92,7 @@ namespace edm
 
     int serializeEvent(EventForOutput const& event, ParameterSetID const& selectorConfig,
                        bool use_compression, int compression_level,
+                       StreamerCompressionAlgo compression_algo,
                        SerializeDataBuffer &data_buffer);
 
     /**
@@ -88,7 +103,15 @@ namespace edm
     static unsigned int compressBuffer(unsigned char *inputBuffer,
                                        unsigned int inputSize,
                                        std::vector<unsigned char> &outputBuffer,
-                                       int compressionLevel);
+                                       int compressionLevel,
+                                       StreamerCompressionAlgo compressionAlgo = ZLIB);
+
+    /**
+     * Returns the algorithm for one of the names "ZLIB", "LZMA", "LZ4"
+     * or "ZSTD".  Throws if the name is unknown or if the algorithm is
+     * not supported by the ROOT version in use.
+     */
+    static StreamerCompressionAlgo compressionAlgorithm(std::string const& name);
 
   private:
 
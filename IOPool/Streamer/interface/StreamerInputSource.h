@@ -18,6 +18,7 @@
 #include "DataFormats/Streamer/interface/StreamedProducts.h"
 #include "DataFormats/Common/interface/EDProductGetter.h"
 
+#include <exception>
 #include <memory>
 #include <vector>
 
@@ -61,7 +62,46 @@ namespace edm {
                                          unsigned int inputSize,
                                          std::vector<unsigned char>& outputBuffer,
                                          unsigned int expectedFullSize);
+
+    /**
+     * Returns true if the data was compressed in ROOT's block format,
+     * with the LZMA, LZ4 or ZSTD algorithm, rather than with zlib.
+     */
+    static bool isBufferROOT(unsigned char const* inputBuffer, unsigned int inputSize);
+
+    static unsigned int uncompressBufferROOT(unsigned char* inputBuffer,
+                                             unsigned int inputSize,
+                                             std::vector<unsigned char>& outputBuffer,
+                                             unsigned int expectedFullSize);
+  private:
+    class EventPrincipalHolder;
+
   protected:
+    /**
+     * A copy of an event message, and the event once deserialized, for
+     * the sources deserializing several events concurrently.
+     */
+    class DeserializedEvent {
+    public:
+      explicit DeserializedEvent(EventMsgView const& eventView);
+      ~DeserializedEvent();
+      DeserializedEvent(DeserializedEvent const&) = delete;
+      DeserializedEvent& operator=(DeserializedEvent const&) = delete;
+
+    private:
+      friend class StreamerInputSource;
+      std::vector<unsigned char> message_;
+      unsigned int lumi_;
+      std::unique_ptr<SendEvent> sendEvent_;
+      std::unique_ptr<EventPrincipalHolder> eventPrincipalHolder_;
+      std::exception_ptr exception_;
+    };
+
+    // May be called concurrently for different events
+    void deserializeEvent(DeserializedEvent& event) const;
+    // Must be called in the order the events are delivered
+    void setDeserializedEvent(DeserializedEvent& event);
+
     static void declareStreamers(SendDescs const& descs);
     static void buildClassCache(SendDescs const& descs);
     void resetAfterEndRun();
@@ -89,6 +129,9 @@ namespace edm {
       EventPrincipal const* eventPrincipal_;
     };
 
+    static unsigned long uncompressEventData(EventMsgView const& eventView, std::vector<unsigned char>& dest);
+    void setEvent(unsigned int lumi);
+
     void read(EventPrincipal& eventPrincipal) override;
 
     void setRun(RunNumber_t r) override;
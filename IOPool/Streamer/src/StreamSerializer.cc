@@ -20,7 +20,11 @@
 #include "FWCore/Utilities/interface/Adler32Calculator.h"
 #include "DataFormats/Streamer/interface/StreamedProducts.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/Utilities/interface/EDMException.h"
 
+#include "Compression.h"
+#include "RVersion.h"
+#include "RZip.h"
 #include "zlib.h"
 #include <algorithm>
 #include <cstdlib>
@@ -128,6 +132,7 @@ namespace edm {
   int StreamSerializer::serializeEvent(EventForOutput const& event,
                                        ParameterSetID const& selectorConfig,
                                        bool use_compression, int compression_level,
+                                       StreamerCompressionAlgo compression_algo,
                                        SerializeDataBuffer& data_buffer) {
 
     EventSelectionIDVector selectionIDs = event.eventSelectionIDs();
@@ -224,7 +229,7 @@ namespace edm {
     //   as double compression can have problems
     if(use_compression) {
       unsigned int dest_size =
-        compressBuffer(data_buffer.ptr_, data_buffer.curr_event_size_, data_buffer.comp_buf_, compression_level);
+        compressBuffer(data_buffer.ptr_, data_buffer.curr_event_size_, data_buffer.comp_buf_, compression_level, compression_algo);
       if(dest_size != 0) {
         data_buffer.ptr_ = &data_buffer.comp_buf_[0]; // reset to point at compressed area
         data_buffer.curr_space_used_ = dest_size;
@@ -237,6 +242,93 @@ namespace edm {
     return data_buffer.curr_space_used_;
   }
 
+  namespace {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,20,0)
+    typedef ROOT::RCompressionSetting::EAlgorithm::EValues RootCompressionAlgorithm;
+#else
+    typedef ROOT::ECompressionAlgorithm RootCompressionAlgorithm;
+#endif
+
+    RootCompressionAlgorithm rootCompressionAlgorithm(StreamerCompressionAlgo compressionAlgo) {
+      switch(compressionAlgo) {
+        case LZMA: return static_cast<RootCompressionAlgorithm>(ROOT::kLZMA);
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,12,0)
+        case LZ4: return static_cast<RootCompressionAlgorithm>(ROOT::kLZ4);
+#endif
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,20,0)
+        case ZSTD: return ROOT::RCompressionSetting::EAlgorithm::kZSTD;
+#endif
+        default: break;
+      }
+      throw Exception(errors::Configuration)
+        << "StreamSerializer: compression algorithm " << static_cast<int>(compressionAlgo)
+        << " is not supported by this ROOT version.\n";
+    }
+
+    // The largest block R__zip compresses in one call, its size must fit in
+    // the 3 bytes of the block header.
+    unsigned int const kMaxZipBlock = 0xffffff;
+    unsigned int const kZipHeaderSize = 9;
+
+    /**
+     * Compresses the input in blocks of at most kMaxZipBlock bytes, each
+     * with its ROOT block header.  Returns zero if the data does not
+     * shrink, the event is then written uncompressed.
+     */
+    unsigned int compressBufferROOT(unsigned char *inputBuffer,
+                                    unsigned int inputSize,
+                                    std::vector<unsigned char> &outputBuffer,
+                                    int compressionLevel,
+                                    StreamerCompressionAlgo compressionAlgo) {
+      RootCompressionAlgorithm algorithm = rootCompressionAlgorithm(compressionAlgo);
+      if(outputBuffer.size() < inputSize) outputBuffer.resize(inputSize);
+
+      unsigned int resultSize = 0;
+      for(unsigned int done = 0; done < inputSize;) {
+        int srcSize = std::min(inputSize - done, kMaxZipBlock);
+        int tgtSize = std::min(inputSize - resultSize, kMaxZipBlock + kZipHeaderSize);
+        int written = 0;
+        if(tgtSize <= static_cast<int>(kZipHeaderSize)) return 0;
+        R__zipMultipleAlgorithm(compressionLevel, &srcSize, reinterpret_cast<char*>(inputBuffer + done),
+                                &tgtSize, reinterpret_cast<char*>(&outputBuffer[resultSize]), &written, algorithm);
+        if(written == 0) {
+          FDEBUG(9) << "Compression with algorithm " << static_cast<int>(compressionAlgo)
+                    << " failed for a block of " << srcSize << " bytes" << std::endl;
+          return 0;
+        }
+        done += srcSize;
+        resultSize += written;
+      }
+
+      FDEBUG(1) << " original size = " << inputSize
+                << " final size = " << resultSize
+                << " ratio = " << double(resultSize)/double(inputSize)
+                << std::endl;
+      return resultSize;
+    }
+  }
+
+  StreamerCompressionAlgo
+  StreamSerializer::compressionAlgorithm(std::string const& name) {
+    StreamerCompressionAlgo compressionAlgo;
+    if(name == "ZLIB") {
+      return ZLIB;
+    } else if(name == "LZMA") {
+      compressionAlgo = LZMA;
+    } else if(name == "LZ4") {
+      compressionAlgo = LZ4;
+    } else if(name == "ZSTD") {
+      compressionAlgo = ZSTD;
+    } else {
+      throw Exception(errors::Configuration)
+        << "StreamSerializer: unknown compression algorithm '" << name << "'.\n"
+        << "Allowed values are ZLIB, LZMA, LZ4 and ZSTD.\n";
+    }
+    // throws if this ROOT version does not provide it
+    rootCompressionAlgorithm(compressionAlgo);
+    return compressionAlgo;
+  }
+
   /**
    * Compresses the data in the specified input buffer into the
    * specified output buffer.  Returns the size of the compressed data
@@ -246,7 +338,11 @@ namespace edm {
   StreamSerializer::compressBuffer(unsigned char *inputBuffer,
                                    unsigned int inputSize,
                                    std::vector<unsigned char> &outputBuffer,
-                                   int compressionLevel) {
+                                   int compressionLevel,
+                                   StreamerCompressionAlgo compressionAlgo) {
+    if(compressionAlgo != ZLIB) {
+      return compressBufferROOT(inputBuffer, inputSize, outputBuffer, compressionLevel, compressionAlgo);
+    }
     unsigned int resultSize = 0;
 
     // what are these magic numbers? (jbk)
@@ -9,6 +9,10 @@
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/Sources/interface/EventSkipperByID.h"
 
+#include "tbb/parallel_for.h"
+
+#include <iterator>
+
 namespace edm {
 
   StreamerFileReader::StreamerFileReader(ParameterSet const& pset, InputSourceDescription const& desc) :
@@ -16,7 +20,11 @@ namespace edm {
       streamerNames_(pset.getUntrackedParameter<std::vector<std::string> >("fileNames")),
       streamReader_(),
       eventSkipperByID_(EventSkipperByID::create(pset).release()),
-      initialNumberOfEventsToSkip_(pset.getUntrackedParameter<unsigned int>("skipEvents")) {
+      initialNumberOfEventsToSkip_(pset.getUntrackedParameter<unsigned int>("skipEvents")),
+      batchSize_(pset.getUntrackedParameter<unsigned int>("deserializationBatchSize")),
+      readyEvents_(),
+      nextEvents_(),
+      nextEventsRead_(false) {
     InputFileCatalog catalog(pset.getUntrackedParameter<std::vector<std::string> >("fileNames"), pset.getUntrackedParameter<std::string>("overrideCatalog"));
     streamerNames_ = catalog.fileNames();
     reset_();
@@ -24,10 +32,12 @@ namespace edm {
   }
 
   StreamerFileReader::~StreamerFileReader() {
+    tasks_.wait();
   }
 
   void
   StreamerFileReader::reset_() {
+    clearBatches();
     if (streamerNames_.size() > 1) {
       streamReader_ = std::make_unique<StreamerInputFile>(streamerNames_, eventSkipperByID());
     } else if (streamerNames_.size() == 1) {
@@ -45,6 +55,26 @@ namespace edm {
 
 
   bool StreamerFileReader::checkNextEvent() {
+    if (batchSize_ > 1) {
+      if (readyEvents_.empty()) {
+        if (!nextEventsRead_) {
+          readBatch();
+        }
+        tasks_.wait();
+        readyEvents_.assign(std::make_move_iterator(nextEvents_.begin()), std::make_move_iterator(nextEvents_.end()));
+        nextEvents_.clear();
+        nextEventsRead_ = false;
+        if (readyEvents_.empty()) {
+          return false;
+        }
+        readBatch();
+      }
+      std::unique_ptr<DeserializedEvent> event = std::move(readyEvents_.front());
+      readyEvents_.pop_front();
+      setDeserializedEvent(*event);
+      return true;
+    }
+
     EventMsgView const* eview = getNextEvent();
 
     if (newHeader()) {
@@ -61,8 +91,55 @@ namespace edm {
     return true;
   }
 
+  /**
+   * Reads up to batchSize_ event messages and starts deserializing them in
+   * tasks.  Like checkNextEvent, merges the INIT message of each new file
+   * into the registry before its events are deserialized.
+   */
+  void
+  StreamerFileReader::readBatch() {
+    nextEventsRead_ = true;
+    while (nextEvents_.size() < batchSize_) {
+      EventMsgView const* eview = getNextEvent();
+      if (newHeader()) {
+        InitMsgView const* header = getHeader();
+        deserializeAndMergeWithRegistry(*header, true);
+      }
+      if (eview == nullptr) {
+        break;
+      }
+      nextEvents_.push_back(std::make_unique<DeserializedEvent>(*eview));
+    }
+    if (nextEvents_.empty()) {
+      return;
+    }
+    tasks_.run([this]() {
+      tbb::parallel_for(std::size_t(0), nextEvents_.size(), [this](std::size_t i) {
+        deserializeEvent(*nextEvents_[i]);
+      });
+    });
+  }
+
+  void
+  StreamerFileReader::clearBatches() {
+    tasks_.wait();
+    readyEvents_.clear();
+    nextEvents_.clear();
+    nextEventsRead_ = false;
+  }
+
   void
   StreamerFileReader::skip(int toSkip) {
+    // the events already read in batches come first
+    if (nextEventsRead_) {
+      tasks_.wait();
+      readyEvents_.insert(readyEvents_.end(), std::make_move_iterator(nextEvents_.begin()), std::make_move_iterator(nextEvents_.end()));
+      nextEvents_.clear();
+      nextEventsRead_ = false;
+    }
+    for(; toSkip > 0 && !readyEvents_.empty(); --toSkip) {
+      readyEvents_.pop_front();
+    }
     for(int i = 0; i != toSkip; ++i) {
       EventMsgView const* evMsg = getNextEvent();
       if(evMsg == nullptr)  {
@@ -77,6 +154,7 @@ namespace edm {
 
   void
   StreamerFileReader::genuineCloseFile() {
+    clearBatches();
     if(streamReader_.get() != nullptr) streamReader_->closeStreamerFile();
   }
 
@@ -114,6 +192,10 @@ namespace edm {
         ->setComment("Names of files to be processed.");
     desc.addUntracked<unsigned int>("skipEvents", 0U)
         ->setComment("Skip the first 'skipEvents' events that otherwise would have been processed.");
+    desc.addUntracked<unsigned int>("deserializationBatchSize", 0U)
+        ->setComment("If larger than 1, the event messages are read in batches of that many events, and the events of a batch "
+                     "are uncompressed and deserialized concurrently in tasks while those of the previous batch are delivered. "
+                     "The events are still delivered in file order.");
     desc.addUntracked<std::string>("overrideCatalog", std::string());
     //This next parameter is read in the base class, but its default value depends on the derived class, so it is set here.
     desc.addUntracked<bool>("inputFileTransitionsEachEvent", false);
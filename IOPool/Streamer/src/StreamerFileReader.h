@@ -4,6 +4,9 @@
 #include "IOPool/Streamer/interface/StreamerInputSource.h"
 #include "FWCore/Utilities/interface/get_underlying_safe.h"
 
+#include "tbb/task_group.h"
+
+#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -34,6 +37,9 @@ namespace edm {
     void genuineCloseFile() override;
     void reset_() override;
 
+    void readBatch();
+    void clearBatches();
+
     std::shared_ptr<EventSkipperByID const> eventSkipperByID() const {return get_underlying_safe(eventSkipperByID_);}
     std::shared_ptr<EventSkipperByID>& eventSkipperByID() {return get_underlying_safe(eventSkipperByID_);}
 
@@ -41,6 +47,14 @@ namespace edm {
     edm::propagate_const<std::unique_ptr<StreamerInputFile>> streamReader_;
     edm::propagate_const<std::shared_ptr<EventSkipperByID>> eventSkipperByID_;
     int initialNumberOfEventsToSkip_;
+
+    // With batchSize_ > 1, the events of one batch are deserialized in
+    // tasks while the source delivers those of the previous batch.
+    unsigned int batchSize_;
+    std::deque<std::unique_ptr<DeserializedEvent>> readyEvents_;
+    std::vector<std::unique_ptr<DeserializedEvent>> nextEvents_;
+    bool nextEventsRead_;
+    tbb::task_group tasks_;
   };
 } //end-of-namespace-def
 
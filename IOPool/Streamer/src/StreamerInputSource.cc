@@ -16,6 +16,7 @@
 #include "DataFormats/Provenance/interface/BranchListIndex.h"
 #include "DataFormats/Provenance/interface/ThinnedAssociationsHelper.h"
 
+#include "RZip.h"
 #include "zlib.h"
 
 #include "DataFormats/Common/interface/RefCoreStreamer.h"
@@ -31,6 +32,7 @@
 #include "DataFormats/Provenance/interface/ProcessHistoryRegistry.h"
 #include "FWCore/Utilities/interface/DebugMacros.h"
 
+#include <exception>
 #include <string>
 #include <iostream>
 #include <set>
@@ -195,10 +197,11 @@ namespace edm {
   }
 
   /**
-   * Deserializes the specified event message.
+   * Checks and uncompresses the data of the specified event message into
+   * dest.  Returns the size of the uncompressed data.
    */
-  void
-  StreamerInputSource::deserializeEvent(EventMsgView const& eventView) {
+  unsigned long
+  StreamerInputSource::uncompressEventData(EventMsgView const& eventView, std::vector<unsigned char>& dest) {
     if(eventView.code() != Header::EVENT)
       throw cms::Exception("StreamTranslation","Event deserialization error")
         << "received wrong message type: expected EVENT, got "
@@ -230,15 +233,24 @@ namespace edm {
     if(origsize != 78 && origsize != 0) {
       // compressed
       dest_size = uncompressBuffer(const_cast<unsigned char*>((unsigned char const*)eventView.eventData()),
-                                   eventView.eventLength(), dest_, origsize);
+                                   eventView.eventLength(), dest, origsize);
     } else { // not compressed
       // we need to copy anyway the buffer as we are using dest in xbuf
       dest_size = eventView.eventLength();
-      dest_.resize(dest_size);
-      unsigned char* pos = (unsigned char*) &dest_[0];
+      dest.resize(dest_size);
+      unsigned char* pos = (unsigned char*) &dest[0];
       unsigned char const* from = (unsigned char const*) eventView.eventData();
       std::copy(from,from+dest_size,pos);
     }
+    return dest_size;
+  }
+
+  /**
+   * Deserializes the specified event message.
+   */
+  void
+  StreamerInputSource::deserializeEvent(EventMsgView const& eventView) {
+    unsigned long dest_size = uncompressEventData(eventView, dest_);
     //TBuffer xbuf(TBuffer::kRead, dest_size,
     //             (char const*) &dest[0],kFALSE);
     //TBuffer xbuf(TBuffer::kRead, eventView.eventLength(),
@@ -257,6 +269,61 @@ namespace edm {
     sendEvent_ = std::unique_ptr<SendEvent>((SendEvent*)xbuf_.ReadObjectAny(tc_));
     setRefCoreStreamer();
 
+    setEvent(eventView.lumi());
+  }
+
+  StreamerInputSource::DeserializedEvent::DeserializedEvent(EventMsgView const& eventView) :
+    message_(eventView.startAddress(), eventView.startAddress() + eventView.size()),
+    lumi_(eventView.lumi()) {
+  }
+
+  StreamerInputSource::DeserializedEvent::~DeserializedEvent() {}
+
+  /**
+   * Does the part of deserializeEvent not depending on the state of the
+   * source, so it can run concurrently for several events.  The exception
+   * thrown for an event is kept and rethrown when the event is delivered.
+   */
+  void
+  StreamerInputSource::deserializeEvent(DeserializedEvent& event) const {
+    try {
+      EventMsgView eventView(&event.message_[0]);
+      std::vector<unsigned char> dest;
+      unsigned long dest_size = uncompressEventData(eventView, dest);
+      std::vector<unsigned char>().swap(event.message_);
+
+      TBufferFile xbuf(TBuffer::kRead, dest_size, &dest[0], kFALSE);
+      event.eventPrincipalHolder_ = std::make_unique<EventPrincipalHolder>();
+      // the product getter is per thread
+      EDProductGetter const* previous = setRefCoreStreamer(event.eventPrincipalHolder_.get());
+      try {
+        event.sendEvent_ = std::unique_ptr<SendEvent>((SendEvent*)xbuf.ReadObjectAny(tc_));
+      } catch(...) {
+        EDProductGetter::switchProductGetter(previous);
+        throw;
+      }
+      EDProductGetter::switchProductGetter(previous);
+    } catch(...) {
+      event.exception_ = std::current_exception();
+    }
+  }
+
+  /**
+   * Makes the event deserialized by deserializeEvent(DeserializedEvent&)
+   * the next one read by the source.
+   */
+  void
+  StreamerInputSource::setDeserializedEvent(DeserializedEvent& event) {
+    if(event.exception_) {
+      std::rethrow_exception(event.exception_);
+    }
+    eventPrincipalHolder_ = std::move(event.eventPrincipalHolder_);
+    sendEvent_ = std::move(event.sendEvent_);
+    setEvent(event.lumi_);
+  }
+
+  void
+  StreamerInputSource::setEvent(unsigned int lumi) {
     if(sendEvent_.get() == nullptr) {
         throw cms::Exception("StreamTranslation","Event deserialization error")
           << "got a null event from input stream\n";
@@ -270,9 +337,9 @@ namespace edm {
       setRunAuxiliary(runAuxiliary);
       resetLuminosityBlockAuxiliary();
     }
-    if(!luminosityBlockAuxiliary() || luminosityBlockAuxiliary()->luminosityBlock() != eventView.lumi()) {
+    if(!luminosityBlockAuxiliary() || luminosityBlockAuxiliary()->luminosityBlock() != lumi) {
       LuminosityBlockAuxiliary* luminosityBlockAuxiliary =
-        new LuminosityBlockAuxiliary(runAuxiliary()->run(), eventView.lumi(), sendEvent_->aux().time(), Timestamp::invalidTimestamp());
+        new LuminosityBlockAuxiliary(runAuxiliary()->run(), lumi, sendEvent_->aux().time(), Timestamp::invalidTimestamp());
       luminosityBlockAuxiliary->setProcessHistoryID(sendEvent_->processHistory().id());
       setLuminosityBlockAuxiliary(luminosityBlockAuxiliary);
     }
@@ -357,6 +424,9 @@ namespace edm {
                                         unsigned int inputSize,
                                         std::vector<unsigned char>& outputBuffer,
                                         unsigned int expectedFullSize) {
+    if(isBufferROOT(inputBuffer, inputSize)) {
+      return uncompressBufferROOT(inputBuffer, inputSize, outputBuffer, expectedFullSize);
+    }
     unsigned long origSize = expectedFullSize;
     unsigned long uncompressedSize = expectedFullSize*1.1;
     FDEBUG(1) << "Uncompress: original size = " << origSize
@@ -384,6 +454,62 @@ namespace edm {
     return (unsigned int) uncompressedSize;
   }
 
+  /**
+   * The data written with zlib's compress2 starts with the zlib header,
+   * whose first byte is 0x78, while the blocks in ROOT's format start with
+   * the two characters naming their algorithm.
+   */
+  bool
+  StreamerInputSource::isBufferROOT(unsigned char const* inputBuffer, unsigned int inputSize) {
+    if(inputSize < 9) return false;
+    return (inputBuffer[0] == 'X' && inputBuffer[1] == 'Z') ||
+           (inputBuffer[0] == 'L' && inputBuffer[1] == '4') ||
+           (inputBuffer[0] == 'Z' && inputBuffer[1] == 'S') ||
+           (inputBuffer[0] == 'Z' && inputBuffer[1] == 'L');
+  }
+
+  /**
+   * Uncompresses the blocks written by StreamSerializer in ROOT's
+   * compressed block format, whatever the algorithm used for each.
+   */
+  unsigned int
+  StreamerInputSource::uncompressBufferROOT(unsigned char* inputBuffer,
+                                            unsigned int inputSize,
+                                            std::vector<unsigned char>& outputBuffer,
+                                            unsigned int expectedFullSize) {
+    FDEBUG(1) << "Uncompress: original size = " << expectedFullSize
+              << ", compressed size = " << inputSize
+              << std::endl;
+    outputBuffer.resize(expectedFullSize);
+    unsigned int done = 0;
+    unsigned int uncompressedSize = 0;
+    while(done < inputSize) {
+      int srcSize = 0;
+      int tgtSize = 0;
+      if(inputSize - done < 9 || R__unzip_header(&srcSize, inputBuffer + done, &tgtSize) != 0 ||
+         static_cast<unsigned int>(srcSize) > inputSize - done ||
+         static_cast<unsigned int>(tgtSize) > expectedFullSize - uncompressedSize) {
+        throw cms::Exception("StreamDeserialization","Uncompression error")
+          << "corrupted compressed block at offset " << done << "\n";
+      }
+      int written = 0;
+      R__unzip(&srcSize, inputBuffer + done, &tgtSize, &outputBuffer[uncompressedSize], &written);
+      if(written != tgtSize) {
+        throw cms::Exception("StreamDeserialization","Uncompression error")
+          << "block at offset " << done << " uncompressed to " << written
+          << " bytes instead of " << tgtSize << "\n";
+      }
+      done += srcSize;
+      uncompressedSize += written;
+    }
+    if(uncompressedSize != expectedFullSize) {
+      throw cms::Exception("StreamDeserialization","Uncompression error")
+        << "mismatch event lengths should be" << expectedFullSize << " got "
+        << uncompressedSize << "\n";
+    }
+    return uncompressedSize;
+  }
+
   void StreamerInputSource::resetAfterEndRun() {
      // called from an online streamer source to reset after a stop command
      // so an enable command will work
@@ -61,6 +61,7 @@ namespace edm {
     maxEventSize_(ps.getUntrackedParameter<int>("max_event_size")),
     useCompression_(ps.getUntrackedParameter<bool>("use_compression")),
     compressionLevel_(ps.getUntrackedParameter<int>("compression_level")),
+    compressionAlgo_(StreamSerializer::compressionAlgorithm(ps.getUntrackedParameter<std::string>("compression_algorithm"))),
     lumiSectionInterval_(ps.getUntrackedParameter<int>("lumiSection_interval")),
     serializer_(selections_),
     serializeDataBuffer_(),
@@ -264,7 +265,7 @@ namespace edm {
       setLumiSection();
     }
 
-    serializer_.serializeEvent(e, selectorConfig(), useCompression_, compressionLevel_, serializeDataBuffer_);
+    serializer_.serializeEvent(e, selectorConfig(), useCompression_, compressionLevel_, compressionAlgo_, serializeDataBuffer_);
 
     // resize bufs_ to reflect space used in serializer_ + header
     // I just added an overhead for header of 50000 for now
@@ -305,6 +306,9 @@ namespace edm {
         ->setComment("If True, compression will be used to write streamer file.");
     desc.addUntracked<int>("compression_level", 1)
         ->setComment("ROOT compression level to use.");
+    desc.addUntracked<std::string>("compression_algorithm", "ZLIB")
+        ->setComment("Algorithm used to compress the events: ZLIB, LZMA, LZ4 or ZSTD.\n"
+                     "The reader recognises the algorithm from the event data.");
     desc.addUntracked<int>("lumiSection_interval", 0)
         ->setComment("If 0, use lumi section number from event.\n"
                      "If not 0, the interval in seconds between fake lumi sections.");
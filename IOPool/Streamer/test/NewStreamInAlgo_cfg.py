@@ -0,0 +1,23 @@
+# Reads back the file written by NewStreamOutAlgo_cfg.py for the algorithm
+# given as argument, the reader finds the algorithm from the event data
+import sys
+import FWCore.ParameterSet.Config as cms
+
+algorithm = sys.argv[2] if len(sys.argv) > 2 else "LZMA"
+
+process = cms.Process("TRANSFER")
+
+import FWCore.Framework.test.cmsExceptionsFatal_cff
+process.options = FWCore.Framework.test.cmsExceptionsFatal_cff.options
+
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+
+process.source = cms.Source("NewEventStreamFileReader",
+    fileNames = cms.untracked.vstring('file:teststreamfile_%s.dat' % algorithm)
+)
+
+process.a1 = cms.EDAnalyzer("StreamThingAnalyzer",
+    product_to_get = cms.string('m1')
+)
+
+process.end = cms.EndPath(process.a1)
@@ -0,0 +1,38 @@
+# Reads teststreamfile.dat deserializing the events in batches in tasks,
+# and checks the events are still delivered in file order
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TRANSFER")
+
+import FWCore.Framework.test.cmsExceptionsFatal_cff
+process.options = FWCore.Framework.test.cmsExceptionsFatal_cff.options
+process.options.numberOfThreads = cms.untracked.uint32(4)
+process.options.numberOfStreams = cms.untracked.uint32(1)
+
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+
+process.source = cms.Source("NewEventStreamFileReader",
+    fileNames = cms.untracked.vstring('file:teststreamfile.dat'),
+    skipEvents = cms.untracked.uint32(3),
+    deserializationBatchSize = cms.untracked.uint32(7)
+)
+
+seq = cms.untracked.VEventID()
+#begin run and lumi
+seq.append(cms.EventID(1,0,0))
+seq.append(cms.EventID(1,1,0))
+for e in range(10123456789+3, 10123456789+50):
+    seq.append(cms.EventID(1,1,e))
+#end lumi and run
+seq.append(cms.EventID(1,1,0))
+seq.append(cms.EventID(1,0,0))
+
+process.check = cms.EDAnalyzer("RunLumiEventChecker",
+    eventSequence = seq
+)
+
+process.a1 = cms.EDAnalyzer("StreamThingAnalyzer",
+    product_to_get = cms.string('m1')
+)
+
+process.end = cms.EndPath(process.check*process.a1)
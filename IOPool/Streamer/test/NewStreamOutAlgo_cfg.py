@@ -0,0 +1,43 @@
+# Writes the events of NewStreamOut_cfg.py compressed with the algorithm
+# given as argument (ZLIB, LZMA, LZ4 or ZSTD) into teststreamfile_<algorithm>.dat
+import sys
+import FWCore.ParameterSet.Config as cms
+
+algorithm = sys.argv[2] if len(sys.argv) > 2 else "LZMA"
+
+process = cms.Process("HLT")
+
+import FWCore.Framework.test.cmsExceptionsFatal_cff
+process.options = FWCore.Framework.test.cmsExceptionsFatal_cff.options
+
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(50)
+)
+
+process.source = cms.Source("EmptySource",
+    firstEvent = cms.untracked.uint64(10123456789)
+)
+
+process.m1 = cms.EDProducer("StreamThingProducer",
+    instance_count = cms.int32(5),
+    array_size = cms.int32(2)
+)
+
+process.m2 = cms.EDProducer("NonProducer")
+
+process.a1 = cms.EDAnalyzer("StreamThingAnalyzer",
+    product_to_get = cms.string('m1')
+)
+
+process.out = cms.OutputModule("EventStreamFileWriter",
+    fileName = cms.untracked.string('teststreamfile_%s.dat' % algorithm),
+    compression_algorithm = cms.untracked.string(algorithm),
+    compression_level = cms.untracked.int32(4),
+    use_compression = cms.untracked.bool(True),
+    max_event_size = cms.untracked.int32(7000000)
+)
+
+process.p1 = cms.Path(process.m1*process.a1*process.m2)
+process.end = cms.EndPath(process.out)
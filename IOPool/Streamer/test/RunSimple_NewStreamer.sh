@@ -21,6 +21,9 @@ cmsRun --parameter-set NewStreamIn_cfg.py  > in  2>&1 || die "cmsRun NewStreamIn
 cmsRun --parameter-set NewStreamIn2_cfg.py  > in2  2>&1 || die "cmsRun NewStreamIn2_cfg.py" $?
 cmsRun --parameter-set NewStreamCopy_cfg.py  > copy  2>&1 || die "cmsRun NewStreamCopy_cfg.py" $?
 cmsRun --parameter-set NewStreamCopy2_cfg.py  > copy2  2>&1 || die "cmsRun NewStreamCopy2_cfg.py" $?
+cmsRun NewStreamOutAlgo_cfg.py LZMA > outLZMA 2>&1 || die "cmsRun NewStreamOutAlgo_cfg.py LZMA" $?
+cmsRun NewStreamInAlgo_cfg.py LZMA > inLZMA 2>&1 || die "cmsRun NewStreamInAlgo_cfg.py LZMA" $?
+cmsRun --parameter-set NewStreamInBatch_cfg.py > inBatch 2>&1 || die "cmsRun NewStreamInBatch_cfg.py" $?
 
 # echo "CHECKSUM = 1" > out
 # echo "CHECKSUM = 1" > in
@@ -30,6 +33,8 @@ ANS_OUT=`grep CHECKSUM out`
 ANS_IN=`grep CHECKSUM in`
 ANS_IN2=`grep CHECKSUM in2`
 ANS_COPY=`grep CHECKSUM copy`
+ANS_OUT_LZMA=`grep CHECKSUM outLZMA`
+ANS_IN_LZMA=`grep CHECKSUM inLZMA`
 
 if [ "${ANS_OUT_SIZE}" == "0" ]
 then
@@ -55,5 +60,11 @@ then
     RC=1
 fi
 
+if [ "${ANS_OUT}" != "${ANS_OUT_LZMA}" ] || [ "${ANS_OUT_LZMA}" != "${ANS_IN_LZMA}" ]
+then
+    echo "New Stream Test Failed (LZMA out!=in)"
+    RC=1
+fi
+
 #rm -rf ${OUTDIR}
 exit ${RC}
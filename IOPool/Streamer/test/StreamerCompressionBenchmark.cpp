@@ -0,0 +1,134 @@
+/** Compares the compression algorithms of the streamer event data.
+
+    Each algorithm compresses and uncompresses buffers of the sizes of
+    typical serialized events, filled with data looking like what the
+    TBufferFile of an event holds (class names, counters, and floats with
+    a limited number of significant bits).  The compression ratio and the
+    compression and uncompression speed in MB/s are printed.
+
+    Returns a non zero value if a buffer does not come back identical.
+
+    Usage: StreamerCompressionBenchmark [repetitions]
+*/
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "IOPool/Streamer/interface/StreamSerializer.h"
+#include "IOPool/Streamer/interface/StreamerInputSource.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+  std::vector<unsigned char> makeEvent(unsigned int size, unsigned int seed) {
+    std::vector<unsigned char> event;
+    event.reserve(size);
+    std::mt19937 engine(seed);
+    std::exponential_distribution<float> energy(0.1f);
+    std::normal_distribution<float> position(0.f, 50.f);
+    std::uniform_int_distribution<uint32_t> hits(0, 200);
+    char const* classNames[] = {"edm::Wrapper<std::vector<reco::Track> >",
+                                "edm::Wrapper<edm::SortedCollection<EcalRecHit> >",
+                                "edm::Wrapper<FEDRawDataCollection>"};
+    unsigned int product = 0;
+    while(event.size() < size) {
+      char const* name = classNames[product++ % 3];
+      event.insert(event.end(), name, name + std::strlen(name));
+      uint32_t n = hits(engine);
+      for(uint32_t i = 0; i < n && event.size() < size; ++i) {
+        float values[3] = {energy(engine), position(engine), position(engine)};
+        for(float& value : values) {
+          // the reconstruction keeps a limited precision
+          uint32_t bits;
+          std::memcpy(&bits, &value, sizeof(bits));
+          bits &= 0xffffe000;
+          std::memcpy(&value, &bits, sizeof(bits));
+        }
+        unsigned char const* begin = reinterpret_cast<unsigned char const*>(values);
+        event.insert(event.end(), begin, begin + sizeof(values));
+        event.insert(event.end(), reinterpret_cast<unsigned char const*>(&i),
+                     reinterpret_cast<unsigned char const*>(&i) + sizeof(i));
+      }
+    }
+    event.resize(size);
+    return event;
+  }
+
+  double megabytesPerSecond(unsigned int size, std::chrono::duration<double> time) {
+    return time.count() > 0. ? size / (1024. * 1024.) / time.count() : 0.;
+  }
+}
+
+int main(int argc, char* argv[]) try {
+  int const repetitions = argc > 1 ? std::atoi(argv[1]) : 1;
+
+  // from a small HLT event to more than the 16 MB of one ROOT block
+  std::vector<unsigned int> const sizes = {100 * 1024, 1024 * 1024, 4 * 1024 * 1024, 20 * 1024 * 1024};
+  std::vector<std::string> const algorithms = {"ZLIB", "LZMA", "LZ4", "ZSTD"};
+  std::vector<int> const levels = {1, 4, 9};
+
+  std::cout << std::setw(6) << "algo" << std::setw(7) << "level" << std::setw(10) << "size kB"
+            << std::setw(8) << "ratio" << std::setw(14) << "compr MB/s" << std::setw(16) << "uncompr MB/s"
+            << std::endl;
+
+  int failures = 0;
+  for(auto const& name : algorithms) {
+    edm::StreamerCompressionAlgo algorithm;
+    try {
+      algorithm = edm::StreamSerializer::compressionAlgorithm(name);
+    } catch(cms::Exception const&) {
+      std::cout << std::setw(6) << name << "  not supported by this ROOT version" << std::endl;
+      continue;
+    }
+    for(int level : levels) {
+      for(unsigned int size : sizes) {
+        std::vector<unsigned char> event = makeEvent(size, size);
+        std::vector<unsigned char> compressed;
+        std::vector<unsigned char> uncompressed;
+        unsigned int compressedSize = 0;
+        unsigned int uncompressedSize = 0;
+        std::chrono::duration<double> compressTime(0.);
+        std::chrono::duration<double> uncompressTime(0.);
+        for(int i = 0; i < repetitions; ++i) {
+          auto start = std::chrono::steady_clock::now();
+          compressedSize = edm::StreamSerializer::compressBuffer(&event[0], size, compressed, level, algorithm);
+          auto middle = std::chrono::steady_clock::now();
+          if(compressedSize != 0) {
+            uncompressedSize = edm::StreamerInputSource::uncompressBuffer(&compressed[0], compressedSize, uncompressed, size);
+          }
+          auto end = std::chrono::steady_clock::now();
+          compressTime += middle - start;
+          uncompressTime += end - middle;
+        }
+        if(compressedSize == 0) {
+          std::cout << std::setw(6) << name << std::setw(7) << level << std::setw(10) << size / 1024
+                    << "  compression failed" << std::endl;
+          ++failures;
+          continue;
+        }
+        if(uncompressedSize != size || !std::equal(event.begin(), event.end(), uncompressed.begin())) {
+          std::cout << std::setw(6) << name << std::setw(7) << level << std::setw(10) << size / 1024
+                    << "  uncompressed data differs" << std::endl;
+          ++failures;
+          continue;
+        }
+        std::cout << std::setw(6) << name << std::setw(7) << level << std::setw(10) << size / 1024
+                  << std::setw(8) << std::fixed << std::setprecision(3) << double(size) / compressedSize
+                  << std::setw(14) << std::setprecision(1) << megabytesPerSecond(size * repetitions, compressTime)
+                  << std::setw(16) << megabytesPerSecond(size * repetitions, uncompressTime)
+                  << std::endl;
+      }
+    }
+  }
+  return failures;
+} catch(cms::Exception const& e) {
+  std::cerr << e.explainSelf() << std::endl;
+  return 1;
+}
@@ -11,6 +11,9 @@
 
 
 class Storage;
+class ReadAhead;
+class ReadRepacker;
+class ReadRepackerTuning;
 
 /** TFile wrapper around #StorageFactory and #Storage.  */
 class TStorageFactoryFile : public TFile
@@ -58,6 +61,10 @@ private:
   TStorageFactoryFile(void);
 
   edm::propagate_const<std::unique_ptr<Storage>> storage_; //< Real underlying storage
+  edm::propagate_const<std::unique_ptr<ReadAhead>> readAhead_; //< Background reads of asynchronous requests
+  edm::propagate_const<std::unique_ptr<ReadRepacker>> repacker_; //< Kept with its spare buffer for all the vectored reads of the file
+  edm::propagate_const<ReadRepackerTuning*> repackTuning_; //< Repacking thresholds learned for the storage, if adaptive
+  bool directReads_; //< Requests read as they are, without repacking, from a mapped local file
 };
 
 #endif // TFILE_ADAPTOR_TSTORAGE_FACTORY_FILE_H
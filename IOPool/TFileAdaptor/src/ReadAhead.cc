@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <cstring>
+
+#include "ReadAhead.h"
+#include "Utilities/StorageFactory/interface/IOFlags.h"
+#include "Utilities/StorageFactory/interface/IOPosBuffer.h"
+#include "Utilities/StorageFactory/interface/Storage.h"
+#include "Utilities/StorageFactory/interface/StorageAccount.h"
+#include "Utilities/StorageFactory/interface/StorageFactory.h"
+
+// Blocks are kept small enough for the caller to start using the first one
+// while the next ones are still being read.
+static const IOSize MAX_BLOCK_SIZE = 16 * 1024 * 1024;
+
+static inline StorageAccount::Counter &
+readAheadCounter(StorageAccount::Operation operation)
+{
+  static const auto token = StorageAccount::tokenForStorageClassName("tstoragefile");
+  return StorageAccount::counter(token, operation);
+}
+
+ReadAhead::ReadAhead(std::string const& path, IOSize limit)
+  : path_(path),
+    limit_(limit),
+    held_(0),
+    stop_(false)
+{}
+
+ReadAhead::~ReadAhead()
+{
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+  if (thread_.joinable()) thread_.join();
+}
+
+/**
+   Sorts and coalesces the ranges into blocks, skipping the ranges already
+   held, and queues the blocks for the background thread.  Blocks which were
+   read but never used are released, oldest first, to make room; the
+   ranges still not fitting in the memory limit are dropped.
+
+   @param pos: An array of file offsets, nbuf long.
+   @param len: An array of offset length, nbuf long.
+   @param nbuf: Number of ranges.
+ */
+void
+ReadAhead::request(long long int const* pos, int const* len, int nbuf)
+{
+  std::vector<std::pair<IOOffset, IOSize>> ranges;
+  ranges.reserve(nbuf);
+  for (int i = 0; i < nbuf; ++i)
+    if (len[i] > 0) ranges.emplace_back(pos[i], len[i]);
+  std::sort(ranges.begin(), ranges.end());
+
+  std::vector<std::shared_ptr<Block>> blocks;
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (auto const& range : ranges)
+  {
+    bool held = std::any_of(blocks_.begin(), blocks_.end(), [&range](std::shared_ptr<Block> const& block) {
+      return block->offset <= range.first
+        && range.first + static_cast<IOOffset>(range.second) <= block->offset + static_cast<IOOffset>(block->size);
+    });
+    if (held) continue;
+
+    if (!blocks.empty())
+    {
+      Block &last = *blocks.back();
+      IOOffset end = last.offset + last.size;
+      IOOffset newEnd = std::max(end, range.first + static_cast<IOOffset>(range.second));
+      IOSize grown = newEnd - end;
+      if (range.first <= end + static_cast<IOOffset>(COALESCE_SIZE)
+          && static_cast<IOSize>(newEnd - last.offset) <= MAX_BLOCK_SIZE
+          && held_ + grown <= limit_)
+      {
+        held_ += grown;
+        last.size += grown;
+        last.needed += range.second;
+        continue;
+      }
+    }
+
+    for (auto iBlock = blocks_.begin(); held_ + range.second > limit_ && iBlock != blocks_.end();)
+    {
+      if ((*iBlock)->ready)
+      {
+        release(iBlock);
+        iBlock = blocks_.begin();
+      }
+      else
+        ++iBlock;
+    }
+    if (held_ + range.second > limit_) break;
+
+    auto block = std::make_shared<Block>();
+    block->offset = range.first;
+    block->size = range.second;
+    block->needed = range.second;
+    held_ += range.second;
+    blocks.push_back(block);
+    blocks_.push_back(block);
+  }
+
+  if (blocks.empty()) return;
+  queue_.push_back(std::move(blocks));
+  if (!thread_.joinable()) thread_ = std::thread([this]() { readBlocks(); });
+  lock.unlock();
+  condition_.notify_all();
+}
+
+bool
+ReadAhead::read(char* buf, IOOffset pos, IOSize len)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto iBlock = std::find_if(blocks_.begin(), blocks_.end(), [pos, len](std::shared_ptr<Block> const& block) {
+    return block->offset <= pos && pos + static_cast<IOOffset>(len) <= block->offset + static_cast<IOOffset>(block->size);
+  });
+  if (iBlock == blocks_.end()) return false;
+
+  std::shared_ptr<Block> block = *iBlock;
+  auto start = std::chrono::high_resolution_clock::now();
+  condition_.wait(lock, [&block]() { return block->ready; });
+  auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start);
+  block->waitTime += waited;
+
+  // The block may have been released while waiting.
+  iBlock = std::find(blocks_.begin(), blocks_.end(), block);
+  if (block->failed)
+  {
+    if (iBlock != blocks_.end()) release(iBlock);
+    return false;
+  }
+
+  memcpy(buf, block->data.get() + (pos - block->offset), len);
+  readAheadCounter(StorageAccount::Operation::readAheadWait).record(len, 0, waited.count());
+  block->used += len;
+  if (block->used >= block->needed && iBlock != blocks_.end()) release(iBlock);
+  return true;
+}
+
+void
+ReadAhead::release(std::deque<std::shared_ptr<Block>>::iterator iBlock)
+{
+  Block const& block = **iBlock;
+  if (block.used > 0 && !block.failed && block.readTime > block.waitTime)
+    readAheadCounter(StorageAccount::Operation::readAheadHidden)
+      .record(block.size, 0, (block.readTime - block.waitTime).count());
+  held_ -= block.size;
+  blocks_.erase(iBlock);
+}
+
+void
+ReadAhead::readBlocks()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true)
+  {
+    condition_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+    if (stop_) return;
+    std::vector<std::shared_ptr<Block>> blocks = std::move(queue_.front());
+    queue_.pop_front();
+    lock.unlock();
+
+    bool failed = false;
+    IOSize total = 0;
+    for (auto const& block : blocks) total += block->size;
+    auto start = std::chrono::high_resolution_clock::now();
+    try
+    {
+      // A Storage of its own, so that its position is never shared with
+      // the one used by ROOT.
+      if (!storage_) storage_ = StorageFactory::get()->open(path_, IOFlags::OpenRead);
+
+      std::vector<IOPosBuffer> iov;
+      iov.reserve(blocks.size());
+      for (auto& block : blocks)
+      {
+        block->data.reset(new char[block->size]);
+        iov.emplace_back(block->offset, block->data.get(), block->size);
+      }
+      StorageAccount::Stamp stats(readAheadCounter(StorageAccount::Operation::readAhead));
+      failed = storage_->readv(&iov[0], iov.size()) != total;
+      if (!failed) stats.tick(total, iov.size());
+    }
+    catch (...)
+    {
+      // The caller falls back to reading the data itself.
+      failed = true;
+    }
+    auto readTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start);
+
+    // The blocks were read by a single readv: share its time between them
+    // by size, so that the time hidden is not counted once per block.
+    lock.lock();
+    for (auto& block : blocks)
+    {
+      block->ready = true;
+      block->failed = failed;
+      block->readTime = std::chrono::nanoseconds(
+        static_cast<std::chrono::nanoseconds::rep>(readTime.count() * (static_cast<double>(block->size) / total)));
+    }
+    condition_.notify_all();
+  }
+}
@@ -0,0 +1,93 @@
+#ifndef TFILE_ADAPTOR_READ_AHEAD_H
+# define TFILE_ADAPTOR_READ_AHEAD_H
+
+/**
+ * Reads byte ranges of a file in a background thread, ahead of the time the
+ * application needs them.
+ *
+ * ROOT asks for an asynchronous read by calling TFile::ReadBuffers without a
+ * buffer; the PoolSource does so for the coming clusters of the event tree.
+ * The ranges of one request are coalesced into a few blocks which are read
+ * with a single vectored read on a second Storage object for the same file,
+ * so the position of the Storage used by ROOT is never touched from another
+ * thread.  A later synchronous read fully contained in a block is served
+ * from memory, waiting for the block if it is still being read.
+ *
+ * A block is released once all its bytes were used.  Blocks never used are
+ * released, oldest first, when the memory limit would be exceeded.
+ *
+ * The StorageAccount operations are, for the "tstoragefile" class:
+ *  - readAhead: the vectored reads done in the background;
+ *  - readAheadWait: the reads served from the blocks, with the time spent
+ *    waiting for the block;
+ *  - readAheadHidden: per block, the part of its read time during which
+ *    the application did not have to wait.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+# include "Utilities/StorageFactory/interface/IOTypes.h"
+
+class Storage;
+
+class ReadAhead {
+
+public:
+  ReadAhead(std::string const& path, IOSize limit);
+  ~ReadAhead();
+
+  ReadAhead(ReadAhead const&) = delete;
+  ReadAhead& operator=(ReadAhead const&) = delete;
+
+  // Queues the ranges for reading in the background.  Ranges not fitting in
+  // the memory limit are ignored.
+  void request(long long int const* pos, int const* len, int nbuf);
+
+  // Copies the range into buf if it was requested, returns false otherwise or
+  // if the background read failed.
+  bool read(char* buf, IOOffset pos, IOSize len);
+
+  // Two ranges distanced by less than COALESCE_SIZE are read as one block.
+  static const IOSize COALESCE_SIZE = 32 * 1024;
+
+private:
+  struct Block {
+    IOOffset offset;
+    IOSize size;
+    // bytes of the requested ranges, the gaps between them are never used
+    IOSize needed;
+    IOSize used = 0;
+    std::unique_ptr<char[]> data;
+    bool ready = false;
+    bool failed = false;
+    // share, by size, of the time of the readv which read this block
+    std::chrono::nanoseconds readTime{0};
+    std::chrono::nanoseconds waitTime{0};
+  };
+
+  void readBlocks();
+  void release(std::deque<std::shared_ptr<Block>>::iterator iBlock);
+
+  std::string path_;
+  IOSize limit_;
+  IOSize held_;
+  std::unique_ptr<Storage> storage_;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  // all blocks not yet released, oldest first
+  std::deque<std::shared_ptr<Block>> blocks_;
+  // requests waiting for the background thread
+  std::deque<std::vector<std::shared_ptr<Block>>> queue_;
+  bool stop_;
+  std::thread thread_;
+};
+
+#endif // TFILE_ADAPTOR_READ_AHEAD_H
@@ -1,13 +1,32 @@
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstring>
 
 #include "ReadRepacker.h"
 
+ReadRepacker::ReadRepacker(IOSize coalesce_size, IOSize big_read_size, IOSize buffer_size)
+  : m_len(nullptr),
+    m_buffer_used(0),
+    m_extra_bytes(0),
+    m_coalesce_size(coalesce_size),
+    m_big_read_size(big_read_size),
+    m_buffer_size(buffer_size)
+{}
+
+void
+ReadRepacker::tune(ReadRepackerTuning const& tuning)
+{
+  m_coalesce_size = tuning.coalesceSize();
+  m_big_read_size = tuning.bigReadSize();
+  m_buffer_size = tuning.bufferSize();
+}
+
 /**
    Given a list of offsets and positions, pack them into a vector of IOPosBuffer (an "IO Vector").
-   This function will coalesce reads that are within READ_COALESCE_SIZE into a IOPosBuffer.
-   This function will not create an IO vector whose summed buffer size is larger than TEMPORARY_BUFFER_SIZE. 
+   This function will coalesce reads that are within the coalesce size into a IOPosBuffer.
+   This function will not create an IO vector whose summed buffer size is larger than the buffer size. 
    The IOPosBuffer in iov all point to a location inside buf.
     
    @param pos: An array of file offsets, nbuf long.
@@ -27,10 +46,10 @@ ReadRepacker::pack(long long int *pos, int *len, int nbuf, char *buf, IOSize buf
   // Determine the buffer to use for the initial packing.
   char * tmp_buf;
   IOSize tmp_size;
-  if (buffer_size < TEMPORARY_BUFFER_SIZE) {
-        m_spare_buffer.resize(TEMPORARY_BUFFER_SIZE);
+  if (buffer_size < m_buffer_size) {
+        m_spare_buffer.resize(m_buffer_size);
         tmp_buf = &m_spare_buffer[0];
-        tmp_size = TEMPORARY_BUFFER_SIZE;
+        tmp_size = m_buffer_size;
   } else {
         tmp_buf = buf;
         tmp_size = buffer_size;
@@ -40,17 +59,17 @@ ReadRepacker::pack(long long int *pos, int *len, int nbuf, char *buf, IOSize buf
 
   if ((nbuf - pack_count > 0) &&  // If there is remaining work..
       (tmp_buf != &m_spare_buffer[0]) &&    // and the spare buffer isn't already used
-      ((IOSize)len[pack_count] < TEMPORARY_BUFFER_SIZE)) { // And the spare buffer is big enough to hold at least one read.
+      ((IOSize)len[pack_count] < m_buffer_size)) { // And the spare buffer is big enough to hold at least one read.
 
     // Verify the spare is allocated.
     // If tmp_buf != &m_spare_buffer[0] before, it certainly won't after.
-    m_spare_buffer.resize(TEMPORARY_BUFFER_SIZE);
+    m_spare_buffer.resize(m_buffer_size);
 
     // If there are remaining chunks and we aren't already using the spare
     // buffer, try using that too.
     // This clutters up the code badly, but could save a network round-trip.
     pack_count += packInternal(&pos[pack_count], &len[pack_count], nbuf-pack_count,
-                               &m_spare_buffer[0], TEMPORARY_BUFFER_SIZE);
+                               &m_spare_buffer[0], m_buffer_size);
 
   }
 
@@ -84,8 +103,8 @@ ReadRepacker::packInternal(long long int *pos, int *len, int nbuf, char *buf, IO
     IOOffset extra_bytes_signed = (idx == 0) ? 0 : ((pos[idx] - iopb.offset()) - iopb.size()); assert(extra_bytes_signed >= 0);
     IOSize   extra_bytes = static_cast<IOSize>(extra_bytes_signed);
 
-    if (((static_cast<IOSize>(len[idx]) < BIG_READ_SIZE) || (iopb.size() < BIG_READ_SIZE)) && 
-        (extra_bytes < READ_COALESCE_SIZE) && (buffer_used + len[idx] + extra_bytes <= buffer_size)) {
+    if (((static_cast<IOSize>(len[idx]) < m_big_read_size) || (iopb.size() < m_big_read_size)) && 
+        (extra_bytes < m_coalesce_size) && (buffer_used + len[idx] + extra_bytes <= buffer_size)) {
       // The space between the two reads is small enough we can coalesce.
 
       // We enforce that the current read or the current iopb must be small.
@@ -160,3 +179,98 @@ ReadRepacker::reset(unsigned int nbuf)
   m_idx_to_iopb_offset.reserve(nbuf);
   m_idx_to_iopb_offset.clear();
 }
+
+ReadRepackerTuning::ReadRepackerTuning()
+  : m_samples(0),
+    m_w(0), m_c(0), m_b(0), m_t(0), m_cc(0), m_bb(0), m_cb(0), m_ct(0), m_bt(0),
+    m_coalesce_size(ReadRepacker::READ_COALESCE_SIZE),
+    m_big_read_size(ReadRepacker::BIG_READ_SIZE),
+    m_buffer_size(ReadRepacker::TEMPORARY_BUFFER_SIZE)
+{}
+
+ReadRepackerTuning &
+ReadRepackerTuning::forStorage(std::string const& storage_class)
+{
+  static std::mutex s_mutex;
+  static std::map<std::string, std::unique_ptr<ReadRepackerTuning>> s_tunings;
+  std::lock_guard<std::mutex> guard(s_mutex);
+  auto &tuning = s_tunings[storage_class];
+  if (!tuning) tuning = std::make_unique<ReadRepackerTuning>();
+  return *tuning;
+}
+
+/**
+ * Adds a vectored read to the weighted sums and, once enough reads were
+ * seen, updates the thresholds from the fitted costs.
+ */
+void
+ReadRepackerTuning::record(IOSize chunks, IOSize bytes, uint64_t elapsed_ns)
+{
+  double latency, chunk_cost, byte_cost;
+  bool fitted;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    double c = chunks, b = bytes, t = elapsed_ns;
+    m_w  = DECAY * m_w  + 1;
+    m_c  = DECAY * m_c  + c;
+    m_b  = DECAY * m_b  + b;
+    m_t  = DECAY * m_t  + t;
+    m_cc = DECAY * m_cc + c * c;
+    m_bb = DECAY * m_bb + b * b;
+    m_cb = DECAY * m_cb + c * b;
+    m_ct = DECAY * m_ct + c * t;
+    m_bt = DECAY * m_bt + b * t;
+    ++m_samples;
+    fitted = fit(latency, chunk_cost, byte_cost);
+  }
+  if (!fitted) return;
+
+  double coalesce = chunk_cost / byte_cost;
+  double buffer = latency / byte_cost;
+  IOSize coalesce_size = static_cast<IOSize>(std::min<double>(std::max<double>(coalesce, MIN_COALESCE_SIZE), MAX_COALESCE_SIZE));
+  IOSize buffer_size = static_cast<IOSize>(std::min<double>(std::max<double>(buffer, ReadRepacker::TEMPORARY_BUFFER_SIZE), MAX_BUFFER_SIZE));
+  m_coalesce_size = coalesce_size;
+  m_big_read_size = buffer_size;
+  m_buffer_size = buffer_size;
+}
+
+bool
+ReadRepackerTuning::costs(double &latency, double &chunk_cost, double &byte_cost) const
+{
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return fit(latency, chunk_cost, byte_cost);
+}
+
+/**
+ * Solves the weighted least squares of the duration against the number of
+ * chunks and bytes.  When the reads all have the same number of chunks, or
+ * the chunks grow with the bytes, their cost cannot be told apart from the
+ * latency or the bandwidth and is taken as zero.  Returns false until the
+ * cost of a byte is known.
+ */
+bool
+ReadRepackerTuning::fit(double &latency, double &chunk_cost, double &byte_cost) const
+{
+  if (m_samples < MIN_SAMPLES) return false;
+
+  double mc = m_c / m_w, mb = m_b / m_w, mt = m_t / m_w;
+  double vcc = m_cc / m_w - mc * mc;
+  double vbb = m_bb / m_w - mb * mb;
+  double vcb = m_cb / m_w - mc * mb;
+  double vct = m_ct / m_w - mc * mt;
+  double vbt = m_bt / m_w - mb * mt;
+  if (vbb <= 0) return false;
+
+  double det = vcc * vbb - vcb * vcb;
+  if (vcc > 0 && det > 1e-3 * vcc * vbb) {
+    chunk_cost = (vct * vbb - vbt * vcb) / det;
+    byte_cost = (vbt * vcc - vct * vcb) / det;
+  } else {
+    chunk_cost = 0;
+    byte_cost = vbt / vbb;
+  }
+  if (!(byte_cost > 0) || !std::isfinite(byte_cost)) return false;
+  chunk_cost = std::max(chunk_cost, 0.);
+  latency = std::max(mt - chunk_cost * mc - byte_cost * mb, 0.);
+  return true;
+}
@@ -25,15 +25,32 @@
  * additional I/O transaction to occur.
  */
 
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 # include "Utilities/StorageFactory/interface/IOPosBuffer.h"
 #include "FWCore/Utilities/interface/propagate_const.h"
 
+class ReadRepackerTuning;
+
 class ReadRepacker {
 
 public:
 
+// The thresholds default to the fixed values below, see ReadRepackerTuning
+// for thresholds adapted to the storage.
+ReadRepacker(IOSize coalesce_size = READ_COALESCE_SIZE,
+             IOSize big_read_size = BIG_READ_SIZE,
+             IOSize buffer_size = TEMPORARY_BUFFER_SIZE);
+
+// Uses the thresholds currently learned by the tuning.
+void tune(ReadRepackerTuning const& tuning);
+
 // Returns the number of input buffers it was able to pack into the IO operation.
 int
 pack(long long int    *pos,   // An array of file offsets to read.
@@ -76,6 +93,79 @@ edm::propagate_const<int*> m_len;              // Pointed to the array of read s
 IOSize                   m_buffer_used;        // Bytes in the temporary buffer used.
 IOSize                   m_extra_bytes;        // Number of bytes read from storage that will be discarded.
 std::vector<char>        m_spare_buffer;       // The spare buffer; allocated if we cannot fit the I/O results into the ROOT buffer.
+IOSize                   m_coalesce_size;      // Reads distanced by less than this are coalesced.
+IOSize                   m_big_read_size;      // Two reads larger than this are not coalesced.
+IOSize                   m_buffer_size;        // Size of the spare buffer.
+
+};
+
+/**
+ * Learns the repacking thresholds from the vectored reads done on one kind
+ * of storage.
+ *
+ * The duration of a vectored read is modelled as
+ *
+ *   latency + chunks * chunk_cost + bytes * byte_cost
+ *
+ * the three terms being fitted, by least squares with the older reads
+ * weighing less and less, to the durations measured by StorageAccount.
+ * Then:
+ *  - two reads are coalesced if the gap between them costs less to read
+ *    than one more chunk, that is if it is shorter than chunk_cost / byte_cost;
+ *  - each vectored read should carry at least the bytes transferred in the
+ *    time of the latency, latency / byte_cost, so the temporary buffer
+ *    and the size of the reads never coalesced grow to that.
+ *
+ * A low latency local disk thus gets small gaps and buffers, avoiding over
+ * reading, while a remote storage gets fewer and larger vectored reads.
+ * The fixed ReadRepacker values are used until enough reads were observed.
+ */
+class ReadRepackerTuning {
+
+public:
+
+ReadRepackerTuning();
+
+ReadRepackerTuning(ReadRepackerTuning const&) = delete;
+ReadRepackerTuning& operator=(ReadRepackerTuning const&) = delete;
+
+// Returns the tuning shared by all the files of a storage class, the
+// protocol of their URL.
+static ReadRepackerTuning &forStorage(std::string const& storage_class);
+
+// Accounts for one vectored read of chunks IOPosBuffers and bytes in total.
+void record(IOSize chunks, IOSize bytes, uint64_t elapsed_ns);
+
+IOSize coalesceSize() const { return m_coalesce_size; }
+IOSize bigReadSize() const { return m_big_read_size; }
+IOSize bufferSize() const { return m_buffer_size; }
+
+// Returns the fitted costs, in nanoseconds, false if not yet known.
+bool costs(double &latency, double &chunk_cost, double &byte_cost) const;
+
+// Weight of a read relative to the next one.
+static constexpr double DECAY = 0.98;
+
+// Reads to observe before changing the thresholds.
+static const unsigned int MIN_SAMPLES = 16;
+
+// Limits of the adapted thresholds.
+static const IOSize MIN_COALESCE_SIZE = 4 * 1024;
+static const IOSize MAX_COALESCE_SIZE = 4 * 1024 * 1024;
+static const IOSize MAX_BUFFER_SIZE = 64 * 1024 * 1024;
+
+private:
+
+bool fit(double &latency, double &chunk_cost, double &byte_cost) const;
+
+mutable std::mutex m_mutex;
+unsigned int m_samples;
+// Weighted sums of 1, chunks, bytes, elapsed and of their products.
+double m_w, m_c, m_b, m_t, m_cc, m_bb, m_cb, m_ct, m_bt;
+
+std::atomic<IOSize> m_coalesce_size;
+std::atomic<IOSize> m_big_read_size;
+std::atomic<IOSize> m_buffer_size;
 
 };
 
@@ -166,6 +166,20 @@
     f->setTimeout(timeout_);
     f->setDebugLevel(debugLevel_);
 
+    // memory used for data read ahead of time in the background, see TStorageFactoryFile
+    f->setReadAheadLimit(static_cast<IOSize>(pset.getUntrackedParameter<unsigned int>("readAheadMemoryMB", f->readAheadLimit()/(1024*1024)))*1024*1024);
+
+    // coalescing of the vectored reads learned per storage, see ReadRepackerTuning
+    f->setAdaptiveRepacking(pset.getUntrackedParameter<bool>("adaptiveRepacking", f->adaptiveRepacking()));
+
+    // local input files read through a memory mapping, see MappedFile
+    f->setMapLocalFiles(pset.getUntrackedParameter<bool>("mapLocalFiles", f->mapLocalFiles()));
+
+    // node-local disk cache of the blocks read from remote files, see BlockCacheFile
+    f->setBlockCache(pset.getUntrackedParameter<std::string>("blockCacheDir", f->blockCacheDir()),
+                     static_cast<IOOffset>(pset.getUntrackedParameter<unsigned int>("blockCacheSizeMB", f->blockCacheSize()/(1024*1024)))*1024*1024,
+                     static_cast<IOSize>(pset.getUntrackedParameter<unsigned int>("blockCacheBlockSizeKB", f->blockCacheBlockSize()/1024))*1024);
+
     // enable file access stats accounting if requested
     f->enableAccounting(doStats_);
 
@@ -207,6 +221,12 @@
     desc.addOptionalUntracked<std::string>("tempDir");
     desc.addOptionalUntracked<double>("tempMinFree");
     desc.addOptionalUntracked<std::vector<std::string> >("native");
+    desc.addOptionalUntracked<unsigned int>("readAheadMemoryMB");
+    desc.addOptionalUntracked<bool>("adaptiveRepacking");
+    desc.addOptionalUntracked<bool>("mapLocalFiles");
+    desc.addOptionalUntracked<std::string>("blockCacheDir");
+    desc.addOptionalUntracked<unsigned int>("blockCacheSizeMB");
+    desc.addOptionalUntracked<unsigned int>("blockCacheBlockSizeKB");
     descriptions.add("AdaptorConfig", desc);
   }
 
@@ -6,6 +6,7 @@
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "FWCore/Utilities/interface/EDMException.h"
 #include "FWCore/Utilities/interface/ExceptionPropagate.h"
+#include "ReadAhead.h"
 #include "ReadRepacker.h"
 #include "TFileCacheRead.h"
 #include "TSystem.h"
@@ -17,6 +18,8 @@
 #include <fcntl.h>
 #include <iostream>
 #include <cassert>
+#include <cstring>
+#include <numeric>
 
 #if 0
 #include "TTreeCache.h"
@@ -95,7 +98,10 @@ storageCounter(StorageAccount::Counter *&c, StorageAccount::Operation operation)
 }
 
 TStorageFactoryFile::TStorageFactoryFile(void)
-  : storage_()
+  : storage_(),
+    repacker_(),
+    repackTuning_(nullptr),
+    directReads_(false)
 {
   StorageAccount::Stamp stats(storageCounter(s_statsCtor, StorageAccount::Operation::construct));
   stats.tick(0);
@@ -112,7 +118,10 @@ TStorageFactoryFile::TStorageFactoryFile(const char *path,
                                          Int_t netopt,
                                          Bool_t parallelopen /* = kFALSE */)
   : TFile(path, "NET", ftitle, compress), // Pass "NET" to prevent local access in base class
-    storage_()
+    storage_(),
+    repacker_(),
+    repackTuning_(nullptr),
+    directReads_(false)
 {
   try {
     Initialize(path, option);
@@ -126,7 +135,10 @@ TStorageFactoryFile::TStorageFactoryFile(const char *path,
                                          const char *ftitle /* = "" */,
                                          Int_t compress /* = 1 */)
   : TFile(path, "NET", ftitle, compress), // Pass "NET" to prevent local access in base class
-    storage_()
+    storage_(),
+    repacker_(),
+    repackTuning_(nullptr),
+    directReads_(false)
 {
   try {
     Initialize(path, option);
@@ -213,6 +225,19 @@ TStorageFactoryFile::Initialize(const char *path,
     }
   }
 
+  std::string url(path);
+  size_t colon = url.find(':');
+  std::string protocol(colon == std::string::npos ? "file" : url.substr(0, colon));
+
+  // Learn the repacking thresholds of this kind of storage.
+  if (read && StorageFactory::get()->adaptiveRepacking())
+    repackTuning_ = &ReadRepackerTuning::forStorage(protocol);
+
+  // A mapped file serves each request from memory; repacking would only
+  // add a copy through the spare buffer.  Only the storage knows if it was
+  // mapped: e.g. files opened for update or cached locally are not.
+  directReads_ = read && storage_->memoryMapped();
+
   fRealName = path;
   fD = 0; // sorry, meaningless
   fWritable = read ? kFALSE : kTRUE;
@@ -300,6 +325,18 @@ TStorageFactoryFile::ReadBuffer(char *buf, Int_t len)
   // FIXME: Re-enable read-ahead if the data wasn't in cache.
   // if (! st) storage_->caching(true, -1, s_readahead);
 
+  // Data requested earlier by an asynchronous ReadBuffers.
+  if (readAhead_)
+  {
+    Long64_t here = GetRelOffset();
+    if (readAhead_->read(buf, here, len))
+    {
+      Seek(here + len);
+      stats.tick(len);
+      return kFALSE;
+    }
+  }
+
   // A real read
   StorageAccount::Stamp xstats(storageCounter(s_statsXRead, StorageAccount::Operation::readActual));
   IOSize n = storage_->xread(buf, len);
@@ -388,6 +425,63 @@ TStorageFactoryFile::ReadBuffersSync(char *buf, Long64_t *pos, Int_t *len, Int_t
    *  I/O transactions.  A clear win for all cases except high-latency WAN.
    */
 
+  // Serve what was read ahead, and read only the rest.
+  if (readAhead_)
+  {
+    std::vector<Long64_t> missPos;
+    std::vector<Int_t> missLen;
+    std::vector<char *> missBuf;
+    char *current = buf;
+    for (Int_t i = 0; i < nbuf; ++i)
+    {
+      if (! readAhead_->read(current, pos[i], len[i]))
+      {
+        missPos.push_back(pos[i]);
+        missLen.push_back(len[i]);
+        missBuf.push_back(current);
+      }
+      current += len[i];
+    }
+    if (missPos.empty())
+      return kFALSE;
+    if (missPos.size() < static_cast<size_t>(nbuf))
+    {
+      std::vector<char> missed(std::accumulate(missLen.begin(), missLen.end(), IOSize(0)));
+      if (ReadBuffersSync(&missed[0], &missPos[0], &missLen[0], missPos.size()))
+        return kTRUE;
+      current = &missed[0];
+      for (size_t i = 0; i < missPos.size(); ++i)
+      {
+        memcpy(missBuf[i], current, missLen[i]);
+        current += missLen[i];
+      }
+      return kFALSE;
+    }
+  }
+
+  if (directReads_)
+  {
+    std::vector<IOPosBuffer> iov;
+    iov.reserve(nbuf);
+    IOSize total = 0;
+    char *current = buf;
+    for (Int_t i = 0; i < nbuf; ++i)
+    {
+      iov.push_back(IOPosBuffer(pos[i], current, len[i]));
+      current += len[i];
+      total += len[i];
+    }
+
+    StorageAccount::Stamp xstats(storageCounter(s_statsXRead, StorageAccount::Operation::readActual));
+    IOSize result = storage_->readv(&iov[0], nbuf);
+    if (result != total) {
+      Error("ReadBuffersSync","Storage::readv returned different size result=%ld expected=%ld",result,total);
+      return kTRUE;
+    }
+    xstats.tick(total);
+    return kFALSE;
+  }
+
   Int_t remaining = nbuf; // Number of read requests left to process.
   Int_t pack_count; // Number of read requests processed by this iteration.
 
@@ -400,7 +494,12 @@ TStorageFactoryFile::ReadBuffersSync(char *buf, Long64_t *pos, Int_t *len, Int_t
   Long64_t *current_pos    = pos;
   Int_t    *current_len    = len;
 
-  ReadRepacker repacker;
+  // The spare buffer of the repacker may grow to the buffer size of the
+  // tuning, so it is allocated once per file rather than for each call.
+  if (! repacker_)
+    repacker_ = std::make_unique<ReadRepacker>();
+  ReadRepacker &repacker = *repacker_;
+  if (repackTuning_) repacker.tune(*repackTuning_);
 
   while (remaining > 0) {
 
@@ -417,7 +516,8 @@ TStorageFactoryFile::ReadBuffersSync(char *buf, Long64_t *pos, Int_t *len, Int_t
       Error("ReadBuffersSync","Storage::readv returned different size result=%ld expected=%ld",result,io_buffer_used);
       return kTRUE;
     }
-    xstats.tick(io_buffer_used);
+    uint64_t elapsed = xstats.tick(io_buffer_used);
+    if (repackTuning_) repackTuning_->record(iov.size(), io_buffer_used, elapsed);
     repacker.unpack(current_buffer);
 
     // Update the location of the unused part of the input buffer.
@@ -477,6 +577,19 @@ TStorageFactoryFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbu
   success = storage_->prefetch(&iov[0], nbuf);
   astats.tick(total);
 
+  // Without prefetching in the storage, read the data in the background if
+  // a source asked for it (PoolSource.readAheadClusters) and allowed to use
+  // some memory for it.  ROOT's probes for prefetch support (nbuf == 0) are
+  // left to the base class.
+  if (not success && nbuf > 0 && StorageFactory::get()->readAhead()
+      && StorageFactory::get()->readAheadLimit() > 0)
+  {
+    if (! readAhead_)
+      readAhead_ = std::make_unique<ReadAhead>(fRealName.Data(), StorageFactory::get()->readAheadLimit());
+    readAhead_->request(static_cast<long long int *>(pos), len, nbuf);
+    return kFALSE;
+  }
+
   // If it didn't suceeed, pass down to the base class.
   if(not success) {
     if(TFile::ReadBuffers(buf, pos, len, nbuf)) {
@@ -586,6 +699,8 @@ TStorageFactoryFile::SysClose(Int_t /* fd */)
 {
   StorageAccount::Stamp stats(storageCounter(s_statsClose, StorageAccount::Operation::close));
 
+  readAhead_ = nullptr;
+  repacker_ = nullptr;
   if (storage_)
   {
     storage_->close();
@@ -0,0 +1,158 @@
+/** Compares the fixed and the adaptive repacking of ROOT vectored reads.
+
+    A simulated storage serves the vectored reads, taking the time
+
+      latency + chunks * chunk cost + bytes / bandwidth
+
+    with some noise, for a local disk, a dCache pool and a remote XRootD
+    server.  The time is simulated rather than spent, so the benchmark
+    runs in a fraction of a second.  The requests look like the ones of
+    the TTreeCache: sorted baskets of a few kB to a few hundred kB, the
+    baskets of the branches not read leaving gaps between them.
+
+    For each storage the total time, the number of vectored reads and
+    chunks and the bytes read but not needed are printed, together with
+    the thresholds learned.  Returns a non zero value if the data given
+    back to ROOT is not the one of the file.
+
+    Usage: ReadRepackerBenchmark [requests]
+*/
+
+#include "IOPool/TFileAdaptor/src/ReadRepacker.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+  struct Profile {
+    char const* name;
+    double latency;   // ns
+    double chunkCost; // ns
+    double bandwidth; // bytes per ns
+  };
+
+  char fileByte(long long int offset) { return static_cast<char>((offset * 2654435761u) >> 11); }
+
+  struct Result {
+    double time = 0;
+    unsigned int reads = 0;
+    unsigned int chunks = 0;
+    double extraBytes = 0;
+    bool ok = true;
+  };
+
+  // Serves one ROOT request as ReadBuffersSync does.
+  void serve(Profile const& profile, std::mt19937& engine, std::vector<long long int>& pos, std::vector<int>& len,
+             ReadRepackerTuning* tuning, Result& result) {
+    std::normal_distribution<double> noise(1., 0.05);
+    IOSize total = 0;
+    for(int l : len) total += l;
+    std::vector<char> buf(total);
+
+    int remaining = pos.size();
+    IOSize remaining_buffer_size = total;
+    char* current_buffer = &buf[0];
+    long long int* current_pos = &pos[0];
+    int* current_len = &len[0];
+
+    ReadRepacker repacker;
+    if(tuning) repacker.tune(*tuning);
+    while(remaining > 0) {
+      int pack_count = repacker.pack(current_pos, current_len, remaining, current_buffer, remaining_buffer_size);
+      std::vector<IOPosBuffer>& iov = repacker.iov();
+      for(auto const& iopb : iov) {
+        char* data = static_cast<char*>(iopb.data());
+        for(IOSize i = 0; i < iopb.size(); ++i) data[i] = fileByte(iopb.offset() + i);
+      }
+      double elapsed = (profile.latency + iov.size() * profile.chunkCost + repacker.bufferUsed() / profile.bandwidth) *
+                       std::max(noise(engine), 0.5);
+      if(tuning) tuning->record(iov.size(), repacker.bufferUsed(), static_cast<uint64_t>(elapsed));
+      result.time += elapsed;
+      result.reads += 1;
+      result.chunks += iov.size();
+      result.extraBytes += repacker.extraBytes();
+      repacker.unpack(current_buffer);
+
+      IOSize real_bytes_processed = repacker.realBytesProcessed();
+      remaining_buffer_size -= real_bytes_processed;
+      current_buffer += real_bytes_processed;
+      current_pos += pack_count;
+      current_len += pack_count;
+      remaining -= pack_count;
+    }
+
+    char const* current = &buf[0];
+    for(size_t i = 0; i < pos.size(); ++i) {
+      for(int j = 0; j < len[i]; ++j) {
+        if(current[j] != fileByte(pos[i] + j)) result.ok = false;
+      }
+      current += len[i];
+    }
+  }
+
+  Result run(Profile const& profile, int requests, ReadRepackerTuning* tuning) {
+    std::mt19937 engine(12345);
+    std::lognormal_distribution<double> basketSize(9.5, 1.2);
+    std::exponential_distribution<double> gap(1. / 16000.);
+    std::uniform_int_distribution<int> baskets(20, 150);
+    std::bernoulli_distribution skip(0.1);
+
+    Result result;
+    long long int offset = 0;
+    for(int r = 0; r < requests; ++r) {
+      std::vector<long long int> pos;
+      std::vector<int> len;
+      int n = baskets(engine);
+      for(int i = 0; i < n; ++i) {
+        offset += static_cast<long long int>(gap(engine)) + (skip(engine) ? 4 * 1024 * 1024 : 0);
+        int size = std::min(std::max(static_cast<int>(basketSize(engine)), 100), 4 * 1024 * 1024);
+        pos.push_back(offset);
+        len.push_back(size);
+        offset += size;
+      }
+      serve(profile, engine, pos, len, tuning, result);
+    }
+    return result;
+  }
+
+  void print(std::string const& label, Result const& result) {
+    std::cout << "  " << std::left << std::setw(10) << label << std::right << std::setw(12) << std::fixed
+              << std::setprecision(3) << result.time * 1e-9 << " s" << std::setw(8) << result.reads << " reads"
+              << std::setw(9) << result.chunks << " chunks" << std::setw(10) << std::setprecision(1)
+              << result.extraBytes / (1024 * 1024) << " MB extra" << std::endl;
+  }
+}
+
+int main(int argc, char* argv[]) {
+  int const requests = argc > 1 ? std::atoi(argv[1]) : 20;
+
+  std::vector<Profile> const profiles = {{"local", 20e3, 5e3, 2.}, {"dcache", 1e6, 50e3, 0.2}, {"xrootd", 50e6, 200e3, 0.05}};
+
+  int failures = 0;
+  for(auto const& profile : profiles) {
+    std::cout << profile.name << ":" << std::endl;
+    Result fixed = run(profile, requests, nullptr);
+    print("fixed", fixed);
+
+    ReadRepackerTuning tuning;
+    Result adaptive = run(profile, requests, &tuning);
+    print("adaptive", adaptive);
+
+    double latency = 0, chunkCost = 0, byteCost = 0;
+    tuning.costs(latency, chunkCost, byteCost);
+    std::cout << "  learned latency " << std::setprecision(1) << latency * 1e-3 << " us, chunk " << chunkCost * 1e-3
+              << " us, " << (byteCost > 0 ? 1. / byteCost * 1e3 : 0.) << " MB/s; coalesce "
+              << tuning.coalesceSize() / 1024 << " kB, buffer " << tuning.bufferSize() / 1024 << " kB" << std::endl;
+
+    if(!fixed.ok || !adaptive.ok) {
+      std::cout << "  data read back differs" << std::endl;
+      ++failures;
+    }
+  }
+  return failures;
+}
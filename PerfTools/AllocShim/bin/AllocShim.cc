@@ -0,0 +1,174 @@
+// -*- C++ -*-
+//
+// Package:     PerfTools/AllocShim
+//
+// Implementation:
+//     The real allocation functions are looked up with dlsym(RTLD_NEXT).
+//     dlsym itself may allocate while we are doing so, those requests are
+//     served from a small static buffer which is never given back.
+//     The counters use initial-exec TLS so that reading or updating them
+//     can never call back into the allocator.
+//
+
+#include "PerfTools/AllocShim/interface/AllocShim.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+#include <dlfcn.h>
+#include <malloc.h>
+
+namespace {
+  typedef void* (*malloc_t)(size_t);
+  typedef void* (*calloc_t)(size_t, size_t);
+  typedef void* (*realloc_t)(void*, size_t);
+  typedef void (*free_t)(void*);
+  typedef int (*posix_memalign_t)(void**, size_t, size_t);
+  typedef void* (*aligned_alloc_t)(size_t, size_t);
+
+  malloc_t s_malloc = nullptr;
+  calloc_t s_calloc = nullptr;
+  realloc_t s_realloc = nullptr;
+  free_t s_free = nullptr;
+  posix_memalign_t s_posix_memalign = nullptr;
+  aligned_alloc_t s_aligned_alloc = nullptr;
+  aligned_alloc_t s_memalign = nullptr;
+
+  __thread edm_alloc_shim_counters s_counters __attribute__((tls_model("initial-exec"))) = {0, 0};
+
+  constexpr std::size_t kBootstrapSize = 8192;
+  alignas(16) char s_bootstrap[kBootstrapSize];
+  std::size_t s_bootstrapUsed = 0;
+  bool s_resolving = false;
+
+  void* bootstrapAlloc(size_t iSize) {
+    //keep 16 byte alignment
+    iSize = (iSize + 15) & ~static_cast<size_t>(15);
+    if(s_bootstrapUsed + iSize > kBootstrapSize) {
+      return nullptr;
+    }
+    void* p = s_bootstrap + s_bootstrapUsed;
+    s_bootstrapUsed += iSize;
+    return p;
+  }
+
+  inline bool fromBootstrap(void const* iPtr) {
+    return iPtr >= s_bootstrap and iPtr < s_bootstrap + kBootstrapSize;
+  }
+
+  void resolve() {
+    s_resolving = true;
+    s_malloc = reinterpret_cast<malloc_t>(dlsym(RTLD_NEXT, "malloc"));
+    s_calloc = reinterpret_cast<calloc_t>(dlsym(RTLD_NEXT, "calloc"));
+    s_realloc = reinterpret_cast<realloc_t>(dlsym(RTLD_NEXT, "realloc"));
+    s_free = reinterpret_cast<free_t>(dlsym(RTLD_NEXT, "free"));
+    s_posix_memalign = reinterpret_cast<posix_memalign_t>(dlsym(RTLD_NEXT, "posix_memalign"));
+    s_aligned_alloc = reinterpret_cast<aligned_alloc_t>(dlsym(RTLD_NEXT, "aligned_alloc"));
+    s_memalign = reinterpret_cast<aligned_alloc_t>(dlsym(RTLD_NEXT, "memalign"));
+    s_resolving = false;
+  }
+
+  inline bool ready() {
+    if(s_free == nullptr) {
+      if(s_resolving) {
+        return false;
+      }
+      resolve();
+    }
+    return true;
+  }
+
+  inline void* countAllocation(void* iPtr) {
+    if(iPtr) {
+      s_counters.allocated += malloc_usable_size(iPtr);
+    }
+    return iPtr;
+  }
+
+  inline void countDeallocation(void* iPtr) {
+    s_counters.deallocated += malloc_usable_size(iPtr);
+  }
+}
+
+extern "C" {
+
+  edm_alloc_shim_counters* edm_alloc_shim_thread_counters() {
+    return &s_counters;
+  }
+
+  void* malloc(size_t iSize) {
+    if(not ready()) {
+      return bootstrapAlloc(iSize);
+    }
+    return countAllocation(s_malloc(iSize));
+  }
+
+  void* calloc(size_t iN, size_t iSize) {
+    if(not ready()) {
+      //the bootstrap buffer is static and hence already zeroed
+      return bootstrapAlloc(iN*iSize);
+    }
+    return countAllocation(s_calloc(iN, iSize));
+  }
+
+  void* realloc(void* iPtr, size_t iSize) {
+    if(not ready()) {
+      return bootstrapAlloc(iSize);
+    }
+    if(fromBootstrap(iPtr)) {
+      void* p = countAllocation(s_malloc(iSize));
+      if(p) {
+        std::size_t available = s_bootstrap + kBootstrapSize - static_cast<char*>(iPtr);
+        std::memcpy(p, iPtr, iSize < available ? iSize : available);
+      }
+      return p;
+    }
+    std::size_t const oldSize = iPtr ? malloc_usable_size(iPtr) : 0;
+    void* p = s_realloc(iPtr, iSize);
+    if(p) {
+      s_counters.deallocated += oldSize;
+      countAllocation(p);
+    } else if(iSize == 0) {
+      //the old memory was freed
+      s_counters.deallocated += oldSize;
+    }
+    return p;
+  }
+
+  void free(void* iPtr) {
+    if(iPtr == nullptr or fromBootstrap(iPtr)) {
+      return;
+    }
+    if(not ready()) {
+      return;
+    }
+    countDeallocation(iPtr);
+    s_free(iPtr);
+  }
+
+  int posix_memalign(void** oPtr, size_t iAlignment, size_t iSize) {
+    if(not ready()) {
+      return ENOMEM;
+    }
+    int ret = s_posix_memalign(oPtr, iAlignment, iSize);
+    if(ret == 0) {
+      countAllocation(*oPtr);
+    }
+    return ret;
+  }
+
+  void* aligned_alloc(size_t iAlignment, size_t iSize) {
+    if(not ready()) {
+      return nullptr;
+    }
+    return countAllocation(s_aligned_alloc(iAlignment, iSize));
+  }
+
+  void* memalign(size_t iAlignment, size_t iSize) {
+    if(not ready()) {
+      return nullptr;
+    }
+    return countAllocation(s_memalign(iAlignment, iSize));
+  }
+}
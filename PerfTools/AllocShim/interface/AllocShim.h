@@ -0,0 +1,40 @@
+#ifndef PerfTools_AllocShim_AllocShim_h
+#define PerfTools_AllocShim_AllocShim_h
+// -*- C++ -*-
+//
+// Package:     PerfTools/AllocShim
+//
+/**
+
+ Description: Per-thread allocation counters filled by an allocator shim
+
+ Usage:
+    The shim library wraps malloc, calloc, realloc, free and the aligned
+ allocation functions of the underlying allocator (glibc or jemalloc) and
+ counts, per thread, the number of bytes handed out and given back. It is
+ meant to be loaded with LD_PRELOAD, e.g.
+
+    LD_PRELOAD=libPerfToolsAllocShim.so cmsRun cfg.py
+
+ The library is built on its own from the bin directory and no other
+ library may link against it: loaded with a plugin it would replace the
+ allocator of the whole job and its initial-exec TLS could make the plugin
+ fail to load. Clients (e.g. the ModuleProfiler service) only include this
+ header and find the counters at run time via
+ dlsym(RTLD_DEFAULT, "edm_alloc_shim_thread_counters"), which only succeeds
+ when the shim was preloaded.
+*/
+
+#include <cstdint>
+
+extern "C" {
+  struct edm_alloc_shim_counters {
+    uint64_t allocated;
+    uint64_t deallocated;
+  };
+
+  // returns the counters of the calling thread
+  edm_alloc_shim_counters* edm_alloc_shim_thread_counters();
+}
+
+#endif
@@ -38,6 +38,8 @@ static const char * const kAlphabeticOrderOpt ="alphabetic-order";
 static const char * const kAlphabeticOrderCommandOpt ="alphabetic-order,A";
 static const char * const kFormatNamesOpt ="format-names";
 static const char * const kFormatNamesCommandOpt ="format-names,F";
+static const char * const kDecompressionTimeOpt ="decompression-time";
+static const char * const kDecompressionTimeCommandOpt ="decompression-time,D";
 
 int main( int argc, char * argv[] ) {
   using namespace boost::program_options;
@@ -57,6 +59,7 @@ int main( int argc, char * argv[] ) {
     ( kOutputCommandOpt, value<string>(), "output file" )
     ( kAlphabeticOrderCommandOpt, "sort by alphabetic order (default: sort by size)" )
     ( kFormatNamesCommandOpt, "format product name as \"product:label (type)\" (default: use full branch name)" )
+    ( kDecompressionTimeCommandOpt, "also measure the decompression time and print the compression algorithm and level of each branch" )
     ( kPlotCommandOpt, value<string>(), "produce a summary plot" )
     ( kPlotTopCommandOpt, value<int>(), "plot only the <arg> top size branches" )
     ( kSavePlotCommandOpt, value<string>(), "save plot into root file <arg>" )
@@ -105,7 +108,7 @@ int main( int argc, char * argv[] ) {
   perftools::EdmEventSize me;
   
   try {
-    me.parseFile(fileName,treeName);
+    me.parseFile(fileName,treeName,vm.count( kDecompressionTimeOpt ) > 0);
   } catch(perftools::EdmEventSize::Error const & error) {
     std::cerr <<  programName << ":" << error.descr << std::endl;
     return error.code;
@@ -18,6 +18,9 @@ namespace perftools {
    *  all its baskets
    *  Estimate the "size in memory" multipling the actual branch size 
    *  by its compression factor
+   *  Optionally measure the time to decompress all the baskets of a branch,
+   *  the compressed baskets being read beforehand so that it does not include
+   *  the time to read them from the storage
    *
    *  \author Vincenzo Innocente
    */
@@ -36,15 +39,21 @@ namespace perftools {
     struct BranchRecord {
       BranchRecord() : 
 	compr_size(0.),  
-	uncompr_size(0.) {}
+	uncompr_size(0.),
+	decompr_time(0.),
+	compression(0) {}
       BranchRecord(std::string const & iname,
-		   double compr,  double uncompr) : 
+		   double compr,  double uncompr, int icompression) : 
 	fullName(iname), name(iname), 
-	compr_size(compr), uncompr_size(uncompr){}
+	compr_size(compr), uncompr_size(uncompr), decompr_time(0.), compression(icompression){}
       std::string fullName;
       std::string name;
       double compr_size;
       double uncompr_size;
+      /// average decompression time (microseconds/event)
+      double decompr_time;
+      /// ROOT compression settings, 100*algorithm+level
+      int compression;
     };
 
     typedef std::vector<BranchRecord> Branches;
@@ -54,8 +63,8 @@ namespace perftools {
     /// Constructor and parse 
     explicit EdmEventSize(std::string const & fileName, std::string const & treeName="Events");
     
-    /// read file, compute branch size, sort by size
-    void parseFile(std::string const & fileName, std::string const & treeName="Events");
+    /// read file, compute branch size and optionally decompression time, sort by size
+    void parseFile(std::string const & fileName, std::string const & treeName="Events", bool decompressionTime=false);
 
     /// sort by name
     void sortAlpha();
@@ -72,6 +81,7 @@ namespace perftools {
   private:
     std::string m_fileName;
     int m_nEvents;
+    bool m_decompressionTime;
     Branches m_branches;
 
   };
@@ -9,6 +9,7 @@
 #include <boost/bind.hpp>
 #include <ostream>
 #include <limits>
+#include <chrono>
 #include <assert.h>
 
 #include "Rtypes.h"
@@ -65,20 +66,41 @@ namespace {
       size[kUncompressed] += buf.Length();
     return size;
   }
+
+  // in microseconds
+  double getDecompressionTime( TBranch * b, TFile * file, std::vector<char> & buffer ) {
+    double result = 0.;
+    Int_t const * bytes = b->GetBasketBytes();
+    for( Int_t i = 0; i < b->GetWriteBasket(); ++i ) {
+      if ( bytes[i] <= 0 ) continue;
+      // read the compressed basket first so that it comes from the file system cache
+      buffer.resize( bytes[i] );
+      file->ReadBuffer( &buffer[0], b->GetBasketSeek( i ), bytes[i] );
+      auto start = std::chrono::steady_clock::now();
+      b->GetBasket( i );
+      result += std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - start ).count();
+      b->DropBaskets( "all" );
+    }
+    TObjArray * branches = b->GetListOfBranches();
+    for( int i = 0, n = branches->GetEntries(); i < n; ++i )
+      result += getDecompressionTime( static_cast<TBranch*>( branches->At( i ) ), file, buffer );
+    return result;
+  }
 }
 
 namespace perftools {
 
   EdmEventSize::EdmEventSize() : 
-    m_nEvents(0) {}
+    m_nEvents(0), m_decompressionTime(false) {}
   
   EdmEventSize::EdmEventSize(std::string const & fileName, std::string const & treeName ) : 
-    m_nEvents(0) {
+    m_nEvents(0), m_decompressionTime(false) {
     parseFile(fileName);
   }
   
-  void EdmEventSize::parseFile(std::string const & fileName, std::string const & treeName) {
+  void EdmEventSize::parseFile(std::string const & fileName, std::string const & treeName, bool decompressionTime) {
     m_fileName = fileName;
+    m_decompressionTime = decompressionTime;
     m_branches.clear();
 
     TFile * file = TFile::Open( fileName.c_str() );
@@ -104,13 +126,16 @@ namespace perftools {
     
     const size_t n =  branches->GetEntries();
     m_branches.reserve(n);
+    std::vector<char> buffer;
     for( size_t i = 0; i < n; ++i ) {
       TBranch * b = dynamic_cast<TBranch*>( branches->At( i ) );
       if (b==0) continue;
       std::string const name( b->GetName() );
       if ( name == "EventAux" ) continue;
       size_type s = getTotalSize(b);
-      m_branches.push_back( BranchRecord(name, double(s[kCompressed])/double(m_nEvents), double(s[kUncompressed])/double(m_nEvents)) );
+      m_branches.push_back( BranchRecord(name, double(s[kCompressed])/double(m_nEvents), double(s[kUncompressed])/double(m_nEvents), b->GetCompressionSettings()) );
+      if ( decompressionTime )
+	m_branches.back().decompr_time = getDecompressionTime(b, file, buffer)/double(m_nEvents);
     }
     std::sort(m_branches.begin(),m_branches.end(), 
 	      boost::bind(std::greater<double>(),
@@ -157,8 +182,11 @@ namespace perftools {
 
   namespace detail {
 
-    void dump(std::ostream& co, EdmEventSize::BranchRecord const & br) {
-      co << br.name << " " <<  br.uncompr_size <<  " " << br.compr_size << "\n"; 
+    void dump(std::ostream& co, EdmEventSize::BranchRecord const & br, bool decompressionTime) {
+      co << br.name << " " <<  br.uncompr_size <<  " " << br.compr_size;
+      if (decompressionTime)
+	co << " " << br.compression/100 << "/" << br.compression%100 << " " << br.decompr_time;
+      co << "\n"; 
     }
   }
 
@@ -166,10 +194,13 @@ namespace perftools {
   void EdmEventSize::dump(std::ostream & co, bool header) const {
     if (header) {
       co << "File " << m_fileName << " Events " << m_nEvents << "\n";
-      co <<"Branch Name | Average Uncompressed Size (Bytes/Event) | Average Compressed Size (Bytes/Event) \n";
+      co <<"Branch Name | Average Uncompressed Size (Bytes/Event) | Average Compressed Size (Bytes/Event)";
+      if (m_decompressionTime)
+	co << " | Compression Algorithm/Level | Average Decompression Time (us/Event)";
+      co << " \n";
     }
     std::for_each(m_branches.begin(),m_branches.end(),
-		  boost::bind(detail::dump,boost::ref(co),_1));
+		  boost::bind(detail::dump,boost::ref(co),_1,m_decompressionTime));
   }
 
   namespace detail {
@@ -0,0 +1,82 @@
+#ifndef STORAGE_FACTORY_BLOCK_CACHE_FILE_H
+# define STORAGE_FACTORY_BLOCK_CACHE_FILE_H
+
+# include "Utilities/StorageFactory/interface/Storage.h"
+# include "FWCore/Utilities/interface/propagate_const.h"
+# include <vector>
+# include <string>
+# include <memory>
+
+/** Proxy class keeping the blocks read from a remote file in a directory
+    on the local disk, shared by all the jobs running on the node.
+
+    A block is stored in its own file, named after a hash of the logical
+    file name, the file size and the block size, and the block number.
+    Blocks are written to a temporary file then renamed, so a job never
+    sees a partially written block whatever the number of jobs filling
+    the cache at the same time.  Reading a block updates the modification
+    time of its file; when the cache grows over its size limit the blocks
+    least recently used are removed, by one job at a time.
+
+    Hits and misses are accounted as the blockCacheHit and blockCacheMiss
+    operations of the "block-cache" storage class, evictions as
+    blockCacheEvict. */
+class BlockCacheFile : public Storage
+{
+public:
+  BlockCacheFile (std::unique_ptr<Storage> base,
+		  const std::string &name,
+		  const std::string &cacheDir,
+		  IOOffset cacheSize,
+		  IOSize blockSize);
+  ~BlockCacheFile (void) override;
+
+  using Storage::read;
+  using Storage::readv;
+  using Storage::write;
+  using Storage::writev;
+
+  IOSize	read (void *into, IOSize n) override;
+  IOSize	read (void *into, IOSize n, IOOffset pos) override;
+  IOSize	readv (IOBuffer *into, IOSize n) override;
+  IOSize	readv (IOPosBuffer *into, IOSize n) override;
+  IOSize	write (const void *from, IOSize n) override;
+  IOSize	write (const void *from, IOSize n, IOOffset pos) override;
+  IOSize	writev (const IOBuffer *from, IOSize n) override;
+  IOSize	writev (const IOPosBuffer *from, IOSize n) override;
+
+  IOOffset	size (void) const override;
+  IOOffset	position (void) const override;
+  IOOffset	position (IOOffset offset, Relative whence = SET) override;
+  void		resize (IOOffset size) override;
+  void		flush (void) override;
+  void		close (void) override;
+
+  /** Returns the part of the URL identifying the file at any site, the
+      logical file name when the URL contains one. */
+  static std::string	logicalName (const std::string &url);
+
+  /** Removes the blocks least recently used until the cache directory
+      holds at most 90% of cacheSize bytes.  Does nothing if another job
+      is already doing it. */
+  static void		evict (const std::string &cacheDir, IOOffset cacheSize);
+
+private:
+  bool			readCached (IOOffset block, char *into, IOSize offset, IOSize n);
+  void			store (IOOffset block, const char *data, IOSize n);
+  std::string		blockPath (IOOffset block) const;
+  IOSize		blockLength (IOOffset block) const;
+
+  edm::propagate_const<std::unique_ptr<Storage>> storage_;
+  std::string		cacheDir_;
+  std::string		key_;
+  IOOffset		cacheSize_;
+  IOSize		blockSize_;
+  IOOffset		size_;
+  IOOffset		position_;
+  IOOffset		openBlock_;
+  int			openFd_;
+  std::vector<char>	buffer_;
+};
+
+#endif // STORAGE_FACTORY_BLOCK_CACHE_FILE_H
@@ -0,0 +1,60 @@
+#ifndef STORAGE_FACTORY_MAPPED_FILE_H
+# define STORAGE_FACTORY_MAPPED_FILE_H
+
+# include "Utilities/StorageFactory/interface/Storage.h"
+# include "Utilities/StorageFactory/interface/File.h"
+# include "FWCore/Utilities/interface/propagate_const.h"
+# include <memory>
+
+/** Read-only access to a local file through a memory mapping of the
+    whole file.
+
+    Reads are copies out of the mapping, served from the page cache
+    without a system call per read.  The read lists given to prefetch(),
+    which the TTreeCache fills, are turned into madvise(MADV_WILLNEED)
+    for their pages; once a list was given the rest of the file is
+    advised MADV_RANDOM, so the kernel stops reading ahead the baskets
+    of the branches not read.
+
+    The file must not be truncated while it is mapped: touching pages
+    past its new end would raise SIGBUS. */
+class MappedFile : public Storage
+{
+public:
+  MappedFile (std::unique_ptr<File> file);
+  ~MappedFile (void) override;
+
+  using Storage::read;
+  using Storage::readv;
+  using Storage::write;
+  using Storage::writev;
+
+  bool		prefetch (const IOPosBuffer *what, IOSize n) override;
+  IOSize	read (void *into, IOSize n) override;
+  IOSize	read (void *into, IOSize n, IOOffset pos) override;
+  IOSize	readv (IOBuffer *into, IOSize n) override;
+  IOSize	readv (IOPosBuffer *into, IOSize n) override;
+  IOSize	write (const void *from, IOSize n) override;
+  IOSize	write (const void *from, IOSize n, IOOffset pos) override;
+  IOSize	writev (const IOBuffer *from, IOSize n) override;
+  IOSize	writev (const IOPosBuffer *from, IOSize n) override;
+
+  IOOffset	size (void) const override;
+  IOOffset	position (void) const override;
+  IOOffset	position (IOOffset offset, Relative whence = SET) override;
+  void		resize (IOOffset size) override;
+  void		flush (void) override;
+  void		close (void) override;
+  bool		memoryMapped (void) const override;
+
+private:
+  void		unmap (void);
+
+  edm::propagate_const<std::unique_ptr<File>> file_;
+  IOOffset	size_;
+  IOOffset	position_;
+  char		*data_;
+  bool		random_;
+};
+
+#endif // STORAGE_FACTORY_MAPPED_FILE_H
@@ -50,6 +50,9 @@ public:
   virtual void		flush (void);
   virtual void		close (void);
 
+  // True if the reads are copies out of a memory mapping of the whole file.
+  virtual bool		memoryMapped (void) const;
+
 private:
   // undefined, no semantics
   Storage (const Storage &);
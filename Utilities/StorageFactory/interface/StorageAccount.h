@@ -13,6 +13,9 @@ class StorageAccount {
 public:
   
   enum class Operation {
+    blockCacheEvict,
+    blockCacheHit,
+    blockCacheMiss,
     check,
     close,
     construct,
@@ -23,6 +26,9 @@ public:
     prefetch,
     read,
     readActual,
+    readAhead,
+    readAheadHidden,
+    readAheadWait,
     readAsync,
     readPrefetchToCache,
     readViaCache,
@@ -84,6 +90,9 @@ public:
     std::atomic<double>   timeMin;
     std::atomic<double>   timeMax;
     
+    ///Accounts for one successful operation, elapsed is in nanoseconds
+    void record(uint64_t amount, int64_t count, uint64_t elapsed);
+
     static void addTo(std::atomic<double>& iAtomic, double iToAdd) {
       double oldValue = iAtomic.load();
       double newValue = oldValue + iToAdd;
@@ -97,7 +106,8 @@ public:
   public:
     Stamp (Counter &counter);
 
-    void     tick (uint64_t amount = 0, int64_t tick = 0) const;
+    /// Accounts for one successful operation, returns its duration in nanoseconds
+    uint64_t tick (uint64_t amount = 0, int64_t tick = 0) const;
   protected:
     Counter &m_counter;
     std::chrono::time_point<std::chrono::high_resolution_clock> m_start;
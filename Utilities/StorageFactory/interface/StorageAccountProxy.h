@@ -38,6 +38,7 @@ public:
   virtual void		resize (IOOffset size);
   virtual void		flush (void);
   virtual void		close (void);
+  virtual bool		memoryMapped (void) const;
 
 protected:
   void releaseStorage() {get_underlying_safe(m_baseStorage).release();}
@@ -45,6 +45,30 @@ public:
   bool		enableAccounting (bool enabled);
   bool		accounting (void) const;
 
+  // Reads the asynchronous requests of TStorageFactoryFile in a background
+  // thread, using up to readAheadLimit bytes, if the storage cannot prefetch.
+  void		setReadAhead(bool enabled);
+  bool		readAhead(void) const;
+
+  void		setReadAheadLimit(IOSize bytes);
+  IOSize	readAheadLimit(void) const;
+
+  // Tunes the coalescing of the vectored reads of TStorageFactoryFile
+  // from the read times observed on each kind of storage.
+  void		setAdaptiveRepacking(bool enabled);
+  bool		adaptiveRepacking(void) const;
+
+  // Reads the local files opened for reading through a memory mapping.
+  void		setMapLocalFiles(bool enabled);
+  bool		mapLocalFiles(void) const;
+
+  // Keeps the blocks read from remote files in dir, shared by the jobs
+  // of the node, up to size bytes.  An empty dir disables the cache.
+  void		setBlockCache(const std::string &dir, IOOffset size, IOSize blockSize);
+  std::string	blockCacheDir(void) const;
+  IOOffset	blockCacheSize(void) const;
+  IOSize	blockCacheBlockSize(void) const;
+
   void		setTimeout(unsigned int timeout);
   unsigned int	timeout(void) const;
 
@@ -80,6 +104,13 @@ private:
   CacheHint	m_cacheHint;
   ReadHint	m_readHint;
   bool		m_accounting;
+  bool		m_readAhead;
+  IOSize	m_readAheadLimit;
+  bool		m_adaptiveRepacking;
+  bool		m_mapLocalFiles;
+  std::string	m_blockCacheDir;
+  IOOffset	m_blockCacheSize;
+  IOSize	m_blockCacheBlockSize;
   double	m_tempfree;
   std::string	m_temppath;
   std::string	m_tempdir;
@@ -4,6 +4,7 @@
 #include "Utilities/StorageFactory/interface/StorageMakerFactory.h"
 #include "Utilities/StorageFactory/interface/StorageFactory.h"
 #include "Utilities/StorageFactory/interface/File.h"
+#include "Utilities/StorageFactory/interface/MappedFile.h"
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -27,7 +28,17 @@ public:
 	mode |= IOFlags::OpenUnbuffered;
 
       auto file = std::make_unique<File> (path, mode);
-      return f->wrapNonLocalFile (std::move(file), proto, path, mode);
+      File *plain = file.get();
+      auto storage = f->wrapNonLocalFile (std::move(file), proto, path, mode);
+
+      // Map the files read where they are, not the ones copied locally.
+      if (storage.get() == plain && f->mapLocalFiles ()
+	  && ! (mode & IOFlags::OpenWrite))
+      {
+	storage.release();
+	return std::make_unique<MappedFile> (std::unique_ptr<File> (plain));
+      }
+      return storage;
     }
 
   bool check (const std::string &/*proto*/,
@@ -0,0 +1,431 @@
+#include "Utilities/StorageFactory/interface/BlockCacheFile.h"
+#include "Utilities/StorageFactory/interface/StorageAccount.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Remote reads of missing blocks are made in vectors of at most this size.
+static const IOSize MAX_MISS_READ = 64*1024*1024;
+
+// Temporary files older than this were left by a job which died while
+// writing a block.
+static const time_t STALE_TEMP_AGE = 3600;
+
+// Bytes added to the cache by this process since the last eviction.
+static std::atomic<IOOffset> s_storedSinceEviction{0};
+
+static void
+nowrite(const std::string &why)
+{
+  cms::Exception ex("BlockCacheFile");
+  ex << "Cannot change file but operation '" << why << "' was called";
+  ex.addContext("BlockCacheFile::" + why + "()");
+  throw ex;
+}
+
+static StorageAccount::Counter &
+blockCacheCounter(StorageAccount::Operation operation)
+{
+  static const auto token = StorageAccount::tokenForStorageClassName("block-cache");
+  return StorageAccount::counter(token, operation);
+}
+
+static bool
+readFully(int fd, char *into, IOSize n, IOOffset pos)
+{
+  while (n > 0)
+  {
+    ssize_t s = ::pread(fd, into, n, pos);
+    if (s == -1 && errno == EINTR)
+      continue;
+    if (s <= 0)
+      return false;
+    into += s;
+    pos += s;
+    n -= s;
+  }
+  return true;
+}
+
+static bool
+writeFully(int fd, const char *from, IOSize n)
+{
+  while (n > 0)
+  {
+    ssize_t s = ::write(fd, from, n);
+    if (s == -1 && errno == EINTR)
+      continue;
+    if (s <= 0)
+      return false;
+    from += s;
+    n -= s;
+  }
+  return true;
+}
+
+BlockCacheFile::BlockCacheFile(std::unique_ptr<Storage> base,
+			       const std::string &name,
+			       const std::string &cacheDir,
+			       IOOffset cacheSize,
+			       IOSize blockSize)
+  : storage_(std::move(base)),
+    cacheDir_(cacheDir),
+    key_(),
+    cacheSize_(cacheSize),
+    blockSize_(blockSize),
+    size_(storage_->size()),
+    position_(0),
+    openBlock_(-1),
+    openFd_(-1)
+{
+  // The blocks of one file are found again only for the same content and
+  // block size, the size of the file distinguishes two files which were
+  // given the same name at different sites.
+  std::string id = logicalName(name) + '\n' + std::to_string(size_) + '\n' + std::to_string(blockSize_);
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : id)
+    hash = (hash ^ c) * 1099511628211ULL;
+  char hex[17];
+  snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+  key_ = hex;
+
+  if (::mkdir(cacheDir_.c_str(), 0777) != 0 && errno != EEXIST)
+  {
+    edm::Exception ex(edm::errors::FileOpenError);
+    ex << "Cannot create block cache directory '" << cacheDir_ << "': "
+       << strerror(errno) << " (error " << errno << ")";
+    ex.addContext("BlockCacheFile::BlockCacheFile()");
+    throw ex;
+  }
+}
+
+BlockCacheFile::~BlockCacheFile(void)
+{
+  if (openFd_ != -1)
+    ::close(openFd_);
+}
+
+std::string
+BlockCacheFile::logicalName(const std::string &url)
+{
+  size_t pos = url.find("/store/");
+  return pos == std::string::npos ? url : url.substr(pos);
+}
+
+std::string
+BlockCacheFile::blockPath(IOOffset block) const
+{
+  return cacheDir_ + '/' + key_.substr(0, 2) + '/' + key_ + '.' + std::to_string(block);
+}
+
+IOSize
+BlockCacheFile::blockLength(IOOffset block) const
+{
+  return std::min<IOOffset>(blockSize_, size_ - block * static_cast<IOOffset>(blockSize_));
+}
+
+/** Copies n bytes from offset in the block into into if the block is in
+    the cache, returns false otherwise.  The file of the last block found
+    is kept open as consecutive reads usually fall in the same block. */
+bool
+BlockCacheFile::readCached(IOOffset block, char *into, IOSize offset, IOSize n)
+{
+  if (block != openBlock_)
+  {
+    if (openFd_ != -1)
+      ::close(openFd_);
+    openBlock_ = -1;
+    openFd_ = ::open(blockPath(block).c_str(), O_RDONLY);
+    if (openFd_ == -1)
+      return false;
+
+    struct stat st;
+    if (fstat(openFd_, &st) != 0 || st.st_size != static_cast<off_t>(blockLength(block)))
+    {
+      ::close(openFd_);
+      openFd_ = -1;
+      return false;
+    }
+    openBlock_ = block;
+    // Most recently used, fails harmlessly if another user wrote the block.
+    futimens(openFd_, nullptr);
+  }
+
+  return readFully(openFd_, into, n, offset);
+}
+
+/** Adds a block to the cache.  The cache is only an optimisation, so any
+    failure to write the block is ignored. */
+void
+BlockCacheFile::store(IOOffset block, const char *data, IOSize n)
+{
+  std::string path = blockPath(block);
+  ::mkdir(path.substr(0, path.rfind('/')).c_str(), 0777);
+
+  std::string pattern = path + ".tmp-XXXXXX";
+  std::vector<char> temp(pattern.c_str(), pattern.c_str() + pattern.size() + 1);
+  int fd = mkstemp(&temp[0]);
+  if (fd == -1)
+    return;
+
+  bool ok = fchmod(fd, 0644) == 0 && writeFully(fd, data, n);
+  ok = (::close(fd) == 0) && ok;
+  // Another job may have stored the same block meanwhile, replacing it
+  // by an identical one is harmless.
+  if (! ok || ::rename(&temp[0], path.c_str()) != 0)
+  {
+    ::unlink(&temp[0]);
+    return;
+  }
+
+  IOOffset stored = s_storedSinceEviction += n;
+  if (stored > cacheSize_ / 16)
+  {
+    s_storedSinceEviction = 0;
+    evict(cacheDir_, cacheSize_);
+  }
+}
+
+void
+BlockCacheFile::evict(const std::string &cacheDir, IOOffset cacheSize)
+{
+  int lock = ::open((cacheDir + "/.lock").c_str(), O_RDWR | O_CREAT, 0666);
+  if (lock == -1)
+    return;
+  if (flock(lock, LOCK_EX | LOCK_NB) != 0)
+  {
+    ::close(lock);
+    return;
+  }
+
+  struct Entry { time_t mtime; IOOffset size; std::string path; };
+  std::vector<Entry> entries;
+  IOOffset total = 0;
+  time_t now = time(nullptr);
+
+  if (DIR *top = opendir(cacheDir.c_str()))
+  {
+    while (dirent *d = readdir(top))
+    {
+      if (d->d_name[0] == '.')
+	continue;
+      std::string subdir = cacheDir + '/' + d->d_name;
+      DIR *sub = opendir(subdir.c_str());
+      if (! sub)
+	continue;
+      while (dirent *f = readdir(sub))
+      {
+	if (f->d_name[0] == '.')
+	  continue;
+	std::string path = subdir + '/' + f->d_name;
+	struct stat st;
+	if (lstat(path.c_str(), &st) != 0 || ! S_ISREG(st.st_mode))
+	  continue;
+	if (strstr(f->d_name, ".tmp-"))
+	{
+	  if (now - st.st_mtime > STALE_TEMP_AGE)
+	    ::unlink(path.c_str());
+	  continue;
+	}
+	entries.push_back(Entry{st.st_mtime, st.st_size, path});
+	total += st.st_size;
+      }
+      closedir(sub);
+    }
+    closedir(top);
+  }
+
+  if (total > cacheSize)
+  {
+    std::sort(entries.begin(), entries.end(),
+	      [](const Entry &a, const Entry &b) { return a.mtime < b.mtime; });
+    IOOffset target = cacheSize / 10 * 9;
+    for (auto const &entry : entries)
+    {
+      if (total <= target)
+	break;
+      StorageAccount::Stamp stats(blockCacheCounter(StorageAccount::Operation::blockCacheEvict));
+      if (::unlink(entry.path.c_str()) == 0)
+	stats.tick(entry.size);
+      total -= entry.size;
+    }
+  }
+
+  flock(lock, LOCK_UN);
+  ::close(lock);
+}
+
+IOSize
+BlockCacheFile::read(void *into, IOSize n)
+{
+  IOSize result = read(into, n, position_);
+  position_ += result;
+  return result;
+}
+
+IOSize
+BlockCacheFile::read(void *into, IOSize n, IOOffset pos)
+{
+  IOPosBuffer buffer(pos, into, n);
+  return readv(&buffer, 1);
+}
+
+IOSize
+BlockCacheFile::readv(IOBuffer *into, IOSize n)
+{
+  std::vector<IOPosBuffer> buffers;
+  buffers.reserve(n);
+  IOOffset pos = position_;
+  for (IOSize i = 0; i < n; ++i)
+  {
+    buffers.emplace_back(pos, into[i].data(), into[i].size());
+    pos += into[i].size();
+  }
+  IOSize result = readv(buffers.empty() ? nullptr : &buffers[0], n);
+  position_ += result;
+  return result;
+}
+
+/** Copies the cached parts of the ranges and reads the missing blocks
+    whole from the remote file, in as few vector reads as possible, before
+    adding them to the cache. */
+IOSize
+BlockCacheFile::readv(IOPosBuffer *into, IOSize n)
+{
+  struct Piece { IOOffset block; char *into; IOSize offset; IOSize size; };
+  std::vector<Piece> misses;
+  IOSize total = 0;
+
+  for (IOSize i = 0; i < n; ++i)
+  {
+    IOOffset pos = into[i].offset();
+    if (pos >= size_)
+      continue;
+    IOSize len = std::min(static_cast<IOOffset>(into[i].size()), size_ - pos);
+    char *data = static_cast<char *>(into[i].data());
+    total += len;
+    while (len > 0)
+    {
+      IOOffset block = pos / blockSize_;
+      IOSize offset = pos - block * blockSize_;
+      IOSize piece = std::min(len, blockLength(block) - offset);
+      StorageAccount::Stamp stats(blockCacheCounter(StorageAccount::Operation::blockCacheHit));
+      if (readCached(block, data, offset, piece))
+	stats.tick(piece);
+      else
+	misses.push_back(Piece{block, data, offset, piece});
+      pos += piece;
+      data += piece;
+      len -= piece;
+    }
+  }
+
+  std::vector<IOOffset> blocks;
+  blocks.reserve(misses.size());
+  for (auto const &miss : misses)
+    blocks.push_back(miss.block);
+  std::sort(blocks.begin(), blocks.end());
+  blocks.erase(std::unique(blocks.begin(), blocks.end()), blocks.end());
+
+  IOSize perRead = std::max(static_cast<IOSize>(1), MAX_MISS_READ / blockSize_);
+  for (size_t first = 0; first < blocks.size(); first += perRead)
+  {
+    size_t last = std::min(blocks.size(), first + perRead);
+    buffer_.resize((last - first) * blockSize_);
+    std::vector<IOPosBuffer> iov;
+    IOSize expected = 0;
+    for (size_t b = first; b < last; ++b)
+    {
+      iov.emplace_back(blocks[b] * blockSize_, &buffer_[(b - first) * blockSize_], blockLength(blocks[b]));
+      expected += blockLength(blocks[b]);
+    }
+
+    StorageAccount::Stamp stats(blockCacheCounter(StorageAccount::Operation::blockCacheMiss));
+    IOSize got = storage_->readv(&iov[0], iov.size());
+    if (got != expected)
+    {
+      edm::Exception ex(edm::errors::FileReadError);
+      ex << "Unable to read " << iov.size() << " blocks of " << expected
+	 << " bytes in total: got only " << got << " bytes back";
+      ex.addContext("BlockCacheFile::readv()");
+      throw ex;
+    }
+    stats.tick(got, iov.size());
+
+    for (size_t b = first; b < last; ++b)
+    {
+      const char *data = &buffer_[(b - first) * blockSize_];
+      store(blocks[b], data, blockLength(blocks[b]));
+      for (auto const &miss : misses)
+	if (miss.block == blocks[b])
+	  memcpy(miss.into, data + miss.offset, miss.size);
+    }
+  }
+
+  return total;
+}
+
+IOSize
+BlockCacheFile::write(const void */*from*/, IOSize)
+{ nowrite("write"); return 0; }
+
+IOSize
+BlockCacheFile::write(const void */*from*/, IOSize, IOOffset /*pos*/)
+{ nowrite("write"); return 0; }
+
+IOSize
+BlockCacheFile::writev(const IOBuffer */*from*/, IOSize)
+{ nowrite("writev"); return 0; }
+
+IOSize
+BlockCacheFile::writev(const IOPosBuffer */*from*/, IOSize)
+{ nowrite("writev"); return 0; }
+
+IOOffset
+BlockCacheFile::size(void) const
+{ return size_; }
+
+IOOffset
+BlockCacheFile::position(void) const
+{ return position_; }
+
+IOOffset
+BlockCacheFile::position(IOOffset offset, Relative whence)
+{
+  if (whence == CURRENT)
+    offset += position_;
+  else if (whence == END)
+    offset += size_;
+  position_ = offset;
+  return position_;
+}
+
+void
+BlockCacheFile::resize(IOOffset /*size*/)
+{ nowrite("resize"); }
+
+void
+BlockCacheFile::flush(void)
+{ nowrite("flush"); }
+
+void
+BlockCacheFile::close(void)
+{
+  if (openFd_ != -1)
+  {
+    ::close(openFd_);
+    openFd_ = -1;
+    openBlock_ = -1;
+  }
+  storage_->close();
+}
@@ -0,0 +1,186 @@
+#include "Utilities/StorageFactory/interface/MappedFile.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static void
+nowrite(const std::string &why)
+{
+  cms::Exception ex("MappedFile");
+  ex << "Cannot change file but operation '" << why << "' was called";
+  ex.addContext("MappedFile::" + why + "()");
+  throw ex;
+}
+
+MappedFile::MappedFile(std::unique_ptr<File> file)
+  : file_(std::move(file)),
+    size_(file_->size()),
+    position_(0),
+    data_(nullptr),
+    random_(false)
+{
+  if (size_ > 0)
+  {
+    void *map = mmap(nullptr, size_, PROT_READ, MAP_SHARED, file_->fd(), 0);
+    if (map == MAP_FAILED)
+    {
+      edm::Exception ex(edm::errors::FileOpenError);
+      ex << "Unable to map " << size_ << " bytes of the file: "
+	 << strerror(errno) << " (error " << errno << ")";
+      ex.addContext("MappedFile::MappedFile()");
+      throw ex;
+    }
+    data_ = static_cast<char *>(map);
+  }
+}
+
+MappedFile::~MappedFile(void)
+{
+  unmap();
+}
+
+void
+MappedFile::unmap(void)
+{
+  if (data_)
+  {
+    munmap(data_, size_);
+    data_ = nullptr;
+  }
+}
+
+bool
+MappedFile::prefetch(const IOPosBuffer *what, IOSize n)
+{
+  if (! data_)
+    return false;
+
+  // Leave the probe of ROOT alone: it is not a read list.
+  if (n == 1 && what[0].offset() == 0 && what[0].size() == PREFETCH_PROBE_LENGTH)
+    return true;
+
+  if (! random_)
+  {
+    madvise(data_, size_, MADV_RANDOM);
+    random_ = true;
+  }
+
+  static const IOOffset page = sysconf(_SC_PAGESIZE);
+  for (IOSize i = 0; i < n; ++i)
+  {
+    IOOffset start = std::min(what[i].offset(), size_);
+    IOOffset end = std::min(start + static_cast<IOOffset>(what[i].size()), size_);
+    start -= start % page;
+    if (start < end)
+      madvise(data_ + start, end - start, MADV_WILLNEED);
+  }
+  return true;
+}
+
+IOSize
+MappedFile::read(void *into, IOSize n)
+{
+  IOSize got = read(into, n, position_);
+  position_ += got;
+  return got;
+}
+
+IOSize
+MappedFile::read(void *into, IOSize n, IOOffset pos)
+{
+  if (pos < 0)
+  {
+    edm::Exception ex(edm::errors::FileReadError);
+    ex << "MappedFile::read(into, " << n << ", " << pos
+       << ") called with a negative offset";
+    ex.addContext("Calling MappedFile::read()");
+    throw ex;
+  }
+
+  if (pos >= size_ || ! data_)
+    return 0;
+
+  n = std::min(n, static_cast<IOSize>(size_ - pos));
+  memcpy(into, data_ + pos, n);
+  return n;
+}
+
+IOSize
+MappedFile::readv(IOBuffer *into, IOSize n)
+{
+  IOSize total = 0;
+  for (IOSize i = 0; i < n; ++i)
+  {
+    IOSize got = read(into[i].data(), into[i].size());
+    total += got;
+    if (got < into[i].size())
+      break;
+  }
+  return total;
+}
+
+IOSize
+MappedFile::readv(IOPosBuffer *into, IOSize n)
+{
+  IOSize total = 0;
+  for (IOSize i = 0; i < n; ++i)
+    total += read(into[i].data(), into[i].size(), into[i].offset());
+  return total;
+}
+
+IOSize
+MappedFile::write(const void */*from*/, IOSize)
+{ nowrite("write"); return 0; }
+
+IOSize
+MappedFile::write(const void */*from*/, IOSize, IOOffset /*pos*/)
+{ nowrite("write"); return 0; }
+
+IOSize
+MappedFile::writev(const IOBuffer */*from*/, IOSize)
+{ nowrite("writev"); return 0; }
+
+IOSize
+MappedFile::writev(const IOPosBuffer */*from*/, IOSize)
+{ nowrite("writev"); return 0; }
+
+IOOffset
+MappedFile::size(void) const
+{ return size_; }
+
+bool
+MappedFile::memoryMapped(void) const
+{ return true; }
+
+IOOffset
+MappedFile::position(void) const
+{ return position_; }
+
+IOOffset
+MappedFile::position(IOOffset offset, Relative whence)
+{
+  if (whence == CURRENT)
+    offset += position_;
+  else if (whence == END)
+    offset += size_;
+  position_ = offset;
+  return position_;
+}
+
+void
+MappedFile::resize(IOOffset /*size*/)
+{ nowrite("resize"); }
+
+void
+MappedFile::flush(void)
+{ nowrite("flush"); }
+
+void
+MappedFile::close(void)
+{
+  unmap();
+  file_->close();
+}
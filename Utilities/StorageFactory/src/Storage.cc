@@ -119,6 +119,10 @@ bool
 Storage::prefetch (const IOPosBuffer * /* what */, IOSize /* n */)
 { return false; }
 
+bool
+Storage::memoryMapped (void) const
+{ return false; }
+
 //////////////////////////////////////////////////////////////////////
 void
 Storage::flush (void)
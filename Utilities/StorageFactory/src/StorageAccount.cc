@@ -7,6 +7,9 @@
 
 namespace {
   char const * const kOperationNames[] = {
+    "blockCacheEvict",
+    "blockCacheHit",
+    "blockCacheMiss",
     "check",
     "close",
     "construct",
@@ -17,6 +20,9 @@ namespace {
     "prefetch",
     "read",
     "readActual",
+    "readAhead",
+    "readAheadHidden",
+    "readAheadWait",
     "readAsync",
     "readPrefetchToCache",
     "readViaCache",
@@ -135,21 +141,27 @@ StorageAccount::Stamp::Stamp (Counter &counter)
   m_counter.attempts++;
 }
 
-void
+uint64_t
 StorageAccount::Stamp::tick (uint64_t amount, int64_t count) const
 {
   std::chrono::nanoseconds elapsed_ns = std::chrono::high_resolution_clock::now() - m_start;
-  uint64_t elapsed = elapsed_ns.count();
-  m_counter.successes++;
-
-  m_counter.vector_count += count;
-  m_counter.vector_square += count*count;
-  m_counter.amount += amount;
-  Counter::addTo(m_counter.amount_square, amount*amount);
-
-  Counter::addTo(m_counter.timeTotal, elapsed);
-  if (elapsed < m_counter.timeMin || m_counter.successes == 1)
-    m_counter.timeMin = elapsed;
-  if (elapsed > m_counter.timeMax)
-    m_counter.timeMax = elapsed;
+  m_counter.record(amount, count, elapsed_ns.count());
+  return elapsed_ns.count();
+}
+
+void
+StorageAccount::Counter::record (uint64_t amount, int64_t count, uint64_t elapsed)
+{
+  successes++;
+
+  vector_count += count;
+  vector_square += count*count;
+  this->amount += amount;
+  addTo(amount_square, amount*amount);
+
+  addTo(timeTotal, elapsed);
+  if (elapsed < timeMin || successes == 1)
+    timeMin = elapsed;
+  if (elapsed > timeMax)
+    timeMax = elapsed;
 }
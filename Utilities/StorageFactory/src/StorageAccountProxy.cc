@@ -141,3 +141,7 @@ StorageAccountProxy::prefetch (const IOPosBuffer *what, IOSize n)
   }
   return value;
 }
+
+bool
+StorageAccountProxy::memoryMapped (void) const
+{ return m_baseStorage->memoryMapped(); }
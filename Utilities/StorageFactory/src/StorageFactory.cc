@@ -3,6 +3,7 @@
 #include "Utilities/StorageFactory/interface/StorageAccount.h"
 #include "Utilities/StorageFactory/interface/StorageAccountProxy.h"
 #include "Utilities/StorageFactory/interface/LocalCacheFile.h"
+#include "Utilities/StorageFactory/interface/BlockCacheFile.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/PluginManager/interface/PluginManager.h"
 #include "FWCore/PluginManager/interface/standard.h"
@@ -14,6 +15,12 @@ StorageFactory::StorageFactory (void)
   : m_cacheHint(CACHE_HINT_AUTO_DETECT),
     m_readHint(READ_HINT_AUTO),
     m_accounting (false),
+    m_readAhead (false),
+    m_readAheadLimit (256*1024*1024),
+    m_adaptiveRepacking (false),
+    m_mapLocalFiles (false),
+    m_blockCacheSize (0),
+    m_blockCacheBlockSize (1024*1024),
     m_tempfree (4.), // GB
     m_temppath (".:$TMPDIR"),
     m_timeout(0U),
@@ -62,6 +69,58 @@ StorageFactory::ReadHint
 StorageFactory::readHint(void) const
 { return m_readHint; }
 
+void
+StorageFactory::setReadAhead(bool enabled)
+{ m_readAhead = enabled; }
+
+bool
+StorageFactory::readAhead(void) const
+{ return m_readAhead; }
+
+void
+StorageFactory::setReadAheadLimit(IOSize bytes)
+{ m_readAheadLimit = bytes; }
+
+IOSize
+StorageFactory::readAheadLimit(void) const
+{ return m_readAheadLimit; }
+
+void
+StorageFactory::setAdaptiveRepacking(bool enabled)
+{ m_adaptiveRepacking = enabled; }
+
+bool
+StorageFactory::adaptiveRepacking(void) const
+{ return m_adaptiveRepacking; }
+
+void
+StorageFactory::setMapLocalFiles(bool enabled)
+{ m_mapLocalFiles = enabled; }
+
+bool
+StorageFactory::mapLocalFiles(void) const
+{ return m_mapLocalFiles; }
+
+void
+StorageFactory::setBlockCache(const std::string &dir, IOOffset size, IOSize blockSize)
+{
+  m_blockCacheDir = dir;
+  m_blockCacheSize = size;
+  m_blockCacheBlockSize = blockSize;
+}
+
+std::string
+StorageFactory::blockCacheDir(void) const
+{ return m_blockCacheDir; }
+
+IOOffset
+StorageFactory::blockCacheSize(void) const
+{ return m_blockCacheSize; }
+
+IOSize
+StorageFactory::blockCacheBlockSize(void) const
+{ return m_blockCacheBlockSize; }
+
 void
 StorageFactory::setTimeout(unsigned int timeout)
 { m_timeout = timeout; }
@@ -186,6 +245,10 @@ StorageFactory::open (const std::string &url, int mode /* = IOFlags::OpenRead */
       {
 	if (dynamic_cast<LocalCacheFile *>(storage.get()))
 	  protocol = "local-cache";
+	else if (! m_blockCacheDir.empty() && m_blockCacheSize > 0
+		 && protocol != "file" && ! (mode & IOFlags::OpenWrite))
+	  storage = std::make_unique<BlockCacheFile>(std::move(storage), url, m_blockCacheDir,
+						     m_blockCacheSize, m_blockCacheBlockSize);
 
 	if (m_accounting)
     ret = std::make_unique<StorageAccountProxy>(protocol, std::move(storage));
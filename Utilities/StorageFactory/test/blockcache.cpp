@@ -0,0 +1,159 @@
+#include "Utilities/StorageFactory/test/Test.h"
+#include "Utilities/StorageFactory/interface/BlockCacheFile.h"
+#include "Utilities/StorageFactory/interface/File.h"
+#include "Utilities/StorageFactory/interface/IOPosBuffer.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// A local file stands in for the remote storage.
+static const IOSize BLOCK_SIZE = 64*1024;
+static const IOSize FILE_SIZE = 40*BLOCK_SIZE + 1234;
+
+static StorageAccount::Counter &
+counter(StorageAccount::Operation operation)
+{
+  return StorageAccount::counter(StorageAccount::tokenForStorageClassName("block-cache"), operation);
+}
+
+static IOOffset
+cachedBytes(const std::string &dir)
+{
+  IOOffset total = 0;
+  if (DIR *top = opendir(dir.c_str()))
+  {
+    while (dirent *d = readdir(top))
+    {
+      if (d->d_name[0] == '.')
+	continue;
+      std::string subdir = dir + '/' + d->d_name;
+      if (DIR *sub = opendir(subdir.c_str()))
+      {
+	while (dirent *f = readdir(sub))
+	{
+	  struct stat st;
+	  if (f->d_name[0] != '.' && stat((subdir + '/' + f->d_name).c_str(), &st) == 0)
+	    total += st.st_size;
+	}
+	closedir(sub);
+      }
+    }
+    closedir(top);
+  }
+  return total;
+}
+
+static void
+check(bool condition, const char *what)
+{
+  if (! condition)
+    throw cms::Exception("BlockCacheTest") << "Check failed: " << what;
+}
+
+static void
+checkRead(Storage &s, IOOffset pos, IOSize n, const std::vector<char> &data)
+{
+  std::vector<char> buf(n);
+  IOSize got = s.read(&buf[0], n, pos);
+  IOSize expected = std::min<IOOffset>(n, data.size() - pos);
+  check(got == expected, "read size");
+  check(memcmp(&buf[0], &data[pos], got) == 0, "read data");
+}
+
+int main (int, char **) try
+{
+  initTest();
+
+  char dirPattern[] = "blockcache-test-XXXXXX";
+  check(mkdtemp(dirPattern) != nullptr, "mkdtemp");
+  std::string base = dirPattern;
+  std::string remote = base + "/remote.root";
+  std::string url = "root://some.site//store/data/remote.root";
+  std::string cacheDir = base + "/cache";
+
+  std::vector<char> data(FILE_SIZE);
+  for (IOSize i = 0; i < FILE_SIZE; ++i)
+    data[i] = static_cast<char>(i * 2654435761u >> 13);
+  {
+    File out(remote, IOFlags::OpenWrite | IOFlags::OpenCreate | IOFlags::OpenTruncate);
+    out.write(&data[0], data.size());
+    out.close();
+  }
+
+  auto &hits = counter(StorageAccount::Operation::blockCacheHit);
+  auto &misses = counter(StorageAccount::Operation::blockCacheMiss);
+  auto &evictions = counter(StorageAccount::Operation::blockCacheEvict);
+
+  // First pass fills the cache, across block boundaries and past the end.
+  {
+    BlockCacheFile s(std::make_unique<File>(remote), url, cacheDir, 1024*1024*1024, BLOCK_SIZE);
+    check(s.size() == static_cast<IOOffset>(FILE_SIZE), "size");
+    checkRead(s, 0, 100, data);
+    checkRead(s, BLOCK_SIZE - 10, 3*BLOCK_SIZE, data);
+    checkRead(s, FILE_SIZE - 500, 1000, data);
+
+    std::vector<char> a(5000), b(BLOCK_SIZE);
+    IOPosBuffer iov[2] = { IOPosBuffer(7*BLOCK_SIZE + 3, &a[0], a.size()),
+			   IOPosBuffer(20*BLOCK_SIZE + 100, &b[0], b.size()) };
+    check(s.readv(iov, 2) == a.size() + b.size(), "readv size");
+    check(memcmp(&a[0], &data[7*BLOCK_SIZE + 3], a.size()) == 0, "readv data");
+    check(memcmp(&b[0], &data[20*BLOCK_SIZE + 100], b.size()) == 0, "readv data");
+    s.close();
+  }
+  check(misses.successes > 0, "misses accounted");
+
+  // A second instance, as another job would, finds all the blocks.
+  uint64_t missesBefore = misses.successes;
+  uint64_t hitsBefore = hits.successes;
+  {
+    BlockCacheFile s(std::make_unique<File>(remote), url, cacheDir, 1024*1024*1024, BLOCK_SIZE);
+    checkRead(s, BLOCK_SIZE, 2*BLOCK_SIZE, data);
+    checkRead(s, 20*BLOCK_SIZE, 1000, data);
+  }
+  check(misses.successes == missesBefore, "second pass served from cache");
+  check(hits.successes > hitsBefore, "hits accounted");
+
+  // Concurrent readers of the whole file each fill and use the cache.
+  std::string concurrentDir = base + "/concurrent";
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([&, t]() {
+      BlockCacheFile s(std::make_unique<File>(remote), url, concurrentDir, 1024*1024*1024, BLOCK_SIZE);
+      for (IOOffset pos = (t * 7919) % BLOCK_SIZE; pos < static_cast<IOOffset>(FILE_SIZE); pos += 3*BLOCK_SIZE/2)
+        checkRead(s, pos, BLOCK_SIZE, data);
+    });
+  for (auto &t : threads)
+    t.join();
+  check(cachedBytes(concurrentDir) == static_cast<IOOffset>(FILE_SIZE), "concurrent cache content");
+
+  // A small cache is kept under its limit.
+  std::string smallDir = base + "/small";
+  IOOffset smallSize = 8*BLOCK_SIZE;
+  {
+    BlockCacheFile s(std::make_unique<File>(remote), url, smallDir, smallSize, BLOCK_SIZE);
+    for (IOOffset pos = 0; pos < static_cast<IOOffset>(FILE_SIZE); pos += BLOCK_SIZE)
+      checkRead(s, pos, BLOCK_SIZE, data);
+  }
+  BlockCacheFile::evict(smallDir, smallSize);
+  check(cachedBytes(smallDir) <= smallSize, "eviction");
+  check(evictions.successes > 0, "evictions accounted");
+
+  std::cout << "stats:\n" << StorageAccount::summaryText () << std::endl;
+  std::string cleanup = "rm -rf " + base;
+  if (system(cleanup.c_str()) != 0)
+    std::cerr << "Cannot remove " << base << std::endl;
+  return EXIT_SUCCESS;
+} catch(cms::Exception const& e) {
+  std::cerr << e.explainSelf() << std::endl;
+  return EXIT_FAILURE;
+} catch(std::exception const& e) {
+  std::cerr << e.what() << std::endl;
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,166 @@
+/** Compares the reads of a local file through File (pread) and MappedFile.
+
+    A file is written in the temporary directory, then read as a TTreeCache
+    reads a ROOT file: in successive windows of the cache size, a sorted
+    list of baskets of a few kB to a few hundred kB, part of the branches
+    only, first given to prefetch() then read.  Each storage reads the
+    file with a cold page cache, the pages of the file having been dropped
+    before, and with a warm page cache.  The data read is checked.
+
+    Usage: test_StorageFactory_MappedFile [file size in MB] [directory]
+*/
+
+#include "Utilities/StorageFactory/interface/MappedFile.h"
+#include "Utilities/StorageFactory/interface/File.h"
+#include "Utilities/StorageFactory/interface/IOPosBuffer.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+static const IOSize CACHE_SIZE = 20*1024*1024;
+
+static char
+fileByte(IOOffset offset)
+{ return static_cast<char>((offset * 2654435761u) >> 11); }
+
+// The baskets read by the TTreeCache, one list per cache window.
+static std::vector<std::vector<IOPosBuffer>>
+readLists(IOOffset fileSize)
+{
+  std::mt19937 engine(12345);
+  std::lognormal_distribution<double> basketSize(10., 1.);
+  std::bernoulli_distribution branchRead(0.3);
+
+  std::vector<std::vector<IOPosBuffer>> lists(1);
+  IOOffset windowStart = 0;
+  for (IOOffset offset = 0; offset < fileSize; )
+  {
+    IOSize size = std::min<IOOffset>(std::min(std::max(basketSize(engine), 100.), 4.*1024*1024),
+				     fileSize - offset);
+    if (offset + size > windowStart + static_cast<IOOffset>(CACHE_SIZE))
+    {
+      lists.emplace_back();
+      windowStart = offset;
+    }
+    if (branchRead(engine))
+      lists.back().push_back(IOPosBuffer(offset, static_cast<void *>(nullptr), size));
+    offset += size;
+  }
+  return lists;
+}
+
+static double
+readAll(Storage &storage, std::vector<std::vector<IOPosBuffer>> lists, bool &ok)
+{
+  std::vector<char> buffer(CACHE_SIZE);
+  auto start = std::chrono::steady_clock::now();
+  for (auto &list : lists)
+  {
+    storage.prefetch(list.data(), list.size());
+    char *into = &buffer[0];
+    for (auto &iop : list)
+    {
+      iop.set_data(into);
+      into += iop.size();
+    }
+    storage.readv(list.data(), list.size());
+
+    for (auto const &iop : list)
+      for (IOSize i = 0; i < iop.size(); i += 997)
+	if (static_cast<char *>(iop.data())[i] != fileByte(iop.offset() + i))
+	  ok = false;
+  }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void
+dropPages(const std::string &path)
+{
+  File file(path);
+  posix_fadvise(file.fd(), 0, 0, POSIX_FADV_DONTNEED);
+  file.close();
+}
+
+int main(int argc, char **argv) try
+{
+  IOOffset fileSize = static_cast<IOOffset>(argc > 1 ? std::atoi(argv[1]) : 256) * 1024 * 1024;
+  std::string dir = argc > 2 ? argv[2] : (getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp");
+
+  std::string pattern = dir + "/mappedfile-XXXXXX";
+  std::vector<char> temp(pattern.c_str(), pattern.c_str() + pattern.size() + 1);
+  int fd = mkstemp(&temp[0]);
+  if (fd == -1)
+    throw cms::Exception("MappedFileBenchmark") << "Cannot create a file in " << dir;
+  std::string path(&temp[0]);
+  {
+    File file(fd);
+    std::vector<char> chunk(1024*1024);
+    for (IOOffset offset = 0; offset < fileSize; offset += chunk.size())
+    {
+      for (IOSize i = 0; i < chunk.size(); ++i)
+	chunk[i] = fileByte(offset + i);
+      file.write(&chunk[0], std::min<IOOffset>(chunk.size(), fileSize - offset));
+    }
+    fdatasync(fd);
+    file.close();
+  }
+
+  auto lists = readLists(fileSize);
+  IOOffset bytes = 0;
+  IOSize baskets = 0;
+  for (auto const &list : lists)
+    for (auto const &iop : list)
+    {
+      bytes += iop.size();
+      ++baskets;
+    }
+  std::cout << "Reading " << baskets << " baskets, " << bytes / (1024*1024) << " MB of a "
+	    << fileSize / (1024*1024) << " MB file in " << lists.size() << " windows" << std::endl;
+
+  bool ok = true;
+  for (bool cold : {true, false})
+  {
+    if (! cold)
+    {
+      File warm(path);
+      readAll(warm, lists, ok);
+    }
+
+    if (cold) dropPages(path);
+    File file(path);
+    double fileTime = readAll(file, lists, ok);
+    file.close();
+
+    if (cold) dropPages(path);
+    MappedFile mapped(std::make_unique<File>(path));
+    double mappedTime = readAll(mapped, lists, ok);
+    mapped.close();
+
+    std::cout << (cold ? "cold" : "warm") << " page cache:" << std::fixed << std::setprecision(3)
+	      << " File " << fileTime << " s (" << std::setprecision(0) << bytes / fileTime / (1024*1024) << " MB/s),"
+	      << std::setprecision(3) << " MappedFile " << mappedTime << " s ("
+	      << std::setprecision(0) << bytes / mappedTime / (1024*1024) << " MB/s)" << std::endl;
+  }
+
+  unlink(path.c_str());
+  if (! ok)
+  {
+    std::cerr << "The data read differs from the data written" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+catch (cms::Exception &e)
+{
+  std::cerr << e.explainSelf() << std::endl;
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,58 @@
+
+#include <exception>
+
+#include "XrdHedgedRead.h"
+
+using namespace XrdAdaptor;
+
+HedgedRead::HedgedRead(Issuer issue, std::chrono::nanoseconds delay)
+  : m_issue(std::move(issue)),
+    m_deadline(std::chrono::steady_clock::now() + delay),
+    m_hedge(delay.count() > 0),
+    m_hedged(false),
+    m_winner(0)
+{
+    m_futures[0] = m_issue(0);
+}
+
+IOSize
+HedgedRead::get()
+{
+    if (m_hedge && m_futures[0].wait_until(m_deadline) == std::future_status::timeout)
+    {
+        try
+        {
+            m_futures[1] = m_issue(1);
+            m_hedged = true;
+        }
+        catch (...)
+        {
+            // The second source is not usable; keep waiting for the first.
+        }
+    }
+    m_winner = 0;
+    if (!m_hedged)
+    {
+        return m_futures[0].get();
+    }
+
+    std::exception_ptr firstFailure;
+    try
+    {
+        return m_futures[0].get();
+    }
+    catch (...)
+    {
+        firstFailure = std::current_exception();
+    }
+    try
+    {
+        IOSize result = m_futures[1].get();
+        m_winner = 1;
+        return result;
+    }
+    catch (...)
+    {
+    }
+    std::rethrow_exception(firstFailure);
+}
@@ -0,0 +1,59 @@
+#ifndef Utilities_XrdAdaptor_XrdHedgedRead_h
+#define Utilities_XrdAdaptor_XrdHedgedRead_h
+
+#include <chrono>
+#include <functional>
+#include <future>
+
+#include "Utilities/StorageFactory/interface/IOTypes.h"
+
+namespace XrdAdaptor {
+
+/**
+ * A read which is duplicated on a second source if the first one is late.
+ *
+ * The read is issued on the first source at construction.  If it has not
+ * completed once the delay expired, the same read is issued on the second
+ * source ("hedged").  The first source reads into the buffers of the
+ * caller and cannot be abandoned, so get() always waits for it; the
+ * duplicate gives the result when the first read fails.  The duplicate is
+ * not cancelled: the issuer must make sure it does not write into the
+ * buffers of the caller, which may reuse them as soon as get() returns.
+ *
+ * This class knows nothing of XrdCl; the reads are issued through a
+ * function, which makes it testable with mock sources.
+ */
+class HedgedRead {
+
+public:
+    // Issues the read on the first (0) or second (1) source.
+    using Issuer = std::function<std::future<IOSize>(unsigned source)>;
+
+    // A zero delay never hedges.
+    HedgedRead(Issuer issue, std::chrono::nanoseconds delay);
+
+    HedgedRead(const HedgedRead&) = delete;
+    HedgedRead &operator=(const HedgedRead&) = delete;
+
+    /**
+     * Waits for the read and returns its size.  If both reads fail, the
+     * exception of the first source is rethrown.
+     */
+    IOSize get();
+
+    // Source of the result; valid after get().
+    unsigned winner() const {return m_winner;}
+    bool hedged() const {return m_hedged;}
+
+private:
+    Issuer m_issue;
+    std::chrono::steady_clock::time_point m_deadline;
+    bool m_hedge;
+    bool m_hedged;
+    unsigned m_winner;
+    std::future<IOSize> m_futures[2];
+};
+
+}
+
+#endif
@@ -6,6 +6,7 @@
 
 #include "XrdRequest.h"
 #include "XrdRequestManager.h"
+#include "XrdStatistics.h"
 
 using namespace XrdAdaptor;
 
@@ -20,6 +21,16 @@ static std::atomic<int> g_fakeError {0};
 
 XrdAdaptor::ClientRequest::~ClientRequest() {}
 
+void
+XrdAdaptor::ClientRequest::recordSuccess(IOSize size)
+{
+    std::shared_ptr<Source> source = getCurrentSource();
+    if (source)
+    {
+        source->sourceStats()->finishRead(size, std::chrono::steady_clock::now() - m_start);
+    }
+}
+
 void 
 XrdAdaptor::ClientRequest::HandleResponse(XrdCl::XRootDStatus *stat, XrdCl::AnyObject *resp)
 {
@@ -49,6 +60,7 @@ XrdAdaptor::ClientRequest::HandleResponse(XrdCl::XRootDStatus *stat, XrdCl::AnyO
             if( read_info->length == 0) {edm::LogWarning("XrdAdaptorInternal") << "XrdAdaptor::ClientRequest::HandleResponse: While reading from\n "
               << m_manager.getFilename() << "\n  received a read_info->length = 0 and read_info->offset = "<<read_info->offset;
             }
+            recordSuccess(read_info->length);
             m_promise.set_value(read_info->length);
         }
         else
@@ -66,6 +78,7 @@ XrdAdaptor::ClientRequest::HandleResponse(XrdCl::XRootDStatus *stat, XrdCl::AnyO
               << m_manager.getFilename() << "\n  received a read_info->GetSize() = 0";
             }
 
+            recordSuccess(read_info->GetSize());
             m_promise.set_value(read_info->GetSize());
         }
     }
@@ -1,6 +1,7 @@
 #ifndef Utilities_XrdAdaptor_XrdRequest_h
 #define Utilities_XrdAdaptor_XrdRequest_h
 
+#include <chrono>
 #include <future>
 #include <vector>
 
@@ -58,6 +59,15 @@ public:
         m_stats = stats;
     }
 
+    /**
+     * Keeps the object alive as long as the request; used by the hedged reads,
+     * which may complete after the caller stopped waiting for them.
+     */
+    void setKeepAlive(std::shared_ptr<void> keepAlive)
+    {
+        m_keep_alive = std::move(keepAlive);
+    }
+
     ~ClientRequest() override;
 
     std::future<IOSize> get_future()
@@ -82,6 +92,8 @@ public:
     std::shared_ptr<Source>& getCurrentSource() {return get_underlying_safe(m_source);}
 
 private:
+    void recordSuccess(IOSize size);
+
     std::shared_ptr<ClientRequest const> self_reference() const {return get_underlying_safe(m_self_reference);}
     std::shared_ptr<ClientRequest>& self_reference() {return get_underlying_safe(m_self_reference);}
 
@@ -93,6 +105,8 @@ private:
     RequestManager &m_manager;
     edm::propagate_const<std::shared_ptr<Source>> m_source;
     edm::propagate_const<std::shared_ptr<XrdReadStatistics>> m_stats;
+    std::shared_ptr<void> m_keep_alive;
+    std::chrono::steady_clock::time_point m_start;
 
     // Some explanation is due here.  When an IO is outstanding,
     // Xrootd takes a raw pointer to this object.  Hence we cannot
@@ -1,5 +1,7 @@
 
+#include <array>
 #include <cassert>
+#include <cstring>
 #include <iostream>
 #include <algorithm>
 #include <netdb.h>
@@ -35,6 +37,10 @@
 
 #define XRD_ADAPTOR_CHUNK_THRESHOLD 1000
 
+// A part of a readv still running when this fraction of the recent reads of
+// its source had completed is duplicated on the other active source.
+#define XRD_ADAPTOR_HEDGE_PERCENTILE 0.95
+
 
 #ifdef __MACH__
 #include <mach/clock.h>
@@ -128,6 +134,7 @@ RequestManager::RequestManager(const std::string &filename, XrdCl::OpenFlags::Fl
 void
 RequestManager::initialize(std::weak_ptr<RequestManager> self)
 {
+  m_self = self;
   m_open_handler = OpenHandler::getInstance(self);
 
   XrdCl::Env *env = XrdCl::DefaultEnv::GetEnv();
@@ -732,6 +739,30 @@ XrdAdaptor::RequestManager::handle(std::shared_ptr<std::vector<IOPosBuffer> > io
         return c_ptr->get_future();
     }
 
+    // Once both sources have a history, a late part is duplicated on the
+    // other source.
+    if (!req1->empty() && !req2->empty() &&
+        activeSources[0]->sourceStats()->latencyPercentile(XRD_ADAPTOR_HEDGE_PERCENTILE).count() > 0 &&
+        activeSources[1]->sourceStats()->latencyPercentile(XRD_ADAPTOR_HEDGE_PERCENTILE).count() > 0)
+    {
+        std::function<IOSize()> read1 = hedgedRead(req1, activeSources[0], activeSources[1]);
+        std::function<IOSize()> read2 = hedgedRead(req2, activeSources[1], activeSources[0]);
+        // Both parts read into the buffers of the caller: as for the reads
+        // below, wait for both before returning or throwing.
+        return std::async(std::launch::deferred,
+            [read1, read2]() {
+                std::exception_ptr failure;
+                IOSize size = 0;
+                for (const auto & read : {read1, read2})
+                {
+                    try {size += read();}
+                    catch (...) {if (!failure) {failure = std::current_exception();}}
+                }
+                if (failure) {std::rethrow_exception(failure);}
+                return size;
+            });
+    }
+
     std::shared_ptr<XrdAdaptor::ClientRequest> c_ptr1, c_ptr2;
     std::future<IOSize> future1, future2;
     if (!req1->empty())
@@ -779,6 +810,74 @@ XrdAdaptor::RequestManager::handle(std::shared_ptr<std::vector<IOPosBuffer> > io
     }
 }
 
+namespace {
+  // What the duplicate of a hedged read must keep alive until XrdCl is
+  // done with it.
+  struct HedgedReadBuffer
+  {
+    std::shared_ptr<RequestManager> manager;
+    std::vector<char> data;
+  };
+}
+
+std::function<IOSize()>
+XrdAdaptor::RequestManager::hedgedRead(std::shared_ptr<std::vector<IOPosBuffer>> iolist,
+                                       std::shared_ptr<Source> primary,
+                                       std::shared_ptr<Source> alternate)
+{
+    // The primary reads straight into the buffers of the caller; only the
+    // duplicate, issued once the deadline passed, gets a buffer of its own.
+    auto duplicate = std::make_shared<std::shared_ptr<HedgedReadBuffer>>();
+    std::shared_ptr<RequestManager> self = m_self.lock();
+    HedgedRead::Issuer issue = [this, self, iolist, duplicate, primary, alternate](unsigned source) {
+        if (source == 0)
+        {
+            auto c_ptr = std::make_shared<XrdAdaptor::ClientRequest>(*this, iolist);
+            primary->handle(c_ptr);
+            return c_ptr->get_future();
+        }
+
+        IOSize size = 0;
+        for (const auto & it : *iolist) size += it.size();
+        auto buffer = std::make_shared<HedgedReadBuffer>();
+        buffer->manager = self;
+        buffer->data.resize(size);
+        auto privateList = std::make_shared<std::vector<IOPosBuffer>>();
+        privateList->reserve(iolist->size());
+        char *data = buffer->data.data();
+        for (const auto & it : *iolist)
+        {
+            privateList->emplace_back(it.offset(), data, it.size());
+            data += it.size();
+        }
+        *duplicate = buffer;
+
+        auto c_ptr = std::make_shared<XrdAdaptor::ClientRequest>(*this, privateList, size);
+        c_ptr->setKeepAlive(buffer);
+        edm::LogVerbatim("XrdAdaptorInternal") << "Hedging a read of " << size << " bytes from "
+            << primary->PrettyID() << " on " << alternate->PrettyID();
+        alternate->handle(c_ptr);
+        alternate->sourceStats()->hedgeIssued();
+        return c_ptr->get_future();
+    };
+    auto read = std::make_shared<HedgedRead>(issue, primary->sourceStats()->latencyPercentile(XRD_ADAPTOR_HEDGE_PERCENTILE));
+
+    return [read, iolist, duplicate, alternate]() {
+        IOSize result = read->get();
+        if (read->winner() == 1)
+        {
+            alternate->sourceStats()->hedgeWon();
+            const char *data = (*duplicate)->data.data();
+            for (const auto & it : *iolist)
+            {
+                memcpy(it.data(), data, it.size());
+                data += it.size();
+            }
+        }
+        return result;
+    };
+}
+
 void
 RequestManager::requestFailure(std::shared_ptr<XrdAdaptor::ClientRequest> c_ptr, XrdCl::Status &c_status)
 {
@@ -1010,10 +1109,18 @@ XrdAdaptor::RequestManager::splitClientRequest(const std::vector<IOPosBuffer> &i
         // The quality of both is increased by 5 to prevent strange effects if quality is 0 for one source.
     float q1 = static_cast<float>(activeSources[0]->getQuality())+5;
     float q2 = static_cast<float>(activeSources[1]->getQuality())+5;
+    // Share the request in proportion to the measured throughput of the sources
+    // so both parts complete at about the same time; until it is known, favour
+    // the source of best quality.
+    float share1 = q2*q2/(q1*q1+q2*q2);
+    if (activeSources[0]->sourceStats()->throughput() > 0 && activeSources[1]->sourceStats()->throughput() > 0)
+    {
+        share1 = XrdSourceStatistics::throughputShare(*activeSources[0]->sourceStats(), *activeSources[1]->sourceStats());
+    }
     IOSize chunk1, chunk2;
     // Make sure the chunk size is at least 1024; little point to reads less than that size.
-    chunk1 = std::max(static_cast<IOSize>(static_cast<float>(XRD_CL_MAX_CHUNK)*(q2*q2/(q1*q1+q2*q2))), static_cast<IOSize>(1024));
-    chunk2 = std::max(static_cast<IOSize>(static_cast<float>(XRD_CL_MAX_CHUNK)*(q1*q1/(q1*q1+q2*q2))), static_cast<IOSize>(1024));
+    chunk1 = std::max(static_cast<IOSize>(static_cast<float>(XRD_CL_MAX_CHUNK)*share1), static_cast<IOSize>(1024));
+    chunk2 = std::max(static_cast<IOSize>(static_cast<float>(XRD_CL_MAX_CHUNK)*(1-share1)), static_cast<IOSize>(1024));
 
     IOSize size_orig = 0;
     for (const auto & it : iolist) size_orig += it.size();
@@ -5,6 +5,7 @@
 #include <vector>
 #include <set>
 #include <condition_variable>
+#include <functional>
 #include <random>
 #include <sys/stat.h>
 
@@ -17,6 +18,7 @@
 
 #include "XrdRequest.h"
 #include "XrdSource.h"
+#include "XrdHedgedRead.h"
 
 namespace XrdCl {
     class File;
@@ -149,6 +151,17 @@ private:
                             std::vector<IOPosBuffer> &req1, std::vector<IOPosBuffer> &req2,
                             std::vector<std::shared_ptr<Source>> const& activeSources) const;
 
+    /**
+     * Starts reading the part of a request meant for the primary source,
+     * hedged on the alternate source if it is late.  The primary reads into
+     * the buffers of the request; the duplicate reads into a buffer of its
+     * own, copied into the buffers of the request when the primary fails.
+     * The returned function always waits for the primary to complete.
+     */
+    std::function<IOSize()> hedgedRead(std::shared_ptr<std::vector<IOPosBuffer>> iolist,
+                                       std::shared_ptr<Source> primary,
+                                       std::shared_ptr<Source> alternate);
+
     /**
      * Given a request, broadcast it to all sources.
      * If active is true, broadcast is made to all active sources.
@@ -295,6 +308,9 @@ private:
     };
 
     std::shared_ptr<OpenHandler> m_open_handler;
+
+    // Kept alive by the hedged reads still outstanding.
+    std::weak_ptr<RequestManager> m_self;
 };
 
 }
@@ -192,7 +192,8 @@ Source::Source(timespec now, std::unique_ptr<XrdCl::File> fh, const std::string
       m_id("(unknown)"),
       m_exclude(exclude),
       m_fh(std::move(fh)),
-      m_stats(nullptr)
+      m_stats(nullptr),
+      m_sourceStats(nullptr)
 #ifdef XRD_FAKE_SLOW
     , m_slow(++g_delayCount % XRD_SLOW_RATE == 0)
     //, m_slow(++g_delayCount >= XRD_SLOW_RATE)
@@ -220,6 +221,12 @@ Source::Source(timespec now, std::unique_ptr<XrdCl::File> fh, const std::string
     if (statsService)
     {
         m_stats = statsService->getStatisticsForSite(m_site);
+        m_sourceStats = statsService->getStatisticsForSource(m_id, m_site);
+    }
+    else
+    {
+        // Needed anyway to share the requests between the sources.
+        m_sourceStats = std::make_shared<XrdSourceStatistics>(m_id, m_site);
     }
 }
 
@@ -422,6 +429,7 @@ Source::handle(std::shared_ptr<ClientRequest> c)
     edm::LogVerbatim("XrdAdaptorInternal") << "Reading from " << ID() << ", quality " << m_qm->get() << std::endl;
     c->m_source = shared_from_this();
     c->m_self_reference = c;
+    c->m_start = std::chrono::steady_clock::now();
     m_qm->startWatch(c->m_qmw);
     if (m_stats)
     {
@@ -19,6 +19,7 @@ namespace XrdAdaptor {
 class RequestList;
 class ClientRequest;
 class XrdSiteStatistics;
+class XrdSourceStatistics;
 class XrdStatisticsService;
 
 class Source : public std::enable_shared_from_this<Source>, boost::noncopyable {
@@ -41,6 +42,10 @@ public:
 
     unsigned getQuality() {return m_qm->get();}
 
+    // Statistics of the reads from this server, never null.
+    std::shared_ptr<XrdSourceStatistics const> sourceStats() const {return get_underlying_safe(m_sourceStats);}
+    std::shared_ptr<XrdSourceStatistics>& sourceStats() {return get_underlying_safe(m_sourceStats);}
+
     struct timespec getLastDowngrade() const {return m_lastDowngrade;}
     void setLastDowngrade(struct timespec now) {m_lastDowngrade = now;}
 
@@ -79,6 +84,7 @@ private:
 
     edm::propagate_const<std::unique_ptr<QualityMetricSource>> m_qm;
     edm::propagate_const<std::shared_ptr<XrdSiteStatistics>> m_stats;
+    edm::propagate_const<std::shared_ptr<XrdSourceStatistics>> m_sourceStats;
 
 #ifdef XRD_FAKE_SLOW
     bool m_slow;
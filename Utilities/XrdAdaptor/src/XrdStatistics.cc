@@ -9,6 +9,7 @@
 #include "XrdRequest.h"
 #include "XrdStatistics.h"
 
+#include <algorithm>
 #include <chrono>
 
 using namespace XrdAdaptor;
@@ -42,6 +43,11 @@ void XrdStatisticsService::postEndJob()
         stats->recomputeProperties(props);
         reportSvc->reportPerformanceForModule(stats->site(), "XrdSiteStatistics", props);
     }
+    for (auto& stats : instance->m_sources)
+    {
+        stats->recomputeProperties(props);
+        reportSvc->reportPerformanceForModule(stats->id(), "XrdSourceStatistics", props);
+    }
 }
 
 std::vector<std::pair<std::string, XrdStatisticsService::CondorIOStats>>
@@ -79,6 +85,19 @@ XrdSiteStatisticsInformation::getStatisticsForSite(std::string const &site)
 }
 
 
+std::shared_ptr<XrdSourceStatistics>
+XrdSiteStatisticsInformation::getStatisticsForSource(std::string const &id, std::string const &site)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& stats : m_sources)
+    {
+        if (stats->id() == id) {return get_underlying_safe(stats);}
+    }
+    m_sources.emplace_back(new XrdSourceStatistics(id, site));
+    return get_underlying_safe(m_sources.back());
+}
+
+
 void
 XrdSiteStatisticsInformation::createInstance()
 {
@@ -183,6 +202,96 @@ XrdSiteStatistics::finishRead(XrdReadStatistics const &readStats)
 }
 
 
+XrdSourceStatistics::XrdSourceStatistics(std::string const &id, std::string const &site) :
+    m_id(id),
+    m_site(site),
+    m_recentBytes(0),
+    m_recentNS(0),
+    m_nextLatency(0),
+    m_readCount(0),
+    m_readSize(0),
+    m_readNS(0),
+    m_hedgeCount(0),
+    m_hedgeWonCount(0)
+{
+    m_latencies.reserve(LATENCY_WINDOW);
+}
+
+
+void
+XrdSourceStatistics::finishRead(IOSize size, std::chrono::nanoseconds elapsed)
+{
+    m_readCount ++;
+    m_readSize += size;
+    m_readNS += elapsed.count();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // The throughput follows the last few tens of reads.
+    m_recentBytes = 0.95*m_recentBytes + size;
+    m_recentNS = 0.95*m_recentNS + elapsed.count();
+    if (m_latencies.size() < LATENCY_WINDOW)
+    {
+        m_latencies.push_back(elapsed.count());
+    }
+    else
+    {
+        m_latencies[m_nextLatency] = elapsed.count();
+        m_nextLatency = (m_nextLatency + 1) % LATENCY_WINDOW;
+    }
+}
+
+
+double
+XrdSourceStatistics::throughput() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_latencies.size() < MIN_READS || m_recentNS <= 0) {return 0;}
+    return m_recentBytes / m_recentNS * 1e9;
+}
+
+
+std::chrono::nanoseconds
+XrdSourceStatistics::latencyPercentile(double fraction) const
+{
+    std::vector<uint64_t> latencies;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_latencies.size() < MIN_READS) {return std::chrono::nanoseconds(0);}
+        latencies = m_latencies;
+    }
+    size_t index = std::min(static_cast<size_t>(fraction*latencies.size()), latencies.size()-1);
+    std::nth_element(latencies.begin(), latencies.begin()+index, latencies.end());
+    return std::chrono::nanoseconds(latencies[index]);
+}
+
+
+double
+XrdSourceStatistics::throughputShare(XrdSourceStatistics const &a, XrdSourceStatistics const &b)
+{
+    double ta = a.throughput();
+    double tb = b.throughput();
+    if (ta <= 0 || tb <= 0) {return 0.5;}
+    return std::min(std::max(ta/(ta+tb), 0.1), 0.9);
+}
+
+
+void
+XrdSourceStatistics::recomputeProperties(std::map<std::string, std::string> &props)
+{
+    props.clear();
+
+    props["site"] = m_site;
+    props["read-numOperations"] = i2str(m_readCount);
+    props["read-totalMegabytes"] = d2str(static_cast<float>(m_readSize)/(1024.0*1024.0));
+    props["read-totalMsecs"] = d2str(static_cast<float>(m_readNS)/1e6);
+    props["read-recentMegabytesPerSec"] = d2str(throughput()/(1024.0*1024.0));
+    props["read-medianMsecs"] = d2str(latencyPercentile(0.5).count()/1e6);
+    props["read-95percentMsecs"] = d2str(latencyPercentile(0.95).count()/1e6);
+    props["hedge-numOperations"] = i2str(m_hedgeCount);
+    props["hedge-numWon"] = i2str(m_hedgeWonCount);
+}
+
+
 XrdReadStatistics::XrdReadStatistics(std::shared_ptr<XrdSiteStatistics> parent, IOSize size, size_t count) :
     m_size(size),
     m_count(count),
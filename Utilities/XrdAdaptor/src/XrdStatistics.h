@@ -29,6 +29,7 @@ namespace XrdAdaptor
 class ClientRequest;
 class XrdReadStatistics;
 class XrdSiteStatistics;
+class XrdSourceStatistics;
 
 
 /* NOTE: All member information is kept in the XrdSiteStatisticsInformation singleton,
@@ -67,12 +68,15 @@ public:
 
     std::shared_ptr<XrdSiteStatistics> getStatisticsForSite(std::string const &site);
 
+    std::shared_ptr<XrdSourceStatistics> getStatisticsForSource(std::string const &id, std::string const &site);
+
 private:
     static void createInstance();
 
     static std::atomic<XrdSiteStatisticsInformation*> m_instance;
     std::mutex m_mutex;
     std::vector<edm::propagate_const<std::shared_ptr<XrdSiteStatistics>>> m_sites;
+    std::vector<edm::propagate_const<std::shared_ptr<XrdSourceStatistics>>> m_sources;
 };
 
 class XrdSiteStatistics
@@ -109,6 +113,61 @@ private:
     std::atomic<uint64_t> m_readNS;
 };
 
+/* Statistics of the successful reads from one server, used to share the
+ * requests between the active sources and to decide when a read is late
+ * enough to be duplicated on the other source ("hedged").
+ */
+class XrdSourceStatistics
+{
+public:
+    XrdSourceStatistics(std::string const &id, std::string const &site);
+    XrdSourceStatistics(const XrdSourceStatistics&) = delete;
+    XrdSourceStatistics &operator=(const XrdSourceStatistics&) = delete;
+
+    std::string const &id() const {return m_id;}
+    std::string const &site() const {return m_site;}
+
+    void finishRead(IOSize size, std::chrono::nanoseconds elapsed);
+
+    void hedgeIssued() {m_hedgeCount++;}
+    void hedgeWon() {m_hedgeWonCount++;}
+
+    // Bytes per second of the recent reads; 0 if not yet known.
+    double throughput() const;
+
+    // Duration under which the given fraction of the recent reads completed;
+    // 0 if too few reads were made.
+    std::chrono::nanoseconds latencyPercentile(double fraction) const;
+
+    // Share of a request to give to source a, proportional to the throughput
+    // of the sources.  It is kept between 0.1 and 0.9 so the throughput of
+    // both sources remains measured; 0.5 if a throughput is not yet known.
+    static double throughputShare(XrdSourceStatistics const &a, XrdSourceStatistics const &b);
+
+    void recomputeProperties(std::map<std::string, std::string> &props);
+
+    // Number of recent reads kept for the percentiles, and needed at least.
+    static const unsigned int LATENCY_WINDOW = 64;
+    static const unsigned int MIN_READS = 16;
+
+private:
+    const std::string m_id;
+    const std::string m_site;
+
+    mutable std::mutex m_mutex;
+    // Exponentially decaying sums of the bytes and time of the reads.
+    double m_recentBytes;
+    double m_recentNS;
+    std::vector<uint64_t> m_latencies;
+    unsigned int m_nextLatency;
+
+    std::atomic<unsigned> m_readCount;
+    std::atomic<uint64_t> m_readSize;
+    std::atomic<uint64_t> m_readNS;
+    std::atomic<unsigned> m_hedgeCount;
+    std::atomic<unsigned> m_hedgeWonCount;
+};
+
 class XrdReadStatistics
 {
 friend class XrdSiteStatistics;
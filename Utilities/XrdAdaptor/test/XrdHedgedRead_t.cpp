@@ -0,0 +1,148 @@
+/** Tests the splitting and hedging of the reads between two sources with
+    mock sources, which answer after an injected delay from a thread of
+    their own instead of reading from an Xrootd server.
+*/
+
+#include "Utilities/XrdAdaptor/src/XrdHedgedRead.h"
+#include "Utilities/XrdAdaptor/src/XrdStatistics.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+using namespace XrdAdaptor;
+using namespace std::chrono;
+
+namespace {
+  class MockSource {
+  public:
+    MockSource(std::string const& id, milliseconds latency, double bytesPerSecond, bool fail = false)
+        : m_stats(std::make_shared<XrdSourceStatistics>(id, "mock")),
+          m_latency(latency),
+          m_bytesPerSecond(bytesPerSecond),
+          m_fail(fail),
+          m_reads(0) {}
+
+    std::future<IOSize> read(IOSize size) {
+      ++m_reads;
+      auto promise = std::make_shared<std::promise<IOSize>>();
+      auto stats = m_stats;
+      auto delay = m_latency + duration_cast<nanoseconds>(duration<double>(size / m_bytesPerSecond));
+      bool fail = m_fail;
+      std::thread([promise, stats, delay, size, fail]() {
+        std::this_thread::sleep_for(delay);
+        if (fail) {
+          promise->set_exception(std::make_exception_ptr(cms::Exception("MockSource") << "read failed"));
+        } else {
+          stats->finishRead(size, delay);
+          promise->set_value(size);
+        }
+      }).detach();
+      return promise->get_future();
+    }
+
+    XrdSourceStatistics& stats() { return *m_stats; }
+    unsigned reads() const { return m_reads; }
+
+  private:
+    std::shared_ptr<XrdSourceStatistics> m_stats;
+    milliseconds m_latency;
+    double m_bytesPerSecond;
+    bool m_fail;
+    std::atomic<unsigned> m_reads;
+  };
+
+  void check(bool condition, char const* what) {
+    if (!condition) {
+      throw cms::Exception("XrdHedgedReadTest") << "Check failed: " << what;
+    }
+  }
+
+  void warmUp(MockSource& source, unsigned reads, IOSize size) {
+    for (unsigned i = 0; i < reads; ++i) {
+      source.read(size).get();
+    }
+  }
+
+  HedgedRead::Issuer issuer(MockSource& first, MockSource& second, IOSize size) {
+    return [&first, &second, size](unsigned source) { return source == 0 ? first.read(size) : second.read(size); };
+  }
+}
+
+int main() try {
+  MockSource fast("fast:1094", milliseconds(2), 400e6);
+  MockSource slow("slow:1094", milliseconds(2), 100e6);
+
+  // No statistics before enough reads were made.
+  check(fast.stats().throughput() == 0, "throughput unknown");
+  check(fast.stats().latencyPercentile(0.95).count() == 0, "percentile unknown");
+  check(XrdSourceStatistics::throughputShare(fast.stats(), slow.stats()) == 0.5, "even share without statistics");
+
+  warmUp(fast, XrdSourceStatistics::MIN_READS, 1024 * 1024);
+  warmUp(slow, XrdSourceStatistics::MIN_READS, 1024 * 1024);
+
+  // The requests are shared in proportion to the throughput.
+  double throughput = fast.stats().throughput();
+  check(throughput > 100e6 && throughput < 500e6, "fast throughput measured");
+  double share = XrdSourceStatistics::throughputShare(fast.stats(), slow.stats());
+  std::cout << "fast " << throughput / 1e6 << " MB/s, slow " << slow.stats().throughput() / 1e6
+            << " MB/s, share of fast " << share << std::endl;
+  check(share > 0.6 && share <= 0.9, "share follows the throughput");
+  check(fast.stats().latencyPercentile(0.5) <= fast.stats().latencyPercentile(0.95), "percentiles ordered");
+
+  // A read completing in time is not hedged.
+  {
+    MockSource second("second:1094", milliseconds(1), 1e9);
+    HedgedRead read(issuer(fast, second, 1024), milliseconds(500));
+    check(read.get() == 1024, "size of the read");
+    check(!read.hedged() && read.winner() == 0, "no hedge for a read in time");
+    check(second.reads() == 0, "second source not used");
+  }
+
+  // A straggler is duplicated, but reads into the buffers of the caller:
+  // the read waits for it and uses its data.
+  {
+    MockSource straggler("straggler:1094", milliseconds(300), 1e9);
+    MockSource second("second:1094", milliseconds(1), 1e9);
+    auto start = steady_clock::now();
+    HedgedRead read(issuer(straggler, second, 1024), fast.stats().latencyPercentile(0.95) + milliseconds(20));
+    check(read.get() == 1024, "size of the hedged read");
+    auto elapsed = duration_cast<milliseconds>(steady_clock::now() - start);
+    std::cout << "hedged read completed in " << elapsed.count() << " ms" << std::endl;
+    check(read.hedged() && read.winner() == 0, "straggler hedged but used");
+    check(second.reads() == 1, "duplicate issued");
+    check(elapsed >= milliseconds(300), "hedged read waits for the straggler");
+  }
+
+  // A late read failing still gets the data of the duplicate.
+  {
+    MockSource failing("failing:1094", milliseconds(100), 1e9, true);
+    MockSource late("late:1094", milliseconds(200), 1e9);
+    HedgedRead read(issuer(failing, late, 1024), milliseconds(10));
+    check(read.get() == 1024, "duplicate covers the failure");
+    check(read.winner() == 1, "duplicate wins after a failure");
+  }
+
+  // Both failing gives the error of the first source.
+  {
+    MockSource failing1("failing1:1094", milliseconds(50), 1e9, true);
+    MockSource failing2("failing2:1094", milliseconds(10), 1e9, true);
+    HedgedRead read(issuer(failing1, failing2, 1024), milliseconds(5));
+    bool thrown = false;
+    try {
+      read.get();
+    } catch (cms::Exception const&) {
+      thrown = true;
+    }
+    check(thrown, "failure of both reads reported");
+  }
+
+  return EXIT_SUCCESS;
+} catch (cms::Exception const& e) {
+  std::cerr << e.explainSelf() << std::endl;
+  return EXIT_FAILURE;
+}